@@ -24,6 +24,7 @@ class StateSegment(enum.Enum):
     # Measurements
     SENSOR_MEASUREMENTS = enum.auto()
     CYCLE_MEASUREMENTS = enum.auto()
+    PLETH_WAVEFORM = enum.auto()
     # Parameters
     PARAMETERS = enum.auto()
     PARAMETERS_REQUEST = enum.auto()
@@ -45,6 +46,9 @@ class StateSegment(enum.Enum):
     BACKEND_CONNECTIONS = enum.auto()
     SCREEN_STATUS = enum.auto()
     SCREEN_STATUS_REQUEST = enum.auto()
+    # Diagnostics
+    MCU_DIAGNOSTICS = enum.auto()
+    I2C_DIAGNOSTICS = enum.auto()
 
     # frontend_pb
     ROTARY_ENCODER = enum.auto()
@@ -75,6 +79,9 @@ MCU_INPUT_TYPES: Mapping[Type[betterproto.Message], StateSegment] = {
     mcu_pb.AlarmMute: StateSegment.ALARM_MUTE,
     mcu_pb.MCUPowerStatus: StateSegment.MCU_POWER_STATUS,
     mcu_pb.ScreenStatus: StateSegment.SCREEN_STATUS,
+    mcu_pb.MCUDiagnostics: StateSegment.MCU_DIAGNOSTICS,
+    mcu_pb.PlethWaveform: StateSegment.PLETH_WAVEFORM,
+    mcu_pb.I2CDiagnostics: StateSegment.I2C_DIAGNOSTICS,
 }
 MCU_OUTPUT_INTERVAL = 0.01  # s
 MCU_OUTPUT_MIN_INTERVAL = 0.01  # s
@@ -29,6 +29,7 @@ MESSAGE_CLASSES: Mapping[int, Type[betterproto.Message]] = {
     # Measurements
     2: mcu_pb.SensorMeasurements,
     3: mcu_pb.CycleMeasurements,
+    25: mcu_pb.PlethWaveform,
     # Parameters
     4: mcu_pb.Parameters,
     5: mcu_pb.ParametersRequest,
@@ -47,6 +48,9 @@ MESSAGE_CLASSES: Mapping[int, Type[betterproto.Message]] = {
     21: mcu_pb.BackendConnections,
     22: mcu_pb.ScreenStatus,
     23: mcu_pb.ScreenStatusRequest,
+    # Diagnostics
+    24: mcu_pb.MCUDiagnostics,
+    26: mcu_pb.I2CDiagnostics,
     # Testing Messages
     254: mcu_pb.Ping,
     255: mcu_pb.Announcement
@@ -134,6 +134,13 @@ class CycleMeasurements(betterproto.Message):
     ve: float = betterproto.float_field(7)
 
 
+@dataclass
+class PlethWaveform(betterproto.Message):
+    time: int = betterproto.uint64_field(1)
+    sequence: int = betterproto.uint32_field(2)
+    samples: bytes = betterproto.bytes_field(3)
+
+
 @dataclass
 class Parameters(betterproto.Message):
     time: int = betterproto.uint64_field(1)
@@ -319,6 +326,49 @@ class ScreenStatus(betterproto.Message):
     lock: bool = betterproto.bool_field(1)
 
 
+@dataclass
+class MCUDiagnostics(betterproto.Message):
+    stack_size: int = betterproto.uint32_field(1)
+    stack_high_water_mark: int = betterproto.uint32_field(2)
+    scratch_size: int = betterproto.uint32_field(3)
+    scratch_high_water_mark: int = betterproto.uint32_field(4)
+    setup_duration: int = betterproto.uint32_field(5)
+    setups_failed: int = betterproto.uint32_field(6)
+    setups_timed_out: int = betterproto.uint32_field(7)
+    times_to_ready: List[int] = betterproto.uint32_field(8)
+    reconnections: List["SensorReconnections"] = betterproto.message_field(9)
+    air_flow_discrepancy: float = betterproto.float_field(10)
+    air_flow_disagreements: int = betterproto.uint32_field(11)
+
+
+@dataclass
+class SensorReconnections(betterproto.Message):
+    connected: bool = betterproto.bool_field(1)
+    disconnections: int = betterproto.uint32_field(2)
+    attempts: int = betterproto.uint32_field(3)
+    reconnections: int = betterproto.uint32_field(4)
+    last_latency: int = betterproto.uint32_field(5)
+    max_latency: int = betterproto.uint32_field(6)
+
+
+@dataclass
+class I2CDeviceHealth(betterproto.Message):
+    transactions: int = betterproto.uint32_field(1)
+    nacks: int = betterproto.uint32_field(2)
+    timeouts: int = betterproto.uint32_field(3)
+    busy: int = betterproto.uint32_field(4)
+    crc_failures: int = betterproto.uint32_field(5)
+    other_errors: int = betterproto.uint32_field(6)
+    recoveries: int = betterproto.uint32_field(7)
+    latencies: List[int] = betterproto.uint32_field(8)
+    failed_recoveries: int = betterproto.uint32_field(9)
+
+
+@dataclass
+class I2CDiagnostics(betterproto.Message):
+    devices: List["I2CDeviceHealth"] = betterproto.message_field(1)
+
+
 @dataclass
 class Ping(betterproto.Message):
     time: int = betterproto.uint64_field(1)
@@ -0,0 +1,116 @@
+/// \file
+/// \brief A minimal host-side benchmark harness with JSON reporting.
+///
+/// Benchmarks are registered statically with PF_BENCHMARK and run by the Benchmark executable,
+/// which writes one JSON document with a record per benchmark so that results can be diffed
+/// across commits to catch performance regressions.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Pufferfish::Benchmark {
+
+/**
+ * Per-operation accounting reported by a benchmark case.
+ *
+ * Operations fill in these counters on every call; the harness averages them over all
+ * iterations. bytes is the size of the frame being processed, which is used to compute
+ * ns per byte. estimated_bytes_touched and estimated_copies are static estimates, which each
+ * operation derives from the implementation it benchmarks rather than measures: they count the
+ * bytes read from or written to buffers and the whole-buffer copies which the implementation is
+ * expected to make, and must be updated by hand when that implementation changes. Operations which
+ * approximate a reference computation (e.g. in fixed-point instead of float) report the absolute
+ * error of their result in abs_error, which the harness averages and also reports the maximum of.
+ */
+struct Counters {
+  size_t bytes = 0;
+  size_t estimated_bytes_touched = 0;
+  size_t estimated_copies = 0;
+  double abs_error = 0;
+};
+
+struct Result {
+  std::string suite;
+  std::string name;
+  uint64_t iterations = 0;
+  double ns_per_op = 0;
+  double ns_per_byte = 0;
+  double frames_per_s = 0;
+  double bytes_per_op = 0;
+  double estimated_bytes_touched_per_op = 0;
+  double estimated_copies_per_op = 0;
+  double mean_abs_error = 0;
+  double max_abs_error = 0;
+  uint64_t heap_allocations = 0;
+};
+
+/// An operation performs exactly one unit of work (e.g. one frame) per call.
+using Operation = std::function<void(Counters &counters)>;
+
+struct Case {
+  std::string suite;
+  std::string name;
+  Operation operation;
+};
+
+struct Options {
+  std::string filter;
+  uint32_t min_time_ms = 200;
+  uint32_t warmup_iterations = 100;
+};
+
+/// Returns the global registry of benchmark cases
+std::vector<Case> &registry();
+
+/// Counts heap allocations made by the process, for checking that operations are allocation-free
+uint64_t heap_allocations();
+
+class Registrar {
+ public:
+  Registrar(const char *suite, const char *name, Operation operation);
+};
+
+Result run(const Case &benchmark_case, const Options &options);
+void write_json(std::ostream &output, const std::vector<Result> &results);
+
+/// Prevents the compiler from optimizing away a computed value
+template <typename T>
+inline void do_not_optimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace Pufferfish::Benchmark
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define PF_BENCHMARK_CONCAT_IMPL(a, b) a##b
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define PF_BENCHMARK_CONCAT(a, b) PF_BENCHMARK_CONCAT_IMPL(a, b)
+
+// Registers a benchmark case; the operation must be a callable taking a Counters reference.
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define PF_BENCHMARK(suite, name, operation)                         \
+  static const Pufferfish::Benchmark::Registrar PF_BENCHMARK_CONCAT( \
+      pf_benchmark_registrar_, __LINE__)(suite, name, operation)
@@ -0,0 +1,114 @@
+/// \file
+/// \brief A minimal host-side benchmark harness with JSON reporting.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Benchmark/Harness.h"
+
+#include <chrono>
+#include <iomanip>
+#include <utility>
+
+namespace Pufferfish::Benchmark {
+
+std::vector<Case> &registry() {
+  static std::vector<Case> cases;
+  return cases;
+}
+
+Registrar::Registrar(const char *suite, const char *name, Operation operation) {
+  registry().push_back(Case{suite, name, std::move(operation)});
+}
+
+Result run(const Case &benchmark_case, const Options &options) {
+  using Clock = std::chrono::steady_clock;
+  static const uint64_t batch_size = 64;
+
+  Counters counters{};
+  for (uint32_t i = 0; i < options.warmup_iterations; ++i) {
+    benchmark_case.operation(counters);
+  }
+
+  Counters totals{};
+  double max_abs_error = 0;
+  uint64_t iterations = 0;
+  uint64_t allocations_before = heap_allocations();
+  auto min_time = std::chrono::milliseconds(options.min_time_ms);
+  auto start = Clock::now();
+  auto elapsed = Clock::duration::zero();
+  while (elapsed < min_time) {
+    for (uint64_t i = 0; i < batch_size; ++i) {
+      Counters op_counters{};
+      benchmark_case.operation(op_counters);
+      totals.bytes += op_counters.bytes;
+      totals.estimated_bytes_touched += op_counters.estimated_bytes_touched;
+      totals.estimated_copies += op_counters.estimated_copies;
+      totals.abs_error += op_counters.abs_error;
+      if (op_counters.abs_error > max_abs_error) {
+        max_abs_error = op_counters.abs_error;
+      }
+    }
+    iterations += batch_size;
+    elapsed = Clock::now() - start;
+  }
+  uint64_t allocations = heap_allocations() - allocations_before;
+
+  Result result;
+  result.suite = benchmark_case.suite;
+  result.name = benchmark_case.name;
+  result.iterations = iterations;
+  double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+  auto n = static_cast<double>(iterations);
+  result.ns_per_op = elapsed_ns / n;
+  result.frames_per_s = n * 1e9 / elapsed_ns;
+  result.bytes_per_op = static_cast<double>(totals.bytes) / n;
+  result.estimated_bytes_touched_per_op = static_cast<double>(totals.estimated_bytes_touched) / n;
+  result.estimated_copies_per_op = static_cast<double>(totals.estimated_copies) / n;
+  result.mean_abs_error = totals.abs_error / n;
+  result.max_abs_error = max_abs_error;
+  if (totals.bytes > 0) {
+    result.ns_per_byte = elapsed_ns / static_cast<double>(totals.bytes);
+  }
+  result.heap_allocations = allocations;
+  return result;
+}
+
+void write_json(std::ostream &output, const std::vector<Result> &results) {
+  output << std::setprecision(6);
+  output << "{\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &result = results[i];
+    output << (i == 0 ? "\n" : ",\n");
+    output << "    {";
+    output << "\"suite\": \"" << result.suite << "\", ";
+    output << "\"name\": \"" << result.name << "\", ";
+    output << "\"iterations\": " << result.iterations << ", ";
+    output << "\"ns_per_op\": " << result.ns_per_op << ", ";
+    output << "\"ns_per_byte\": " << result.ns_per_byte << ", ";
+    output << "\"frames_per_s\": " << result.frames_per_s << ", ";
+    output << "\"bytes_per_op\": " << result.bytes_per_op << ", ";
+    output << "\"estimated_bytes_touched_per_op\": " << result.estimated_bytes_touched_per_op << ", ";
+    output << "\"estimated_copies_per_op\": " << result.estimated_copies_per_op << ", ";
+    output << "\"mean_abs_error\": " << result.mean_abs_error << ", ";
+    output << "\"max_abs_error\": " << result.max_abs_error << ", ";
+    output << "\"heap_allocations\": " << result.heap_allocations << "}";
+  }
+  output << "\n  ]\n}\n";
+}
+
+}  // namespace Pufferfish::Benchmark
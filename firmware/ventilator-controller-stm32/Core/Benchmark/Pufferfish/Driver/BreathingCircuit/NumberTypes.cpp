@@ -0,0 +1,175 @@
+/// \file
+/// \brief Benchmarks comparing the cost and numerical error of float and fixed-point control.
+///
+/// The PI controller and the display smoother are each instantiated with float, Q31 and Q15, and
+/// driven with the same recorded-like flow signal. Every operation compares its output against
+/// the float implementation run over the same signal, so the JSON report has the absolute error
+/// of each fixed-point instantiation next to its time per operation. Fixed-point inputs are
+/// divided by a full-scale flow of 128 L/min, and the PI gains are multiplied by it.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+#include <optional>
+
+#include "Pufferfish/Benchmark/Harness.h"
+#include "Pufferfish/Driver/BreathingCircuit/Algorithms.h"
+#include "Pufferfish/Protocols/Application/SignalSmoothing.h"
+#include "Pufferfish/Util/FixedPoint.h"
+#include "Pufferfish/Util/Numeric.h"
+
+namespace Pufferfish::Driver::BreathingCircuit {
+
+namespace BM = Benchmark;
+
+namespace {
+
+using Protocols::Application::DisplaySmoother;
+using Protocols::Application::SmoothingParameters;
+using Util::Q15;
+using Util::Q31;
+
+constexpr size_t num_samples = 2048;
+constexpr float full_scale = 128;          // L/min
+constexpr float flow_setpoint = 40;        // L/min
+constexpr uint32_t sampling_interval = 5;  // ms
+constexpr SmoothingParameters smoothing_params{1, 0.5, 100, 100, full_scale};
+
+using Signal = std::array<float, num_samples>;
+
+// A flow rising towards the setpoint with sensor noise, followed by a step down, which exercises
+// the integrator's anti-windup and the smoother's convergence and transition handling
+const Signal &flow_signal() {
+  static const Signal signal = [] {
+    Signal result{};
+    uint32_t noise_state = 1;
+    for (size_t i = 0; i < num_samples; ++i) {
+      static const uint32_t lcg_multiplier = 1664525;
+      static const uint32_t lcg_increment = 1013904223;
+      noise_state = noise_state * lcg_multiplier + lcg_increment;
+      float noise = static_cast<float>(noise_state >> 8U) / static_cast<float>(1U << 24U) - 0.5F;
+      float level = (i < num_samples / 2) ? flow_setpoint : flow_setpoint / 2;
+      float time_constant = static_cast<float>(num_samples) / 16;
+      float settled = 1 - std::exp(-static_cast<float>(i % (num_samples / 2)) / time_constant);
+      result[i] = level * settled + noise;
+    }
+    return result;
+  }();
+  return signal;
+}
+
+template <typename Number>
+Number to_number(float value) {
+  if constexpr (Util::Numeric<Number>::is_fixed_point) {
+    return Util::Numeric<Number>::from_float(value / full_scale);
+  }
+  return Util::Numeric<Number>::from_float(value);
+}
+
+template <typename Number>
+PI<Number> make_pi() {
+  if constexpr (Util::Numeric<Number>::is_fixed_point) {
+    return PI<Number>(PI<>::default_p_gain * full_scale, PI<>::default_i_gain * full_scale);
+  }
+  return PI<Number>();
+}
+
+const Signal &reference_actuations() {
+  static const Signal actuations = [] {
+    Signal result{};
+    PI<> pi;
+    for (size_t i = 0; i < num_samples; ++i) {
+      pi.transform(flow_signal()[i], flow_setpoint, result[i]);
+    }
+    return result;
+  }();
+  return actuations;
+}
+
+const Signal &reference_smoothed() {
+  static const Signal smoothed = [] {
+    Signal result{};
+    DisplaySmoother<> smoother{sampling_interval, smoothing_params};
+    for (size_t i = 0; i < num_samples; ++i) {
+      auto current_time = static_cast<uint32_t>(i * sampling_interval);
+      smoother.transform(current_time, flow_signal()[i], result[i]);
+    }
+    return result;
+  }();
+  return smoothed;
+}
+
+// Runs one step of the controller per operation, restarting it at the end of the signal
+template <typename Number>
+void pi_step(BM::Counters &counters) {
+  static std::array<Number, num_samples> measurements = [] {
+    std::array<Number, num_samples> result{};
+    for (size_t i = 0; i < num_samples; ++i) {
+      result[i] = to_number<Number>(flow_signal()[i]);
+    }
+    return result;
+  }();
+  static const Number setpoint = to_number<Number>(flow_setpoint);
+  static std::optional<PI<Number>> pi;
+  static size_t next = 0;
+  if (next == 0) {
+    pi.emplace(make_pi<Number>());
+  }
+
+  Number actuation{};
+  pi->transform(measurements[next], setpoint, actuation);
+  BM::do_not_optimize(actuation);
+  counters.abs_error =
+      std::abs(Util::Numeric<Number>::to_float(actuation) - reference_actuations()[next]);
+  next = (next + 1) % num_samples;
+}
+
+// Runs one sample of the smoother per operation, restarting it at the end of the signal
+template <typename Number>
+void smoother_step(BM::Counters &counters) {
+  static std::optional<DisplaySmoother<Number>> smoother;
+  static size_t next = 0;
+  if (next == 0) {
+    smoother.emplace(sampling_interval, smoothing_params);
+  }
+
+  float filtered = 0;
+  auto current_time = static_cast<uint32_t>(next * sampling_interval);
+  smoother->transform(current_time, flow_signal()[next], filtered);
+  BM::do_not_optimize(filtered);
+  float reference = reference_smoothed()[next];
+  // Both outputs are NaN until the smoother first converges
+  if (!std::isnan(filtered) && !std::isnan(reference)) {
+    counters.abs_error = std::abs(filtered - reference);
+  }
+  next = (next + 1) % num_samples;
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("breathing_circuit.pi", "float", pi_step<float>);
+PF_BENCHMARK("breathing_circuit.pi", "q31", pi_step<Q31>);
+PF_BENCHMARK("breathing_circuit.pi", "q15", pi_step<Q15>);
+PF_BENCHMARK("breathing_circuit.display_smoother", "float", smoother_step<float>);
+PF_BENCHMARK("breathing_circuit.display_smoother", "q31", smoother_step<Q31>);
+PF_BENCHMARK("breathing_circuit.display_smoother", "q15", smoother_step<Q15>);
+// clang-format on
+
+}  // namespace Pufferfish::Driver::BreathingCircuit
@@ -0,0 +1,99 @@
+/// \file
+/// \brief Benchmarks of parsing FDO2 responses.
+///
+/// The receive cases feed a response byte-by-byte through ResponseReceiver::input/output, as
+/// Device::receive does with the bytes from the UART, so they include the cost of framing. The
+/// command_receiver cases parse a complete line which has already been buffered.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+
+#include "Pufferfish/Benchmark/Harness.h"
+#include "Pufferfish/Driver/Serial/FDO2/Device.h"
+
+namespace PF = Pufferfish;
+namespace BM = PF::Benchmark;
+namespace FDO2 = PF::Driver::Serial::FDO2;
+
+namespace {
+
+// Typical responses, as the sensor sends them in broadcast mode and on startup
+const char *mraw() {
+  return "#MRAW 20945 2341 0 5125 154030 7132 1013200 45132\r";
+}
+const char *vers() {
+  return "#VERS 1 1 412 7\r";
+}
+const char *bcst() {
+  return "#BCST 100\r";
+}
+
+void receive(const char *frame, BM::Counters &counters) {
+  static FDO2::ResponseReceiver receiver;
+  FDO2::Response response{};
+  size_t length = std::strlen(frame);
+  for (size_t i = 0; i < length; ++i) {
+    receiver.input(static_cast<uint8_t>(frame[i]));
+  }
+  BM::do_not_optimize(receiver.output(response));
+  BM::do_not_optimize(response);
+  counters.bytes = length;
+}
+
+void command_receiver(const char *frame, BM::Counters &counters) {
+  static FDO2::Responses::ChunkBuffer buffer;
+  static const char *prepared = nullptr;
+  if (prepared != frame) {
+    buffer.clear();
+    for (const char *c = frame; *c != '\0'; ++c) {
+      buffer.push_back(*c);
+    }
+    prepared = frame;
+  }
+  FDO2::Response response{};
+  BM::do_not_optimize(FDO2::CommandReceiver::transform(buffer, response));
+  BM::do_not_optimize(response);
+  counters.bytes = buffer.size();
+}
+
+void receive_mraw(BM::Counters &counters) {
+  receive(mraw(), counters);
+}
+void receive_vers(BM::Counters &counters) {
+  receive(vers(), counters);
+}
+void receive_bcst(BM::Counters &counters) {
+  receive(bcst(), counters);
+}
+void command_receiver_mraw(BM::Counters &counters) {
+  command_receiver(mraw(), counters);
+}
+void command_receiver_vers(BM::Counters &counters) {
+  command_receiver(vers(), counters);
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("fdo2.responses", "receive/mraw", receive_mraw);
+PF_BENCHMARK("fdo2.responses", "receive/vers", receive_vers);
+PF_BENCHMARK("fdo2.responses", "receive/bcst", receive_bcst);
+PF_BENCHMARK("fdo2.responses", "command_receiver/mraw", command_receiver_mraw);
+PF_BENCHMARK("fdo2.responses", "command_receiver/vers", command_receiver_vers);
+// clang-format on
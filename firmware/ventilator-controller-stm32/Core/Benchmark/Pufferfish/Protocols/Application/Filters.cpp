@@ -0,0 +1,92 @@
+/// \file
+/// \brief Throughput benchmarks of the biquad and FIR filters, per sample and per block.
+///
+/// Filters are designed like the flow prefilter in the control loop, for signals sampled at
+/// 500 Hz. Block operations process one block of 32 samples, so that their ns per byte can be
+/// compared with that of the per-sample operations.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Protocols/Application/Filters.h"
+
+#include <array>
+
+#include "Pufferfish/Benchmark/Harness.h"
+
+namespace Pufferfish::Protocols::Application {
+
+namespace BM = Benchmark;
+
+namespace {
+
+constexpr float sample_rate = 500;  // Hz
+constexpr float cutoff = 50;        // Hz
+constexpr size_t block_size = 32;
+constexpr BiquadCoefficients low_pass = FilterDesign::low_pass(cutoff, sample_rate);
+constexpr size_t num_taps = 16;
+
+using Block = std::array<float, block_size>;
+
+const Block &input_block() {
+  static const Block block = [] {
+    Block result{};
+    for (size_t i = 0; i < block_size; ++i) {
+      result[i] = static_cast<float>((i * 37) % 11);
+    }
+    return result;
+  }();
+  return block;
+}
+
+BiquadCascade<2> &biquad() {
+  static BiquadCascade<2> filter{{low_pass, low_pass}};
+  return filter;
+}
+
+FIRFilter<num_taps> &fir() {
+  static FIRFilter<num_taps> filter{FilterDesign::low_pass_taps<num_taps>(cutoff, sample_rate)};
+  return filter;
+}
+
+template <typename Filter>
+void per_sample(Filter &filter, BM::Counters &counters) {
+  static size_t next = 0;
+  float output = filter.transform(input_block()[next]);
+  BM::do_not_optimize(output);
+  next = (next + 1) % block_size;
+  counters.bytes = sizeof(float);
+}
+
+template <typename Filter>
+void per_block(Filter &filter, BM::Counters &counters) {
+  static Block output{};
+  filter.transform(input_block(), output);
+  BM::do_not_optimize(output);
+  counters.bytes = sizeof(Block);
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("filters.biquad2", "sample", [](auto &c) { per_sample(biquad(), c); });
+PF_BENCHMARK("filters.biquad2", "block", [](auto &c) { per_block(biquad(), c); });
+PF_BENCHMARK("filters.fir16", "sample", [](auto &c) { per_sample(fir(), c); });
+PF_BENCHMARK("filters.fir16", "block", [](auto &c) { per_block(fir(), c); });
+// clang-format on
+
+}  // namespace Pufferfish::Protocols::Application
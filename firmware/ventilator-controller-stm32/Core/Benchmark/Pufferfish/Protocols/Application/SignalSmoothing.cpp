@@ -0,0 +1,108 @@
+/// \file
+/// \brief Benchmarks comparing separate display smoothers with the multi-channel display smoother.
+///
+/// Both are configured like SensorMeasurementsSmoothers, with four channels (FiO2, flow, SpO2 and
+/// heart rate), and each operation is one sampling interval in which every channel is updated.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Protocols/Application/SignalSmoothing.h"
+
+#include <array>
+
+#include "Pufferfish/Benchmark/Harness.h"
+#include "Pufferfish/Util/FixedPoint.h"
+
+namespace Pufferfish::Protocols::Application {
+
+namespace BM = Benchmark;
+
+namespace {
+
+constexpr size_t num_channels = 4;
+constexpr uint32_t sampling_interval = 5;  // ms
+constexpr std::array<SmoothingParameters, num_channels> params{
+    {{1, 0.5, 100, 100, 128},
+     {1, 0.5, 100, 100, 128},
+     {1, 0.5, 100, 1000, 128},
+     {1, 0.5, 100, 1000, 256}}};
+constexpr size_t num_samples = 1024;
+
+using Samples = std::array<std::array<float, num_channels>, num_samples>;
+
+// Noisy measurements around typical values, which the smoothers converge on and leave
+const Samples &samples() {
+  static const Samples result = [] {
+    static const std::array<float, num_channels> levels{{60, 40, 97, 80}};
+    Samples samples{};
+    uint32_t noise_state = 1;
+    for (size_t i = 0; i < num_samples; ++i) {
+      for (size_t channel = 0; channel < num_channels; ++channel) {
+        static const uint32_t lcg_multiplier = 1664525;
+        static const uint32_t lcg_increment = 1013904223;
+        noise_state = noise_state * lcg_multiplier + lcg_increment;
+        float noise = static_cast<float>(noise_state >> 8U) / static_cast<float>(1U << 24U);
+        float step = (i < num_samples / 2) ? 0 : 5;
+        samples[i][channel] = levels[channel] + step + noise - 0.5F;
+      }
+    }
+    return samples;
+  }();
+  return result;
+}
+
+template <typename Number>
+void separate(BM::Counters & /*counters*/) {
+  static std::array<DisplaySmoother<Number>, num_channels> smoothers{
+      {{sampling_interval, params[0]},
+       {sampling_interval, params[1]},
+       {sampling_interval, params[2]},
+       {sampling_interval, params[3]}}};
+  static uint32_t current_time = 0;
+  static std::array<float, num_channels> filtered{};
+
+  const auto &raw = samples()[(current_time / sampling_interval) % num_samples];
+  for (size_t channel = 0; channel < num_channels; ++channel) {
+    smoothers[channel].transform(current_time, raw[channel], filtered[channel]);
+  }
+  BM::do_not_optimize(filtered);
+  current_time += sampling_interval;
+}
+
+template <typename Number>
+void multi_channel(BM::Counters & /*counters*/) {
+  static MultiChannelDisplaySmoother<Number, num_channels> smoother{sampling_interval, params};
+  static uint32_t current_time = 0;
+  static std::array<float, num_channels> filtered{};
+
+  const auto &raw = samples()[(current_time / sampling_interval) % num_samples];
+  smoother.transform(current_time, raw, filtered);
+  BM::do_not_optimize(filtered);
+  current_time += sampling_interval;
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("signal_smoothing.separate", "float", separate<float>);
+PF_BENCHMARK("signal_smoothing.separate", "q31", separate<Util::Q31>);
+PF_BENCHMARK("signal_smoothing.multi_channel", "float", multi_channel<float>);
+PF_BENCHMARK("signal_smoothing.multi_channel", "q31", multi_channel<Util::Q31>);
+// clang-format on
+
+}  // namespace Pufferfish::Protocols::Application
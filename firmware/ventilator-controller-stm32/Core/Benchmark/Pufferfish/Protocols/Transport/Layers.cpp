@@ -0,0 +1,268 @@
+/// \file
+/// \brief Micro-benchmarks of the individual backend transport layers.
+///
+/// Each layer is benchmarked in isolation on a typical small payload (the size of an encoded
+/// SensorMeasurements message) and on a maximum-length payload. Every case reports the whole-buffer
+/// copies and the bytes it reads and writes, as static estimates from the layer's implementation.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+
+#include "Pufferfish/Benchmark/Harness.h"
+#include "Pufferfish/Driver/Serial/Backend/Frames.h"
+#include "Pufferfish/HAL/CRCChecker.h"
+#include "Pufferfish/Protocols/Transport/CRCElements.h"
+#include "Pufferfish/Protocols/Transport/Chunks.h"
+#include "Pufferfish/Protocols/Transport/Datagrams.h"
+#include "Pufferfish/Util/COBS.h"
+
+namespace PF = Pufferfish;
+namespace BM = PF::Benchmark;
+namespace Transport = PF::Protocols::Transport;
+using PF::Driver::Serial::Backend::FrameProps;
+
+namespace {
+
+using CRCElementProps = Transport::CRCElementProps<FrameProps::payload_max_size>;
+using DatagramProps = Transport::DatagramProps<CRCElementProps::payload_max_size>;
+
+// Typical size of an encoded SensorMeasurements message behind the message type header
+constexpr size_t small_payload_size = 40;
+
+// Fills a buffer with deterministic data in which roughly one byte in sixteen is zero, so that
+// COBS has to insert code bytes like it does for real protobuf payloads.
+template <size_t capacity>
+void fill_payload(PF::Util::Containers::ByteVector<capacity> &buffer, size_t size) {
+  static const uint32_t multiplier = 1103515245;
+  static const uint32_t increment = 12345;
+  static const uint32_t zero_period = 16;
+  uint32_t state = 1;
+  buffer.clear();
+  for (size_t i = 0; i < size; ++i) {
+    state = state * multiplier + increment;
+    auto byte = static_cast<uint8_t>(state >> 16U);
+    buffer.push_back((state % zero_period == 0) ? 0 : byte);
+  }
+}
+
+// COBS
+
+void encode_cobs(size_t size, BM::Counters &counters) {
+  static FrameProps::PayloadBuffer input;
+  static FrameProps::ChunkBuffer output;
+  if (input.size() != size) {
+    fill_payload(input, size);
+  }
+
+  PF::Util::encode_cobs(input, output);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  // one pass to size the output, one pass to encode
+  counters.estimated_bytes_touched = 2 * input.size() + output.size();
+  counters.estimated_copies = 1;
+}
+
+void decode_cobs(size_t size, BM::Counters &counters) {
+  static FrameProps::PayloadBuffer payload;
+  static FrameProps::EncodedBuffer input;
+  static FrameProps::PayloadBuffer output;
+  if (payload.size() != size) {
+    fill_payload(payload, size);
+    PF::Util::encode_cobs(payload, input);
+  }
+
+  PF::Util::decode_cobs(input, output);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = input.size() + output.size();
+  counters.estimated_copies = 1;
+}
+
+// Chunks
+
+void split_chunk(size_t size, BM::Counters &counters) {
+  static Transport::ChunkSplitter<FrameProps::encoded_max_size> splitter;
+  static FrameProps::PayloadBuffer payload;
+  static FrameProps::ChunkBuffer stream;
+  static FrameProps::EncodedBuffer output;
+  if (payload.size() != size) {
+    fill_payload(payload, size);
+    PF::Util::encode_cobs(payload, stream);
+    stream.push_back(0x00);
+  }
+
+  bool input_overwritten = false;
+  for (size_t i = 0; i < stream.size(); ++i) {
+    splitter.input(stream[i], input_overwritten);
+  }
+  splitter.output(output);
+  BM::do_not_optimize(output);
+  counters.bytes = stream.size();
+  // each byte is pushed into the splitter's buffer, which is then copied to the output
+  counters.estimated_bytes_touched = 2 * stream.size() + 2 * output.size();
+  counters.estimated_copies = 2;
+}
+
+// Frames
+
+void send_frame(size_t size, BM::Counters &counters) {
+  static const PF::Driver::Serial::Backend::FrameSender sender;
+  static FrameProps::PayloadBuffer input;
+  static FrameProps::ChunkBuffer output;
+  if (input.size() != size) {
+    fill_payload(input, size);
+  }
+
+  sender.transform(input, output);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size() + output.size();
+  counters.estimated_copies = 1;
+}
+
+void receive_frame(size_t size, BM::Counters &counters) {
+  static PF::Driver::Serial::Backend::FrameReceiver receiver;
+  static FrameProps::PayloadBuffer payload;
+  static FrameProps::ChunkBuffer stream;
+  static FrameProps::PayloadBuffer output;
+  if (payload.size() != size) {
+    fill_payload(payload, size);
+    PF::Util::encode_cobs(payload, stream);
+    stream.push_back(0x00);
+  }
+
+  for (size_t i = 0; i < stream.size(); ++i) {
+    receiver.input(stream[i]);
+  }
+  receiver.output(output);
+  BM::do_not_optimize(output);
+  counters.bytes = stream.size();
+  // splitter buffer, copy into a temporary encoded buffer, and COBS decoding
+  counters.estimated_bytes_touched = 2 * stream.size() + 2 * stream.size() + 2 * output.size();
+  counters.estimated_copies = 3;
+}
+
+// CRCElements
+
+PF::HAL::SoftCRC32 &crc32c() {
+  static PF::HAL::SoftCRC32 crc{PF::HAL::crc32c_params};
+  return crc;
+}
+
+void send_crcelement(size_t size, BM::Counters &counters) {
+  static Transport::CRCElementSender<FrameProps::payload_max_size> sender(crc32c());
+  static CRCElementProps::PayloadBuffer input;
+  static FrameProps::PayloadBuffer output;
+  if (input.size() != size) {
+    fill_payload(input, size);
+  }
+
+  sender.transform(input, output);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  // payload copy, then a CRC pass over the copied payload
+  counters.estimated_bytes_touched = 3 * input.size() + Transport::CRCElementHeaderProps::header_size;
+  counters.estimated_copies = 1;
+}
+
+void receive_crcelement(size_t size, BM::Counters &counters) {
+  static Transport::CRCElementReceiver<FrameProps::payload_max_size> receiver(crc32c());
+  static Transport::CRCElementSender<FrameProps::payload_max_size> sender(crc32c());
+  static CRCElementProps::PayloadBuffer payload;
+  static FrameProps::PayloadBuffer input;
+  static CRCElementProps::PayloadBuffer output;
+  if (payload.size() != size) {
+    fill_payload(payload, size);
+    sender.transform(payload, input);
+  }
+
+  Transport::ParsedCRCElement<FrameProps::payload_max_size> crcelement(output);
+  // the status must be kept alive, or the compiler can drop the CRC check entirely
+  auto status = receiver.transform(input, crcelement);
+  BM::do_not_optimize(status);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 3 * input.size();
+  counters.estimated_copies = 1;
+}
+
+// Datagrams
+
+void send_datagram(size_t size, BM::Counters &counters) {
+  static Transport::DatagramSender<CRCElementProps::payload_max_size> sender;
+  static DatagramProps::PayloadBuffer input;
+  static CRCElementProps::PayloadBuffer output;
+  if (input.size() != size) {
+    fill_payload(input, size);
+  }
+
+  sender.transform(input, output);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size() + Transport::DatagramHeaderProps::header_size;
+  counters.estimated_copies = 1;
+}
+
+void receive_datagram(size_t size, BM::Counters &counters) {
+  static Transport::DatagramReceiver<CRCElementProps::payload_max_size> receiver;
+  static DatagramProps::PayloadBuffer payload;
+  static CRCElementProps::PayloadBuffer input;
+  static DatagramProps::PayloadBuffer output;
+  if (payload.size() != size) {
+    fill_payload(payload, size);
+    Transport::ConstructedDatagram<CRCElementProps::payload_max_size> datagram(payload);
+    datagram.write(input);
+  }
+
+  Transport::ParsedDatagram<CRCElementProps::payload_max_size> datagram(output);
+  auto status = receiver.transform(input, datagram);
+  BM::do_not_optimize(status);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size();
+  counters.estimated_copies = 1;
+}
+
+// The maximum payload for each layer is the chunk payload minus the headers of all layers above
+constexpr size_t max_frame_payload = FrameProps::payload_max_size;
+constexpr size_t max_crcelement_payload = CRCElementProps::payload_max_size;
+constexpr size_t max_datagram_payload = DatagramProps::payload_max_size;
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("transport.cobs", "encode/small", [](auto &c) { encode_cobs(small_payload_size, c); });
+PF_BENCHMARK("transport.cobs", "encode/max", [](auto &c) { encode_cobs(max_frame_payload, c); });
+PF_BENCHMARK("transport.cobs", "decode/small", [](auto &c) { decode_cobs(small_payload_size, c); });
+PF_BENCHMARK("transport.cobs", "decode/max", [](auto &c) { decode_cobs(max_frame_payload, c); });
+PF_BENCHMARK("transport.chunks", "split/small", [](auto &c) { split_chunk(small_payload_size, c); });
+PF_BENCHMARK("transport.chunks", "split/max", [](auto &c) { split_chunk(max_frame_payload, c); });
+PF_BENCHMARK("transport.frames", "send/small", [](auto &c) { send_frame(small_payload_size, c); });
+PF_BENCHMARK("transport.frames", "send/max", [](auto &c) { send_frame(max_frame_payload, c); });
+PF_BENCHMARK("transport.frames", "receive/small", [](auto &c) { receive_frame(small_payload_size, c); });
+PF_BENCHMARK("transport.frames", "receive/max", [](auto &c) { receive_frame(max_frame_payload, c); });
+PF_BENCHMARK("transport.crcelements", "send/small", [](auto &c) { send_crcelement(small_payload_size, c); });
+PF_BENCHMARK("transport.crcelements", "send/max", [](auto &c) { send_crcelement(max_crcelement_payload, c); });
+PF_BENCHMARK("transport.crcelements", "receive/small", [](auto &c) { receive_crcelement(small_payload_size, c); });
+PF_BENCHMARK("transport.crcelements", "receive/max", [](auto &c) { receive_crcelement(max_crcelement_payload, c); });
+PF_BENCHMARK("transport.datagrams", "send/small", [](auto &c) { send_datagram(small_payload_size, c); });
+PF_BENCHMARK("transport.datagrams", "send/max", [](auto &c) { send_datagram(max_datagram_payload, c); });
+PF_BENCHMARK("transport.datagrams", "receive/small", [](auto &c) { receive_datagram(small_payload_size, c); });
+PF_BENCHMARK("transport.datagrams", "receive/max", [](auto &c) { receive_datagram(max_datagram_payload, c); });
+// clang-format on
@@ -0,0 +1,108 @@
+/// \file
+/// \brief Micro-benchmarks comparing OrderedMap with HashedOrderedMap on the alarm hot paths.
+///
+/// Both maps are used the way AlarmsManager uses its map of active alarms: keyed by LogEventCode,
+/// with capacity for active_log_events_max_elems alarms. Every loop, each alarms service checks
+/// whether its alarms are active and activates or deactivates them, so the cases cover lookups
+/// of every alarm code, and alarms being deactivated and re-activated.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Application/States.h"
+#include "Pufferfish/Benchmark/Harness.h"
+#include "Pufferfish/Util/Containers/HashedOrderedMap.h"
+#include "Pufferfish/Util/Containers/OrderedMap.h"
+
+// The alarm codes are defined in this namespace, along with macros which refer to them unqualified
+namespace Pufferfish::Application {
+
+namespace BM = Benchmark;
+
+namespace {
+
+using Ordered = Util::Containers::OrderedMap<LogEventCode, uint32_t, active_log_events_max_elems>;
+using Hashed =
+    Util::Containers::HashedOrderedMap<LogEventCode, uint32_t, active_log_events_max_elems>;
+
+constexpr size_t num_codes = _LogEventCode_MAX + 1;
+// A few alarms are active at a time during normal operation; all of them can be during a fault
+constexpr size_t few_active = 4;
+constexpr size_t all_active = active_log_events_max_elems;
+
+// Spreads the active alarms across the range of alarm codes
+LogEventCode active_code(size_t i) {
+  static const size_t stride = 5;
+  return static_cast<LogEventCode>((i * stride) % num_codes);
+}
+
+template <typename Map>
+void fill(Map &map, size_t num_active) {
+  map.clear();
+  for (size_t i = 0; i < num_active; ++i) {
+    map.input(active_code(i), i);
+  }
+}
+
+// Checks whether each alarm code is active, as the alarms services do on every loop
+template <typename Map>
+void lookup_all(size_t num_active, BM::Counters & /*counters*/) {
+  static Map map;
+  if (map.size() != num_active) {
+    fill(map, num_active);
+  }
+
+  size_t active = 0;
+  for (size_t code = 0; code < num_codes; ++code) {
+    if (map.has(static_cast<LogEventCode>(code))) {
+      ++active;
+    }
+  }
+  BM::do_not_optimize(active);
+}
+
+// Deactivates the oldest active alarm and then re-activates it, which moves it to the end
+template <typename Map>
+void churn(size_t num_active, BM::Counters & /*counters*/) {
+  static Map map;
+  static size_t next = 0;
+  if (map.size() != num_active) {
+    fill(map, num_active);
+    next = 0;
+  }
+
+  LogEventCode code = active_code(next);
+  map.erase(code);
+  map.input(code, next);
+  next = (next + 1) % num_active;
+  BM::do_not_optimize(map);
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("containers.ordered_map", "lookup_all/few", [](auto &c) { lookup_all<Ordered>(few_active, c); });
+PF_BENCHMARK("containers.ordered_map", "lookup_all/full", [](auto &c) { lookup_all<Ordered>(all_active, c); });
+PF_BENCHMARK("containers.ordered_map", "churn/few", [](auto &c) { churn<Ordered>(few_active, c); });
+PF_BENCHMARK("containers.ordered_map", "churn/full", [](auto &c) { churn<Ordered>(all_active, c); });
+PF_BENCHMARK("containers.hashed_ordered_map", "lookup_all/few", [](auto &c) { lookup_all<Hashed>(few_active, c); });
+PF_BENCHMARK("containers.hashed_ordered_map", "lookup_all/full", [](auto &c) { lookup_all<Hashed>(all_active, c); });
+PF_BENCHMARK("containers.hashed_ordered_map", "churn/few", [](auto &c) { churn<Hashed>(few_active, c); });
+PF_BENCHMARK("containers.hashed_ordered_map", "churn/full", [](auto &c) { churn<Hashed>(all_active, c); });
+// clang-format on
+
+}  // namespace Pufferfish::Application
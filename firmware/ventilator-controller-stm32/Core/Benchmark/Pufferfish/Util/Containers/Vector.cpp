@@ -0,0 +1,160 @@
+/// \file
+/// \brief Throughput benchmarks of the bulk and erasure operations of Vector.
+///
+/// Byte buffers are benchmarked at the size of a backend transport chunk, which is what
+/// ChunkSplitter, COBS and the message buffers work with. Erasures are benchmarked on a Vector of
+/// alarm-sized records, with an element erased from the front and then added back at the end.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/Containers/Vector.h"
+
+#include <utility>
+
+#include "Pufferfish/Benchmark/Harness.h"
+
+namespace PF = Pufferfish;
+namespace BM = PF::Benchmark;
+
+namespace {
+
+constexpr size_t chunk_size = 255;
+using Chunk = PF::Util::Containers::ByteVector<chunk_size>;
+
+constexpr size_t num_records = 32;
+using Record = std::pair<uint32_t, uint32_t>;
+using Records = PF::Util::Containers::Vector<Record, num_records>;
+
+const Chunk &source_chunk() {
+  static Chunk chunk;
+  if (chunk.empty()) {
+    for (size_t i = 0; i < chunk_size; ++i) {
+      chunk.push_back(static_cast<uint8_t>(i));
+    }
+  }
+  return chunk;
+}
+
+Records &full_records() {
+  static Records records;
+  if (records.empty()) {
+    for (uint32_t i = 0; i < num_records; ++i) {
+      records.push_back(Record{i, i});
+    }
+  }
+  return records;
+}
+
+// Byte buffers
+
+void push_back_bytes(BM::Counters &counters) {
+  static Chunk output;
+  const Chunk &input = source_chunk();
+  output.clear();
+  for (uint8_t byte : input) {
+    output.push_back(byte);
+  }
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size();
+  counters.estimated_copies = 1;
+}
+
+void append_bytes(BM::Counters &counters) {
+  static Chunk output;
+  const Chunk &input = source_chunk();
+  output.clear();
+  output.append(input);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size();
+  counters.estimated_copies = 1;
+}
+
+void copy_from_bytes(BM::Counters &counters) {
+  static Chunk output;
+  const Chunk &input = source_chunk();
+  output.copy_from(input);
+  BM::do_not_optimize(output);
+  counters.bytes = input.size();
+  counters.estimated_bytes_touched = 2 * input.size();
+  counters.estimated_copies = 1;
+}
+
+void resize_bytes(BM::Counters &counters) {
+  static Chunk output;
+  output.clear();
+  output.resize(chunk_size);
+  BM::do_not_optimize(output);
+  counters.bytes = chunk_size;
+  counters.estimated_bytes_touched = chunk_size;
+}
+
+void resize_uninitialized_bytes(BM::Counters &counters) {
+  static Chunk output;
+  output.clear();
+  output.resize_uninitialized(chunk_size);
+  BM::do_not_optimize(output);
+  counters.bytes = chunk_size;
+}
+
+// Erasures
+
+void erase_front(BM::Counters &counters) {
+  Records &records = full_records();
+  Record front = records[0];
+  records.erase(0);
+  records.push_back(front);
+  BM::do_not_optimize(records);
+  counters.estimated_bytes_touched = 2 * sizeof(Record) * num_records;
+}
+
+void swap_erase_front(BM::Counters &counters) {
+  Records &records = full_records();
+  Record front = records[0];
+  records.swap_erase(0);
+  records.push_back(front);
+  BM::do_not_optimize(records);
+  counters.estimated_bytes_touched = 3 * sizeof(Record);
+}
+
+void erase_range_front(BM::Counters &counters) {
+  static const size_t num_erased = 4;
+  Records &records = full_records();
+  std::array<Record, num_erased> front{};
+  for (size_t i = 0; i < num_erased; ++i) {
+    front[i] = records[i];
+  }
+  records.erase_range(0, num_erased);
+  records.append(front);
+  BM::do_not_optimize(records);
+  counters.estimated_bytes_touched = 2 * sizeof(Record) * num_records;
+}
+
+}  // namespace
+
+// clang-format off
+PF_BENCHMARK("containers.vector", "push_back/chunk", push_back_bytes);
+PF_BENCHMARK("containers.vector", "append/chunk", append_bytes);
+PF_BENCHMARK("containers.vector", "copy_from/chunk", copy_from_bytes);
+PF_BENCHMARK("containers.vector", "resize/chunk", resize_bytes);
+PF_BENCHMARK("containers.vector", "resize_uninitialized/chunk", resize_uninitialized_bytes);
+PF_BENCHMARK("containers.vector", "erase/front", erase_front);
+PF_BENCHMARK("containers.vector", "swap_erase/front", swap_erase_front);
+PF_BENCHMARK("containers.vector", "erase_range/front", erase_range_front);
+// clang-format on
@@ -0,0 +1,108 @@
+/// \file
+/// \brief Runs all registered host-side benchmarks and reports the results as JSON.
+///
+/// Usage: Benchmark [--filter <substring>] [--min-time <ms>] [--out <file.json>]
+/// Results are written to stdout unless an output file is given.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "Pufferfish/Benchmark/Harness.h"
+
+namespace {
+
+std::atomic<uint64_t> allocation_count{0};
+
+}  // namespace
+
+// Global allocation hooks, so that the harness can verify that benchmarked operations
+// don't touch the heap (the firmware never does).
+void *operator new(size_t size) {
+  ++allocation_count;
+  void *pointer = std::malloc(size);  // NOLINT(cppcoreguidelines-no-malloc)
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void operator delete(void *pointer, size_t /*size*/) noexcept {
+  std::free(pointer);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+namespace Pufferfish::Benchmark {
+
+uint64_t heap_allocations() {
+  return allocation_count.load();
+}
+
+}  // namespace Pufferfish::Benchmark
+
+int main(int argc, char *argv[]) {
+  namespace BM = Pufferfish::Benchmark;
+
+  BM::Options options;
+  std::string output_path;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];       // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::string value = argv[i + 1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag == "--filter") {
+      options.filter = value;
+    } else if (flag == "--min-time") {
+      options.min_time_ms = std::stoul(value);
+    } else if (flag == "--out") {
+      output_path = value;
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<BM::Result> results;
+  for (const BM::Case &benchmark_case : BM::registry()) {
+    std::string full_name = benchmark_case.suite + "/" + benchmark_case.name;
+    if (!options.filter.empty() && full_name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    std::cerr << "Running " << full_name << std::endl;
+    results.push_back(BM::run(benchmark_case, options));
+  }
+
+  if (output_path.empty()) {
+    BM::write_json(std::cout, results);
+    return EXIT_SUCCESS;
+  }
+
+  std::ofstream output_file(output_path);
+  if (!output_file) {
+    std::cerr << "Couldn't open " << output_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  BM::write_json(output_file, results);
+  return EXIT_SUCCESS;
+}
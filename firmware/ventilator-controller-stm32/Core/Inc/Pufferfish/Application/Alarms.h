@@ -12,7 +12,7 @@
 #include "LogEvents.h"
 #include "Pufferfish/Protocols/Application/Debouncing.h"
 #include "Pufferfish/Util/Containers/EnumMap.h"
-#include "Pufferfish/Util/Containers/OrderedMap.h"
+#include "Pufferfish/Util/Containers/HashedOrderedMap.h"
 #include "Pufferfish/Util/Timeouts.h"
 #include "States.h"
 
@@ -53,8 +53,9 @@ class AlarmsManager {
   Application::LogEventsManager &log_manager_;
   Debouncers debouncers_;
   InitWaiters init_waiters_;
-  Util::Containers::OrderedMap<LogEventCode, uint32_t, Application::active_log_events_max_elems>
-      active_alarms_;
+  Util::Containers::
+      HashedOrderedMap<LogEventCode, uint32_t, Application::active_log_events_max_elems>
+          active_alarms_;
 
   [[nodiscard]] bool is_active(LogEventCode alarm_code) const;
   // Returns the output value from the debouncer:
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "Pufferfish/Protocols/Application/States.h"
+#include "Pufferfish/Protocols/Application/Subscriptions.h"
+#include "Pufferfish/Util/Containers/SnapshotBuffer.h"
 #include "Pufferfish/Util/Enums.h"
 #include "Pufferfish/Util/TaggedUnion.h"
 #include "boost/pfr.hpp"
@@ -34,6 +36,18 @@ bool operator==<NextLogEvents>(const NextLogEvents &first, const NextLogEvents &
 template <>
 bool operator==<ActiveLogEvents>(const ActiveLogEvents &first, const ActiveLogEvents &second);
 
+template <>
+bool operator==<PlethWaveform>(const PlethWaveform &first, const PlethWaveform &second);
+
+template <>
+bool operator==<MCUDiagnostics>(const MCUDiagnostics &first, const MCUDiagnostics &second);
+
+template <>
+bool operator==<I2CDeviceHealth>(const I2CDeviceHealth &first, const I2CDeviceHealth &second);
+
+template <>
+bool operator==<I2CDiagnostics>(const I2CDiagnostics &first, const I2CDiagnostics &second);
+
 // Message constants
 static const size_t next_log_events_max_elems = 2;
 static const size_t active_log_events_max_elems = 32;
@@ -57,6 +71,7 @@ enum class MessageTypes : uint8_t {
   // Measurements
   sensor_measurements = 2,
   cycle_measurements = 3,
+  pleth_waveform = 25,
   // Parameters
   parameters = 4,
   parameters_request = 5,
@@ -75,7 +90,10 @@ enum class MessageTypes : uint8_t {
   backend_connections = 21,
   // Screen Status
   screen_status = 22,
-  screen_status_request = 23
+  screen_status_request = 23,
+  // Diagnostics
+  mcu_diagnostics = 24,
+  i2c_diagnostics = 26
 };
 
 // MessageTypeValues should include all defined values of MessageTypes
@@ -85,6 +103,7 @@ using MessageTypeValues = Util::EnumValues<
     // Measurements
     MessageTypes::sensor_measurements,
     MessageTypes::cycle_measurements,
+    MessageTypes::pleth_waveform,
     // Parameters
     MessageTypes::parameters,
     MessageTypes::parameters_request,
@@ -102,7 +121,10 @@ using MessageTypeValues = Util::EnumValues<
     MessageTypes::mcu_power_status,
     MessageTypes::backend_connections,
     MessageTypes::screen_status,
-    MessageTypes::screen_status_request>;
+    MessageTypes::screen_status_request,
+    // Diagnostics
+    MessageTypes::mcu_diagnostics,
+    MessageTypes::i2c_diagnostics>;
 
 // StateSegments
 
@@ -115,6 +137,7 @@ union StateSegmentUnion {
   // Measurements
   SensorMeasurements sensor_measurements;
   CycleMeasurements cycle_measurements;
+  PlethWaveform pleth_waveform;
   // Parameters
   Parameters parameters;
   ParametersRequest parameters_request;
@@ -133,6 +156,9 @@ union StateSegmentUnion {
   BackendConnections backend_connections;
   ScreenStatus screen_status;
   ScreenStatusRequest screen_status_request;
+  // Diagnostics
+  MCUDiagnostics mcu_diagnostics;
+  I2CDiagnostics i2c_diagnostics;
 };
 
 using StateSegment = Util::TaggedUnion<StateSegmentUnion, MessageTypes>;
@@ -143,6 +169,7 @@ struct StateSegments {
   // Measurements
   SensorMeasurements sensor_measurements;  // noise-filtered
   CycleMeasurements cycle_measurements;
+  PlethWaveform pleth_waveform;
   // Parameters
   Parameters parameters;
   ParametersRequest parameters_request;
@@ -159,6 +186,9 @@ struct StateSegments {
   // System Miscellaneous
   MCUPowerStatus mcu_power_status;
   BackendConnections backend_connections;
+  // Diagnostics
+  MCUDiagnostics mcu_diagnostics;
+  I2CDiagnostics i2c_diagnostics;
 
   // Internal States
   SensorMeasurements sensor_measurements_raw;
@@ -168,11 +198,35 @@ struct StateSegments {
   bool backend_connected;
 };
 
+// The states which contexts outside the main loop, such as ISRs and timer callbacks, may need;
+// the Store only publishes snapshots of these, since copying every state segment would be
+// expensive.
+struct StateSnapshot {
+  SensorMeasurements sensor_measurements;  // noise-filtered
+  SensorMeasurements sensor_measurements_raw;
+  Parameters parameters;
+  AlarmMute alarm_mute;
+  MCUPowerStatus mcu_power_status;
+  bool backend_connected;
+};
+
 // Store
 
+// The Store notifies subscribers of changes to states given to its input method. States which are
+// modified through the Store's mutable references must be explicitly marked as changed with the
+// notify method, or subscribers will not see the changes.
+// The Store's references must only be used from a single context (i.e. the main loop). Other
+// contexts, such as ISRs, must instead read the states from a snapshot, which is only updated
+// when the main loop publishes a consistent version of the states in StateSnapshot.
 class Store : public Protocols::Application::IndexedStateSender<MessageTypes, StateSegment> {
  public:
   using Status = Protocols::Application::StateOutputStatus;
+  using Versions =
+      Protocols::Application::StateVersions<MessageTypes, MessageTypeValues::max() + 1>;
+  template <size_t num_dependencies>
+  using Subscription = Protocols::Application::
+      StateSubscription<MessageTypes, MessageTypeValues::max() + 1, num_dependencies>;
+  using Snapshots = Util::Containers::SnapshotBuffer<StateSnapshot>;
 
   Store() = default;
 
@@ -180,6 +234,7 @@ class Store : public Protocols::Application::IndexedStateSender<MessageTypes, St
   // Measurements
   SensorMeasurements &sensor_measurements_filtered();
   CycleMeasurements &cycle_measurements();
+  PlethWaveform &pleth_waveform();
   // Parameters
   Parameters &parameters();
   [[nodiscard]] bool has_parameters_request() const;
@@ -198,6 +253,9 @@ class Store : public Protocols::Application::IndexedStateSender<MessageTypes, St
   // System Miscellaneous
   MCUPowerStatus &mcu_power_status();
   [[nodiscard]] const BackendConnections &backend_connections() const;
+  // Diagnostics
+  MCUDiagnostics &mcu_diagnostics();
+  I2CDiagnostics &i2c_diagnostics();
 
   // Internal States
   SensorMeasurements &sensor_measurements_raw();
@@ -210,10 +268,24 @@ class Store : public Protocols::Application::IndexedStateSender<MessageTypes, St
   Status input(const StateSegment &input, bool default_initialization = false);
   Status output(MessageTypes type, StateSegment &output) const override;
 
+  // Change notification
+  void notify(MessageTypes type);
+  [[nodiscard]] const Versions &versions() const;
+
+  // Snapshots
+  void publish();
+  Snapshots::Status snapshot(StateSnapshot &snapshot) const;
+  [[nodiscard]] Snapshots::Version snapshot_version() const;
+
  private:
   StateSegments state_segments_{};
   bool has_parameters_request_ = false;
   bool has_alarm_limits_request_ = false;
+  Versions versions_;
+  Snapshots snapshots_;
+  StateSnapshot published_{};
+
+  Status write(const StateSegment &input, bool default_initialization);
 };
 
 }  // namespace Pufferfish::Application
@@ -173,6 +173,44 @@ typedef struct _ExpectedLogEvent {
     uint32_t session_id; /* used when the sender's log is ephemeral */
 } ExpectedLogEvent;
 
+typedef struct _I2CDeviceHealth { 
+    uint32_t transactions; 
+    uint32_t nacks; 
+    uint32_t timeouts; 
+    uint32_t busy; /* transactions which found the bus or peripheral busy */
+    uint32_t crc_failures; 
+    uint32_t other_errors; 
+    uint32_t recoveries; /* successful bus recoveries after this device's transactions failed */
+    pb_size_t latencies_count;
+    uint32_t latencies[6]; /* transactions by latency, in bins whose upper bounds double from 250 us */
+    uint32_t failed_recoveries; /* bus recoveries which didn't release the bus or re-initialize the peripheral */
+} I2CDeviceHealth;
+
+typedef struct _SensorReconnections { 
+    bool connected; 
+    uint32_t disconnections; 
+    uint32_t attempts; 
+    uint32_t reconnections; 
+    uint32_t last_latency; /* ms, from the latest disconnection to the next reconnection */
+    uint32_t max_latency; /* ms */
+} SensorReconnections;
+
+typedef struct _MCUDiagnostics { 
+    uint32_t stack_size; /* bytes */
+    uint32_t stack_high_water_mark; /* bytes */
+    uint32_t scratch_size; /* bytes */
+    uint32_t scratch_high_water_mark; /* bytes */
+    uint32_t setup_duration; /* ms, until every sensor had finished or failed setup */
+    uint32_t setups_failed; /* bitmask of sensors which failed setup, including timeouts */
+    uint32_t setups_timed_out; /* bitmask of sensors which didn't finish setup in time */
+    pb_size_t times_to_ready_count;
+    uint32_t times_to_ready[7]; /* ms, until each sensor finished or failed setup */
+    pb_size_t reconnections_count;
+    SensorReconnections reconnections[5]; /* Reconnection of sensors after startup, in the order: SFM3019 air, SFM3019 O2, ABP, FDO2, SDP */
+    float air_flow_discrepancy; /* L/min, smoothed SDP flow minus SFM3019 air flow */
+    uint32_t air_flow_disagreements; /* times the flows started to disagree beyond tolerance */
+} MCUDiagnostics;
+
 typedef struct _MCUPowerStatus { 
     float power_left; 
     bool charging; 
@@ -209,6 +247,13 @@ typedef struct _Ping {
     uint32_t id; 
 } Ping;
 
+typedef PB_BYTES_ARRAY_T(25) PlethWaveform_samples_t;
+typedef struct _PlethWaveform { 
+    uint64_t time; /* ms, when the last sample was received */
+    uint32_t sequence; /* index of the first sample, counting every sample since the MCU was reset */
+    PlethWaveform_samples_t samples; /* pleth amplitudes at 75 Hz, oldest first */
+} PlethWaveform;
+
 typedef struct _Range { 
     int32_t lower; 
     int32_t upper; 
@@ -333,6 +378,11 @@ typedef struct _NextLogEvents {
     LogEvent elements[2]; 
 } NextLogEvents;
 
+typedef struct _I2CDiagnostics { 
+    pb_size_t devices_count;
+    I2CDeviceHealth devices[5]; 
+} I2CDiagnostics;
+
 
 /* Helper constants for enums */
 #define _VentilationMode_MIN VentilationMode_hfnc
@@ -359,6 +409,7 @@ extern "C" {
 /* Initializer values for message structs */
 #define SensorMeasurements_init_default          {0, 0, 0, 0, 0, 0, 0, 0}
 #define CycleMeasurements_init_default           {0, 0, 0, 0, 0, 0, 0}
+#define PlethWaveform_init_default               {0, 0, {0, {0}}}
 #define Parameters_init_default                  {0, 0, _VentilationMode_MIN, 0, 0, 0, 0, 0, 0, 0}
 #define ParametersRequest_init_default           {0, 0, _VentilationMode_MIN, 0, 0, 0, 0, 0, 0, 0}
 #define Range_init_default                       {0, 0}
@@ -374,10 +425,15 @@ extern "C" {
 #define BackendConnections_init_default          {0, 0}
 #define ScreenStatusRequest_init_default         {0}
 #define ScreenStatus_init_default                {0}
+#define MCUDiagnostics_init_default              {0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0}, 0, {SensorReconnections_init_default, SensorReconnections_init_default, SensorReconnections_init_default, SensorReconnections_init_default, SensorReconnections_init_default}, 0, 0}
+#define SensorReconnections_init_default         {0, 0, 0, 0, 0, 0}
+#define I2CDeviceHealth_init_default             {0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, 0}
+#define I2CDiagnostics_init_default              {0, {I2CDeviceHealth_init_default, I2CDeviceHealth_init_default, I2CDeviceHealth_init_default, I2CDeviceHealth_init_default, I2CDeviceHealth_init_default}}
 #define Ping_init_default                        {0, 0}
 #define Announcement_init_default                {0, {0, {0}}}
 #define SensorMeasurements_init_zero             {0, 0, 0, 0, 0, 0, 0, 0}
 #define CycleMeasurements_init_zero              {0, 0, 0, 0, 0, 0, 0}
+#define PlethWaveform_init_zero                  {0, 0, {0, {0}}}
 #define Parameters_init_zero                     {0, 0, _VentilationMode_MIN, 0, 0, 0, 0, 0, 0, 0}
 #define ParametersRequest_init_zero              {0, 0, _VentilationMode_MIN, 0, 0, 0, 0, 0, 0, 0}
 #define Range_init_zero                          {0, 0}
@@ -393,6 +449,10 @@ extern "C" {
 #define BackendConnections_init_zero             {0, 0}
 #define ScreenStatusRequest_init_zero            {0}
 #define ScreenStatus_init_zero                   {0}
+#define MCUDiagnostics_init_zero                 {0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0}, 0, {SensorReconnections_init_zero, SensorReconnections_init_zero, SensorReconnections_init_zero, SensorReconnections_init_zero, SensorReconnections_init_zero}, 0, 0}
+#define SensorReconnections_init_zero            {0, 0, 0, 0, 0, 0}
+#define I2CDeviceHealth_init_zero                {0, 0, 0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0}, 0}
+#define I2CDiagnostics_init_zero                 {0, {I2CDeviceHealth_init_zero, I2CDeviceHealth_init_zero, I2CDeviceHealth_init_zero, I2CDeviceHealth_init_zero, I2CDeviceHealth_init_zero}}
 #define Ping_init_zero                           {0, 0}
 #define Announcement_init_zero                   {0, {0, {0}}}
 
@@ -418,6 +478,32 @@ extern "C" {
 #define CycleMeasurements_ve_tag                 7
 #define ExpectedLogEvent_id_tag                  1
 #define ExpectedLogEvent_session_id_tag          2
+#define I2CDeviceHealth_transactions_tag         1
+#define I2CDeviceHealth_nacks_tag                2
+#define I2CDeviceHealth_timeouts_tag             3
+#define I2CDeviceHealth_busy_tag                 4
+#define I2CDeviceHealth_crc_failures_tag         5
+#define I2CDeviceHealth_other_errors_tag         6
+#define I2CDeviceHealth_recoveries_tag           7
+#define I2CDeviceHealth_latencies_tag            8
+#define I2CDeviceHealth_failed_recoveries_tag    9
+#define MCUDiagnostics_stack_size_tag            1
+#define MCUDiagnostics_stack_high_water_mark_tag 2
+#define MCUDiagnostics_scratch_size_tag          3
+#define MCUDiagnostics_scratch_high_water_mark_tag 4
+#define MCUDiagnostics_setup_duration_tag        5
+#define MCUDiagnostics_setups_failed_tag         6
+#define MCUDiagnostics_setups_timed_out_tag      7
+#define MCUDiagnostics_times_to_ready_tag        8
+#define MCUDiagnostics_reconnections_tag         9
+#define MCUDiagnostics_air_flow_discrepancy_tag  10
+#define MCUDiagnostics_air_flow_disagreements_tag 11
+#define SensorReconnections_connected_tag        1
+#define SensorReconnections_disconnections_tag   2
+#define SensorReconnections_attempts_tag         3
+#define SensorReconnections_reconnections_tag    4
+#define SensorReconnections_last_latency_tag     5
+#define SensorReconnections_max_latency_tag      6
 #define MCUPowerStatus_power_left_tag            1
 #define MCUPowerStatus_charging_tag              2
 #define Parameters_time_tag                      1
@@ -442,6 +528,9 @@ extern "C" {
 #define ParametersRequest_ie_tag                 10
 #define Ping_time_tag                            1
 #define Ping_id_tag                              2
+#define PlethWaveform_time_tag                   1
+#define PlethWaveform_sequence_tag               2
+#define PlethWaveform_samples_tag                3
 #define Range_lower_tag                          1
 #define Range_upper_tag                          2
 #define ScreenStatus_lock_tag                    1
@@ -504,6 +593,7 @@ extern "C" {
 #define NextLogEvents_remaining_tag              3
 #define NextLogEvents_session_id_tag             4
 #define NextLogEvents_elements_tag               5
+#define I2CDiagnostics_devices_tag               1
 
 /* Struct field encoding specification for nanopb */
 #define SensorMeasurements_FIELDLIST(X, a) \
@@ -529,6 +619,13 @@ X(a, STATIC,   SINGULAR, FLOAT,    ve,                7)
 #define CycleMeasurements_CALLBACK NULL
 #define CycleMeasurements_DEFAULT NULL
 
+#define PlethWaveform_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT64,   time,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   sequence,          2) \
+X(a, STATIC,   SINGULAR, BYTES,    samples,           3)
+#define PlethWaveform_CALLBACK NULL
+#define PlethWaveform_DEFAULT NULL
+
 #define Parameters_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT64,   time,              1) \
 X(a, STATIC,   SINGULAR, BOOL,     ventilating,       2) \
@@ -709,6 +806,51 @@ X(a, STATIC,   SINGULAR, BOOL,     lock,              1)
 #define ScreenStatus_CALLBACK NULL
 #define ScreenStatus_DEFAULT NULL
 
+#define MCUDiagnostics_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   stack_size,        1) \
+X(a, STATIC,   SINGULAR, UINT32,   stack_high_water_mark,   2) \
+X(a, STATIC,   SINGULAR, UINT32,   scratch_size,      3) \
+X(a, STATIC,   SINGULAR, UINT32,   scratch_high_water_mark,   4) \
+X(a, STATIC,   SINGULAR, UINT32,   setup_duration,    5) \
+X(a, STATIC,   SINGULAR, UINT32,   setups_failed,     6) \
+X(a, STATIC,   SINGULAR, UINT32,   setups_timed_out,   7) \
+X(a, STATIC,   REPEATED, UINT32,   times_to_ready,    8) \
+X(a, STATIC,   REPEATED, MESSAGE,  reconnections,     9) \
+X(a, STATIC,   SINGULAR, FLOAT,    air_flow_discrepancy,  10) \
+X(a, STATIC,   SINGULAR, UINT32,   air_flow_disagreements,  11)
+#define MCUDiagnostics_CALLBACK NULL
+#define MCUDiagnostics_DEFAULT NULL
+#define MCUDiagnostics_reconnections_MSGTYPE SensorReconnections
+
+#define SensorReconnections_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, BOOL,     connected,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   disconnections,    2) \
+X(a, STATIC,   SINGULAR, UINT32,   attempts,          3) \
+X(a, STATIC,   SINGULAR, UINT32,   reconnections,     4) \
+X(a, STATIC,   SINGULAR, UINT32,   last_latency,      5) \
+X(a, STATIC,   SINGULAR, UINT32,   max_latency,       6)
+#define SensorReconnections_CALLBACK NULL
+#define SensorReconnections_DEFAULT NULL
+
+#define I2CDeviceHealth_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   transactions,      1) \
+X(a, STATIC,   SINGULAR, UINT32,   nacks,             2) \
+X(a, STATIC,   SINGULAR, UINT32,   timeouts,          3) \
+X(a, STATIC,   SINGULAR, UINT32,   busy,              4) \
+X(a, STATIC,   SINGULAR, UINT32,   crc_failures,      5) \
+X(a, STATIC,   SINGULAR, UINT32,   other_errors,      6) \
+X(a, STATIC,   SINGULAR, UINT32,   recoveries,        7) \
+X(a, STATIC,   REPEATED, UINT32,   latencies,         8) \
+X(a, STATIC,   SINGULAR, UINT32,   failed_recoveries,   9)
+#define I2CDeviceHealth_CALLBACK NULL
+#define I2CDeviceHealth_DEFAULT NULL
+
+#define I2CDiagnostics_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  devices,           1)
+#define I2CDiagnostics_CALLBACK NULL
+#define I2CDiagnostics_DEFAULT NULL
+#define I2CDiagnostics_devices_MSGTYPE I2CDeviceHealth
+
 #define Ping_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT64,   time,              1) \
 X(a, STATIC,   SINGULAR, UINT32,   id,                2)
@@ -723,6 +865,7 @@ X(a, STATIC,   SINGULAR, BYTES,    announcement,      2)
 
 extern const pb_msgdesc_t SensorMeasurements_msg;
 extern const pb_msgdesc_t CycleMeasurements_msg;
+extern const pb_msgdesc_t PlethWaveform_msg;
 extern const pb_msgdesc_t Parameters_msg;
 extern const pb_msgdesc_t ParametersRequest_msg;
 extern const pb_msgdesc_t Range_msg;
@@ -738,12 +881,17 @@ extern const pb_msgdesc_t MCUPowerStatus_msg;
 extern const pb_msgdesc_t BackendConnections_msg;
 extern const pb_msgdesc_t ScreenStatusRequest_msg;
 extern const pb_msgdesc_t ScreenStatus_msg;
+extern const pb_msgdesc_t MCUDiagnostics_msg;
+extern const pb_msgdesc_t SensorReconnections_msg;
+extern const pb_msgdesc_t I2CDeviceHealth_msg;
+extern const pb_msgdesc_t I2CDiagnostics_msg;
 extern const pb_msgdesc_t Ping_msg;
 extern const pb_msgdesc_t Announcement_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define SensorMeasurements_fields &SensorMeasurements_msg
 #define CycleMeasurements_fields &CycleMeasurements_msg
+#define PlethWaveform_fields &PlethWaveform_msg
 #define Parameters_fields &Parameters_msg
 #define ParametersRequest_fields &ParametersRequest_msg
 #define Range_fields &Range_msg
@@ -759,6 +907,10 @@ extern const pb_msgdesc_t Announcement_msg;
 #define BackendConnections_fields &BackendConnections_msg
 #define ScreenStatusRequest_fields &ScreenStatusRequest_msg
 #define ScreenStatus_fields &ScreenStatus_msg
+#define MCUDiagnostics_fields &MCUDiagnostics_msg
+#define SensorReconnections_fields &SensorReconnections_msg
+#define I2CDeviceHealth_fields &I2CDeviceHealth_msg
+#define I2CDiagnostics_fields &I2CDiagnostics_msg
 #define Ping_fields &Ping_msg
 #define Announcement_fields &Announcement_msg
 
@@ -772,16 +924,21 @@ extern const pb_msgdesc_t Announcement_msg;
 #define BackendConnections_size                  4
 #define CycleMeasurements_size                   41
 #define ExpectedLogEvent_size                    12
+#define I2CDeviceHealth_size                     84
+#define I2CDiagnostics_size                      430
 #define LogEvent_size                            132
+#define MCUDiagnostics_size                      265
 #define MCUPowerStatus_size                      7
 #define NextLogEvents_size                       294
 #define ParametersRequest_size                   50
 #define Parameters_size                          50
 #define Ping_size                                17
+#define PlethWaveform_size                       44
 #define Range_size                               22
 #define ScreenStatusRequest_size                 2
 #define ScreenStatus_size                        2
 #define SensorMeasurements_size                  47
+#define SensorReconnections_size                 32
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -811,6 +968,13 @@ struct MessageDescriptor<CycleMeasurements> {
     }
 };
 template <>
+struct MessageDescriptor<PlethWaveform> {
+    static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 3;
+    static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
+        return &PlethWaveform_msg;
+    }
+};
+template <>
 struct MessageDescriptor<Parameters> {
     static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 10;
     static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
@@ -916,6 +1080,34 @@ struct MessageDescriptor<ScreenStatus> {
     }
 };
 template <>
+struct MessageDescriptor<MCUDiagnostics> {
+    static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 11;
+    static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
+        return &MCUDiagnostics_msg;
+    }
+};
+template <>
+struct MessageDescriptor<SensorReconnections> {
+    static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 6;
+    static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
+        return &SensorReconnections_msg;
+    }
+};
+template <>
+struct MessageDescriptor<I2CDeviceHealth> {
+    static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 9;
+    static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
+        return &I2CDeviceHealth_msg;
+    }
+};
+template <>
+struct MessageDescriptor<I2CDiagnostics> {
+    static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 1;
+    static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
+        return &I2CDiagnostics_msg;
+    }
+};
+template <>
 struct MessageDescriptor<Ping> {
     static PB_INLINE_CONSTEXPR const pb_size_t fields_array_length = 2;
     static PB_INLINE_CONSTEXPR const pb_msgdesc_t* fields() {
@@ -9,24 +9,151 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
+#include "Pufferfish/Util/Numeric.h"
+
 namespace Pufferfish::Driver::BreathingCircuit {
 
+// A PI controller whose actuation is clamped to [0, 1], with the integral term clamped to the
+// same range for anti-windup.
+// Number may be float or a fixed-point type such as Util::Q31. Fixed-point types can only
+// represent values in [-1, 1), so measurements and setpoints must be divided by a full-scale
+// value before they're passed in, and the gains must be multiplied by that full-scale value
+// (and must remain below 1); the actuation then saturates just below 1.
+template <typename Number = float>
 class PI {
  public:
-  void transform(float measurement, float setpoint, float &actuation);
+  static constexpr float default_p_gain = 0.00001;
+  static constexpr float default_i_gain = 0.0002;
+
+  PI() : PI(default_p_gain, default_i_gain) {}
+  PI(float p_gain, float i_gain)
+      : p_gain_(Numeric::from_float(p_gain)), i_gain_(Numeric::from_float(i_gain)) {}
+
+  void transform(Number measurement, Number setpoint, Number &actuation);
+
+ private:
+  using Numeric = Util::Numeric<Number>;
+
+  static constexpr Number out_max = Numeric::from_float(1);
+  static constexpr Number out_min = Numeric::from_float(0);
+
+  const Number p_gain_;
+  const Number i_gain_;
+
+  Number error_{};
+  // The integral is accumulated after it's multiplied by the gain, so that it stays within the
+  // range of the actuation and can be represented in fixed-point
+  Number integral_term_{};
+};
+
+// A piecewise-linear function defined by points sorted by increasing x, which is clamped to the
+// y values of the first and last points outside of their x range
+template <size_t num_points>
+class LookupTable {
+ public:
+  static_assert(num_points >= 2, "LookupTable must have at least two points");
+
+  struct Point {
+    float x;
+    float y;
+  };
+  using Points = std::array<Point, num_points>;
+
+  explicit constexpr LookupTable(const Points &points) : points_(points) {}
+
+  [[nodiscard]] float interpolate(float x) const;
+
+ private:
+  const Points points_;
+};
+
+struct PIGains {
+  float p;
+  float i;
+};
+
+// Gains for each range of setpoints, so that a controller can be tuned separately for the
+// different dynamics of its plant across its operating range. Ranges are sorted by increasing
+// lower bound, and each range extends to the lower bound of the next range; setpoints below the
+// first lower bound use the gains of the first range.
+template <size_t num_ranges>
+class GainSchedule {
+ public:
+  struct Range {
+    float lower;
+    PIGains gains;
+  };
+  using Ranges = std::array<Range, num_ranges>;
+
+  explicit constexpr GainSchedule(const Ranges &ranges) : ranges_(ranges) {}
+
+  [[nodiscard]] const PIGains &gains(float setpoint) const;
+
+ private:
+  const Ranges ranges_;
+};
+
+// Limits the rate of change of a setpoint, so that a step change of the target is followed as a
+// ramp which the plant can track without saturating its actuator
+class SetpointRamp {
+ public:
+  // rate is in units of the setpoint per ms
+  explicit constexpr SetpointRamp(float rate) : rate_(rate) {}
+
+  // The setpoint starts at 0, and moves towards target by at most rate per ms elapsed since the
+  // previous call
+  void transform(uint32_t current_time, float target, float &setpoint);
+  // Moves the setpoint to value, from which the next call will start ramping
+  void reset(float value);
+
+ private:
+  const float rate_;
+  float setpoint_ = 0;
+  bool started_ = false;
+  uint32_t prev_time_ = 0;  // ms
+};
+
+// A flow controller which ramps its setpoint, estimates the actuation needed to reach it from a
+// characteristic of the actuator (feed-forward), and corrects the remaining error with a PI
+// controller whose gains are scheduled by setpoint. Its actuation is clamped to [0, 1]; while
+// the actuation is saturated, the integral term is pulled back towards the saturation limit
+// (back-calculation anti-windup) instead of being frozen, so that it recovers smoothly.
+template <size_t num_characteristic_points, size_t num_gain_ranges>
+class FeedforwardPI {
+ public:
+  using Characteristic = LookupTable<num_characteristic_points>;
+  using Schedule = GainSchedule<num_gain_ranges>;
+
+  constexpr FeedforwardPI(
+      const Characteristic &characteristic,
+      const Schedule &schedule,
+      float ramp_rate,
+      float back_calculation_gain)
+      : characteristic_(characteristic),
+        schedule_(schedule),
+        ramp_(ramp_rate),
+        back_calculation_gain_(back_calculation_gain) {}
+
+  void transform(uint32_t current_time, float measurement, float target, float &actuation);
+  // Clears the integral term and restarts the setpoint ramp from measurement
+  void reset(float measurement);
 
  private:
   static constexpr float out_max = 1;
   static constexpr float out_min = 0;
-  static constexpr float p_gain = 0.00001;
-  static constexpr float i_gain = 0.0002;
-  static constexpr float i_max = out_max / i_gain;
-  static constexpr float i_min = out_min / i_gain;
 
-  float error_ = 0;
-  float error_integral_ = 0;
+  const Characteristic characteristic_;
+  const Schedule schedule_;
+  SetpointRamp ramp_;
+  const float back_calculation_gain_;
+
+  float integral_term_ = 0;
 };
 
 }  // namespace Pufferfish::Driver::BreathingCircuit
+
+#include "Algorithms.tpp"
@@ -0,0 +1,96 @@
+/*
+ * Algorithms.tpp
+ *
+ *  Created on: June 6, 2020
+ *      Author: Ethan Li
+ */
+
+#pragma once
+
+#include "Algorithms.h"
+
+namespace Pufferfish::Driver::BreathingCircuit {
+
+// PI
+
+template <typename Number>
+void PI<Number>::transform(
+    Number measurement, Number setpoint, Number &actuation) {
+  error_ = setpoint - measurement;
+  integral_term_ += error_ * i_gain_;
+  if (integral_term_ < out_min) {
+    integral_term_ = out_min;
+  }
+  if (integral_term_ > out_max) {
+    integral_term_ = out_max;
+  }
+
+  actuation = error_ * p_gain_ + integral_term_;
+  if (actuation < out_min) {
+    actuation = out_min;
+  }
+  if (actuation > out_max) {
+    actuation = out_max;
+  }
+}
+
+// LookupTable
+
+template <size_t num_points>
+float LookupTable<num_points>::interpolate(float x) const {
+  if (x <= points_[0].x) {
+    return points_[0].y;
+  }
+
+  for (size_t i = 1; i < num_points; ++i) {
+    const Point &upper = points_[i];
+    if (x < upper.x) {
+      const Point &lower = points_[i - 1];
+      return lower.y + (x - lower.x) * (upper.y - lower.y) / (upper.x - lower.x);
+    }
+  }
+  return points_[num_points - 1].y;
+}
+
+// GainSchedule
+
+template <size_t num_ranges>
+const PIGains &GainSchedule<num_ranges>::gains(float setpoint) const {
+  size_t index = 0;
+  for (size_t i = 1; i < num_ranges; ++i) {
+    if (setpoint >= ranges_[i].lower) {
+      index = i;
+    }
+  }
+  return ranges_[index].gains;
+}
+
+// FeedforwardPI
+
+template <size_t num_characteristic_points, size_t num_gain_ranges>
+void FeedforwardPI<num_characteristic_points, num_gain_ranges>::transform(
+    uint32_t current_time, float measurement, float target, float &actuation) {
+  float setpoint = 0;
+  ramp_.transform(current_time, target, setpoint);
+
+  const PIGains &gains = schedule_.gains(setpoint);
+  const float error = setpoint - measurement;
+  const float unsaturated =
+      characteristic_.interpolate(setpoint) + gains.p * error + integral_term_;
+  actuation = unsaturated;
+  if (actuation < out_min) {
+    actuation = out_min;
+  }
+  if (actuation > out_max) {
+    actuation = out_max;
+  }
+  integral_term_ += gains.i * error + back_calculation_gain_ * (actuation - unsaturated);
+}
+
+template <size_t num_characteristic_points, size_t num_gain_ranges>
+void FeedforwardPI<num_characteristic_points, num_gain_ranges>::reset(float measurement) {
+  integral_term_ = 0;
+  ramp_.reset(measurement);
+}
+
+}  // namespace Pufferfish::Driver::BreathingCircuit
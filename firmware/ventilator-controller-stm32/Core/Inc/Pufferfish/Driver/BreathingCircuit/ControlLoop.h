@@ -17,18 +17,21 @@
 #include "Pufferfish/HAL/Interfaces/PWM.h"
 #include "Pufferfish/Util/Timeouts.h"
 #include "Sensors.h"
+#include "SignalSmoothing.h"
 
 namespace Pufferfish::Driver::BreathingCircuit {
 
 class ControlLoop {
  public:
+  static constexpr uint32_t update_interval = 2;                  // ms
+  static constexpr float update_rate = 1000.F / update_interval;  // Hz
+
   virtual void update(uint32_t current_time) = 0;
 
  protected:
   Util::MsTimer &step_timer() { return step_timer_; }
 
  private:
-  static const uint32_t update_interval = 2;  // ms
   Util::MsTimer step_timer_{update_interval, 0};
 };
 
@@ -40,9 +43,13 @@ class HFNCControlLoop : public ControlLoop {
       Driver::I2C::SFM3019::Sensor &sfm3019_air,
       Driver::I2C::SFM3019::Sensor &sfm3019_o2,
       HAL::Interfaces::PWM &valve_air,
-      HAL::Interfaces::PWM &valve_o2)
-      : parameters_(parameters),
+      HAL::Interfaces::PWM &valve_o2,
+      Controller &controller,
+      bool prefilter_flows = false)
+      : prefilter_flows_(prefilter_flows),
+        parameters_(parameters),
         sensor_measurements_(sensor_measurements),
+        controller_(controller),
         sfm3019_air_(sfm3019_air),
         sfm3019_o2_(sfm3019_o2),
         valve_air_(valve_air),
@@ -57,15 +64,20 @@ class HFNCControlLoop : public ControlLoop {
   [[nodiscard]] const SensorConnections &sensor_connections() const;
 
  private:
+  // If enabled, the flow measurements are low-pass filtered before they're used by the
+  // controller and reported as sensor measurements
+  const bool prefilter_flows_;
   const Parameters &parameters_;
   SensorMeasurements &sensor_measurements_;
 
-  HFNCController controller_;
+  Controller &controller_;
 
   // SensorVars
   SensorVars sensor_vars_{};
   Driver::I2C::SFM3019::Sensor &sfm3019_air_;
   Driver::I2C::SFM3019::Sensor &sfm3019_o2_;
+  SensorPrefilter flow_air_prefilter_{update_rate};
+  SensorPrefilter flow_o2_prefilter_{update_rate};
 
   // Setpoints
   ActuatorSetpoints actuator_setpoints_{};
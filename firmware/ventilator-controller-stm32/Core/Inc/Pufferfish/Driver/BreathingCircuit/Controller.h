@@ -25,6 +25,7 @@ struct SensorVars {
   float flow_o2;          // L/min
   float p_out_above_atm;  // psi
   uint32_t po2;           // dPa
+  uint32_t po2_time;      // ms, when po2 was measured
 };
 
 struct ActuatorSetpoints {
@@ -50,6 +51,9 @@ class Controller {
       ActuatorVars &actuator_vars) = 0;
 };
 
+// Splits the flow setpoint between the air and O2 valves to reach the FiO2 setpoint
+void transform_hfnc_setpoints(const Parameters &parameters, ActuatorSetpoints &actuator_setpoints);
+
 class HFNCController : public Controller {
  public:
   void transform(
@@ -61,8 +65,57 @@ class HFNCController : public Controller {
       ActuatorVars &actuator_vars) override;
 
  private:
-  PI valve_o2_{};
-  PI valve_air_{};
+  PI<> valve_o2_{};
+  PI<> valve_air_{};
+};
+
+// An HFNC controller which drives each valve with a FeedforwardPI, for a faster response to
+// changes of the flow setpoint than HFNCController. Its valve characteristic and gains are
+// uncalibrated, so the firmware only uses it when built with HFNC_FEEDFORWARD_CONTROLLER.
+class HFNCFeedforwardController : public Controller {
+ public:
+  // Valve opening needed to reach each flow at steady state, for the nominal valve and inlet
+  // pressure; the feedback terms correct for any deviations from it
+  using ValveCharacteristic = LookupTable<7>;
+  static constexpr ValveCharacteristic::Points valve_characteristic_points{{
+      {0, 0},      // L/min, opening
+      {1, 0.2},    // L/min, opening
+      {5, 0.28},   // L/min, opening
+      {10, 0.34},  // L/min, opening
+      {20, 0.45},  // L/min, opening
+      {40, 0.62},  // L/min, opening
+      {80, 0.95}   // L/min, opening
+  }};
+  using ValveGainSchedule = GainSchedule<3>;
+  static constexpr ValveGainSchedule::Ranges valve_gain_ranges{{
+      {0, {0.004, 0.0004}},   // L/min, {opening/(L/min), opening/(L/min)/step}
+      {10, {0.003, 0.0003}},  // L/min, {opening/(L/min), opening/(L/min)/step}
+      {40, {0.002, 0.0002}}   // L/min, {opening/(L/min), opening/(L/min)/step}
+  }};
+  static constexpr float ramp_rate = 0.4;              // L/min/ms
+  static constexpr float back_calculation_gain = 0.1;  // 1/step
+
+  void transform(
+      uint32_t current_time,
+      const Parameters &parameters,
+      const SensorVars &sensor_vars,
+      const SensorMeasurements &sensor_measurements,
+      ActuatorSetpoints &actuator_setpoints,
+      ActuatorVars &actuator_vars) override;
+
+ private:
+  using ValveController = FeedforwardPI<7, 3>;
+
+  ValveController valve_o2_{
+      ValveCharacteristic{valve_characteristic_points},
+      ValveGainSchedule{valve_gain_ranges},
+      ramp_rate,
+      back_calculation_gain};
+  ValveController valve_air_{
+      ValveCharacteristic{valve_characteristic_points},
+      ValveGainSchedule{valve_gain_ranges},
+      ramp_rate,
+      back_calculation_gain};
 };
 
 }  // namespace Pufferfish::Driver::BreathingCircuit
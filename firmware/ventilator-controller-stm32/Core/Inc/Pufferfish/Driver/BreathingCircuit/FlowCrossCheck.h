@@ -0,0 +1,75 @@
+/*
+ * FlowCrossCheck.h
+ *
+ *  Cross-checking of a flow measurement against a redundant flow estimate
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Pufferfish/Application/States.h"
+#include "Pufferfish/Protocols/Application/Debouncing.h"
+#include "Pufferfish/Protocols/Application/SignalSmoothing.h"
+#include "Pufferfish/Util/Timeouts.h"
+
+namespace Pufferfish::Driver::BreathingCircuit {
+
+/**
+ * Compares the flow used for control against a redundant estimate of the same flow
+ *
+ * The flows are compared at a fixed sampling interval. Their difference is smoothed, since the
+ * redundant estimate is noisier, and the flows disagree while the smoothed difference is larger
+ * than an absolute tolerance plus a tolerance relative to the reference flow. Disagreement is
+ * debounced over about half a second, and every debounced disagreement is counted.
+ */
+class FlowCrossCheck {
+ public:
+  enum class Status { ok = 0, disagreement };
+
+  static const uint32_t sampling_interval = 10;            // ms
+  static constexpr float discrepancy_responsiveness = 0.1;  // per sample
+  static const uint8_t debounce_samples = 50;
+
+  /**
+   * @param tolerance the difference allowed between the flows, in L/min
+   * @param relative_tolerance the difference allowed in addition, as a fraction of the
+   * reference flow
+   */
+  FlowCrossCheck(float tolerance, float relative_tolerance)
+      : tolerance_(tolerance), relative_tolerance_(relative_tolerance) {}
+
+  /**
+   * Compares the flows if the sampling interval has passed since they were last compared
+   * Both flows must be valid, i.e. both sensors must be connected.
+   * @param reference_flow the flow used for control, in L/min
+   * @param check_flow the redundant estimate of the flow, in L/min
+   * @return disagreement while the flows have disagreed for the debouncing duration
+   */
+  Status transform(uint32_t current_time, float reference_flow, float check_flow);
+
+  /// Forgets the smoothed difference and debouncing, e.g. while either sensor is disconnected
+  void reset();
+
+  /// Reports the smoothed difference and the count of disagreements
+  void output(Application::MCUDiagnostics &diagnostics) const;
+
+  /// The smoothed difference of the check flow from the reference flow, in L/min
+  [[nodiscard]] float discrepancy() const { return discrepancy_; }
+  [[nodiscard]] uint32_t disagreements() const { return disagreements_; }
+
+ private:
+  const float tolerance_;
+  const float relative_tolerance_;
+
+  Util::MsTimer sampling_timer_{sampling_interval};
+  bool sampled_ = false;
+  Protocols::Application::EWMA<float> smoother_{discrepancy_responsiveness};
+  Protocols::Application::Debouncer debouncer_{debounce_samples, 0};
+  Protocols::Application::EdgeDetector edge_detector_;
+  float discrepancy_ = 0;  // L/min
+  bool disagreeing_ = false;
+  uint32_t disagreements_ = 0;
+};
+
+}  // namespace Pufferfish::Driver::BreathingCircuit
@@ -7,37 +7,65 @@
 #pragma once
 
 #include "Pufferfish/Application/States.h"
+#include "Pufferfish/Protocols/Application/Filters.h"
 #include "Pufferfish/Protocols/Application/SignalSmoothing.h"
 
 namespace Pufferfish::Driver::BreathingCircuit {
 
 using Application::SensorMeasurements;
 
+// Number may be float or a fixed-point type such as Util::Q31, in which case each measurement is
+// scaled by the full-scale value in its smoothing parameters
+template <typename Number = float>
 class SensorMeasurementsSmoothers {
  public:
-  using SmoothingParameters = Protocols::Application::DisplaySmoother::SmoothingParameters;
+  using SmoothingParameters = Protocols::Application::SmoothingParameters;
+  using Status = Protocols::Application::DisplaySmootherStatus;
 
-  static constexpr SmoothingParameters fio2_params{1, 0.5, 100, 100};
-  static constexpr SmoothingParameters flow_params{1, 0.5, 100, 100};
-  static constexpr SmoothingParameters spo2_params{1, 0.5, 100, 1000};
-  static constexpr SmoothingParameters hr_params{1, 0.5, 100, 1000};
+  static constexpr SmoothingParameters fio2_params{1, 0.5, 100, 100, 128};   // % FiO2
+  static constexpr SmoothingParameters flow_params{1, 0.5, 100, 100, 128};   // L/min
+  static constexpr SmoothingParameters spo2_params{1, 0.5, 100, 1000, 128};  // % SpO2
+  static constexpr SmoothingParameters hr_params{1, 0.5, 100, 1000, 256};    // bpm
 
   static const uint32_t sampling_interval = 5;  // ms
 
   SensorMeasurementsSmoothers()
-      : fio2_(sampling_interval, fio2_params),
-        flow_(sampling_interval, flow_params),
-        spo2_(sampling_interval, spo2_params),
-        hr_(sampling_interval, hr_params) {}
+      : smoothers_(sampling_interval, {fio2_params, flow_params, spo2_params, hr_params}) {}
 
-  void transform(
+  // Returns ok if any filtered measurement was updated, and waiting otherwise
+  Status transform(
       uint32_t current_time, const SensorMeasurements &raw, SensorMeasurements &filtered);
 
  private:
-  Protocols::Application::DisplaySmoother fio2_;
-  Protocols::Application::DisplaySmoother flow_;
-  Protocols::Application::DisplaySmoother spo2_;
-  Protocols::Application::DisplaySmoother hr_;
+  // Channels of the smoothers, in the order of their parameters
+  enum Channel : size_t { fio2 = 0, flow, spo2, hr, num_channels };
+
+  using Smoothers = Protocols::Application::MultiChannelDisplaySmoother<Number, num_channels>;
+
+  Smoothers smoothers_;
+};
+
+// Low-pass filters a high-rate sensor signal before it's used by a controller, to attenuate
+// sensor noise and any actuator ripple which aliases below the cutoff frequency. The filter is
+// restarted at the current value whenever the signal resumes after missing samples, so that it
+// doesn't produce a transient from a stale or zero history.
+class SensorPrefilter {
+ public:
+  static constexpr float cutoff = 50;  // Hz
+
+  // sample_rate is the rate at which transform is called, in Hz
+  explicit constexpr SensorPrefilter(float sample_rate)
+      : filter_({Protocols::Application::FilterDesign::low_pass(cutoff, sample_rate)}) {}
+
+  // Filters value in place if it's valid; otherwise, leaves value unchanged and waits for the
+  // signal to resume
+  void transform(bool valid, float &value);
+
+ private:
+  Protocols::Application::BiquadCascade<1> filter_;
+  bool started_ = false;
 };
 
 }  // namespace Pufferfish::Driver::BreathingCircuit
+
+#include "SignalSmoothing.tpp"
@@ -0,0 +1,38 @@
+/*
+ * SignalSmoothing.tpp
+ *
+ *  Created on: June 6, 2020
+ *      Author: Ethan Li
+ */
+
+#pragma once
+
+#include "SignalSmoothing.h"
+
+namespace Pufferfish::Driver::BreathingCircuit {
+
+// SensorMeasurementsSmoothers
+
+template <typename Number>
+typename SensorMeasurementsSmoothers<Number>::Status
+SensorMeasurementsSmoothers<Number>::transform(
+    uint32_t current_time, const SensorMeasurements &raw, SensorMeasurements &filtered) {
+  filtered.time = current_time;
+  typename Smoothers::Values raw_values{};
+  raw_values[fio2] = raw.fio2;
+  raw_values[flow] = raw.flow;
+  raw_values[spo2] = raw.spo2;
+  raw_values[hr] = raw.hr;
+  typename Smoothers::Values filtered_values{};
+  if (smoothers_.transform(current_time, raw_values, filtered_values) != Status::ok) {
+    return Status::waiting;
+  }
+
+  filtered.fio2 = filtered_values[fio2];
+  filtered.flow = filtered_values[flow];
+  filtered.spo2 = filtered_values[spo2];
+  filtered.hr = filtered_values[hr];
+  return Status::ok;
+}
+
+}  // namespace Pufferfish::Driver::BreathingCircuit
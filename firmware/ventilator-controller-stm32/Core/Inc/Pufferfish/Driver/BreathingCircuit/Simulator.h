@@ -38,6 +38,7 @@ class Simulator {
 
  protected:
   static const uint32_t sensor_update_interval = 2;              // ms
+  static const uint32_t po2_max_age = 500;                       // ms
   static constexpr float po2_fio2_conversion = 100.0 / 1013250;  // % FiO2 / dPa O2 at 1 atm
   static constexpr float spo2_min = 21;                          // % SpO2
   static constexpr float spo2_max = 100;                         // % SpO2
@@ -53,6 +54,8 @@ class Simulator {
   [[nodiscard]] bool update_needed() const;
 
   [[nodiscard]] uint32_t current_time() const;
+  /// Whether a measurement timestamped by the clock given to input_clock is at most max_age old
+  [[nodiscard]] bool within_age(uint32_t measurement_time, uint32_t max_age) const;
   static void transform_fio2(float params_fio2, float &sensor_meas_fio2);
 
  private:
@@ -32,8 +32,12 @@ class ExtendedI2CDevice : public HAL::Interfaces::I2CDevice {
       : dev_(dev), mux_(mux), ext_slot(ext_slot) {}
 
   I2CDeviceStatus read(uint8_t *buf, size_t count) override;
+  I2CDeviceStatus read(uint16_t address, uint8_t *buf, size_t count) override;
   I2CDeviceStatus write(uint8_t *buf, size_t count) override;
 
+  [[nodiscard]] I2CMux &mux() const { return mux_; }
+  [[nodiscard]] uint8_t slot() const { return ext_slot; }
+
  private:
   I2CDevice &dev_;
   I2CMux &mux_;
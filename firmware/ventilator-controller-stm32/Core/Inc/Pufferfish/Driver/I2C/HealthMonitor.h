@@ -0,0 +1,104 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * HealthMonitor.h
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Pufferfish/Application/States.h"
+#include "Pufferfish/HAL/Interfaces/I2CBus.h"
+#include "Pufferfish/HAL/Interfaces/I2CDevice.h"
+#include "Pufferfish/HAL/Interfaces/Time.h"
+#include "Pufferfish/Util/Containers/Array.h"
+
+namespace Pufferfish::Driver::I2C {
+
+/**
+ * An I2C device which records the errors and latencies of its transactions, and which
+ * recovers its bus when its transactions keep timing out or finding the bus busy
+ *
+ * Recovery busy-waits inside the transaction which reaches the recovery threshold, so it
+ * stalls the caller. On the STM32, in the worst case that transaction first blocks for the
+ * HAL timeout of 100 ms and then for about 120 us of recovery, so a stuck bus stalls the main
+ * loop for about 100 ms per transaction; each of the transactions leading up to a recovery
+ * also blocks for up to the HAL timeout.
+ */
+class MonitoredDevice : public HAL::Interfaces::I2CDevice {
+ public:
+  static constexpr size_t num_latency_bins = 6;
+  static constexpr uint32_t first_latency_bound = 250;  // us; bounds of later bins double
+  // consecutive timeouts or busy buses after which the bus is recovered
+  static const size_t default_recovery_threshold = 3;
+
+  /**
+   * @param dev the device whose transactions are monitored
+   * @param bus the bus which the device is on
+   * @param time the clock used for measuring latencies
+   */
+  MonitoredDevice(
+      HAL::Interfaces::I2CDevice &dev,
+      HAL::Interfaces::I2CBus &bus,
+      HAL::Interfaces::Time &time,
+      size_t recovery_threshold = default_recovery_threshold)
+      : dev_(dev), bus_(bus), time_(time), recovery_threshold_(recovery_threshold) {
+    health_.latencies_count = num_latency_bins;
+  }
+
+  I2CDeviceStatus read(uint8_t *buf, size_t count) override;
+  I2CDeviceStatus read(uint16_t address, uint8_t *buf, size_t count) override;
+  I2CDeviceStatus write(uint8_t *buf, size_t count) override;
+  void report(I2CDeviceStatus status) override;
+
+  [[nodiscard]] const Application::I2CDeviceHealth &health() const;
+
+ private:
+  HAL::Interfaces::I2CDevice &dev_;
+  HAL::Interfaces::I2CBus &bus_;
+  HAL::Interfaces::Time &time_;
+  const size_t recovery_threshold_;
+
+  size_t bus_errors_ = 0;  // consecutive timeouts or busy buses since the last recovery
+  Application::I2CDeviceHealth health_{};
+
+  I2CDeviceStatus record(uint32_t start_time, I2CDeviceStatus status);
+  void count_error(I2CDeviceStatus status);
+};
+
+using MonitoredDeviceRef = std::reference_wrapper<MonitoredDevice>;
+
+/**
+ * Collects the health of a group of monitored devices into a diagnostics message
+ */
+template <size_t size>
+class HealthMonitors {
+ public:
+  explicit HealthMonitors(const std::array<MonitoredDeviceRef, size> &devices)
+      : devices_(devices) {}
+
+  void output(Application::I2CDiagnostics &diagnostics) const;
+
+ private:
+  static_assert(
+      size <= sizeof(Application::I2CDiagnostics::devices) /
+                  sizeof(Application::I2CDiagnostics::devices[0]),
+      "I2CDiagnostics can't hold the health of this many devices");
+
+  std::array<MonitoredDeviceRef, size> devices_;
+};
+
+template <typename... Arg>
+constexpr auto make_health_monitors(Arg &&... arg) noexcept {
+  return HealthMonitors<sizeof...(Arg)>(Util::Containers::make_array<MonitoredDeviceRef>(arg...));
+}
+
+}  // namespace Pufferfish::Driver::I2C
+
+#include "HealthMonitor.tpp"
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * HealthMonitor.tpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include "HealthMonitor.h"
+
+namespace Pufferfish::Driver::I2C {
+
+template <size_t size>
+void HealthMonitors<size>::output(Application::I2CDiagnostics &diagnostics) const {
+  diagnostics.devices_count = size;
+  for (size_t i = 0; i < size; ++i) {
+    diagnostics.devices[i] = devices_[i].get().health();
+  }
+}
+
+}  // namespace Pufferfish::Driver::I2C
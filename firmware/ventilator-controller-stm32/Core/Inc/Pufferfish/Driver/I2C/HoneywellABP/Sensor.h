@@ -6,64 +6,74 @@
 
 #pragma once
 
+#include <array>
+
 #include "Device.h"
 #include "Pufferfish/Application/States.h"
 #include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Driver/Lifecycle.h"
+#include "Pufferfish/Driver/Reconnector.h"
 #include "Pufferfish/HAL/Interfaces/Time.h"
 
 namespace Pufferfish::Driver::I2C::HoneywellABP {
 
-/**
- * State management for HoneyWell ABP, without I/O.
- * This is basically a Moore machine, so the state consists of the
- * next action to take, along with the current time.
- */
-class StateMachine {
- public:
-  enum class Action { initialize, check_range, measure, wait_measurement };
-
-  [[nodiscard]] Action update(uint32_t current_time);
-
- private:
-  // the measuring duration is in correlation with hfnc controlloop duration
-  // this should be changed relative to that.
-  static const uint32_t measuring_duration = 1;  // ms
-
-  Action next_action_ = Action::initialize;
-  Util::MsTimer measuring_timer_{measuring_duration, 0};
-};
-
 /**
  * High-level driver for HoneyWell ABP
  */
-class Sensor : public Initializable {
+class Sensor : public Reconnectable {
  public:
+  /// The states of the sensor's lifecycle
+  enum class Action { check_range, measure };
+
   explicit Sensor(Device &device, HAL::Interfaces::Time &time) : device_(device), time_(time) {}
 
   InitializableState setup() override;
+  void reconnect() override;
   InitializableState output(float &output);
 
- private:
-  using Action = StateMachine::Action;
+  [[nodiscard]] Action get_state() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(Action action) const;
 
-  static const uint32_t power_up_delay = 3;     // ms
-  static const size_t max_retries_setup = 8;    // max retries for setup
-  static const size_t max_retries_measure = 8;  // max retries for measuring
+ private:
+  static const uint32_t power_up_delay = 3;  // ms
+  // the measuring duration is in correlation with hfnc controlloop duration
+  // this should be changed relative to that.
+  static const uint32_t measuring_duration = 1;  // ms
+  // Setup is retried up to 8 times, with backoffs from 1 ms up to 8 ms
+  static constexpr RetryPolicy setup_retries{8, 1, 8};
+  // Measurements are retried up to 8 times between valid outputs
+  static constexpr RetryPolicy measure_retries{8, 0, 0};
+
+  static const size_t num_actions = 2;
+  static constexpr std::array<LifecycleState<Action>, num_actions> lifecycle_table{{
+      {Action::check_range,
+       InitializableState::setup,
+       power_up_delay,
+       0,
+       Action::measure,
+       Action::check_range,
+       setup_retries},
+      {Action::measure,
+       InitializableState::ok,
+       measuring_duration,
+       0,
+       Action::measure,
+       Action::measure,
+       measure_retries},
+  }};
+  static_assert(valid_lifecycle(lifecycle_table), "Lifecycle table must be indexed by action");
 
   const float p_min = 0.0;  // psi; minimum pressure for abpxxxx001pg2a3
   const float p_max = 1.0;  // psi; maximum pressure for abpxxxx001pg2a3
 
-  size_t retry_count_ = 0;
   Device device_;
   Sample sample_{};
-  StateMachine fsm_;
-  Action next_action_ = Action::initialize;
+  Lifecycle<Action, num_actions> lifecycle_{lifecycle_table};
 
   HAL::Interfaces::Time &time_;
 
-  InitializableState initialize(uint32_t current_time);
-  InitializableState check_range(uint32_t current_time);
-  InitializableState measure(uint32_t current_time, float &output);
+  StepStatus check_range();
+  StepStatus measure(float &output);
 };
 
 }  // namespace Pufferfish::Driver::I2C::HoneywellABP
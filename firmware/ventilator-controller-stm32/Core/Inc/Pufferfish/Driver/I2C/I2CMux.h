@@ -23,6 +23,7 @@ class I2CMux {
  public:
   /**
    * Changes the device slot of the multiplexer
+   * The current slot is cached, so selecting it again shouldn't need a transaction.
    * @param slot    a slot of the mux
    * @return ok if the updating is success, error code otherwise
    */
@@ -63,9 +63,18 @@ class Device {
    */
   I2CDeviceStatus read_input_current(uint16_t &i_in);
 
+  /**
+   * Reads out all telemetry registers back-to-back
+   * @param telemetry[out] the register values; only updated if every register was read
+   * @return ok on success, error code otherwise
+   */
+  I2CDeviceStatus read_telemetry(Telemetry &telemetry);
+
  private:
   I2CDevice i2cdevice_;
 
+  I2CDeviceStatus read_register(uint16_t address, uint16_t &value);
+
   static constexpr float batt_voltage_conversion = 128.176;  // µV
   static constexpr float voltage_conversion = 1.648;         // mV
   static constexpr float current_conversion = 1.46487;       // µV/RSNSB
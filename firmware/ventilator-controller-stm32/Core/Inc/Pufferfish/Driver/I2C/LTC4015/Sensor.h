@@ -6,55 +6,72 @@
 
 #pragma once
 
+#include <array>
+
 #include "Device.h"
 #include "Pufferfish/Application/Alarms.h"
 #include "Pufferfish/Application/States.h"
 #include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Driver/Lifecycle.h"
 #include "Pufferfish/HAL/Interfaces/Time.h"
 
 namespace Pufferfish::Driver::I2C::LTC4015 {
 
 using Application::MCUPowerStatus;
 
-/**
- * State management for LTC4015, without I/O.
- * This is basically a Moore machine, so the state consists of the
- * next action to take, along with the current time.
- */
-class StateMachine {
- public:
-  // More actions will be added later
-  enum class Action { initialize, measure };
-
-  [[nodiscard]] Action update();
-
- private:
-  Action next_action_ = Action::initialize;
-};
-
 /**
  * High-level driver for LTC4015
  */
 class Sensor : public Initializable {
  public:
-  explicit Sensor(Device &device) : device_(device) {}
+  /// The states of the sensor's lifecycle; more actions will be added later
+  enum class Action { initialize, measure };
+
+  Sensor(Device &device, HAL::Interfaces::Time &time) : device_(device), time_(time) {}
 
   InitializableState setup() override;
-  // updates the battery power charging field
+  /// Updates the battery power charging field; the device is only polled once per interval
   InitializableState output(MCUPowerStatus &mcu_power_status);
 
+  /// The telemetry from the latest poll
+  [[nodiscard]] const Telemetry &telemetry() const { return telemetry_; }
+  [[nodiscard]] Action get_state() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(Action action) const;
+
  private:
-  static const size_t max_retries_setup = 8;    // max retries for setup
-  static const size_t max_retries_measure = 8;  // max retries for measuring
+  // Battery status changes slowly, so polling it rarely leaves I2C1 free for the ABP
+  static const uint32_t polling_interval = 1000;  // ms
+  // Setup is retried up to 8 times, with backoffs from 1 ms up to 8 ms
+  static constexpr RetryPolicy setup_retries{8, 1, 8};
+  // Measurements are retried up to 8 times between valid outputs
+  static constexpr RetryPolicy measure_retries{8, 0, 0};
+
+  static const size_t num_actions = 2;
+  static constexpr std::array<LifecycleState<Action>, num_actions> lifecycle_table{{
+      {Action::initialize,
+       InitializableState::setup,
+       0,
+       0,
+       Action::measure,
+       Action::initialize,
+       setup_retries},
+      {Action::measure,
+       InitializableState::ok,
+       polling_interval,
+       0,
+       Action::measure,
+       Action::measure,
+       measure_retries},
+  }};
+  static_assert(valid_lifecycle(lifecycle_table), "Lifecycle table must be indexed by action");
 
   Device device_;
-  using Action = StateMachine::Action;
-  StateMachine fsm_;
-  Action next_action_ = Action::initialize;
-  size_t retry_count_ = 0;
+  HAL::Interfaces::Time &time_;
+  Telemetry telemetry_{};
+  Lifecycle<Action, num_actions> lifecycle_{lifecycle_table};
 
-  InitializableState initialize();
-  InitializableState measure(MCUPowerStatus &mcu_power_status);
+  StepStatus initialize();
+  StepStatus measure();
 };
 
 }  // namespace Pufferfish::Driver::I2C::LTC4015
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Pufferfish {
@@ -28,6 +29,27 @@ enum class Command : uint16_t {
 
 enum class Mask : uint16_t { charger_enabled = 0x2000 };
 
+// The telemetry registers are contiguous, from system_status to iin_addr
+static const size_t num_telemetry_registers = 6;
+// Register addresses are sent in the high byte of each Command
+static const uint16_t register_address_step = 0x0100;
+
+/**
+ * Raw values of the telemetry registers, all read in the same poll
+ */
+struct Telemetry {
+  uint16_t system_status = 0;
+  uint16_t vbat = 0;
+  uint16_t vin = 0;
+  uint16_t vsys = 0;
+  uint16_t ibat = 0;
+  uint16_t iin = 0;
+
+  [[nodiscard]] constexpr bool charger_enabled() const {
+    return (system_status & static_cast<uint16_t>(Mask::charger_enabled)) != 0;
+  }
+};
+
 }  // namespace LTC4015
 }  // namespace I2C
 }  // namespace Driver
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * MuxScheduler.h
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "ExtendedI2CDevice.h"
+#include "I2CMux.h"
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/Array.h"
+
+namespace Pufferfish::Driver::I2C {
+
+using ExtendedI2CDeviceRef = std::reference_wrapper<ExtendedI2CDevice>;
+
+/**
+ * Counts of the slot selects made by a MuxScheduler
+ */
+struct MuxSchedulerStatistics {
+  uint32_t rounds = 0;
+  uint32_t selects = 0;         // selects which needed a transaction with the mux
+  uint32_t skipped_selects = 0;  // selects of the slot which was already selected
+  uint32_t select_errors = 0;
+};
+
+/**
+ * Schedules the transactions of devices behind I2C multiplexers, grouped by mux slot
+ *
+ * Each round runs a transaction for every device, ordered so that the devices behind each
+ * slot of a mux are handled together: each slot is selected once per round, and the
+ * transactions of the devices behind it then find it already selected. Devices are grouped by
+ * mux in the order in which their muxes first appear, and by slot in increasing order within
+ * each mux; devices behind the same slot keep their given order. The devices behind a slot
+ * which couldn't be selected are skipped for the round.
+ */
+template <size_t size>
+class MuxScheduler {
+ public:
+  explicit MuxScheduler(const std::array<ExtendedI2CDeviceRef, size> &devices);
+
+  /**
+   * Runs a round of transactions
+   * @param transact a function which takes the index of a device, as given to the constructor,
+   * and makes its transactions, e.g. by reading the output of the sensor connected to it
+   * @return ok if every slot was selected, or the error of the last select which failed
+   */
+  template <typename Transact>
+  I2CDeviceStatus run(Transact &&transact);
+
+  /// The indices of the devices in the order in which they're handled in each round
+  [[nodiscard]] const std::array<size_t, size> &order() const { return order_; }
+  [[nodiscard]] const MuxSchedulerStatistics &statistics() const { return statistics_; }
+
+ private:
+  std::array<ExtendedI2CDeviceRef, size> devices_;
+  std::array<size_t, size> order_{};
+  MuxSchedulerStatistics statistics_;
+
+  [[nodiscard]] bool before(size_t first, size_t second) const;
+  [[nodiscard]] size_t mux_rank(size_t index) const;
+  I2CDeviceStatus select(const ExtendedI2CDevice &device);
+};
+
+template <typename... Arg>
+auto make_mux_scheduler(Arg &&... arg) noexcept {
+  return MuxScheduler<sizeof...(Arg)>(
+      Util::Containers::make_array<ExtendedI2CDeviceRef>(arg...));
+}
+
+}  // namespace Pufferfish::Driver::I2C
+
+#include "MuxScheduler.tpp"
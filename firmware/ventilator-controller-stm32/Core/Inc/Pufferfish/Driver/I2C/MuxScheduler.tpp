@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * MuxScheduler.tpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include "MuxScheduler.h"
+
+namespace Pufferfish::Driver::I2C {
+
+template <size_t size>
+MuxScheduler<size>::MuxScheduler(const std::array<ExtendedI2CDeviceRef, size> &devices)
+    : devices_(devices) {
+  // Stable insertion sort, since the number of devices is small
+  for (size_t i = 0; i < size; ++i) {
+    size_t j = i;
+    for (; j > 0 && before(i, order_[j - 1]); --j) {
+      order_[j] = order_[j - 1];
+    }
+    order_[j] = i;
+  }
+}
+
+template <size_t size>
+template <typename Transact>
+I2CDeviceStatus MuxScheduler<size>::run(Transact &&transact) {
+  ++statistics_.rounds;
+  I2CDeviceStatus status = I2CDeviceStatus::ok;
+  I2CDeviceStatus select_status = I2CDeviceStatus::ok;
+  for (size_t i = 0; i < size; ++i) {
+    const ExtendedI2CDevice &device = devices_[order_[i]].get();
+    if (i == 0 || before(order_[i - 1], order_[i])) {
+      // the first device behind its slot
+      select_status = select(device);
+      if (select_status != I2CDeviceStatus::ok) {
+        status = select_status;
+      }
+    }
+    if (select_status == I2CDeviceStatus::ok) {
+      transact(order_[i]);
+    }
+  }
+  return status;
+}
+
+template <size_t size>
+bool MuxScheduler<size>::before(size_t first, size_t second) const {
+  size_t first_rank = mux_rank(first);
+  size_t second_rank = mux_rank(second);
+  if (first_rank != second_rank) {
+    return first_rank < second_rank;
+  }
+
+  return devices_[first].get().slot() < devices_[second].get().slot();
+}
+
+template <size_t size>
+size_t MuxScheduler<size>::mux_rank(size_t index) const {
+  const I2CMux &mux = devices_[index].get().mux();
+  for (size_t i = 0; i < index; ++i) {
+    if (&devices_[i].get().mux() == &mux) {
+      return i;
+    }
+  }
+  return index;
+}
+
+template <size_t size>
+I2CDeviceStatus MuxScheduler<size>::select(const ExtendedI2CDevice &device) {
+  I2CMux &mux = device.mux();
+  if (mux.get_current_slot() == device.slot()) {
+    ++statistics_.skipped_selects;
+    return I2CDeviceStatus::ok;
+  }
+
+  ++statistics_.selects;
+  I2CDeviceStatus status = mux.select_slot(device.slot());
+  if (status != I2CDeviceStatus::ok) {
+    ++statistics_.select_errors;
+  }
+  return status;
+}
+
+}  // namespace Pufferfish::Driver::I2C
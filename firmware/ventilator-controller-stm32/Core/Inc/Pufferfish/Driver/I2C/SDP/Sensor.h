@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Sensor.h
+ *
+ *  Created on: Oct 19, 2020
+ *
+ *  High-level measurement driver for the SDP differential pressure sensors.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Pufferfish/Driver/I2C/SDP.h"
+#include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Driver/Lifecycle.h"
+#include "Pufferfish/Driver/Reconnector.h"
+#include "Pufferfish/HAL/Interfaces/Time.h"
+
+namespace Pufferfish::Driver::I2C::SDP {
+
+/**
+ * Computes flow through a restriction from the differential pressure across it
+ * Flow is proportional to the square root of the differential pressure, as for an orifice or
+ * venturi, and is corrected for the change of gas density with temperature.
+ * @param differential_pressure the differential pressure in Pa
+ * @param temperature the gas temperature in deg C
+ * @param flow_coefficient the flow in L/min at 1 Pa and 20 deg C
+ * @return the flow in L/min, which has the sign of the differential pressure
+ */
+float compute_flow(float differential_pressure, float temperature, float flow_coefficient);
+
+/**
+ * High-level (stateful) driver for Sensirion SDP differential pressure sensors
+ *
+ * The sensor measures continuously with averaging, and is read at its update rate. Only the
+ * differential pressure is read in most measurements, since the scale factor doesn't change;
+ * the full sample is read periodically to update the temperature.
+ */
+class Sensor : public Reconnectable {
+ public:
+  /// The states of the sensor's lifecycle, in the order in which they're normally entered
+  enum class Action { stop, start_measure, check_range, measure };
+
+  /// @param flow_coefficient the flow in L/min at 1 Pa and 20 deg C, see compute_flow
+  Sensor(SDPSensor &device, float flow_coefficient, HAL::Interfaces::Time &time)
+      : device_(device), flow_coefficient_(flow_coefficient), time_(time) {}
+
+  InitializableState setup() override;
+  void reconnect() override;
+  /// @param flow[out] the flow in L/min
+  InitializableState output(float &flow);
+
+  /// The latest sample; the temperature is only updated periodically
+  [[nodiscard]] const SDPSample &sample() const { return sample_; }
+  [[nodiscard]] Action get_state() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(Action action) const;
+
+ private:
+  static const uint32_t stop_duration = 500;             // us
+  static const uint32_t warming_up_duration = 20000;     // us
+  static const uint32_t check_timeout = 50000;           // us
+  static const uint32_t measuring_duration = 500;        // us; the update rate with averaging
+  static const uint32_t measure_timeout = 10000;         // us
+  static const uint32_t temperature_interval = 1000000;  // us
+  // Setup is retried up to 8 times, with backoffs from 1 ms up to 16 ms
+  static constexpr RetryPolicy setup_retries{8, 1000, 16000};
+  // Measurements are retried up to 8 times between valid outputs
+  static constexpr RetryPolicy measure_retries{8, 0, 0};
+
+  static const size_t num_actions = 4;
+  static constexpr std::array<LifecycleState<Action>, num_actions> lifecycle_table{{
+      {Action::stop,
+       InitializableState::setup,
+       0,
+       0,
+       Action::start_measure,
+       Action::stop,
+       setup_retries},
+      {Action::start_measure,
+       InitializableState::setup,
+       stop_duration,
+       0,
+       Action::check_range,
+       Action::stop,
+       setup_retries},
+      {Action::check_range,
+       InitializableState::setup,
+       warming_up_duration,
+       check_timeout,
+       Action::measure,
+       Action::stop,
+       setup_retries},
+      {Action::measure,
+       InitializableState::ok,
+       measuring_duration,
+       measure_timeout,
+       Action::measure,
+       Action::measure,
+       measure_retries},
+  }};
+  static_assert(valid_lifecycle(lifecycle_table), "Lifecycle table must be indexed by action");
+
+  // Measurement ranges of the SDP3x
+  static constexpr float min_dp = -500;   // Pa
+  static constexpr float max_dp = 500;    // Pa
+  static constexpr float min_temp = -40;  // deg C
+  static constexpr float max_temp = 85;   // deg C
+
+  SDPSensor &device_;
+  const float flow_coefficient_;
+  HAL::Interfaces::Time &time_;
+  SDPSample sample_{};
+  uint32_t temperature_time_ = 0;  // us, when the temperature was last read
+  Lifecycle<Action, num_actions> lifecycle_{lifecycle_table};
+
+  StepStatus step(Action action);
+  StepStatus check_range();
+  StepStatus measure(float &flow);
+  StepStatus read_full_sample();
+};
+
+}  // namespace Pufferfish::Driver::I2C::SDP
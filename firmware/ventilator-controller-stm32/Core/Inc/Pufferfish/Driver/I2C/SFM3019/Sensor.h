@@ -9,79 +9,147 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
 #include "Device.h"
 #include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Driver/Lifecycle.h"
+#include "Pufferfish/Driver/Reconnector.h"
 #include "Pufferfish/HAL/Interfaces/Time.h"
-#include "Pufferfish/Util/Timeouts.h"
 
 namespace Pufferfish::Driver::I2C::SFM3019 {
 
-/**
- * State management for Sensirion SFM3019 flow sensor, without I/O.
- * This is basically a Moore machine, so the state consists of the
- * next action to take, along with the current time.
- */
-class StateMachine {
- public:
-  enum class Action { initialize, wait_warmup, check_range, measure, wait_measurement };
-
-  Action update(uint32_t current_time_us);
-  Action output();
-
- private:
-  static const uint32_t warming_up_duration_us = 30000;  // us
-  static const uint32_t measuring_duration_us = 500;     // us
-
-  Action next_action_ = Action::initialize;
-  Util::UsTimer warmup_timer_{warming_up_duration_us, 0};
-  Util::UsTimer measuring_timer_{measuring_duration_us, 0};
-};
-
 /**
  * High-level (stateful) driver for Sensirion SFM3019 flow sensor
  */
-class Sensor : public Initializable {
+class Sensor : public Reconnectable {
  public:
+  /// The states of the sensor's lifecycle, in the order in which they're normally entered
+  enum class Action {
+    reset,
+    request_product_id,
+    read_product_id,
+    request_conversion_factors,
+    read_conversion_factors,
+    set_averaging,
+    start_measure,
+    check_range,
+    measure
+  };
+
   Sensor(Device &device, bool resetter, HAL::Interfaces::Time &time)
       : resetter(resetter), device_(device), time_(time) {}
 
   InitializableState setup() override;
+  void reconnect() override;
   InitializableState output(float &flow);
 
-  StateMachine::Action get_state();
+  [[nodiscard]] Action get_state() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(Action action) const;
 
  private:
-  static const uint32_t power_up_delay = 2;  // ms
+  static const uint32_t power_up_delay = 2000;        // us
+  static const uint32_t read_conv_delay = 20;         // us
+  static const uint32_t warming_up_duration = 30000;  // us
+  static const uint32_t measuring_duration = 500;     // us
   static const uint32_t product_number = 0x04020611;
-  static const uint32_t read_conv_delay_us = 20;  // us
   static const int16_t scale_factor = 170;
   static const int16_t offset = -24576;
 
   static const uint16_t flow_unit =
       make_flow_unit(UnitPrefix::none, TimeBase::per_min, Unit::standard_liter_20deg);
   static const uint32_t averaging_window = 0;
-  static constexpr float flow_min = -200;      // L/min
-  static constexpr float flow_max = 200;       // L/min
-  static const size_t max_faults_setup = 8;    // max retries for all setup steps combined
-  static const size_t max_faults_measure = 8;  // max retries between valid outputs
-
+  static constexpr float flow_min = -200;  // L/min
+  static constexpr float flow_max = 200;   // L/min
+  // Each setup step is retried up to 8 times, with backoffs from 1 ms up to 8 ms
+  static constexpr RetryPolicy setup_retries{8, 1000, 8000};
+  // Measurements are retried up to 8 times between valid outputs, at the measuring interval
+  static constexpr RetryPolicy measure_retries{8, 0, 0};
+
+  static const size_t num_actions = 9;
+  static constexpr std::array<LifecycleState<Action>, num_actions> lifecycle_table{{
+      {Action::reset,
+       InitializableState::setup,
+       0,
+       0,
+       Action::request_product_id,
+       Action::reset,
+       setup_retries},
+      {Action::request_product_id,
+       InitializableState::setup,
+       power_up_delay,
+       0,
+       Action::read_product_id,
+       Action::request_product_id,
+       setup_retries},
+      {Action::read_product_id,
+       InitializableState::setup,
+       0,
+       0,
+       Action::request_conversion_factors,
+       Action::request_product_id,
+       setup_retries},
+      {Action::request_conversion_factors,
+       InitializableState::setup,
+       0,
+       0,
+       Action::read_conversion_factors,
+       Action::request_conversion_factors,
+       setup_retries},
+      {Action::read_conversion_factors,
+       InitializableState::setup,
+       read_conv_delay,
+       0,
+       Action::set_averaging,
+       Action::request_conversion_factors,
+       setup_retries},
+      {Action::set_averaging,
+       InitializableState::setup,
+       0,
+       0,
+       Action::start_measure,
+       Action::set_averaging,
+       setup_retries},
+      {Action::start_measure,
+       InitializableState::setup,
+       0,
+       0,
+       Action::check_range,
+       Action::start_measure,
+       setup_retries},
+      {Action::check_range,
+       InitializableState::setup,
+       warming_up_duration,
+       0,
+       Action::measure,
+       Action::check_range,
+       setup_retries},
+      {Action::measure,
+       InitializableState::ok,
+       measuring_duration,
+       0,
+       Action::measure,
+       Action::measure,
+       measure_retries},
+  }};
+  static_assert(valid_lifecycle(lifecycle_table), "Lifecycle table must be indexed by action");
+
+  // The resetter sends a general call reset on the first setup. It resets every device on the
+  // bus, so after a reconnection the sensor is only told to stop measuring instead.
   const bool resetter;
+  bool reconnected_ = false;
 
   Device &device_;
-  StateMachine fsm_;
-  InitializableState prev_state_ = InitializableState::setup;
-  size_t fault_count_ = 0;
+  Lifecycle<Action, num_actions> lifecycle_{lifecycle_table};
 
   ConversionFactors conversion_{};
 
   HAL::Interfaces::Time &time_;
 
-  InitializableState initialize();
-  InitializableState check_range();
-  InitializableState measure(float &flow);
+  StepStatus step(Action action);
+  StepStatus measure(float &flow);
 };
 
 }  // namespace Pufferfish::Driver::I2C::SFM3019
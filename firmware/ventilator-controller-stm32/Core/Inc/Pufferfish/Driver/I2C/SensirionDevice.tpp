@@ -24,6 +24,7 @@ I2CDeviceStatus SensirionDevice::read(std::array<uint8_t, size> &buf) {
     uint8_t received_crc = buf_with_crc[word_start + sizeof(uint16_t)];
 
     if (expected_crc != received_crc) {
+      dev_.report(I2CDeviceStatus::crc_check_failed);
       return I2CDeviceStatus::crc_check_failed;
     }
 
@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
+#include "Pufferfish/Application/States.h"
 #include "Pufferfish/Statuses.h"
 #include "Pufferfish/Util/Containers/Array.h"
 
@@ -20,6 +24,8 @@ class Initializable {
  public:
   /**
    * Run a step of setup and return the result
+   * Each step should return without blocking, so that the setup of other hardware
+   * can be interleaved with it.
    * @return ok when setup has completed, setup when it is in progress, failed when an error
    * occurred
    */
@@ -28,24 +34,66 @@ class Initializable {
 
 using InitializableRef = std::reference_wrapper<Initializable>;
 
+/**
+ * Setup progress of one Initializable in a group of Initializables
+ */
+struct InitializableProgress {
+  InitializableState state = InitializableState::setup;
+  uint32_t timeout = 0;        // ms after setup starts by which setup must be ok, or 0 for none
+  uint32_t time_to_ready = 0;  // ms after setup starts at which setup became ok or failed
+  bool timed_out = false;
+};
+
+/**
+ * Interleaves the setup of a group of hardware, so that they are all set up concurrently
+ * Each call of setup runs one step of setup for every Initializable which is still in
+ * progress; Initializables which are ok or failed aren't stepped again. Then the time until
+ * every Initializable is ready is the time taken by the slowest one, rather than their sum.
+ */
 template <size_t size>
 class Initializables {
  public:
-  explicit Initializables(const std::array<InitializableRef, size> &initializables)
-      : initializables_(initializables) {}
+  /// Every Initializable gets the same timeout, which can be overridden with set_timeout
+  Initializables(const std::array<InitializableRef, size> &initializables, uint32_t timeout)
+      : initializables_(initializables) {
+    for (InitializableProgress &progress : progress_) {
+      progress.timeout = timeout;
+    }
+  }
 
-  void setup();
+  void set_timeout(size_t index, uint32_t timeout);
+
+  /**
+   * Runs a step of setup for every Initializable which is still in progress
+   * An Initializable which is still in progress after its timeout is considered failed.
+   * @param current_time the current time in ms; setup starts at the time of the first call
+   */
+  void setup(uint32_t current_time);
   [[nodiscard]] bool setup_failed() const;
   [[nodiscard]] bool setup_in_progress() const;
 
+  [[nodiscard]] const InitializableProgress &progress(size_t index) const;
+  /// The time to ready of the slowest Initializable which is no longer in progress
+  [[nodiscard]] uint32_t setup_duration() const;
+  /// Reports the setup duration, and the setup progress of each Initializable by its index
+  void output(Application::MCUDiagnostics &diagnostics) const;
+
  private:
+  static_assert(
+      size <= sizeof(Application::MCUDiagnostics::times_to_ready) /
+                  sizeof(Application::MCUDiagnostics::times_to_ready[0]),
+      "MCUDiagnostics can't hold the setup progress of this many Initializables");
+
   std::array<InitializableRef, size> initializables_;
-  std::array<InitializableState, size> initialization_states_;
+  std::array<InitializableProgress, size> progress_{};
+  bool started_ = false;
+  uint32_t start_time_ = 0;
 };
 
 template <typename... Arg>
-constexpr auto make_initializables(Arg &&... arg) noexcept {
-  return Initializables<sizeof...(Arg)>(Util::Containers::make_array<InitializableRef>(arg...));
+constexpr auto make_initializables(uint32_t timeout, Arg &&... arg) noexcept {
+  return Initializables<sizeof...(Arg)>(
+      Util::Containers::make_array<InitializableRef>(arg...), timeout);
 }
 
 }  // namespace Pufferfish::Driver
@@ -9,30 +9,92 @@
 #include <algorithm>
 
 #include "Initializable.h"
+#include "Pufferfish/Util/Timeouts.h"
 
 namespace Pufferfish::Driver {
 
 template <size_t size>
-void Initializables<size>::setup() {
+void Initializables<size>::set_timeout(size_t index, uint32_t timeout) {
+  progress_[index].timeout = timeout;
+}
+
+template <size_t size>
+void Initializables<size>::setup(uint32_t current_time) {
+  if (!started_) {
+    started_ = true;
+    start_time_ = current_time;
+  }
+
   for (size_t i = 0; i < initializables_.size(); ++i) {
-    initialization_states_[i] = initializables_[i].get().setup();
+    InitializableProgress &progress = progress_[i];
+    if (progress.state != InitializableState::setup) {
+      continue;
+    }
+
+    progress.state = initializables_[i].get().setup();
+    if (progress.state == InitializableState::setup && progress.timeout != 0 &&
+        !Util::within_timeout(start_time_, progress.timeout, current_time)) {
+      progress.state = InitializableState::failed;
+      progress.timed_out = true;
+    }
+    if (progress.state != InitializableState::setup) {
+      progress.time_to_ready = current_time - start_time_;
+    }
   }
 }
 
 template <size_t size>
 bool Initializables<size>::setup_failed() const {
-  return std::find(
-             initialization_states_.cbegin(),
-             initialization_states_.cend(),
-             InitializableState::failed) != initialization_states_.cend();
+  return std::find_if(
+             progress_.cbegin(),
+             progress_.cend(),
+             [](const InitializableProgress &progress) {
+               return progress.state == InitializableState::failed;
+             }) != progress_.cend();
 }
 
 template <size_t size>
 bool Initializables<size>::setup_in_progress() const {
-  return std::find(
-             initialization_states_.cbegin(),
-             initialization_states_.cend(),
-             InitializableState::setup) != initialization_states_.cend();
+  return std::find_if(
+             progress_.cbegin(),
+             progress_.cend(),
+             [](const InitializableProgress &progress) {
+               return progress.state == InitializableState::setup;
+             }) != progress_.cend();
+}
+
+template <size_t size>
+const InitializableProgress &Initializables<size>::progress(size_t index) const {
+  return progress_[index];
+}
+
+template <size_t size>
+uint32_t Initializables<size>::setup_duration() const {
+  uint32_t duration = 0;
+  for (const InitializableProgress &progress : progress_) {
+    if (progress.state != InitializableState::setup) {
+      duration = std::max(duration, progress.time_to_ready);
+    }
+  }
+  return duration;
+}
+
+template <size_t size>
+void Initializables<size>::output(Application::MCUDiagnostics &diagnostics) const {
+  diagnostics.setup_duration = setup_duration();
+  diagnostics.setups_failed = 0;
+  diagnostics.setups_timed_out = 0;
+  diagnostics.times_to_ready_count = size;
+  for (size_t i = 0; i < size; ++i) {
+    const InitializableProgress &progress = progress_[i];
+    if (progress.state == InitializableState::failed) {
+      diagnostics.setups_failed |= 1U << i;
+    }
+    if (progress.timed_out) {
+      diagnostics.setups_timed_out |= 1U << i;
+    }
+    diagnostics.times_to_ready[i] = progress.time_to_ready;
+  }
 }
 
 }  // namespace Pufferfish::Driver
@@ -0,0 +1,151 @@
+/// \file
+/// \brief A table-driven state machine for the setup and measurement lifecycle of sensors.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish::Driver {
+
+/**
+ * The outcome of one attempt at the step of a lifecycle state
+ */
+enum class StepStatus {
+  done = 0,  /// The step has finished, so the next state should be entered
+  waiting,   /// The step hasn't finished yet, e.g. because a response hasn't arrived yet
+  fault,     /// The step went wrong, and should be retried by the state's retry policy
+  failed     /// The step went wrong in a way which retries can't fix
+};
+
+/**
+ * How a lifecycle state is retried after faults
+ * The retry after each fault is delayed by a backoff, which starts at initial_backoff and
+ * doubles after every fault up to max_backoff. The lifecycle fails after more than max_faults
+ * faults in all of its setup steps combined, or after more than max_faults faults between steps
+ * which are done in the measurement phase.
+ */
+struct RetryPolicy {
+  size_t max_faults;
+  uint32_t initial_backoff;
+  uint32_t max_backoff;
+};
+
+/**
+ * A row of the transition table of a lifecycle, which describes one state
+ * All times are in the units of the clock which the driver passes to its Lifecycle.
+ */
+template <typename State>
+struct LifecycleState {
+  State state;
+  // setup while the sensor is being set up, or ok while it's making measurements
+  InitializableState phase;
+  uint32_t delay;    // time after the state is entered before its step is first run
+  uint32_t timeout;  // time after the state is entered by which its step must be done, or 0
+  State next;        // entered when the step is done
+  State retry;       // entered after a fault, once the backoff has passed
+  RetryPolicy retries;
+};
+
+/**
+ * Timing statistics of a lifecycle state, as counts and in the units of the driver's clock
+ */
+struct LifecycleStatistics {
+  uint32_t entries = 0;
+  uint32_t faults = 0;
+  uint32_t total_time = 0;  // time spent in the state, summed over every time it was exited
+  uint32_t max_time = 0;    // the longest time spent in the state before it was exited
+};
+
+/**
+ * Checks that every row of a transition table is at the index of its state
+ */
+template <typename State, size_t num_states>
+constexpr bool valid_lifecycle(const std::array<LifecycleState<State>, num_states> &table);
+
+/**
+ * Setup and measurement lifecycle of a sensor, as a Moore machine driven by a transition table
+ *
+ * The driver provides the step of each state as a function from the state to a StepStatus,
+ * which does I/O but never blocks; the lifecycle decides when to run steps, and which state to
+ * enter afterwards. At most one step is run per call, and none is run while a state's delay or
+ * backoff is still passing, so timed waits never block the caller. The lifecycle starts in the
+ * first state of its table, when setup is first called.
+ */
+template <typename State, size_t num_states>
+class Lifecycle {
+ public:
+  using Table = std::array<LifecycleState<State>, num_states>;
+
+  /// The table must outlive the lifecycle, so it should be static
+  explicit Lifecycle(const Table &table) : table_(table), state_(table[0].state) {}
+
+  /**
+   * Runs a step of setup, unless setup has already finished
+   * @param step the function which runs the step of a state in the setup phase
+   * @return ok when a state in the measurement phase has been reached, setup when setup is in
+   * progress, failed when the lifecycle has failed
+   */
+  template <typename Step>
+  InitializableState setup(uint32_t current_time, Step &&step);
+
+  /**
+   * Runs a step of measurement, if setup has finished
+   * @param step the function which runs the step of a state in the measurement phase
+   * @return ok while the lifecycle is in the measurement phase, failed otherwise
+   */
+  template <typename Step>
+  InitializableState output(uint32_t current_time, Step &&step);
+
+  /**
+   * Restarts the lifecycle from the first state of its table, even if it has failed
+   * Statistics are kept, so that they cover every attempt at setting up the sensor.
+   */
+  void reset();
+
+  [[nodiscard]] State state() const { return state_; }
+  /// The phase of the current state, or failed if the lifecycle has failed
+  [[nodiscard]] InitializableState phase() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(State state) const;
+
+ private:
+  const Table &table_;
+  State state_;
+  bool started_ = false;
+  bool failed_ = false;
+  uint32_t entry_time_ = 0;
+  uint32_t wait_ = 0;  // time after entry_time_ before the step may be run
+  size_t faults_ = 0;  // faults since setup started, or since the last measurement
+  std::array<LifecycleStatistics, num_states> statistics_{};
+
+  template <typename Step>
+  InitializableState run(uint32_t current_time, Step &step);
+  void enter(State state, uint32_t current_time, uint32_t wait);
+  void exit(uint32_t current_time);
+  void fault(uint32_t current_time);
+  [[nodiscard]] const LifecycleState<State> &row(State state) const;
+};
+
+}  // namespace Pufferfish::Driver
+
+#include "Lifecycle.tpp"
@@ -0,0 +1,167 @@
+/// \file
+/// \brief A table-driven state machine for the setup and measurement lifecycle of sensors.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+
+#include "Lifecycle.h"
+#include "Pufferfish/Util/Timeouts.h"
+
+namespace Pufferfish::Driver {
+
+template <typename State, size_t num_states>
+constexpr bool valid_lifecycle(const std::array<LifecycleState<State>, num_states> &table) {
+  for (size_t i = 0; i < num_states; ++i) {
+    if (static_cast<size_t>(table[i].state) != i ||
+        static_cast<size_t>(table[i].next) >= num_states ||
+        static_cast<size_t>(table[i].retry) >= num_states) {
+      return false;
+    }
+  }
+  return num_states > 0;
+}
+
+// Lifecycle
+
+template <typename State, size_t num_states>
+template <typename Step>
+InitializableState Lifecycle<State, num_states>::setup(uint32_t current_time, Step &&step) {
+  if (failed_) {
+    return InitializableState::failed;
+  }
+  if (started_ && row(state_).phase == InitializableState::ok) {
+    return InitializableState::ok;
+  }
+
+  return run(current_time, step);
+}
+
+template <typename State, size_t num_states>
+template <typename Step>
+InitializableState Lifecycle<State, num_states>::output(uint32_t current_time, Step &&step) {
+  if (failed_ || !started_ || row(state_).phase != InitializableState::ok) {
+    return InitializableState::failed;
+  }
+
+  return run(current_time, step);
+}
+
+template <typename State, size_t num_states>
+void Lifecycle<State, num_states>::reset() {
+  state_ = table_[0].state;
+  started_ = false;
+  failed_ = false;
+  faults_ = 0;
+}
+
+template <typename State, size_t num_states>
+InitializableState Lifecycle<State, num_states>::phase() const {
+  if (failed_) {
+    return InitializableState::failed;
+  }
+
+  return row(state_).phase;
+}
+
+template <typename State, size_t num_states>
+const LifecycleStatistics &Lifecycle<State, num_states>::statistics(State state) const {
+  return statistics_[static_cast<size_t>(state)];
+}
+
+template <typename State, size_t num_states>
+template <typename Step>
+InitializableState Lifecycle<State, num_states>::run(uint32_t current_time, Step &step) {
+  if (!started_) {
+    started_ = true;
+    enter(state_, current_time, row(state_).delay);
+  }
+  if (Util::within_timeout(entry_time_, wait_, current_time)) {
+    return phase();
+  }
+
+  const LifecycleState<State> &current = row(state_);
+  switch (step(state_)) {
+    case StepStatus::done:
+      if (row(current.next).phase == InitializableState::ok) {
+        faults_ = 0;
+      }
+      exit(current_time);
+      enter(current.next, current_time, row(current.next).delay);
+      break;
+    case StepStatus::waiting:
+      if (current.timeout != 0 &&
+          !Util::within_timeout(entry_time_, current.timeout, current_time)) {
+        fault(current_time);
+      }
+      break;
+    case StepStatus::fault:
+      fault(current_time);
+      break;
+    case StepStatus::failed:
+      exit(current_time);
+      failed_ = true;
+      break;
+  }
+  return phase();
+}
+
+template <typename State, size_t num_states>
+void Lifecycle<State, num_states>::enter(State state, uint32_t current_time, uint32_t wait) {
+  state_ = state;
+  entry_time_ = current_time;
+  wait_ = wait;
+  ++statistics_[static_cast<size_t>(state)].entries;
+}
+
+template <typename State, size_t num_states>
+void Lifecycle<State, num_states>::exit(uint32_t current_time) {
+  LifecycleStatistics &statistics = statistics_[static_cast<size_t>(state_)];
+  uint32_t duration = current_time - entry_time_;
+  statistics.total_time += duration;
+  statistics.max_time = std::max(statistics.max_time, duration);
+}
+
+template <typename State, size_t num_states>
+void Lifecycle<State, num_states>::fault(uint32_t current_time) {
+  const LifecycleState<State> &current = row(state_);
+  ++statistics_[static_cast<size_t>(state_)].faults;
+  ++faults_;
+  exit(current_time);
+  if (faults_ > current.retries.max_faults) {
+    failed_ = true;
+    return;
+  }
+
+  uint32_t backoff = current.retries.initial_backoff;
+  for (size_t i = 1; i < faults_ && backoff < current.retries.max_backoff; ++i) {
+    backoff = backoff > current.retries.max_backoff / 2 ? current.retries.max_backoff
+                                                        : backoff * 2;
+  }
+  backoff = std::min(backoff, current.retries.max_backoff);
+  enter(current.retry, current_time, std::max(backoff, row(current.retry).delay));
+}
+
+template <typename State, size_t num_states>
+const LifecycleState<State> &Lifecycle<State, num_states>::row(State state) const {
+  return table_[static_cast<size_t>(state)];
+}
+
+}  // namespace Pufferfish::Driver
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Reconnector.h
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Pufferfish/Application/States.h"
+#include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/Array.h"
+
+namespace Pufferfish::Driver {
+
+/**
+ * An interface for a hardware whose setup can be restarted after it has failed,
+ * e.g. because the device was disconnected and then connected again
+ */
+class Reconnectable : public Initializable {
+ public:
+  /**
+   * Forget the state of setup, so that subsequent calls of setup start it again from the
+   * beginning; this must not block
+   */
+  virtual void reconnect() = 0;
+};
+
+/**
+ * Counts and latencies of reconnections, in ms
+ */
+struct ReconnectStatistics {
+  uint32_t disconnections = 0;
+  uint32_t attempts = 0;
+  uint32_t reconnections = 0;
+  uint32_t last_latency = 0;  // time from the latest disconnection to the next reconnection
+  uint32_t max_latency = 0;
+};
+
+/**
+ * Supervises a Reconnectable after its setup, and restarts its setup when it fails
+ *
+ * Failed setups are retried with exponential backoff. Each update runs at most one step of
+ * setup, so reconnection never blocks the caller.
+ */
+class Reconnector {
+ public:
+  enum class State { connected = 0, backing_off, reconnecting };
+
+  /**
+   * @param initial_backoff the wait in ms after a disconnection before setup is restarted;
+   * it doubles after each failed attempt, up to max_backoff
+   * @param attempt_timeout the time in ms after which an attempt which hasn't finished setup is
+   * considered failed, or 0 for no timeout
+   */
+  Reconnector(
+      Reconnectable &device,
+      uint32_t initial_backoff,
+      uint32_t max_backoff,
+      uint32_t attempt_timeout)
+      : device_(device),
+        initial_backoff_(initial_backoff),
+        max_backoff_(max_backoff),
+        attempt_timeout_(attempt_timeout) {}
+
+  /**
+   * Checks whether the device has failed, and runs a step of reconnection if it has
+   * The device must have finished setup before the first update.
+   * @return ok while the device is connected, failed while it isn't, or setup if the device
+   * hasn't finished setup yet
+   */
+  InitializableState update(uint32_t current_time);
+
+  [[nodiscard]] State state() const { return state_; }
+  /// The result of the latest update
+  [[nodiscard]] InitializableState status() const { return status_; }
+  [[nodiscard]] const ReconnectStatistics &statistics() const { return statistics_; }
+
+ private:
+  Reconnectable &device_;
+  const uint32_t initial_backoff_;
+  const uint32_t max_backoff_;
+  const uint32_t attempt_timeout_;
+
+  State state_ = State::connected;
+  InitializableState status_ = InitializableState::setup;
+  uint32_t disconnect_time_ = 0;
+  uint32_t wait_start_time_ = 0;  // start of the current backoff or attempt
+  uint32_t backoff_ = 0;
+  ReconnectStatistics statistics_;
+
+  InitializableState step(uint32_t current_time);
+  void back_off(uint32_t current_time);
+};
+
+using ReconnectorRef = std::reference_wrapper<Reconnector>;
+
+/**
+ * Collects the connection states and statistics of a group of reconnectors into MCU diagnostics
+ */
+template <size_t size>
+class Reconnectors {
+ public:
+  explicit Reconnectors(const std::array<ReconnectorRef, size> &reconnectors)
+      : reconnectors_(reconnectors) {}
+
+  /// Reports each Reconnector by its index, and returns whether any of the reports changed
+  bool output(Application::MCUDiagnostics &diagnostics) const;
+
+ private:
+  static_assert(
+      size <= sizeof(Application::MCUDiagnostics::reconnections) /
+                  sizeof(Application::MCUDiagnostics::reconnections[0]),
+      "MCUDiagnostics can't hold the reconnections of this many sensors");
+
+  std::array<ReconnectorRef, size> reconnectors_;
+};
+
+template <typename... Arg>
+constexpr auto make_reconnectors(Arg &&... arg) noexcept {
+  return Reconnectors<sizeof...(Arg)>(Util::Containers::make_array<ReconnectorRef>(arg...));
+}
+
+}  // namespace Pufferfish::Driver
+
+#include "Reconnector.tpp"
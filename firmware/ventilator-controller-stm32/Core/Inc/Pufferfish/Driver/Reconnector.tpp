@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Reconnector.tpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include "Reconnector.h"
+
+namespace Pufferfish::Driver {
+
+template <size_t size>
+bool Reconnectors<size>::output(Application::MCUDiagnostics &diagnostics) const {
+  bool changed = diagnostics.reconnections_count != size;
+  diagnostics.reconnections_count = size;
+  for (size_t i = 0; i < size; ++i) {
+    const Reconnector &reconnector = reconnectors_[i].get();
+    const ReconnectStatistics &statistics = reconnector.statistics();
+    Application::SensorReconnections reconnections{};
+    reconnections.connected = reconnector.status() == InitializableState::ok;
+    reconnections.disconnections = statistics.disconnections;
+    reconnections.attempts = statistics.attempts;
+    reconnections.reconnections = statistics.reconnections;
+    reconnections.last_latency = statistics.last_latency;
+    reconnections.max_latency = statistics.max_latency;
+    if (!(reconnections == diagnostics.reconnections[i])) {
+      diagnostics.reconnections[i] = reconnections;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace Pufferfish::Driver
@@ -26,15 +26,17 @@ class Backend {
       HAL::Interfaces::CRC32 &crc32c,
       Application::Store &store,
       Application::LogEventsSender &log_sender)
-      : receiver_(crc32c), sender_(crc32c), synchronizers_(store, log_sender) {}
+      : receiver_(crc32c, scratch_), sender_(crc32c, scratch_), synchronizers_(store, log_sender) {}
 
   Status input(uint8_t new_byte);
   void update_clock(uint32_t current_time);
   Status output(FrameProps::ChunkBuffer &output_buffer);
 
   [[nodiscard]] bool connected() const;
+  [[nodiscard]] const ScratchArena &scratch() const;
 
  private:
+  ScratchArena scratch_;
   Receiver receiver_;
   Sender sender_;
   Synchronizers synchronizers_;
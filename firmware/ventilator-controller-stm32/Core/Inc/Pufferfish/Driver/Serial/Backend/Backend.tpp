@@ -41,6 +41,7 @@ Backend::Status Backend::input(uint8_t new_byte) {
     case Receiver::OutputStatus::invalid_message_length:
     case Receiver::OutputStatus::invalid_message_type:
     case Receiver::OutputStatus::invalid_message_encoding:
+    case Receiver::OutputStatus::insufficient_scratch:
       // TODO(lietk12): handle error cases first
       return Status::invalid;
     case Receiver::OutputStatus::waiting:
@@ -87,6 +88,7 @@ Backend::Status Backend::output(FrameProps::ChunkBuffer &output_buffer) {
     case Sender::Status::invalid_frame_length:
     case Sender::Status::invalid_frame_encoding:
     case Sender::Status::invalid_return_code:
+    case Sender::Status::insufficient_scratch:
       // TODO(lietk12): handle error cases first
       return Status::invalid;
   }
@@ -98,4 +100,8 @@ bool Backend::connected() const {
   return synchronizers_.connected();
 }
 
+const ScratchArena &Backend::scratch() const {
+  return scratch_;
+}
+
 }  // namespace Pufferfish::Driver::Serial::Backend
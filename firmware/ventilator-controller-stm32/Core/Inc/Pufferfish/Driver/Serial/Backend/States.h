@@ -37,6 +37,8 @@ static const auto state_send_root_sched = Util::Containers::make_array<StateSend
     StateSendEntryTypes::main_sched);
 static const auto state_send_realtime_sched =
     Util::Containers::make_array<MessageTypes>(MessageTypes::sensor_measurements);
+// States in the main schedule are sent periodically in a round-robin, as well as whenever they
+// change
 static const auto state_send_main_sched = Util::Containers::make_array<MessageTypes>(
     MessageTypes::cycle_measurements,
     MessageTypes::parameters,
@@ -46,6 +48,21 @@ static const auto state_send_main_sched = Util::Containers::make_array<MessageTy
     MessageTypes::alarm_mute,
     MessageTypes::screen_status,
     MessageTypes::mcu_power_status);
+// States in the event schedule are sent whenever they change, and to newly-connected backends.
+// Streamed waveforms and slow diagnostics are only in the event schedule, so that they don't
+// lengthen the round-robin.
+static const auto state_send_event_sched = Util::Containers::make_array<MessageTypes>(
+    MessageTypes::cycle_measurements,
+    MessageTypes::parameters,
+    MessageTypes::alarm_limits,
+    MessageTypes::next_log_events,
+    MessageTypes::active_log_events,
+    MessageTypes::alarm_mute,
+    MessageTypes::screen_status,
+    MessageTypes::mcu_power_status,
+    MessageTypes::pleth_waveform,
+    MessageTypes::mcu_diagnostics,
+    MessageTypes::i2c_diagnostics);
 
 static const uint32_t connection_timeout = 500;       // ms
 static const uint32_t state_send_root_interval = 10;  // ms
@@ -57,7 +74,7 @@ class Synchronizers {
   Synchronizers(Application::Store &store, Application::LogEventsSender &log_sender)
       : store_(store),
         state_sender_main_(state_send_main_sched, store),
-        event_sender_(state_send_main_sched, store),
+        event_sender_(state_send_event_sched, store),
         state_sender_realtime_(state_send_realtime_sched, store),
         state_sender_root_(state_send_root_sched, child_state_senders_),
         log_events_sender_(log_sender) {}
@@ -75,7 +92,7 @@ class Synchronizers {
   using ChangedEventSender = Protocols::Application::StateChangeEventSender<
       Application::MessageTypes,
       Application::StateSegment,
-      state_send_main_sched.size(),
+      state_send_event_sched.size(),
       Application::MessageTypeValues::max() + 1>;
   using ChildStateSenders = Protocols::Application::MappedStateSenders<
       StateSendEntryTypes,
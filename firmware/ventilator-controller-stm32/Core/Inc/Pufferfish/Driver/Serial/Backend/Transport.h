@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Frames.h"
@@ -15,6 +16,7 @@
 #include "Pufferfish/Protocols/Transport/CRCElements.h"
 #include "Pufferfish/Protocols/Transport/Datagrams.h"
 #include "Pufferfish/Protocols/Transport/Messages.h"
+#include "Pufferfish/Util/Arena.h"
 
 namespace Pufferfish::Driver::Serial::Backend {
 
@@ -34,6 +36,7 @@ static const MessageDescriptors message_descriptors{
     // Measurements
     {MessageTypes::sensor_measurements, Util::get_protobuf_desc<Application::SensorMeasurements>()},
     {MessageTypes::cycle_measurements, Util::get_protobuf_desc<Application::CycleMeasurements>()},
+    {MessageTypes::pleth_waveform, Util::get_protobuf_desc<Application::PlethWaveform>()},
     // Parameters
     {MessageTypes::parameters, Util::get_protobuf_desc<Application::Parameters>()},
     {MessageTypes::parameters_request, Util::get_protobuf_desc<Application::ParametersRequest>()},
@@ -55,7 +58,10 @@ static const MessageDescriptors message_descriptors{
     // System Miscellaneous
     {MessageTypes::mcu_power_status, Util::get_protobuf_desc<Application::MCUPowerStatus>()},
     {MessageTypes::backend_connections,
-     Util::get_protobuf_desc<Application::BackendConnections>()}};
+     Util::get_protobuf_desc<Application::BackendConnections>()},
+    // Diagnostics
+    {MessageTypes::mcu_diagnostics, Util::get_protobuf_desc<Application::MCUDiagnostics>()},
+    {MessageTypes::i2c_diagnostics, Util::get_protobuf_desc<Application::I2CDiagnostics>()}};
 
 using CRCElementProps =
     Protocols::Transport::CRCElementProps<Driver::Serial::Backend::FrameProps::payload_max_size>;
@@ -65,6 +71,13 @@ using Message = Protocols::Transport::Message<
     Application::MessageTypeValues,
     DatagramProps::payload_max_size>;
 
+// The payload buffers between the protocol layers are borrowed from a scratch arena for the
+// duration of each transformation, rather than being placed on the stack. A Receiver and a
+// Sender can share one scratch arena, as long as they're only used from the same context.
+using ScratchArena = Util::Arena<
+    sizeof(FrameProps::PayloadBuffer) + sizeof(CRCElementProps::PayloadBuffer) +
+    sizeof(DatagramProps::PayloadBuffer) + 3 * alignof(std::max_align_t)>;
+
 class Receiver {
  public:
   enum class InputStatus { ok = 0, output_ready, invalid_frame_length, input_overwritten };
@@ -80,10 +93,12 @@ class Receiver {
     invalid_datagram_sequence,
     invalid_message_length,
     invalid_message_type,
-    invalid_message_encoding
+    invalid_message_encoding,
+    insufficient_scratch
   };
 
-  explicit Receiver(HAL::Interfaces::CRC32 &crc32c) : crc_(crc32c), message_(message_descriptors) {}
+  Receiver(HAL::Interfaces::CRC32 &crc32c, ScratchArena &scratch)
+      : crc_(crc32c), message_(message_descriptors), scratch_(scratch) {}
 
   // Call this until it returns outputReady, then call output
   InputStatus input(uint8_t new_byte);
@@ -102,6 +117,7 @@ class Receiver {
   CRCReceiver crc_;
   DatagramReceiver datagram_;
   MessageReceiver message_;
+  ScratchArena &scratch_;
 };
 
 class Sender {
@@ -115,10 +131,12 @@ class Sender {
     invalid_crcelement_length,
     invalid_frame_encoding,
     invalid_frame_length,
-    invalid_return_code
+    invalid_return_code,
+    insufficient_scratch
   };
 
-  explicit Sender(HAL::Interfaces::CRC32 &crc32c) : message_(message_descriptors), crc_(crc32c) {}
+  Sender(HAL::Interfaces::CRC32 &crc32c, ScratchArena &scratch)
+      : message_(message_descriptors), crc_(crc32c), scratch_(scratch) {}
 
   Status transform(
       const Application::StateSegment &state_segment, FrameProps::ChunkBuffer &output_buffer);
@@ -133,6 +151,7 @@ class Sender {
   DatagramSender datagram_;
   CRCSender crc_;
   FrameSender frame_;
+  ScratchArena &scratch_;
 };
 
 }  // namespace Pufferfish::Driver::Serial::Backend
@@ -28,12 +28,18 @@ Receiver::InputStatus Receiver::input(uint8_t new_byte) {
 }
 
 Receiver::OutputStatus Receiver::output(Message &output_message) {
-  FrameProps::PayloadBuffer temp_buffer1;
-  CRCReceiver::Props::PayloadBuffer temp_buffer2;
-  DatagramReceiver::Props::PayloadBuffer temp_buffer3;
+  ScratchArena::Scope scope(scratch_);
+  FrameProps::PayloadBuffer *temp_buffer1 = nullptr;
+  CRCReceiver::Props::PayloadBuffer *temp_buffer2 = nullptr;
+  DatagramReceiver::Props::PayloadBuffer *temp_buffer3 = nullptr;
+  if (scratch_.create(temp_buffer1) != IndexStatus::ok ||
+      scratch_.create(temp_buffer2) != IndexStatus::ok ||
+      scratch_.create(temp_buffer3) != IndexStatus::ok) {
+    return OutputStatus::insufficient_scratch;
+  }
 
   // Frame
-  switch (frame_.output(temp_buffer1)) {
+  switch (frame_.output(*temp_buffer1)) {
     case FrameProps::OutputStatus::waiting:
       return OutputStatus::waiting;
     case FrameProps::OutputStatus::invalid_length:
@@ -45,8 +51,8 @@ Receiver::OutputStatus Receiver::output(Message &output_message) {
   }
 
   // CRCElement
-  ParsedCRC receive_crc(temp_buffer2);
-  switch (crc_.transform(temp_buffer1, receive_crc)) {
+  ParsedCRC receive_crc(*temp_buffer2);
+  switch (crc_.transform(*temp_buffer1, receive_crc)) {
     case CRCReceiver::Status::invalid_parse:
       return OutputStatus::invalid_crcelement_parse;
     case CRCReceiver::Status::invalid_crc:
@@ -56,8 +62,8 @@ Receiver::OutputStatus Receiver::output(Message &output_message) {
   }
 
   // Datagram
-  ParsedDatagram receive_datagram(temp_buffer3);
-  switch (datagram_.transform(temp_buffer2, receive_datagram)) {
+  ParsedDatagram receive_datagram(*temp_buffer3);
+  switch (datagram_.transform(*temp_buffer2, receive_datagram)) {
     case DatagramReceiver::Status::invalid_parse:
       return OutputStatus::invalid_datagram_parse;
     case DatagramReceiver::Status::invalid_length:
@@ -70,13 +76,15 @@ Receiver::OutputStatus Receiver::output(Message &output_message) {
 
   // Message
   using MessageStatus = Protocols::Transport::MessageStatus;
-  switch (message_.transform(temp_buffer3, output_message)) {
+  switch (message_.transform(*temp_buffer3, output_message)) {
     case MessageStatus::invalid_length:
       return OutputStatus::invalid_message_length;
     case MessageStatus::invalid_type:
       return OutputStatus::invalid_message_type;
     case MessageStatus::invalid_encoding:
       return OutputStatus::invalid_message_encoding;
+    case MessageStatus::insufficient_scratch:
+      return OutputStatus::insufficient_scratch;
     case MessageStatus::ok:
       break;
   }
@@ -87,25 +95,33 @@ Receiver::OutputStatus Receiver::output(Message &output_message) {
 
 Sender::Status Sender::transform(
     const Application::StateSegment &state_segment, FrameProps::ChunkBuffer &output_buffer) {
-  DatagramSender::Props::PayloadBuffer temp_buffer1;
-  CRCSender::Props::PayloadBuffer temp_buffer2;
-  FrameProps::PayloadBuffer temp_buffer3;
+  ScratchArena::Scope scope(scratch_);
+  DatagramSender::Props::PayloadBuffer *temp_buffer1 = nullptr;
+  CRCSender::Props::PayloadBuffer *temp_buffer2 = nullptr;
+  FrameProps::PayloadBuffer *temp_buffer3 = nullptr;
+  if (scratch_.create(temp_buffer1) != IndexStatus::ok ||
+      scratch_.create(temp_buffer2) != IndexStatus::ok ||
+      scratch_.create(temp_buffer3) != IndexStatus::ok) {
+    return Status::insufficient_scratch;
+  }
 
   // Message
   using MessageStatus = Protocols::Transport::MessageStatus;
-  switch (message_.transform(state_segment, temp_buffer1)) {
+  switch (message_.transform(state_segment, *temp_buffer1)) {
     case MessageStatus::invalid_length:
       return Status::invalid_message_length;
     case MessageStatus::invalid_type:
       return Status::invalid_message_type;
     case MessageStatus::invalid_encoding:
       return Status::invalid_message_encoding;
+    case MessageStatus::insufficient_scratch:
+      return Status::insufficient_scratch;
     case MessageStatus::ok:
       break;
   }
 
   // Datagram
-  switch (datagram_.transform(temp_buffer1, temp_buffer2)) {
+  switch (datagram_.transform(*temp_buffer1, *temp_buffer2)) {
     case DatagramSender::Status::invalid_length:
       return Status::invalid_datagram_length;
     case DatagramSender::Status::ok:
@@ -113,7 +129,7 @@ Sender::Status Sender::transform(
   }
 
   // CRCElement
-  switch (crc_.transform(temp_buffer2, temp_buffer3)) {
+  switch (crc_.transform(*temp_buffer2, *temp_buffer3)) {
     case CRCSender::Status::invalid_length:
       return Status::invalid_crcelement_length;
     case CRCSender::Status::ok:
@@ -121,7 +137,7 @@ Sender::Status Sender::transform(
   }
 
   // Frame
-  switch (frame_.transform(temp_buffer3, output_buffer)) {
+  switch (frame_.transform(*temp_buffer3, output_buffer)) {
     case FrameProps::OutputStatus::invalid_length:
       return Status::invalid_frame_length;
     case FrameProps::OutputStatus::invalid_cobs:
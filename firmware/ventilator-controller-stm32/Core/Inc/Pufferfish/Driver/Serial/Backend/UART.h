@@ -29,6 +29,7 @@ class UARTBackend {
   void receive();
   void update_clock(uint32_t current_time);
   [[nodiscard]] bool connected() const;
+  [[nodiscard]] const ScratchArena &scratch() const;
   void send();
 
  private:
@@ -50,6 +50,10 @@ bool UARTBackend::connected() const {
   return backend_.connected();
 }
 
+const ScratchArena &UARTBackend::scratch() const {
+  return backend_.scratch();
+}
+
 void UARTBackend::send() {
   // Create a new output to write if needed
   if (sent_ >= send_output_.size()) {
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <array>
+#include <climits>
 #include <cstdint>
 
 #include "Pufferfish/Util/Containers/Vector.h"
@@ -33,6 +34,9 @@ static const Header bcst{{start, 'B', 'C', 'S', 'T'}};
 static const Header erro{{start, 'E', 'R', 'R', 'O'}};
 }  // namespace Headers
 
+// Command framing
+static const char frame_end = 0x0d;
+
 // Command arguments
 static const int arg_base = 10;
 static const char arg_delimiter = ' ';
@@ -49,6 +53,7 @@ namespace Responses {
 enum class ParseStatus { ok = 0, missing_arg, unexpected_arg, invalid_arg_delimiter };
 
 static const size_t mraw_num_fields = 8;
+static const size_t max_num_fields = mraw_num_fields;
 // Note: this is optimized for MOXY, RDUM and WRUM may not fit as they require up to ~778 bytes
 static const size_t max_len = max_frame_len(mraw_num_fields);
 using ChunkBuffer = Util::Containers::Vector<char, max_len>;
@@ -83,9 +88,6 @@ struct Erro {
   int32_t code;
 };
 
-template <typename Response>
-ParseStatus parse(const ChunkBuffer &input_buffer, Response &response);
-
 union Union {
   Vers vers;
   Mraw mraw;
@@ -128,10 +130,131 @@ using Request = Util::TaggedUnion<Requests::Union, CommandTypes>;
 
 // Command sending/receiving
 
+/**
+ * Parses responses one byte at a time, as they arrive from the UART, without buffering them.
+ *
+ * The header selects the response type, whose arguments are described by a table of fields in
+ * Commands.cpp; each field's digits are accumulated into its value as they arrive. Arguments are
+ * parsed with the semantics of strtoul/strtol on the 32-bit target, including their saturation
+ * on overflow and their handling of leading whitespace and signs, so that every frame gets the
+ * same values and ParseStatus as from the strtoul-based parser which this replaces. The one
+ * deliberate difference is that a LOGO response has no arguments, so "#LOGO\r" is valid.
+ * Frames longer than Responses::max_len are rejected, and parsing always resumes with the next
+ * frame.
+ */
+class ResponseParser {
+ public:
+  enum class Status { waiting = 0, ok, invalid_header, invalid_args, invalid_frame_length };
+  /// Raw values of the arguments, before they're narrowed to the types of their fields
+  using Fields = std::array<uint32_t, Responses::max_num_fields>;
+
+  /// Returns waiting until the end of a frame, and then the result of parsing the frame
+  Status input(char new_byte) {
+    ++frame_length_;
+    // The header, digits and delimiters between arguments are most of the bytes of a response,
+    // so they are handled here; everything else is handled by input_other
+    if (state_ == State::header && new_byte != frame_end) {
+      header_ = (header_ << CHAR_BIT) | static_cast<uint8_t>(new_byte);
+      if (frame_length_ == Headers::length) {
+        match_header();
+      }
+      return Status::waiting;
+    }
+    auto digit = static_cast<uint8_t>(new_byte - '0');
+    if (digit < arg_base) {
+      if (state_ >= State::leading && state_ <= State::digits &&
+          magnitude_ < max_exact_magnitude) {
+        magnitude_ = magnitude_ * arg_base + digit;
+        state_ = State::digits;
+        return Status::waiting;
+      }
+    } else if (
+        new_byte == arg_delimiter && state_ == State::digits && field_ + 1 < num_fields_) {
+      store_field();
+      ++field_;
+      start_field();
+      return Status::waiting;
+    }
+    return input_other(new_byte);
+  }
+  /// Outputs the response of the most recent frame with a valid header; fields which weren't
+  /// parsed are zero
+  void output(Response &output_response) const;
+  /// Returns the result of parsing the arguments of the most recent frame with a valid header
+  [[nodiscard]] Responses::ParseStatus args_status() const { return args_status_; }
+  /// Returns the number of bytes received so far in the current frame
+  [[nodiscard]] size_t frame_length() const { return frame_length_; }
+
+ private:
+  // The states of a number, from leading to digits, must stay in this order
+  enum class State { header, invalid_header, first_delimiter, leading, sign, digits, skip };
+
+  // Below this, another digit can't overflow the magnitude
+  static const uint32_t max_exact_magnitude = UINT32_MAX / arg_base;
+
+  State state_ = State::header;
+  size_t frame_length_ = 0;
+  uint64_t header_ = 0;  // bytes of the header so far, packed into an integer
+
+  // Layout of the response type
+  size_t layout_ = 0;
+  size_t num_fields_ = 0;
+  uint8_t signed_fields_ = 0;  // bit i is set if field i is signed
+
+  // Arguments
+  size_t field_ = 0;  // index of the field being parsed
+  Fields fields_{};
+  Responses::ParseStatus args_status_ = Responses::ParseStatus::ok;
+
+  // Number being parsed
+  size_t leading_spaces_ = 0;   // spaces before the number, until any other leading byte
+  bool other_leading_ = false;  // whether a sign or other whitespace follows those spaces
+  bool negative_ = false;
+  bool overflowed_ = false;
+  uint32_t magnitude_ = 0;
+
+  Status input_other(char new_byte);
+  void match_header();
+  Status end_frame();
+  Status frame_status();
+  void resolve_no_digits(char new_byte);
+  void fail(Responses::ParseStatus status);
+
+  void start_field() {
+    leading_spaces_ = 0;
+    other_leading_ = false;
+    negative_ = false;
+    overflowed_ = false;
+    magnitude_ = 0;
+    state_ = State::leading;
+  }
+
+  void store_field() {
+    static const uint32_t max_unsigned = UINT32_MAX;
+    static const uint32_t max_signed = INT32_MAX;
+    static const uint32_t min_signed_magnitude = max_signed + 1;
+
+    uint32_t raw = negative_ ? 0U - magnitude_ : magnitude_;
+    if ((signed_fields_ & (1U << field_)) != 0) {
+      // strtol saturates to the limits of long
+      uint32_t limit = negative_ ? min_signed_magnitude : max_signed;
+      if (overflowed_ || magnitude_ > limit) {
+        raw = negative_ ? min_signed_magnitude : max_signed;
+      }
+    } else if (overflowed_) {
+      // strtoul saturates to ULONG_MAX, even for negative numbers
+      raw = max_unsigned;
+    }
+    fields_[field_] = raw;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+  }
+};
+
 class CommandReceiver {
  public:
   enum class Status { ok = 0, invalid_header, invalid_args };
 
+  /// Parses a whole frame, ending with frame_end; on invalid_args, output_response has the
+  /// arguments which were parsed before the error
   static Status transform(const Responses::ChunkBuffer &input_buffer, Response &output_response);
 };
 
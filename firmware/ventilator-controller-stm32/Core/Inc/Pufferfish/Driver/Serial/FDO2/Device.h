@@ -16,8 +16,6 @@
 
 namespace Pufferfish::Driver::Serial::FDO2 {
 
-static const char frame_end = 0x0d;
-
 class ResponseReceiver {
  public:
   enum class InputStatus { ok = 0, output_ready, invalid_frame_length, input_overwritten };
@@ -29,13 +27,14 @@ class ResponseReceiver {
     invalid_args
   };
 
-  ResponseReceiver() : chunks_(frame_end, true) {}
-
+  /// Returns output_ready at the end of each frame, including frames which are too long;
+  /// invalid_frame_length is returned once, at the first byte past the maximum frame length
   InputStatus input(uint8_t new_byte);
   OutputStatus output(Response &output_response);
 
  private:
-  Protocols::Transport::ChunkSplitter<Responses::max_len, char> chunks_;
+  ResponseParser parser_;
+  OutputStatus output_status_ = OutputStatus::waiting;
 };
 
 class RequestSender {
@@ -61,15 +60,18 @@ class Device {
     timed_out  /// Operation timed out
   };
 
-  static const uint16_t broadcast_interval = 100;  // ms
+  static const uint16_t default_broadcast_interval = 100;  // ms
 
   explicit Device(volatile HAL::Interfaces::BufferedUART &uart) : uart_(uart) {}
 
   /**
-   * Starts broadcast
+   * Starts broadcast of Mraw measurements
+   * The interval must be long enough for each Mraw frame to be transmitted at the UART's baud
+   * rate, which is about 35 ms for typical frames at 19200 baud.
+   * @param interval the time between measurements, in ms
    * @return ok on success, error code otherwise
    */
-  Status start_broadcast();
+  Status start_broadcast(uint16_t interval);
 
   /**
    * Receives the next response
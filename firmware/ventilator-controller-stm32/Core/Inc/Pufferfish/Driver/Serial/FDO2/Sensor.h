@@ -9,61 +9,162 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
 #include "Device.h"
 #include "Pufferfish/Driver/Initializable.h"
+#include "Pufferfish/Driver/Lifecycle.h"
+#include "Pufferfish/Driver/Reconnector.h"
 #include "Pufferfish/HAL/Interfaces/Time.h"
-#include "Pufferfish/Util/Timeouts.h"
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/RingBuffer.h"
 
 namespace Pufferfish::Driver::Serial::FDO2 {
 
-class StateMachine {
+/**
+ * A measurement from the sensor, with the time at which it was received
+ */
+struct Sample {
+  uint32_t time;  // ms
+  Responses::Mraw mraw;
+};
+
+/**
+ * Averages each block of consecutive samples into one sample
+ * The status bits of the block are combined, so that any flag raised in the block is kept, and
+ * the time of the output sample is the midpoint of the block.
+ */
+class SampleDecimator {
  public:
-  enum class Action {
-    request_version,
-    check_version,
-    start_broadcast,
-    check_broadcast,
-    wait_measurement
-  };
+  enum class Status { ok = 0, waiting };
 
-  [[nodiscard]] Action update(uint32_t current_time, bool passed_check = false);
+  explicit SampleDecimator(size_t factor) : factor_(factor == 0 ? 1 : factor) {}
 
- private:
-  static const uint32_t response_timeout = 50;  // ms
+  /// Returns ok when the input completes a block, in which case output is the block's average
+  Status transform(const Sample &input, Sample &output);
+  /// Discards the samples of the current block
+  void reset() { count_ = 0; }
 
-  Action next_action_ = Action::request_version;
-  Util::MsTimer response_timer_{response_timeout, 0};
+ private:
+  size_t factor_;
+  size_t count_ = 0;
+  uint32_t start_time_ = 0;  // ms
+  uint32_t status_ = 0;
+  int64_t po2_ = 0;
+  int64_t temperature_ = 0;
+  int64_t phase_shift_ = 0;
+  int64_t signal_intensity_ = 0;
+  int64_t ambient_light_ = 0;
+  int64_t ambient_pressure_ = 0;
+  int64_t relative_humidity_ = 0;
 };
 
 /**
  * High-level (stateful) driver for FDO2 sensor
+ * Every measurement broadcast by the sensor is buffered, both as received and decimated, so that
+ * consumers can read all of them at their own rates. When a buffer is full, its oldest sample is
+ * dropped. Measurement fails when no measurement has been received for a few broadcast intervals,
+ * e.g. because the sensor was disconnected or reset, so that its setup can be restarted.
  */
-class Sensor : public Initializable {
+class Sensor : public Reconnectable {
  public:
-  explicit Sensor(Device &device, HAL::Interfaces::Time &time) : device_(device), time_(time) {}
+  /// The states of the sensor's lifecycle
+  enum class Action { request_version, check_version, start_broadcast, check_broadcast, measure };
+
+  static const size_t raw_buffer_size = 32;       // samples, one of which is unused
+  static const size_t decimated_buffer_size = 8;  // samples, one of which is unused
+
+  /**
+   * @param broadcast_interval the time between measurements from the sensor, in ms
+   * @param decimation the number of measurements averaged into each decimated sample
+   */
+  Sensor(
+      Device &device,
+      HAL::Interfaces::Time &time,
+      uint16_t broadcast_interval = Device::default_broadcast_interval,
+      size_t decimation = 1)
+      : device_(device),
+        time_(time),
+        expected_bcst_{broadcast_interval},
+        decimator_(decimation) {}
 
   InitializableState setup() override;
-  InitializableState output(uint32_t &po2);
+  void reconnect() override;
+  /// Buffers all measurements received since the previous call
+  InitializableState output();
 
- private:
-  using Action = StateMachine::Action;
+  /// Pops the oldest buffered measurement, as received
+  BufferStatus read_raw(Sample &sample);
+  /// Pops the oldest buffered decimated measurement
+  BufferStatus read_decimated(Sample &sample);
+
+  [[nodiscard]] Action get_state() const;
+  [[nodiscard]] const LifecycleStatistics &statistics(Action action) const;
 
+ private:
   static constexpr Responses::Vers expected_vers{8, 1, 341, 15};
-  static constexpr Responses::Bcst expected_bcst{Device::broadcast_interval};
-  static const size_t max_retries_setup = 100;  // max retries for all setup steps combined
+  static const uint32_t response_timeout = 50;  // ms
+  // Setup steps are retried up to 100 times combined; the response timeout paces the retries
+  static constexpr RetryPolicy setup_retries{100, 0, 0};
+  static constexpr RetryPolicy measure_retries{0, 0, 0};
+  // broadcast intervals without a measurement, after which the broadcast is considered stopped
+  static const uint32_t stale_intervals = 4;
+
+  static const size_t num_actions = 5;
+  static constexpr std::array<LifecycleState<Action>, num_actions> lifecycle_table{{
+      {Action::request_version,
+       InitializableState::setup,
+       0,
+       0,
+       Action::check_version,
+       Action::request_version,
+       setup_retries},
+      {Action::check_version,
+       InitializableState::setup,
+       0,
+       response_timeout,
+       Action::start_broadcast,
+       Action::request_version,
+       setup_retries},
+      {Action::start_broadcast,
+       InitializableState::setup,
+       0,
+       0,
+       Action::check_broadcast,
+       Action::start_broadcast,
+       setup_retries},
+      {Action::check_broadcast,
+       InitializableState::setup,
+       0,
+       response_timeout,
+       Action::measure,
+       Action::start_broadcast,
+       setup_retries},
+      {Action::measure,
+       InitializableState::ok,
+       0,
+       0,
+       Action::measure,
+       Action::measure,
+       measure_retries},
+  }};
+  static_assert(valid_lifecycle(lifecycle_table), "Lifecycle table must be indexed by action");
 
   Device &device_;
-  StateMachine fsm_;
   HAL::Interfaces::Time &time_;
-  Action next_action_ = Action::request_version;
-  size_t retry_count_ = 0;
+  const Responses::Bcst expected_bcst_;
+  Lifecycle<Action, num_actions> lifecycle_{lifecycle_table};
+
+  uint32_t last_sample_time_ = 0;  // ms
+  SampleDecimator decimator_;
+  Util::Containers::RingBuffer<raw_buffer_size, Sample> raw_;
+  Util::Containers::RingBuffer<decimated_buffer_size, Sample> decimated_;
 
   bool get_response(CommandTypes type, Response &response);
-  InitializableState check_version(uint32_t current_time);
-  InitializableState check_broadcast(uint32_t current_time);
+  StepStatus step(Action action);
+  StepStatus measure();
 };
 
 }  // namespace Pufferfish::Driver::Serial::FDO2
@@ -22,7 +22,7 @@
 #pragma once
 
 #include "Pufferfish/Driver/Serial/Nonin/FrameReceiver.h"
-#include "Pufferfish/Driver/Serial/Nonin/PacketReceiver.h"
+#include "Pufferfish/Driver/Serial/Nonin/Packet.h"
 #include "Pufferfish/HAL/Interfaces/BufferedUART.h"
 #include "Types.h"
 
@@ -39,6 +39,9 @@ enum class PacketStatus {
 /**
  * Device class to receive a byte from Nonin OEM III using UART and calculates
  * the measurements on complete packet availability and returns the measurements
+ * Frames are only parsed one at a time while searching for the start of a packet. Once it's
+ * found, the bytes of the packet are collected as they arrive, and all of its frames are
+ * validated together when the packet is complete, so errors in a packet are reported at its end.
  */
 class Device {
  public:
@@ -55,7 +58,12 @@ class Device {
  private:
   volatile HAL::Interfaces::BufferedUART &nonin_uart_;
   FrameReceiver frame_receiver_;
-  PacketReceiver packet_receiver_;
+  Packet packet_{};
+  size_t received_length_ = 0;  // bytes of packet_ which have been received
+  bool synchronized_ = false;
+
+  PacketStatus synchronize(uint8_t new_byte);
+  PacketStatus complete_packet(Sample &sensor_measurements);
 };
 
 }  // namespace Pufferfish::Driver::Serial::Nonin
@@ -1,6 +1,5 @@
-/// PacketReceiver.h
-/// This file has call and methos for packet receiver takes the input frames and
-/// output the packet measurements on availability
+/// Packet.h
+/// Validation of packets of frames from the Nonin OEM III, and parsing of their measurements
 
 // Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
 // SPDX-License-Identifier: Apache-2.0
@@ -29,13 +28,15 @@
 
 namespace Pufferfish::Driver::Serial::Nonin {
 
-enum class PacketInputStatus {
-  output_ready = 0,  /// Input is available to read output
-  waiting,           /// Input is wait to read more bytes
-  frame_loss         /// missed one or more frames in previous received packet
-};
 using Packet = std::array<Frame, packet_size>;
-using PacketOutputStatus = Pufferfish::Driver::Serial::Nonin::FrameOutputStatus;
+
+/* validate_packet return values */
+enum class PacketValidation {
+  ok = 0,            /// All frames of the packet are valid
+  invalid_header,    /// Error in status byte or in byte 1 of a frame
+  invalid_checksum,  /// Error in frame checksum
+  frame_loss         /// The sync bit is set in a frame other than the first
+};
 
 /**
  * @brief  Inline function to get the SpO2 data
@@ -61,38 +62,18 @@ inline uint16_t get_hr_data(uint8_t msb_byte, uint8_t lsb_byte) {
   return static_cast<uint16_t>(msb | lsb) & Measurements::hr_mask;
 }
 
-/*
- * PacketReceiver class for
- */
-class PacketReceiver {
- public:
-  PacketReceiver() = default;
-
-  /**
-   * @brief  Input is called until packet is filled
-   * @param  frame input frame of 5 bytes
-   * @param  frameIndex frame index of a packet
-   * @return Packet input status on available of packet
-   */
-  PacketInputStatus input(const Frame &frame);
-
-  /**
-   * @brief  Output is called after the input status is available to read
-   * measurements
-   * @param  sensorMeasurements is updated on available of measurements
-   * @return Packet Output status on available of measurements
-   */
-  PacketOutputStatus output(Sample &sensor_measurements);
-
- private:
-  Packet packet_data_{};
-  size_t received_length_ = packet_size;
-  PacketInputStatus input_status_ = PacketInputStatus::waiting;
-};
-
 extern void read_status_byte(
     Sample &sensor_measurements, const size_t &frame_index, const uint8_t &byte_value);
 
 bool check_packet_sync(const Frame &frame);
 
+/**
+ * @brief  Validates the header, checksum and sync bit of every frame in a packet at once
+ * @param  packet the packet to validate
+ * @return the status of the first invalid frame, or ok
+ */
+PacketValidation validate_packet(const Packet &packet);
+
+void read_packet_measurements(Sample &sensor_measurements, const Packet &packet_data);
+
 }  // namespace Pufferfish::Driver::Serial::Nonin
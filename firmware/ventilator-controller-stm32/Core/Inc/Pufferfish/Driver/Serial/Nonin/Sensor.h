@@ -13,8 +13,11 @@
 #include <cstdint>
 
 #include "Device.h"
+#include "Pufferfish/Application/States.h"
 #include "Pufferfish/Driver/Initializable.h"
 #include "Pufferfish/HAL/Interfaces/Time.h"
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/RingBuffer.h"
 #include "Pufferfish/Util/Timeouts.h"
 
 namespace Pufferfish::Driver::Serial::Nonin {
@@ -37,8 +40,17 @@ class Sensor : public Initializable {
 
   void post_setup_reset();
 
+  /**
+   * @brief  Moves the oldest packet_size buffered PLETH samples into a waveform message
+   * @param  waveform is updated when enough samples have been buffered
+   * @return ok if waveform was updated, empty otherwise
+   */
+  BufferStatus output(Application::PlethWaveform &waveform);
+
  private:
   static const uint32_t measurement_timeout = 5000;  // ms
+  // About 1.7 s of PLETH samples; if they aren't read out in time, the oldest are dropped
+  static const size_t pleth_buffer_size = 128;  // samples, one of which is unused
 
   Device &device_;
   HAL::Interfaces::Time &time_;
@@ -48,6 +60,12 @@ class Sensor : public Initializable {
   Sample measurements_{};
 
   Util::MsTimer waiting_timer_{measurement_timeout, 0};
+
+  Util::Containers::RingBuffer<pleth_buffer_size, uint8_t> pleth_;
+  uint32_t pleth_count_ = 0;  // samples buffered since construction, including dropped ones
+  uint32_t pleth_time_ = 0;   // ms, when the newest samples were buffered
+
+  void buffer_pleth();
 };
 
 }  // namespace Pufferfish::Driver::Serial::Nonin
@@ -52,6 +52,8 @@ struct Status {
 
 /* Packet of 25 frames */
 static const size_t packet_size = 25;
+/* Frames, and therefore PLETH samples, are sent at 75 Hz */
+static const uint32_t frame_rate = 75;  // Hz
 /* PLETH for 25 frames */
 using PlethPulseAmplitudes = std::array<uint8_t, packet_size>;
 using Flags = std::array<bool, packet_size>;
@@ -75,7 +75,10 @@ class BufferedUART {
       uint32_t timeout,
       HAL::AtomicSize &written_size) volatile = 0;
 
-  void setup_irq() volatile;
+  /**
+   * Set up the UART interrupt to service the RX queue.
+   */
+  virtual void setup_irq() volatile = 0;
 };
 
 }  // namespace Interfaces
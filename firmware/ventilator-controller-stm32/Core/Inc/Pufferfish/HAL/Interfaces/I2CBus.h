@@ -0,0 +1,44 @@
+/// I2CBus.h
+/// This file has interface class and methods for I2C buses.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish {
+namespace HAL {
+namespace Interfaces {
+
+/**
+ * An abstract class which represents an I2C bus shared by one or more devices
+ */
+class I2CBus {
+ public:
+  /**
+   * Recovers the bus from a stuck transaction, e.g. a device holding SDA low,
+   * and re-initializes the I2C peripheral
+   * @return ok if the bus is free afterwards, error code otherwise
+   */
+  virtual I2CDeviceStatus recover() = 0;
+};
+
+}  // namespace Interfaces
+}  // namespace HAL
+}  // namespace Pufferfish
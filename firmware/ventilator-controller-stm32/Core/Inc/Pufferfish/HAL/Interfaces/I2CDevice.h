@@ -60,6 +60,13 @@ class I2CDevice {
    * @return ok on success, error code otherwise
    */
   virtual I2CDeviceStatus write(uint8_t *buf, size_t count) = 0;
+
+  /**
+   * Reports an error which a higher-level protocol found in data read from the device,
+   * such as a failed CRC check, so that it can be included in the device's statistics
+   * @param status the error which was found
+   */
+  virtual void report(I2CDeviceStatus /*status*/) {}
 };
 
 }  // namespace Interfaces
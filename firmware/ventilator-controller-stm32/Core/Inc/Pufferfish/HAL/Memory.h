@@ -0,0 +1,36 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Memory placement attributes for hot code and data
+ */
+
+#pragma once
+
+// The linker script defines the following output sections, which the startup code
+// initializes before static constructors are run:
+// - .itcm_text is copied from flash into ITCM, which the CPU can execute from with
+//   zero wait states, without depending on the instruction cache.
+// - .dtcm_data is copied from flash into DTCM, which the CPU can access with zero
+//   wait states. DTCM is never cached, so data in it never needs cache maintenance.
+// - .dma_buffers is reserved in D2 SRAM, which the MPU makes non-cacheable, so that
+//   buffers accessed by DMA never need cache maintenance. It is not initialized.
+// These attributes are only applied on the target; on the host (e.g. for unit tests),
+// they have no effect.
+//
+// Functions placed in ITCM should be small and called frequently, since ITCM is only
+// 64 KB; calls between flash and ITCM go through linker-generated long-branch veneers.
+// GCC ignores section attributes on member functions of class templates, so
+// PF_ITCM_FUNCTION must only be used on non-template functions; template instantiations
+// are instead placed in ITCM by their mangled names in the linker scripts.
+// Objects placed in DTCM or D2 SRAM must not be const, or they will conflict with the
+// section flags of mutable objects.
+
+#if defined(__arm__)
+#define PF_ITCM_FUNCTION __attribute__((section(".itcm_text")))
+#define PF_DTCM_DATA __attribute__((section(".dtcm_data")))
+#define PF_DMA_BUFFER __attribute__((section(".dma_buffers"), aligned(32)))
+#else
+#define PF_ITCM_FUNCTION
+#define PF_DTCM_DATA
+#define PF_DMA_BUFFER
+#endif
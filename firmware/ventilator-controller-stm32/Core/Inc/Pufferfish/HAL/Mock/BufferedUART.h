@@ -55,9 +55,9 @@ class BufferedUART : public Interfaces::BufferedUART {
   /**
    * sets read byte data from ring buffer
    * @param  Set read byte input data
-   * @return None
+   * @return buffer status of ring buffer, full if the byte was dropped
    */
-  void set_read(const uint8_t &byte) volatile;
+  BufferStatus set_read(const uint8_t &byte) volatile;
 
   /**
    * Write byte data to ring buffer
@@ -69,9 +69,9 @@ class BufferedUART : public Interfaces::BufferedUART {
   /**
    * Gets write byte data from ring buffer
    * @param  write byte output data
-   * @return None
+   * @return buffer status of ring buffer, empty if there was no byte to get
    */
-  void get_write(uint8_t &byte) volatile;
+  BufferStatus get_write(uint8_t &byte) volatile;
 
   /**
    * write data to ring buffer
@@ -115,6 +115,12 @@ class BufferedUART : public Interfaces::BufferedUART {
       uint32_t timeout,
       HAL::AtomicSize &written_size) volatile override;
 
+  /**
+   * Mock method to set up the UART interrupt, which does nothing
+   * @return None
+   */
+  void setup_irq() volatile override;
+
  private:
   volatile Util::Containers::RingBuffer<rx_buffer_size, uint8_t> rx_buffer_;
   volatile Util::Containers::RingBuffer<tx_buffer_size, uint8_t> tx_buffer_;
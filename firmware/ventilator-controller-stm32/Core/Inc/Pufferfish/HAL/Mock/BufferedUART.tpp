@@ -33,8 +33,9 @@ BufferStatus BufferedUART<rx_buffer_size, tx_buffer_size>::read(uint8_t &read_by
 }
 
 template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
-void BufferedUART<rx_buffer_size, tx_buffer_size>::set_read(const uint8_t &byte) volatile {
-  rx_buffer_.push(byte);
+BufferStatus BufferedUART<rx_buffer_size, tx_buffer_size>::set_read(
+    const uint8_t &byte) volatile {
+  return rx_buffer_.push(byte);
 }
 
 template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
@@ -44,8 +45,9 @@ BufferStatus BufferedUART<rx_buffer_size, tx_buffer_size>::write(uint8_t write_b
 }
 
 template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
-void BufferedUART<rx_buffer_size, tx_buffer_size>::get_write(uint8_t &byte) volatile {
-  tx_buffer_.pop(byte);
+BufferStatus BufferedUART<rx_buffer_size, tx_buffer_size>::get_write(
+    uint8_t &byte) volatile {
+  return tx_buffer_.pop(byte);
 }
 
 template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
@@ -108,6 +110,9 @@ BufferStatus BufferedUART<rx_buffer_size, tx_buffer_size>::write_block(
   return BufferStatus::partial;
 }
 
+template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
+void BufferedUART<rx_buffer_size, tx_buffer_size>::setup_irq() volatile {}
+
 }  // namespace Mock
 }  // namespace HAL
 }  // namespace Pufferfish
@@ -0,0 +1,62 @@
+/// I2CBus.h
+/// This file has mock class and methods for unit testing of I2C buses.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <queue>
+
+#include "Pufferfish/HAL/Interfaces/I2CBus.h"
+
+namespace Pufferfish {
+namespace HAL {
+namespace Mock {
+
+/**
+ * I2CBus class
+ */
+class I2CBus : public Interfaces::I2CBus {
+ public:
+  /**
+   * @brief  Counts the recovery, and returns the next queued status
+   * @return the oldest status added by add_recover_status, or ok if there is none
+   */
+  I2CDeviceStatus recover() override;
+
+  /**
+   * @brief  Appends a status to be returned by recover
+   * @param  status the status to append
+   * @return None
+   */
+  void add_recover_status(I2CDeviceStatus status);
+
+  /**
+   * @brief  Returns the number of times recover was called
+   */
+  [[nodiscard]] size_t recoveries() const;
+
+ private:
+  size_t recoveries_ = 0;
+  std::queue<I2CDeviceStatus> recover_status_queue_;
+};
+
+}  // namespace Mock
+}  // namespace HAL
+}  // namespace Pufferfish
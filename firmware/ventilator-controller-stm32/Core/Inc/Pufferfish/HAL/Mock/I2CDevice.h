@@ -52,14 +52,21 @@ class I2CDevice : public Interfaces::I2CDevice {
   /**
    * Reads data from the device
    * This method should be used when data from a specific memory address needs to be read
+   * The data is taken from the read queue, and the address is recorded for get_read_address
    * @param address of the specific register
    * @param buf[out]    output of the data
    * @param count   the number of bytes to be read
    * @return ok on success, error code otherwise
    */
-  // TODO(lietk12): Add implementation of this method
   I2CDeviceStatus read(uint16_t address, uint8_t *buf, size_t count) override;
 
+  /**
+   * @brief  pops the register address of the oldest register read
+   * @param  address[out] the register address
+   * @return ok on success, no_new_data if no register was read
+   */
+  I2CDeviceStatus get_read_address(uint16_t &address);
+
   /**
    * @brief  Append the input data to the read queue
    * @param  buf the input data to append
@@ -101,6 +108,7 @@ class I2CDevice : public Interfaces::I2CDevice {
 
   std::queue<ReadBuffer> read_buf_queue_;
   std::queue<I2CDeviceStatus> read_status_queue_;
+  std::queue<uint16_t> read_address_queue_;
   std::queue<WriteBuffer> write_buf_queue_;
   std::queue<I2CDeviceStatus> write_status_queue_;
 };
@@ -114,7 +114,7 @@ class BufferedUART : public Interfaces::BufferedUART {
   /**
    * Set up the UART interrupt to service the RX queue.
    */
-  void setup_irq() volatile;
+  void setup_irq() volatile override;
 
   /**
    * Handle the UART interrupt which occurs when the RX or TX queue should be
@@ -81,6 +81,8 @@ void BufferedUART<rx_buffer_size, tx_buffer_size>::setup_irq() volatile {
   // We only enable TXE when after we write to txBuffer
 }
 
+// The interrupt handlers are placed in ITCM by the linker scripts, since GCC ignores section
+// attributes on member functions of class templates
 template <AtomicSize rx_buffer_size, AtomicSize tx_buffer_size>
 void BufferedUART<rx_buffer_size, tx_buffer_size>::handle_irq() volatile {
   handle_irq_rx();
@@ -14,7 +14,9 @@
 #include "DigitalInput.h"
 #include "DigitalOutput.h"
 #include "Endian.h"
+#include "I2CBus.h"
 #include "I2CDevice.h"
+#include "Memory.h"
 #include "PWM.h"
 #include "Random.h"
 #include "SPIDevice.h"
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * I2CBus.h
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#pragma once
+
+#include "Pufferfish/HAL/Interfaces/I2CBus.h"
+#include "Pufferfish/HAL/Interfaces/Time.h"
+#include "stm32h7xx_hal.h"
+
+namespace Pufferfish::HAL::STM32 {
+
+/**
+ * An I2C peripheral of the STM32, with the GPIO pins of its bus
+ */
+class I2CBus : public Interfaces::I2CBus {
+ public:
+  /**
+   * Constructs an I2C bus
+   * @param hi2c  STM32 HAL handler for the I2C port
+   * @param scl_port  GPIO port of the SCL pin
+   * @param scl_pin  GPIO pin of the SCL pin
+   * @param sda_port  GPIO port of the SDA pin
+   * @param sda_pin  GPIO pin of the SDA pin
+   */
+  I2CBus(
+      I2C_HandleTypeDef &hi2c,
+      GPIO_TypeDef &scl_port,
+      uint16_t scl_pin,
+      GPIO_TypeDef &sda_port,
+      uint16_t sda_pin,
+      Interfaces::Time &time)
+      : hi2c_(hi2c),
+        scl_port_(scl_port),
+        scl_pin(scl_pin),
+        sda_port_(sda_port),
+        sda_pin(sda_pin),
+        time_(time) {}
+
+  /**
+   * Clocks out any device which is holding SDA low, sends a STOP condition, and
+   * re-initializes the peripheral; this busy-waits for up to 23 half clock periods
+   * (about 120 us), plus the time to re-initialize the peripheral
+   */
+  I2CDeviceStatus recover() override;
+
+ private:
+  // at most 9 clocks are needed to finish a byte and its acknowledgement
+  static const size_t max_recovery_clocks = 9;
+  static const uint32_t half_clock_period = 5;  // us, for a 100 kHz clock
+
+  I2C_HandleTypeDef &hi2c_;
+  GPIO_TypeDef &scl_port_;
+  const uint16_t scl_pin;
+  GPIO_TypeDef &sda_port_;
+  const uint16_t sda_pin;
+  Interfaces::Time &time_;
+
+  void write_scl(bool high);
+  void write_sda(bool high);
+  [[nodiscard]] bool sda_high() const;
+};
+
+}  // namespace Pufferfish::HAL::STM32
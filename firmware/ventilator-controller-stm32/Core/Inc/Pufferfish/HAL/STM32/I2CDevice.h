@@ -41,6 +41,12 @@ class I2CDevice : public Interfaces::I2CDevice {
  private:
   I2C_HandleTypeDef &dev_;
   const uint16_t addr;
+
+  /**
+   * Distinguishes NACKs, timeouts and a busy bus from other HAL errors
+   * @param error the status to return for other errors
+   */
+  I2CDeviceStatus to_status(HAL_StatusTypeDef stat, I2CDeviceStatus error);
 };
 
 }  // namespace STM32
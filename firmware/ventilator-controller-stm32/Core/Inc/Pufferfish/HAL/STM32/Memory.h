@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Memory.h
+ *
+ *  Memory protection and cache configuration, and the stack's memory region
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Pufferfish::HAL::STM32 {
+
+/**
+ * Configures the MPU so that D2 SRAM (where DMA buffers are placed) is not cacheable,
+ * and then enables the instruction cache. Must be called before any peripheral starts
+ * DMA transfers, and before HAL_Init, so that the cache is already enabled while the
+ * peripherals are being initialized.
+ */
+void configure_memory();
+
+/**
+ * Returns the lowest word of the main stack, which is the first word of RAM_D1 after the
+ * statically-allocated data and the heap reserved by the linker script.
+ * The heap may still grow past its reservation into the stack, since _sbrk only checks
+ * against the stack pointer.
+ */
+uint32_t *stack_bottom();
+
+/// Returns the word past the highest word of the main stack, where the stack pointer starts
+uint32_t *stack_top();
+
+}  // namespace Pufferfish::HAL::STM32
@@ -14,6 +14,7 @@
 
 #include "Pufferfish/Util/Containers/EnumSet.h"
 #include "Pufferfish/Util/Containers/Vector.h"
+#include "Pufferfish/Util/ObjectPool.h"
 #include "States.h"
 
 namespace Pufferfish::Protocols::Application {
@@ -87,11 +88,14 @@ class StateChangeEventSender : public StateSender<StateSegment> {
   using Store = Util::Containers::EnumMap<Index, StateSegment, allowed_indices_capacity>;
   // trackable_states_ is a subset of index_sequence, so it only needs sched_size capacity
   using TrackableStates = Util::Containers::Vector<Index, sched_size>;
+  // output borrows the new state it compares from this pool, rather than placing it on the stack
+  using StatePool = Util::ObjectPool<StateSegment, 1>;
 
   IndexedSender &all_states_;
   NotificationSender notification_sender_;
   TrackableStates trackable_states_;
   Store prev_states_;
+  StatePool new_states_;
 };
 
 }  // namespace Pufferfish::Protocols::Application
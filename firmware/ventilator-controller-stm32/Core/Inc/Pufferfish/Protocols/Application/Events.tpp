@@ -100,8 +100,14 @@ template <typename Index, typename StateSegment, size_t sched_size, size_t allow
 StateOutputStatus
 StateChangeEventSender<Index, StateSegment, sched_size, allowed_indices_capacity>::output(
     StateSegment &output) {
+  typename StatePool::Handle new_state_handle;
+  if (new_states_.acquire(new_state_handle) != IndexStatus::ok) {
+    // output was re-entered, so the new state can't be borrowed
+    return StateOutputStatus::none;
+  }
+
+  StateSegment &new_state = *new_state_handle;
   for (Index index : trackable_states_) {
-    StateSegment new_state{};
     StateOutputStatus status = all_states_.output(index, new_state);
     if (status == StateOutputStatus::invalid_type) {
       return status;
@@ -111,14 +117,10 @@ StateChangeEventSender<Index, StateSegment, sched_size, allowed_indices_capacity
       if (!prev_states_.has(index)) {
         notification_sender_.input(index);
         prev_states_.input(index, new_state);
-      } else {
-        StateSegment prev_state{};
-        // prev_states_ has index, so output will return IndexStatus::ok
-        prev_states_.output(index, prev_state);
-        if (new_state != prev_state) {
-          notification_sender_.input(index);
-          prev_states_.input(index, new_state);
-        }
+      } else if (new_state != prev_states_[index]) {
+        // prev_states_ has index, so it's compared in place instead of being copied out first
+        notification_sender_.input(index);
+        prev_states_[index] = new_state;
       }
     }
   }
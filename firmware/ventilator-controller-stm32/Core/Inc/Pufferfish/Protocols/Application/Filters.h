@@ -0,0 +1,115 @@
+/*
+ * Filters.h
+ *
+ *  Linear filters for high-rate sensor signals
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pufferfish::Protocols::Application {
+
+// Coefficients of a second-order IIR section, normalized so that a0 = 1:
+// y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+struct BiquadCoefficients {
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+};
+
+// Filter design functions, which are meant to be evaluated at compile time (e.g. to initialize a
+// static constexpr member) so that no trigonometry is computed at runtime. Frequencies are in Hz
+// and must be below half of the sample rate.
+namespace FilterDesign {
+
+// The quality factor of a second-order Butterworth filter, which has a maximally-flat passband
+static constexpr float butterworth_quality = 0.70710678;
+
+// Biquad designs, from the Audio EQ Cookbook by Robert Bristow-Johnson
+constexpr BiquadCoefficients low_pass(
+    float cutoff, float sample_rate, float quality = butterworth_quality);
+constexpr BiquadCoefficients high_pass(
+    float cutoff, float sample_rate, float quality = butterworth_quality);
+// quality sets the width of the notch; higher values give narrower notches
+constexpr BiquadCoefficients notch(float center, float sample_rate, float quality);
+
+// A windowed-sinc low-pass FIR filter with a Hamming window and unity DC gain
+template <size_t num_taps>
+constexpr std::array<float, num_taps> low_pass_taps(float cutoff, float sample_rate);
+// A moving average over num_taps samples
+template <size_t num_taps>
+constexpr std::array<float, num_taps> moving_average_taps();
+
+}  // namespace FilterDesign
+
+// A cascade of second-order IIR sections, each in transposed direct form II, which processes
+// samples one at a time or in blocks
+template <size_t num_sections>
+class BiquadCascade {
+ public:
+  using Coefficients = std::array<BiquadCoefficients, num_sections>;
+
+  explicit constexpr BiquadCascade(const Coefficients &coefficients)
+      : coefficients_(coefficients) {}
+
+  // Clears the filter's history, as if every previous input were 0
+  void reset();
+  // Sets the filter's history to its steady state for a constant input of value, so that a
+  // filter which is started on a signal doesn't produce a transient from 0
+  void reset(float value);
+
+  float transform(float input);
+  // Filters a block of consecutive samples; output may be the same array as input
+  template <size_t block_size>
+  void transform(
+      const std::array<float, block_size> &input, std::array<float, block_size> &output);
+
+ private:
+  struct State {
+    float s1;
+    float s2;
+  };
+
+  const Coefficients coefficients_;
+  std::array<State, num_sections> states_{};
+};
+
+// A FIR filter, which processes samples one at a time or in blocks
+template <size_t num_taps>
+class FIRFilter {
+ public:
+  static_assert(num_taps > 0, "FIRFilter must have at least one tap");
+
+  using Taps = std::array<float, num_taps>;
+
+  // taps[0] is applied to the newest sample
+  explicit constexpr FIRFilter(const Taps &taps);
+
+  // Clears the filter's history, as if every previous input were 0
+  void reset();
+  // Fills the filter's history with value
+  void reset(float value);
+
+  float transform(float input);
+  // Filters a block of consecutive samples; output may be the same array as input
+  template <size_t block_size>
+  void transform(
+      const std::array<float, block_size> &input, std::array<float, block_size> &output);
+
+ private:
+  // Taps in order from the oldest sample to the newest
+  Taps reversed_taps_{};
+  // Every sample is written twice, num_taps apart, so that the most recent num_taps samples are
+  // always contiguous, starting at next_
+  std::array<float, 2 * num_taps> history_{};
+  size_t next_ = 0;
+};
+
+}  // namespace Pufferfish::Protocols::Application
+
+#include "Filters.tpp"
@@ -0,0 +1,219 @@
+/*
+ * Filters.tpp
+ *
+ *  Linear filters for high-rate sensor signals
+ */
+
+#pragma once
+
+#include "Filters.h"
+
+namespace Pufferfish::Protocols::Application {
+
+namespace FilterDesign {
+
+namespace Detail {
+
+static constexpr double pi = 3.14159265358979323846;
+
+// std::sin isn't constexpr, so designs use a Taylor series instead, which is accurate to double
+// precision after the argument is reduced to [-pi, pi]
+constexpr double sine(double x) {
+  const double turns = x / (2 * pi);
+  const auto whole_turns = static_cast<int64_t>(turns >= 0 ? turns + 0.5 : turns - 0.5);
+  x -= 2 * pi * static_cast<double>(whole_turns);
+
+  constexpr int num_terms = 14;
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < num_terms; ++n) {
+    term *= -x * x / ((2.0 * n) * (2.0 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double cosine(double x) {
+  return sine(x + pi / 2);
+}
+
+// Shared denominator of the cookbook biquad designs
+struct Prototype {
+  double cos_w0;
+  double alpha;
+};
+
+constexpr Prototype prototype(float frequency, float sample_rate, float quality) {
+  const double w0 = 2 * pi * frequency / sample_rate;
+  return Prototype{cosine(w0), sine(w0) / (2.0 * quality)};
+}
+
+constexpr BiquadCoefficients normalize(
+    double b0, double b1, double b2, double a0, double a1, double a2) {
+  return BiquadCoefficients{
+      static_cast<float>(b0 / a0),
+      static_cast<float>(b1 / a0),
+      static_cast<float>(b2 / a0),
+      static_cast<float>(a1 / a0),
+      static_cast<float>(a2 / a0)};
+}
+
+}  // namespace Detail
+
+constexpr BiquadCoefficients low_pass(float cutoff, float sample_rate, float quality) {
+  const Detail::Prototype p = Detail::prototype(cutoff, sample_rate, quality);
+  const double b1 = 1 - p.cos_w0;
+  return Detail::normalize(b1 / 2, b1, b1 / 2, 1 + p.alpha, -2 * p.cos_w0, 1 - p.alpha);
+}
+
+constexpr BiquadCoefficients high_pass(float cutoff, float sample_rate, float quality) {
+  const Detail::Prototype p = Detail::prototype(cutoff, sample_rate, quality);
+  const double b1 = -(1 + p.cos_w0);
+  return Detail::normalize(-b1 / 2, b1, -b1 / 2, 1 + p.alpha, -2 * p.cos_w0, 1 - p.alpha);
+}
+
+constexpr BiquadCoefficients notch(float center, float sample_rate, float quality) {
+  const Detail::Prototype p = Detail::prototype(center, sample_rate, quality);
+  return Detail::normalize(1, -2 * p.cos_w0, 1, 1 + p.alpha, -2 * p.cos_w0, 1 - p.alpha);
+}
+
+template <size_t num_taps>
+constexpr std::array<float, num_taps> low_pass_taps(float cutoff, float sample_rate) {
+  const double normalized_cutoff = 2.0 * cutoff / sample_rate;  // relative to Nyquist
+  const double middle = static_cast<double>(num_taps - 1) / 2;
+  std::array<double, num_taps> taps{};
+  double sum = 0;
+  for (size_t i = 0; i < num_taps; ++i) {
+    const double offset = static_cast<double>(i) - middle;
+    double sinc = normalized_cutoff;
+    if (offset != 0) {
+      sinc = Detail::sine(Detail::pi * normalized_cutoff * offset) / (Detail::pi * offset);
+    }
+    double window = 1;
+    if (num_taps > 1) {
+      constexpr double hamming_a0 = 0.54;
+      constexpr double hamming_a1 = 0.46;
+      const double phase =
+          2 * Detail::pi * static_cast<double>(i) / static_cast<double>(num_taps - 1);
+      window = hamming_a0 - hamming_a1 * Detail::cosine(phase);
+    }
+    taps[i] = sinc * window;
+    sum += taps[i];
+  }
+
+  std::array<float, num_taps> result{};
+  for (size_t i = 0; i < num_taps; ++i) {
+    result[i] = static_cast<float>(taps[i] / sum);
+  }
+  return result;
+}
+
+template <size_t num_taps>
+constexpr std::array<float, num_taps> moving_average_taps() {
+  std::array<float, num_taps> result{};
+  for (float &tap : result) {
+    tap = 1.0F / num_taps;
+  }
+  return result;
+}
+
+}  // namespace FilterDesign
+
+// BiquadCascade
+
+template <size_t num_sections>
+void BiquadCascade<num_sections>::reset() {
+  states_ = {};
+}
+
+template <size_t num_sections>
+void BiquadCascade<num_sections>::reset(float value) {
+  float input = value;
+  for (size_t i = 0; i < num_sections; ++i) {
+    const BiquadCoefficients &c = coefficients_[i];
+    // Every section passes a constant input through with its DC gain
+    const float output = input * (c.b0 + c.b1 + c.b2) / (1 + c.a1 + c.a2);
+    states_[i].s2 = c.b2 * input - c.a2 * output;
+    states_[i].s1 = c.b1 * input - c.a1 * output + states_[i].s2;
+    input = output;
+  }
+}
+
+template <size_t num_sections>
+float BiquadCascade<num_sections>::transform(float input) {
+  float value = input;
+  for (size_t i = 0; i < num_sections; ++i) {
+    const BiquadCoefficients &c = coefficients_[i];
+    State &state = states_[i];
+    const float output = c.b0 * value + state.s1;
+    state.s1 = c.b1 * value - c.a1 * output + state.s2;
+    state.s2 = c.b2 * value - c.a2 * output;
+    value = output;
+  }
+  return value;
+}
+
+template <size_t num_sections>
+template <size_t block_size>
+void BiquadCascade<num_sections>::transform(
+    const std::array<float, block_size> &input, std::array<float, block_size> &output) {
+  // Each section is applied to the whole block in turn, so that its coefficients and state stay
+  // in registers throughout the inner loop
+  for (size_t i = 0; i < num_sections; ++i) {
+    const BiquadCoefficients c = coefficients_[i];
+    State state = states_[i];
+    const std::array<float, block_size> &source = (i == 0) ? input : output;
+    for (size_t j = 0; j < block_size; ++j) {
+      const float value = source[j];
+      const float result = c.b0 * value + state.s1;
+      state.s1 = c.b1 * value - c.a1 * result + state.s2;
+      state.s2 = c.b2 * value - c.a2 * result;
+      output[j] = result;
+    }
+    states_[i] = state;
+  }
+}
+
+// FIRFilter
+
+template <size_t num_taps>
+constexpr FIRFilter<num_taps>::FIRFilter(const Taps &taps) {
+  for (size_t i = 0; i < num_taps; ++i) {
+    reversed_taps_[i] = taps[num_taps - 1 - i];
+  }
+}
+
+template <size_t num_taps>
+void FIRFilter<num_taps>::reset() {
+  reset(0);
+}
+
+template <size_t num_taps>
+void FIRFilter<num_taps>::reset(float value) {
+  history_.fill(value);
+  next_ = 0;
+}
+
+template <size_t num_taps>
+float FIRFilter<num_taps>::transform(float input) {
+  history_[next_] = input;
+  history_[next_ + num_taps] = input;
+  next_ = (next_ + 1 == num_taps) ? 0 : next_ + 1;
+
+  float result = 0;
+  for (size_t i = 0; i < num_taps; ++i) {
+    result += reversed_taps_[i] * history_[next_ + i];
+  }
+  return result;
+}
+
+template <size_t num_taps>
+template <size_t block_size>
+void FIRFilter<num_taps>::transform(
+    const std::array<float, block_size> &input, std::array<float, block_size> &output) {
+  for (size_t i = 0; i < block_size; ++i) {
+    output[i] = transform(input[i]);
+  }
+}
+
+}  // namespace Pufferfish::Protocols::Application
@@ -6,28 +6,40 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
+#include "Pufferfish/Util/Numeric.h"
 #include "Pufferfish/Util/Timeouts.h"
 
 namespace Pufferfish::Protocols::Application {
 
 static constexpr float float_nan = std::numeric_limits<float>::quiet_NaN();
 
+// The filters below can be instantiated with float or with a fixed-point type such as Util::Q31
+// for Number; see Util/Numeric.h. NaN inputs are handled the same way for every Number type.
+
 // Basic implementation of an exponentially-weighted moving average
 // Note: this does not account for the time interval of sampling, so the responsiveness
 // parameter will need to be re-adjusted upon any changes to the time interval of calls to
 // the EWMA filter!
+template <typename Number = float>
 class EWMA {
  public:
-  explicit EWMA(float responsiveness) : responsiveness(responsiveness) {}
+  explicit EWMA(float responsiveness)
+      : responsiveness(Numeric::from_float(responsiveness)),
+        complement(Numeric::from_float(1 - responsiveness)) {}
 
-  void transform(float raw, float &filtered);
+  void transform(Number raw, Number &filtered);
 
  private:
-  const float responsiveness;
-  float average_ = float_nan;
+  using Numeric = Util::Numeric<Number>;
+
+  const Number responsiveness;
+  const Number complement;
+  Number average_ = Numeric::nan();
 };
 
 // A custom signal filter which tracks when the input has converged on a value
@@ -44,6 +56,7 @@ class EWMA {
 // If the input has converged but is actually slowly drifting in a single direction,
 // then the output will change occasionally, whenever the input drifts far enough away from
 // the last convergence estimate. Then its new value will become the new convergence estimate.
+template <typename Number = float>
 class ConvergenceSmoother {
  public:
   ConvergenceSmoother(
@@ -58,37 +71,48 @@ class ConvergenceSmoother {
       float change_min_magnitude,
       uint32_t convergence_min_duration,
       uint32_t change_min_duration)
-      : change_min_magnitude(change_min_magnitude),
+      : change_min_magnitude(Numeric::from_float(change_min_magnitude)),
         convergence_timer_(convergence_min_duration),
         change_timer_(change_min_duration) {}
 
-  void transform(uint32_t current_time, float raw, float &filtered);
+  void transform(uint32_t current_time, Number raw, Number &filtered);
 
  private:
-  const float change_min_magnitude;
+  using Numeric = Util::Numeric<Number>;
+
+  const Number change_min_magnitude;
 
   bool started_converging_ = false;
   Util::MsTimer convergence_timer_;
   bool started_changing_ = false;
   Util::MsTimer change_timer_;
-  float converged_ = float_nan;
-  float filtered_ = float_nan;
+  Number converged_ = Numeric::nan();
+  Number filtered_ = Numeric::nan();
 
-  float prev_raw_ = float_nan;
+  Number prev_raw_ = Numeric::nan();
   uint32_t prev_time_ = 0;  // ms
 };
 
+enum class DisplaySmootherStatus { ok = 0, waiting };
+
+// Values are passed in and out of a DisplaySmoother as floats. If it uses a fixed-point type,
+// they're divided by full_scale before they're filtered, so full_scale must be larger than the
+// magnitude of any value to be filtered; larger values saturate. full_scale has no effect for
+// floats.
+struct SmoothingParameters {
+  float ewma_responsiveness;
+  float change_min_magnitude;
+  uint32_t convergence_min_duration;
+  uint32_t change_min_duration;
+  float full_scale = 1;
+};
+
 // A class to combine EWMA with ConvergenceSmoother, to smooth & stabilize
 // noisy values for user display and alarm condition detection
+template <typename Number = float>
 class DisplaySmoother {
  public:
-  enum class Status { ok = 0, waiting };
-  struct SmoothingParameters {
-    float ewma_responsiveness;
-    float change_min_magnitude;
-    uint32_t convergence_min_duration;
-    uint32_t change_min_duration;
-  };
+  using Status = DisplaySmootherStatus;
 
   // Cppcheck has a false positive where it thinks ewma_ and convergence_ aren't being initialized
   // by the constructor - but they clearly are here:
@@ -98,9 +122,14 @@ class DisplaySmoother {
       float ewma_responsiveness,
       float change_min_magnitude,
       uint32_t convergence_min_duration,
-      uint32_t change_min_duration)
-      : ewma_{ewma_responsiveness},
-        convergence_{change_min_magnitude, convergence_min_duration, change_min_duration},
+      uint32_t change_min_duration,
+      float full_scale = 1)
+      : full_scale_(full_scale),
+        ewma_{ewma_responsiveness},
+        convergence_{
+            scale_magnitude(change_min_magnitude, full_scale),
+            convergence_min_duration,
+            change_min_duration},
         sampling_timer_{sampling_interval, 0} {}
   DisplaySmoother(uint32_t sampling_interval, SmoothingParameters params)
       : DisplaySmoother(
@@ -108,14 +137,77 @@ class DisplaySmoother {
             params.ewma_responsiveness,
             params.change_min_magnitude,
             params.convergence_min_duration,
-            params.change_min_duration) {}
+            params.change_min_duration,
+            params.full_scale) {}
 
   Status transform(uint32_t current_time, float raw, float &filtered);
 
  private:
-  EWMA ewma_;
-  ConvergenceSmoother convergence_;
+  using Numeric = Util::Numeric<Number>;
+
+  const float full_scale_;
+  EWMA<Number> ewma_;
+  ConvergenceSmoother<Number> convergence_;
+  Util::MsTimer sampling_timer_;
+
+  static constexpr float scale_magnitude(float magnitude, float full_scale) {
+    return Numeric::is_fixed_point ? magnitude / full_scale : magnitude;
+  }
+  [[nodiscard]] Number to_number(float value) const;
+  [[nodiscard]] float to_float(Number value) const;
+};
+
+// A bank of DisplaySmoothers which share a sampling interval, with separate parameters for each
+// channel, updated together in one pass. Its output is identical to that of a separate
+// DisplaySmoother per channel.
+// The state of each stage is stored as a structure of arrays, with one element per channel, and
+// each stage is applied to every channel in its own loop, so that the compiler can interleave
+// the independent per-channel computations (for dual-issue on the Cortex-M7) or vectorize them
+// (e.g. with SSE on the host).
+template <typename Number, size_t num_channels>
+class MultiChannelDisplaySmoother {
+ public:
+  using Status = DisplaySmootherStatus;
+  using Values = std::array<float, num_channels>;
+  using Parameters = std::array<SmoothingParameters, num_channels>;
+
+  MultiChannelDisplaySmoother(uint32_t sampling_interval, const Parameters &params);
+
+  // Updates every element of filtered and returns ok once per sampling interval; otherwise,
+  // leaves filtered unchanged and returns waiting
+  Status transform(uint32_t current_time, const Values &raw, Values &filtered);
+
+ private:
+  using Numeric = Util::Numeric<Number>;
+  using Numbers = std::array<Number, num_channels>;
+  using Times = std::array<uint32_t, num_channels>;
+  using Flags = std::array<bool, num_channels>;
+
   Util::MsTimer sampling_timer_;
+  Values full_scale_{};
+
+  // EWMA
+  Numbers responsiveness_{};
+  Numbers complement_{};
+  Numbers average_{};
+
+  // ConvergenceSmoother
+  Numbers change_min_magnitude_{};
+  Times convergence_min_duration_{};
+  Times change_min_duration_{};
+  Flags started_converging_{};
+  Times convergence_start_{};
+  Flags started_changing_{};
+  Times change_start_{};
+  Numbers converged_{};
+  Numbers filtered_{};
+  Numbers prev_raw_{};
+  Times prev_time_{};  // ms
+
+  void transform_ewma(const Numbers &raw, Numbers &filtered);
+  void transform_convergence(uint32_t current_time, const Numbers &raw);
 };
 
 }  // namespace Pufferfish::Protocols::Application
+
+#include "SignalSmoothing.tpp"
@@ -0,0 +1,239 @@
+/*
+ * SignalSmoothing.tpp
+ *
+ *  Created on: June 6, 2020
+ *      Author: Ethan Li
+ */
+
+#pragma once
+
+#include "SignalSmoothing.h"
+
+namespace Pufferfish::Protocols::Application {
+
+// EWMA
+
+template <typename Number>
+void EWMA<Number>::transform(Number raw, Number &filtered) {
+  if (Numeric::is_nan(raw)) {
+    average_ = Numeric::nan();
+    filtered = average_;
+    return;
+  }
+
+  if (Numeric::is_nan(average_)) {
+    average_ = raw;
+  }
+  average_ = responsiveness * raw + complement * average_;
+  filtered = average_;
+}
+
+// ConvergenceSmoother
+
+template <typename Number>
+void ConvergenceSmoother<Number>::transform(
+    uint32_t current_time, Number raw, Number &filtered) {
+  if (Numeric::is_nan(prev_raw_)) {  // Smoother was reset
+    started_changing_ = false;
+    started_converging_ = false;
+    converged_ = Numeric::nan();
+    filtered_ = Numeric::nan();
+    prev_time_ = current_time;
+  }
+  // Differences with NaN aren't NaN for fixed-point types, so they're only compared if both of
+  // their operands are valid
+  const bool raw_valid = !Numeric::is_nan(raw);
+  const Number change_magnitude = Numeric::abs(raw - prev_raw_);
+  const bool possibly_converging = raw_valid && Numeric::is_nan(converged_) &&
+                                   !Numeric::is_nan(prev_raw_) &&
+                                   change_magnitude < change_min_magnitude;
+  const Number residual = Numeric::abs(raw - converged_);
+  const bool possibly_converged =
+      raw_valid && !Numeric::is_nan(converged_) && residual < change_min_magnitude;
+  if (possibly_converging || possibly_converged) {
+    // Value may be converging or is already converged
+    started_changing_ = false;  // stop the "changing" timer
+    if (!started_converging_) {
+      // Need to initialize the "converging" timer
+      convergence_timer_.reset(current_time);
+      started_converging_ = true;
+    }
+    const bool converged = !convergence_timer_.within_timeout(current_time);
+    const bool prev_converged = !convergence_timer_.within_timeout(prev_time_);
+    if (converged && !prev_converged) {
+      // Value has just converged
+      converged_ = raw;
+      filtered_ = converged_;
+    }
+  } else {
+    // Value may be starting a transition to a different level
+    started_converging_ = false;  // stop the "converging" timer
+    if (!started_changing_) {
+      // Need to initialize the "changing" timer
+      change_timer_.reset(current_time);
+      started_changing_ = true;
+    }
+    if (!change_timer_.within_timeout(current_time)) {
+      // Value is transitioning to a different level
+      filtered_ = raw;
+      converged_ = Numeric::nan();
+    }
+  }
+  filtered = filtered_;
+  prev_raw_ = raw;
+  prev_time_ = current_time;
+}
+
+// DisplaySmoother
+
+template <typename Number>
+typename DisplaySmoother<Number>::Status DisplaySmoother<Number>::transform(
+    uint32_t current_time, float raw, float &filtered) {
+  if (sampling_timer_.within_timeout(current_time)) {
+    return Status::waiting;
+  }
+
+  sampling_timer_.reset(current_time);
+  Number ewma_result = Numeric::nan();
+  ewma_.transform(to_number(raw), ewma_result);
+  Number result = Numeric::nan();
+  convergence_.transform(current_time, ewma_result, result);
+  filtered = to_float(result);
+  return Status::ok;
+}
+
+template <typename Number>
+Number DisplaySmoother<Number>::to_number(float value) const {
+  if constexpr (Numeric::is_fixed_point) {
+    return Numeric::from_float(value / full_scale_);
+  }
+  return Numeric::from_float(value);
+}
+
+template <typename Number>
+float DisplaySmoother<Number>::to_float(Number value) const {
+  if constexpr (Numeric::is_fixed_point) {
+    return Numeric::to_float(value) * full_scale_;
+  }
+  return Numeric::to_float(value);
+}
+
+// MultiChannelDisplaySmoother
+
+template <typename Number, size_t num_channels>
+MultiChannelDisplaySmoother<Number, num_channels>::MultiChannelDisplaySmoother(
+    uint32_t sampling_interval, const Parameters &params)
+    : sampling_timer_{sampling_interval, 0} {
+  for (size_t i = 0; i < num_channels; ++i) {
+    const SmoothingParameters &channel = params[i];
+    float change_min_magnitude = channel.change_min_magnitude;
+    if constexpr (Numeric::is_fixed_point) {
+      change_min_magnitude /= channel.full_scale;
+    }
+    full_scale_[i] = channel.full_scale;
+    responsiveness_[i] = Numeric::from_float(channel.ewma_responsiveness);
+    complement_[i] = Numeric::from_float(1 - channel.ewma_responsiveness);
+    average_[i] = Numeric::nan();
+    change_min_magnitude_[i] = Numeric::from_float(change_min_magnitude);
+    convergence_min_duration_[i] = channel.convergence_min_duration;
+    change_min_duration_[i] = channel.change_min_duration;
+    converged_[i] = Numeric::nan();
+    filtered_[i] = Numeric::nan();
+    prev_raw_[i] = Numeric::nan();
+  }
+}
+
+template <typename Number, size_t num_channels>
+typename MultiChannelDisplaySmoother<Number, num_channels>::Status
+MultiChannelDisplaySmoother<Number, num_channels>::transform(
+    uint32_t current_time, const Values &raw, Values &filtered) {
+  if (sampling_timer_.within_timeout(current_time)) {
+    return Status::waiting;
+  }
+
+  sampling_timer_.reset(current_time);
+  Numbers scaled{};
+  for (size_t i = 0; i < num_channels; ++i) {
+    if constexpr (Numeric::is_fixed_point) {
+      scaled[i] = Numeric::from_float(raw[i] / full_scale_[i]);
+    } else {
+      scaled[i] = Numeric::from_float(raw[i]);
+    }
+  }
+  Numbers ewma_result{};
+  transform_ewma(scaled, ewma_result);
+  transform_convergence(current_time, ewma_result);
+  for (size_t i = 0; i < num_channels; ++i) {
+    if constexpr (Numeric::is_fixed_point) {
+      filtered[i] = Numeric::to_float(filtered_[i]) * full_scale_[i];
+    } else {
+      filtered[i] = Numeric::to_float(filtered_[i]);
+    }
+  }
+  return Status::ok;
+}
+
+template <typename Number, size_t num_channels>
+void MultiChannelDisplaySmoother<Number, num_channels>::transform_ewma(
+    const Numbers &raw, Numbers &filtered) {
+  // Equivalent to EWMA::transform, with its branches written as selects so that the loop has no
+  // control flow
+  for (size_t i = 0; i < num_channels; ++i) {
+    const Number previous = Numeric::is_nan(average_[i]) ? raw[i] : average_[i];
+    const Number average = responsiveness_[i] * raw[i] + complement_[i] * previous;
+    average_[i] = Numeric::is_nan(raw[i]) ? Numeric::nan() : average;
+    filtered[i] = average_[i];
+  }
+}
+
+template <typename Number, size_t num_channels>
+void MultiChannelDisplaySmoother<Number, num_channels>::transform_convergence(
+    uint32_t current_time, const Numbers &raw) {
+  // Equivalent to ConvergenceSmoother::transform
+  for (size_t i = 0; i < num_channels; ++i) {
+    if (Numeric::is_nan(prev_raw_[i])) {  // Smoother was reset
+      started_changing_[i] = false;
+      started_converging_[i] = false;
+      converged_[i] = Numeric::nan();
+      filtered_[i] = Numeric::nan();
+      prev_time_[i] = current_time;
+    }
+    const bool raw_valid = !Numeric::is_nan(raw[i]);
+    const Number change_magnitude = Numeric::abs(raw[i] - prev_raw_[i]);
+    const bool possibly_converging = raw_valid && Numeric::is_nan(converged_[i]) &&
+                                     !Numeric::is_nan(prev_raw_[i]) &&
+                                     change_magnitude < change_min_magnitude_[i];
+    const Number residual = Numeric::abs(raw[i] - converged_[i]);
+    const bool possibly_converged =
+        raw_valid && !Numeric::is_nan(converged_[i]) && residual < change_min_magnitude_[i];
+    if (possibly_converging || possibly_converged) {
+      started_changing_[i] = false;
+      if (!started_converging_[i]) {
+        convergence_start_[i] = current_time;
+        started_converging_[i] = true;
+      }
+      const bool converged = !Util::within_timeout(
+          convergence_start_[i], convergence_min_duration_[i], current_time);
+      const bool prev_converged = !Util::within_timeout(
+          convergence_start_[i], convergence_min_duration_[i], prev_time_[i]);
+      if (converged && !prev_converged) {
+        converged_[i] = raw[i];
+        filtered_[i] = converged_[i];
+      }
+    } else {
+      started_converging_[i] = false;
+      if (!started_changing_[i]) {
+        change_start_[i] = current_time;
+        started_changing_[i] = true;
+      }
+      if (!Util::within_timeout(change_start_[i], change_min_duration_[i], current_time)) {
+        filtered_[i] = raw[i];
+        converged_[i] = Numeric::nan();
+      }
+    }
+    prev_raw_[i] = raw[i];
+    prev_time_[i] = current_time;
+  }
+}
+
+}  // namespace Pufferfish::Protocols::Application
@@ -0,0 +1,73 @@
+/// Subscriptions.h
+/// Change notifications for indexed states, so that consumers of the states
+/// only need to run when the states they depend on have changed
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish::Protocols::Application {
+
+// Tracks a version number for each state, which is incremented whenever the state
+// is changed. Versions are only ever compared for equality, so wraparound is harmless.
+template <typename Index, size_t capacity>
+class StateVersions {
+ public:
+  using Version = uint32_t;
+
+  IndexStatus notify(Index index);
+  [[nodiscard]] Version version(Index index) const;
+
+ private:
+  std::array<Version, capacity> versions_{};
+};
+
+// Checks whether any of a fixed set of states has changed. A subscription only
+// stores the versions it last saw, so checking it costs a few integer comparisons,
+// and it never allocates.
+template <typename Index, size_t capacity, size_t num_dependencies>
+class StateSubscription {
+ public:
+  using Versions = StateVersions<Index, capacity>;
+  using Dependencies = std::array<Index, num_dependencies>;
+
+  StateSubscription(const Versions &versions, const Dependencies &dependencies)
+      : versions_(versions), dependencies_(dependencies) {}
+
+  // Returns true if any dependency has changed since the last time changed() returned true,
+  // and on the first call; the changes are then considered to have been handled.
+  bool changed();
+
+ private:
+  using Version = typename Versions::Version;
+
+  const Versions &versions_;
+  const Dependencies dependencies_;
+  std::array<Version, num_dependencies> seen_versions_{};
+  bool initialized_ = false;
+};
+
+}  // namespace Pufferfish::Protocols::Application
+
+#include "Subscriptions.tpp"
@@ -0,0 +1,68 @@
+/// Subscriptions.tpp
+/// Change notifications for indexed states, so that consumers of the states
+/// only need to run when the states they depend on have changed
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Subscriptions.h"
+
+namespace Pufferfish::Protocols::Application {
+
+// StateVersions
+
+template <typename Index, size_t capacity>
+IndexStatus StateVersions<Index, capacity>::notify(Index index) {
+  auto position = static_cast<size_t>(index);
+  if (position >= capacity) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  ++versions_[position];
+  return IndexStatus::ok;
+}
+
+template <typename Index, size_t capacity>
+typename StateVersions<Index, capacity>::Version StateVersions<Index, capacity>::version(
+    Index index) const {
+  auto position = static_cast<size_t>(index);
+  if (position >= capacity) {
+    return 0;
+  }
+
+  return versions_[position];
+}
+
+// StateSubscription
+
+template <typename Index, size_t capacity, size_t num_dependencies>
+bool StateSubscription<Index, capacity, num_dependencies>::changed() {
+  bool changed = !initialized_;
+  initialized_ = true;
+  for (size_t i = 0; i < num_dependencies; ++i) {
+    Version version = versions_.version(dependencies_[i]);
+    if (version != seen_versions_[i]) {
+      seen_versions_[i] = version;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+}  // namespace Pufferfish::Protocols::Application
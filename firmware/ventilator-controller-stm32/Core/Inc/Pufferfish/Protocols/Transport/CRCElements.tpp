@@ -38,7 +38,7 @@ template <typename PayloadBuffer>
 template <size_t output_size>
 IndexStatus CRCElement<PayloadBuffer>::write_protected(
     Util::Containers::ByteVector<output_size> &output_buffer) const {
-  if (output_buffer.resize(CRCElementHeaderProps::header_size + payload_.size()) !=
+  if (output_buffer.resize_uninitialized(CRCElementHeaderProps::header_size + payload_.size()) !=
       IndexStatus::ok) {
     return IndexStatus::out_of_bounds;
   }
@@ -24,7 +24,8 @@ IndexStatus Datagram<PayloadBuffer>::write(
       Util::Containers::ByteVector<output_size>::max_size() >=
           (PayloadBuffer::max_size() + DatagramHeaderProps::header_size),
       "Write method unavailable as the size of the output buffer is too small");
-  if (output_buffer.resize(DatagramHeaderProps::header_size + payload_.size()) != IndexStatus::ok) {
+  if (output_buffer.resize_uninitialized(DatagramHeaderProps::header_size + payload_.size()) !=
+      IndexStatus::ok) {
     return IndexStatus::out_of_bounds;
   }
 
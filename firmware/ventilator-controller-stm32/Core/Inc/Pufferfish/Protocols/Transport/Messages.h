@@ -11,12 +11,19 @@
 
 #include "Pufferfish/Util/Containers/EnumMap.h"
 #include "Pufferfish/Util/Containers/Vector.h"
+#include "Pufferfish/Util/ObjectPool.h"
 #include "Pufferfish/Util/Protobuf.h"
 #include "nanopb/pb_common.h"
 
 namespace Pufferfish::Protocols::Transport {
 
-enum class MessageStatus { ok = 0, invalid_length, invalid_type, invalid_encoding };
+enum class MessageStatus {
+  ok = 0,
+  invalid_length,
+  invalid_type,
+  invalid_encoding,
+  insufficient_scratch
+};
 
 // Messages
 
@@ -86,7 +93,11 @@ class MessageSender {
       const TaggedUnion &payload, Util::Containers::ByteVector<output_size> &output_buffer) const;
 
  private:
+  // transform borrows the message it writes from this pool, rather than placing it on the stack
+  using MessagePool = Util::ObjectPool<Message, 1>;
+
   const ProtobufDescriptors &descriptors_;
+  mutable MessagePool messages_;
 };
 
 }  // namespace Pufferfish::Protocols::Transport
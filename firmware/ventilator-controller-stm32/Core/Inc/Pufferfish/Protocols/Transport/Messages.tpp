@@ -38,7 +38,7 @@ MessageStatus Message<TaggedUnion, MessageTypes, max_size>::write(
     return MessageStatus::invalid_encoding;
   }
 
-  if (output_buffer.resize(header_size + encoded_size) != IndexStatus::ok) {
+  if (output_buffer.resize_uninitialized(header_size + encoded_size) != IndexStatus::ok) {
     return MessageStatus::invalid_length;
   }
 
@@ -104,9 +104,13 @@ template <size_t output_size>
 MessageStatus MessageSender<Message, TaggedUnion, descriptors_capacity>::transform(
     const TaggedUnion &input_payload,
     Util::Containers::ByteVector<output_size> &output_buffer) const {
-  Message input_message;
-  input_message.payload = input_payload;
-  return input_message.write(output_buffer, descriptors_);
+  typename MessagePool::Handle input_message;
+  if (messages_.acquire(input_message) != IndexStatus::ok) {
+    return MessageStatus::insufficient_scratch;
+  }
+
+  input_message->payload = input_payload;
+  return input_message->write(output_buffer, descriptors_);
 }
 
 }  // namespace Pufferfish::Protocols::Transport
@@ -55,7 +55,10 @@ enum class I2CDeviceStatus {
   crc_check_failed,   /// The CRC code received is inconsistent
   invalid_ext_slot,   /// The MUX slot of ExtendedI2CDevice is invalid
   test_failed,        /// unit tests are failing
-  no_new_data         /// no new data is received from the sensor
+  no_new_data,        /// no new data is received from the sensor
+  nack,               /// the I2C device didn't acknowledge its address or data
+  timeout,            /// the I2C transaction didn't finish in time
+  busy                /// the I2C bus or peripheral was busy, e.g. because SDA is held low
 };
 
 /**
@@ -0,0 +1,102 @@
+/// \file
+/// \brief A statically-allocated arena for scoped scratch objects
+///
+/// An arena lends out memory from a fixed buffer in stack order, so that large temporaries
+/// (e.g. the payload buffers of each protocol layer) can be borrowed from a budget which is
+/// sized at compile time, instead of being placed on the stack.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish::Util {
+
+/**
+ * A bump allocator over a fixed-size buffer.
+ *
+ * Memory is only ever freed by a Scope, which returns everything allocated during its lifetime
+ * to the arena when it's destroyed; objects in the arena are never destroyed individually, so
+ * they must be trivially destructible. The arena records the most memory it has ever had in use
+ * at once, so that its capacity can be checked against real usage.
+ *
+ * An arena must only be used from a single context (e.g. only from the main loop), and it must
+ * outlive every Scope and every object created in it.
+ */
+template <size_t capacity>
+class Arena {
+ public:
+  /// Returns all memory allocated from the arena during the Scope's lifetime, upon destruction.
+  /// Scopes must be destroyed in reverse order of construction, which is guaranteed if they are
+  /// only ever created as local variables.
+  class Scope {
+   public:
+    explicit Scope(Arena &arena) : arena_(arena), mark_(arena.used_) {}
+    ~Scope() { arena_.used_ = mark_; }
+
+    Scope(const Scope &) = delete;
+    Scope(Scope &&) = delete;
+    Scope &operator=(const Scope &) = delete;
+    Scope &operator=(Scope &&) = delete;
+
+   private:
+    Arena &arena_;
+    size_t mark_;
+  };
+
+  Arena() = default;
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  [[nodiscard]] size_t used() const;
+  [[nodiscard]] static constexpr size_t max_size() noexcept { return capacity; }
+  [[nodiscard]] size_t available() const;
+  /// The most memory which has been in use at once, including alignment padding
+  [[nodiscard]] size_t high_water_mark() const;
+
+  /**
+   * Allocates uninitialized memory from the arena
+   * @param size the number of bytes to allocate
+   * @param alignment the required alignment of the memory, which must be a power of two
+   * @param[out] memory the allocated memory, if allocation succeeded
+   * @return ok on success, out_of_bounds if the arena doesn't have enough memory available
+   */
+  IndexStatus allocate(size_t size, size_t alignment, void *&memory);
+
+  /**
+   * Creates a value-initialized object in the arena
+   * @param[out] object the created object, if allocation succeeded
+   * @return ok on success, out_of_bounds if the arena doesn't have enough memory available
+   */
+  template <typename Object>
+  IndexStatus create(Object *&object);
+
+ private:
+  alignas(alignof(std::max_align_t)) std::array<uint8_t, capacity> buffer_{};
+  size_t used_ = 0;
+  size_t high_water_mark_ = 0;
+};
+
+}  // namespace Pufferfish::Util
+
+#include "Arena.tpp"
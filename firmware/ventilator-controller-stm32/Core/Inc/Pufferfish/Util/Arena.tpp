@@ -0,0 +1,78 @@
+/// \file
+/// \brief A statically-allocated arena for scoped scratch objects
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <new>
+#include <type_traits>
+
+#include "Arena.h"
+
+namespace Pufferfish::Util {
+
+template <size_t capacity>
+size_t Arena<capacity>::used() const {
+  return used_;
+}
+
+template <size_t capacity>
+size_t Arena<capacity>::available() const {
+  return capacity - used_;
+}
+
+template <size_t capacity>
+size_t Arena<capacity>::high_water_mark() const {
+  return high_water_mark_;
+}
+
+template <size_t capacity>
+IndexStatus Arena<capacity>::allocate(size_t size, size_t alignment, void *&memory) {
+  auto base = reinterpret_cast<uintptr_t>(buffer_.data());
+  uintptr_t start = (base + used_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+  size_t offset = start - base;
+  if (offset > capacity || size > capacity - offset) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  memory = buffer_.data() + offset;
+  used_ = offset + size;
+  if (used_ > high_water_mark_) {
+    high_water_mark_ = used_;
+  }
+  return IndexStatus::ok;
+}
+
+template <size_t capacity>
+template <typename Object>
+IndexStatus Arena<capacity>::create(Object *&object) {
+  static_assert(
+      std::is_trivially_destructible<Object>::value,
+      "Objects in an Arena are never destroyed, so they must be trivially destructible");
+
+  void *memory = nullptr;
+  if (allocate(sizeof(Object), alignof(Object), memory) != IndexStatus::ok) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  object = new (memory) Object{};
+  return IndexStatus::ok;
+}
+
+}  // namespace Pufferfish::Util
@@ -41,7 +41,8 @@ IndexStatus encode_cobs(
   uint8_t code = 1;
 
   // resize to the calculated encoded buffer size
-  if (encoded_buffer.resize(get_encoded_cobs_buffer_size(buffer)) != IndexStatus::ok) {
+  if (encoded_buffer.resize_uninitialized(get_encoded_cobs_buffer_size(buffer)) !=
+      IndexStatus::ok) {
     return IndexStatus::out_of_bounds;
   };
 
@@ -5,10 +5,11 @@
  *      Author: Ethan Li
  *
  *  A statically-allocated map for a finite, pre-determined set of keys.
- *  Backed by an array of keys and an array of values. Methods use early
- *  returns of status codes instead of exceptions for error handling, for
+ *  Backed by a bit-packed EnumSet of keys and an array of values. Methods use
+ *  early returns of status codes instead of exceptions for error handling, for
  *  bounds-checking.
- *  This Map is designed for frequent lookups but doesn't support traversal.
+ *  This Map is designed for frequent lookups; traversal is supported through
+ *  the keys method.
  */
 
 #pragma once
@@ -55,7 +56,7 @@ class EnumMap {
   IndexStatus input(const Key &key, const Value &value) noexcept;  // O(1)
   // Note: this copies the value in the map to the value output parameter!
   IndexStatus output(const Key &key, Value &value) const;  // O(1)
-  void clear();                                            // O(n)
+  void clear();                                            // O(n / 32)
   IndexStatus erase(const Key &key) noexcept;              // O(1)
   [[nodiscard]] bool has(const Key &key) const;            // O(1)
 
@@ -63,6 +64,9 @@ class EnumMap {
   const Value &operator[](const Key &key) const noexcept;
   Value &operator[](const Key &key) noexcept;
 
+  // The set of keys which have values, e.g. for traversal with keys().for_each
+  [[nodiscard]] const EnumSet<Key, capacity> &keys() const noexcept;
+
  private:
   EnumSet<Key, capacity> keys_{};
   std::array<Value, capacity> values_{};
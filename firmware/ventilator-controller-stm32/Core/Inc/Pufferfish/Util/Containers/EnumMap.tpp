@@ -86,4 +86,9 @@ Value &EnumMap<Key, Value, capacity>::operator[](const Key &key) noexcept {
   return values_[static_cast<size_t>(key)];
 }
 
+template <typename Key, typename Value, size_t capacity>
+const EnumSet<Key, capacity> &EnumMap<Key, Value, capacity>::keys() const noexcept {
+  return keys_;
+}
+
 }  // namespace Pufferfish::Util::Containers
@@ -5,15 +5,18 @@
  *      Author: Ethan Li
  *
  *  A statically-allocated set for a finite, pre-determined set of keys.
- *  Backed by an array of pairs. Methods use early returns of status codes instead
- *  of exceptions for error handling, for bounds-checking.
- *  This Set is designed for frequent lookups but doesn't support traversal.
+ *  Backed by a bitset packed into 32-bit words, so that clearing, counting,
+ *  and combining sets is done a word at a time. Methods use early returns of
+ *  status codes instead of exceptions for error handling, for bounds-checking.
+ *  This Set is designed for frequent lookups; traversal is supported in order
+ *  of increasing key values.
  */
 
 #pragma once
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <utility>
 
@@ -29,6 +32,10 @@ template <typename Key, size_t capacity>
 class EnumSet : public Set<Key> {
  public:
   using InitializerList = std::initializer_list<Key>;
+  using Word = uint32_t;
+
+  static constexpr size_t word_bits = sizeof(Word) * 8;
+  static constexpr size_t num_words = (capacity + word_bits - 1) / word_bits;
 
   EnumSet() = default;
   // Construct the EnumSet with an initial set of keys, given as an
@@ -44,6 +51,7 @@ class EnumSet : public Set<Key> {
   // Note: when capacity is 0, this returns the max value of size_t
   [[nodiscard]] static constexpr size_t max_key_value() noexcept { return capacity - 1; }
 
+  // Note: size, full, and available count keys with a popcount of each word, in O(n / 32)
   [[nodiscard]] size_t size() const;
   [[nodiscard]] static constexpr size_t max_size() noexcept { return capacity; }
   [[nodiscard]] bool empty() const;
@@ -51,13 +59,30 @@ class EnumSet : public Set<Key> {
   [[nodiscard]] size_t available() const;
 
   IndexStatus input(const Key &key) noexcept;             // O(1)
-  void clear();                                           // O(n)
+  void clear();                                           // O(n / 32)
   IndexStatus erase(const Key &key) noexcept;             // O(1)
   [[nodiscard]] bool has(const Key &key) const override;  // O(1)
 
+  // Adds all keys in other to the set
+  EnumSet &operator|=(const EnumSet &other) noexcept;  // O(n / 32)
+  // Removes all keys not in other from the set
+  EnumSet &operator&=(const EnumSet &other) noexcept;  // O(n / 32)
+  bool operator==(const EnumSet &other) const noexcept;
+  bool operator!=(const EnumSet &other) const noexcept;
+
+  // Calls function(key) on each key in the set, in order of increasing key values. Words without
+  // any keys are skipped, and the keys in each word are found by counting trailing zeros, so this
+  // is O(n / 32 + size()). Keys must not be added or removed by function.
+  template <typename Function>
+  void for_each(Function function) const;
+
  private:
-  std::array<bool, capacity> occupancies_{};
-  size_t size_ = 0;
+  std::array<Word, num_words> words_{};
+
+  [[nodiscard]] static constexpr size_t word_of(size_t index) { return index / word_bits; }
+  [[nodiscard]] static constexpr Word mask_of(size_t index) {
+    return Word(1) << (index % word_bits);
+  }
 };
 
 }  // namespace Pufferfish::Util::Containers
@@ -22,22 +22,31 @@ EnumSet<Key, capacity>::EnumSet(std::initializer_list<Key> init) noexcept {
 
 template <typename Key, size_t capacity>
 size_t EnumSet<Key, capacity>::size() const {
-  return size_;
+  size_t size = 0;
+  for (const Word &word : words_) {
+    size += __builtin_popcount(word);
+  }
+  return size;
 }
 
 template <typename Key, size_t capacity>
 bool EnumSet<Key, capacity>::empty() const {
-  return size_ == 0;
+  for (const Word &word : words_) {
+    if (word != 0) {
+      return false;
+    }
+  }
+  return true;
 }
 
 template <typename Key, size_t capacity>
 bool EnumSet<Key, capacity>::full() const {
-  return size_ == max_size();
+  return size() == max_size();
 }
 
 template <typename Key, size_t capacity>
 size_t EnumSet<Key, capacity>::available() const {
-  return max_size() - size_;
+  return max_size() - size();
 }
 
 template <typename Key, size_t capacity>
@@ -47,19 +56,13 @@ IndexStatus EnumSet<Key, capacity>::input(const Key &key) noexcept {
     return IndexStatus::out_of_bounds;
   }
 
-  if (!occupancies_[index]) {
-    ++size_;
-    occupancies_[index] = true;
-  }
+  words_[word_of(index)] |= mask_of(index);
   return IndexStatus::ok;
 }
 
 template <typename Key, size_t capacity>
 void EnumSet<Key, capacity>::clear() {
-  for (size_t i = 0; i < max_size(); ++i) {
-    occupancies_[i] = false;
-  }
-  size_ = 0;
+  words_.fill(0);
 }
 
 template <typename Key, size_t capacity>
@@ -69,10 +72,7 @@ IndexStatus EnumSet<Key, capacity>::erase(const Key &key) noexcept {
   }
 
   auto index = static_cast<size_t>(key);
-  if (occupancies_[index]) {
-    --size_;
-    occupancies_[index] = false;
-  }
+  words_[word_of(index)] &= ~mask_of(index);
   return IndexStatus::ok;
 }
 
@@ -83,7 +83,47 @@ bool EnumSet<Key, capacity>::has(const Key &key) const {
     return false;
   }
 
-  return occupancies_[index];
+  return (words_[word_of(index)] & mask_of(index)) != 0;
+}
+
+template <typename Key, size_t capacity>
+EnumSet<Key, capacity> &EnumSet<Key, capacity>::operator|=(const EnumSet &other) noexcept {
+  for (size_t i = 0; i < num_words; ++i) {
+    words_[i] |= other.words_[i];
+  }
+  return *this;
+}
+
+template <typename Key, size_t capacity>
+EnumSet<Key, capacity> &EnumSet<Key, capacity>::operator&=(const EnumSet &other) noexcept {
+  for (size_t i = 0; i < num_words; ++i) {
+    words_[i] &= other.words_[i];
+  }
+  return *this;
+}
+
+template <typename Key, size_t capacity>
+bool EnumSet<Key, capacity>::operator==(const EnumSet &other) const noexcept {
+  return words_ == other.words_;
+}
+
+template <typename Key, size_t capacity>
+bool EnumSet<Key, capacity>::operator!=(const EnumSet &other) const noexcept {
+  return !(*this == other);
+}
+
+template <typename Key, size_t capacity>
+template <typename Function>
+void EnumSet<Key, capacity>::for_each(Function function) const {
+  for (size_t i = 0; i < num_words; ++i) {
+    Word word = words_[i];
+    while (word != 0) {
+      size_t index = i * word_bits + __builtin_ctz(word);
+      function(static_cast<Key>(index));
+      // Clear the lowest set bit
+      word &= word - 1;
+    }
+  }
 }
 
 }  // namespace Pufferfish::Util::Containers
@@ -0,0 +1,142 @@
+/// \file
+/// \brief A statically-allocated hash map which remembers order of initial insertion.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish::Util::Containers {
+
+/**
+ * Default hash for HashedOrderedMap keys which are enums or integers.
+ *
+ * Uses Fibonacci hashing, so the upper bits of the result are well-mixed even when the keys are
+ * consecutive enum values; HashedOrderedMap only uses the upper bits.
+ */
+template <typename Key>
+struct IntegerHash {
+  constexpr uint32_t operator()(const Key &key) const noexcept {
+    return static_cast<uint32_t>(key) * golden_ratio;
+  }
+
+ private:
+  static constexpr uint32_t golden_ratio = 2654435769U;
+};
+
+// Returns the number of hash bits needed to index at least min_buckets buckets
+constexpr size_t hash_bucket_bits(size_t min_buckets) {
+  size_t bits = 0;
+  while ((size_t(1) << bits) < min_buckets) {
+    ++bits;
+  }
+  return bits;
+}
+
+/**
+ * A drop-in replacement for OrderedMap with O(1) lookups, insertions, and erasures.
+ *
+ * Key-value pairs are stored in a fixed pool of nodes which are doubly-linked in order of
+ * initial insertion, so that erasing a pair never needs to shift the pairs after it. Alongside
+ * the nodes, an open-addressing index with linear probing maps keys to nodes; it has at least
+ * twice as many buckets as max_pairs, so probe sequences stay short, and erasures shift later
+ * entries of a probe sequence back instead of leaving tombstones, so lookups don't slow down as
+ * pairs are erased and re-inserted. Methods use early returns of status codes instead of
+ * exceptions for error handling, for bounds-checking.
+ *
+ * Key must be copyable and equality-comparable, and Hash must map keys to 32-bit hashes whose
+ * upper bits are well-mixed.
+ */
+template <typename Key, typename Value, size_t max_pairs, typename Hash = IntegerHash<Key>>
+class HashedOrderedMap {
+ public:
+  using Pair = std::pair<Key, Value>;
+
+  HashedOrderedMap() = default;
+  // Construct the HashedOrderedMap with an initial set of key-value pairs, given as an
+  // initializer list (e.g. HashedOrderedMap map{{k1, v1}, {k2, v2}, {k3, v3}};)
+  // Note: the value for the last copy of a duplicated key will overwrite all previous values.
+  // Note: this makes copies of the values!
+  HashedOrderedMap(std::initializer_list<Pair> init);
+
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] static constexpr size_t max_size() noexcept { return max_pairs; }
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] bool full() const;
+  [[nodiscard]] size_t available() const;
+
+  // Note: this makes a copy of value!
+  IndexStatus input(const Key &key, const Value &value);  // O(1)
+  // Note: this copies the value in the map to the value output parameter!
+  IndexStatus output(const Key &key, Value &value) const;  // O(1)
+  void clear();                                            // O(m)
+  IndexStatus erase(const Key &key);                       // O(1)
+  [[nodiscard]] bool has(const Key &key) const;            // O(1)
+
+  // Calls function(pair) on each key-value pair, in order of initial insertion. Pairs must not
+  // be added or removed by function.
+  template <typename Function>
+  void for_each(Function function) const;
+
+ private:
+  using NodeIndex = uint16_t;
+  static constexpr NodeIndex no_node = UINT16_MAX;
+  static_assert(max_pairs > 0, "HashedOrderedMap must have a nonzero capacity");
+  static_assert(max_pairs < no_node, "HashedOrderedMap capacity is too large");
+
+  static constexpr size_t num_bucket_bits = hash_bucket_bits(2 * max_pairs);
+  static constexpr size_t num_buckets = size_t(1) << num_bucket_bits;
+  static constexpr size_t bucket_mask = num_buckets - 1;
+
+  struct Node {
+    Pair pair;
+    NodeIndex prev;
+    NodeIndex next;
+  };
+
+  std::array<Node, max_pairs> nodes_{};
+  // Each bucket holds 1 + the index of its node, or 0 if the bucket is empty, so that the index
+  // is empty when zero-initialized
+  std::array<NodeIndex, num_buckets> buckets_{};
+  NodeIndex head_ = no_node;
+  NodeIndex tail_ = no_node;
+  // Erased nodes are kept in a singly-linked free list; nodes from num_used_ onwards were never
+  // allocated, so they don't need to be put in the free list up front.
+  NodeIndex free_ = no_node;
+  NodeIndex num_used_ = 0;
+  size_t size_ = 0;
+
+  [[nodiscard]] static size_t home_bucket(const Key &key);
+  // Returns ok with the bucket holding key, or out_of_bounds with the empty bucket which ends
+  // the probe sequence for key
+  IndexStatus find(const Key &key, size_t &bucket) const;
+  IndexStatus allocate(NodeIndex &node);
+  void release(NodeIndex node);
+  void erase_bucket(size_t bucket);
+};
+
+}  // namespace Pufferfish::Util::Containers
+
+#include "HashedOrderedMap.tpp"
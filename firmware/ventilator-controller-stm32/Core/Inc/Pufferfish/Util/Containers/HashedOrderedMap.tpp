@@ -0,0 +1,203 @@
+/// \file
+/// \brief A statically-allocated hash map which remembers order of initial insertion.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "HashedOrderedMap.h"
+
+namespace Pufferfish::Util::Containers {
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+HashedOrderedMap<Key, Value, max_pairs, Hash>::HashedOrderedMap(std::initializer_list<Pair> init) {
+  for (const auto &pair : init) {
+    input(pair.first, pair.second);
+  }
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+size_t HashedOrderedMap<Key, Value, max_pairs, Hash>::size() const {
+  return size_;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+bool HashedOrderedMap<Key, Value, max_pairs, Hash>::empty() const {
+  return size_ == 0;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+bool HashedOrderedMap<Key, Value, max_pairs, Hash>::full() const {
+  return size_ == max_size();
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+size_t HashedOrderedMap<Key, Value, max_pairs, Hash>::available() const {
+  return max_size() - size_;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+IndexStatus HashedOrderedMap<Key, Value, max_pairs, Hash>::input(
+    const Key &key, const Value &value) {
+  size_t bucket = 0;
+  if (find(key, bucket) == IndexStatus::ok) {
+    nodes_[buckets_[bucket] - 1].pair.second = value;
+    return IndexStatus::ok;
+  }
+
+  NodeIndex node = no_node;
+  if (allocate(node) != IndexStatus::ok) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  nodes_[node].pair = Pair{key, value};
+  nodes_[node].prev = tail_;
+  nodes_[node].next = no_node;
+  if (tail_ == no_node) {
+    head_ = node;
+  } else {
+    nodes_[tail_].next = node;
+  }
+  tail_ = node;
+  buckets_[bucket] = static_cast<NodeIndex>(node + 1);
+  ++size_;
+  return IndexStatus::ok;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+IndexStatus HashedOrderedMap<Key, Value, max_pairs, Hash>::output(
+    const Key &key, Value &value) const {
+  size_t bucket = 0;
+  IndexStatus status = find(key, bucket);
+  if (status != IndexStatus::ok) {
+    return status;
+  }
+
+  value = nodes_[buckets_[bucket] - 1].pair.second;
+  return IndexStatus::ok;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+void HashedOrderedMap<Key, Value, max_pairs, Hash>::clear() {
+  buckets_.fill(0);
+  head_ = no_node;
+  tail_ = no_node;
+  free_ = no_node;
+  num_used_ = 0;
+  size_ = 0;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+IndexStatus HashedOrderedMap<Key, Value, max_pairs, Hash>::erase(const Key &key) {
+  size_t bucket = 0;
+  if (find(key, bucket) != IndexStatus::ok) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  NodeIndex node = buckets_[bucket] - 1;
+  erase_bucket(bucket);
+
+  const Node &erased = nodes_[node];
+  if (erased.prev == no_node) {
+    head_ = erased.next;
+  } else {
+    nodes_[erased.prev].next = erased.next;
+  }
+  if (erased.next == no_node) {
+    tail_ = erased.prev;
+  } else {
+    nodes_[erased.next].prev = erased.prev;
+  }
+  release(node);
+  --size_;
+  return IndexStatus::ok;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+bool HashedOrderedMap<Key, Value, max_pairs, Hash>::has(const Key &key) const {
+  size_t bucket = 0;
+  return find(key, bucket) == IndexStatus::ok;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+template <typename Function>
+void HashedOrderedMap<Key, Value, max_pairs, Hash>::for_each(Function function) const {
+  for (NodeIndex node = head_; node != no_node; node = nodes_[node].next) {
+    function(nodes_[node].pair);
+  }
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+size_t HashedOrderedMap<Key, Value, max_pairs, Hash>::home_bucket(const Key &key) {
+  static const size_t hash_bits = 32;
+  return Hash{}(key) >> (hash_bits - num_bucket_bits);
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+IndexStatus HashedOrderedMap<Key, Value, max_pairs, Hash>::find(
+    const Key &key, size_t &bucket) const {
+  // There are more buckets than nodes, so every probe sequence ends at an empty bucket
+  for (bucket = home_bucket(key); buckets_[bucket] != 0; bucket = (bucket + 1) & bucket_mask) {
+    if (nodes_[buckets_[bucket] - 1].pair.first == key) {
+      return IndexStatus::ok;
+    }
+  }
+
+  return IndexStatus::out_of_bounds;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+IndexStatus HashedOrderedMap<Key, Value, max_pairs, Hash>::allocate(NodeIndex &node) {
+  if (free_ != no_node) {
+    node = free_;
+    free_ = nodes_[node].next;
+    return IndexStatus::ok;
+  }
+
+  if (num_used_ < max_pairs) {
+    node = num_used_;
+    ++num_used_;
+    return IndexStatus::ok;
+  }
+
+  return IndexStatus::out_of_bounds;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+void HashedOrderedMap<Key, Value, max_pairs, Hash>::release(NodeIndex node) {
+  nodes_[node].next = free_;
+  free_ = node;
+}
+
+template <typename Key, typename Value, size_t max_pairs, typename Hash>
+void HashedOrderedMap<Key, Value, max_pairs, Hash>::erase_bucket(size_t bucket) {
+  // Shift back each later entry in the probe sequence whose home bucket is at or before the
+  // hole, so that no entry is ever separated from its home bucket by an empty bucket
+  size_t hole = bucket;
+  for (size_t next = (hole + 1) & bucket_mask; buckets_[next] != 0;
+       next = (next + 1) & bucket_mask) {
+    size_t home = home_bucket(nodes_[buckets_[next] - 1].pair.first);
+    if (((next - home) & bucket_mask) >= ((next - hole) & bucket_mask)) {
+      buckets_[hole] = buckets_[next];
+      hole = next;
+    }
+  }
+  buckets_[hole] = 0;
+}
+
+}  // namespace Pufferfish::Util::Containers
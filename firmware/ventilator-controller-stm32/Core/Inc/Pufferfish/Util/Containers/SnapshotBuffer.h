@@ -0,0 +1,96 @@
+/// \file
+/// \brief A lock-free double buffer for publishing consistent snapshots of a value.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pufferfish::Util::Containers {
+
+/**
+ * Double-buffered storage for a value which is written by one context and read by others.
+ *
+ * The writer always writes the new version of the value into the buffer slot which readers
+ * aren't using, and then publishes it by incrementing a sequence counter, so readers never
+ * need to take a lock or disable interrupts. A reader copies out the most recently published
+ * version, and then checks the sequence counter to confirm that the writer didn't start
+ * overwriting that slot during the copy. A read can only need a retry if the writer has
+ * published two versions during a single copy; readers in ISRs which preempt the writer
+ * therefore always succeed on the first attempt.
+ *
+ * There must only be one writer, and the value type must be trivially copyable.
+ */
+template <typename Value>
+class SnapshotBuffer {
+ public:
+  using Version = uint32_t;
+
+  enum class Status {
+    ok = 0,    /// a consistent snapshot was read
+    contended  /// the writer kept overwriting the snapshot while it was being read
+  };
+
+  static const size_t default_max_attempts = 4;
+
+  SnapshotBuffer() = default;
+  explicit SnapshotBuffer(const Value &initial);
+
+  /**
+   * Publishes a new version of the value. Must only be called from a single context.
+   * @param value the new version of the value
+   */
+  void write(const Value &value);
+
+  /**
+   * Copies out the most recently published version of the value.
+   *
+   * Gives up if the writer overwrites the snapshot during every attempt; in that case
+   * snapshot is left with unspecified contents.
+   * @param[out] snapshot a consistent copy of the most recently published version
+   * @param max_attempts the maximum number of times to try copying the value
+   * @return ok on success, contended otherwise
+   */
+  Status read(Value &snapshot, size_t max_attempts = default_max_attempts) const;
+
+  /**
+   * Returns the number of versions published since construction, so that readers can
+   * skip copying out a version they have already seen. The version wraps around, so it
+   * should only be compared for equality.
+   */
+  [[nodiscard]] Version version() const;
+
+ private:
+  static const size_t num_slots = 2;
+
+  // Each published version takes two steps of the sequence counter: the counter is odd while
+  // the writer is filling a slot, and even once the version in that slot is published. All
+  // arithmetic on the counter is modular, so wraparound is harmless.
+  std::atomic<uint32_t> sequence_{0};
+  std::array<Value, num_slots> slots_{};
+
+  static size_t slot(Version version);
+};
+
+}  // namespace Pufferfish::Util::Containers
+
+#include "SnapshotBuffer.tpp"
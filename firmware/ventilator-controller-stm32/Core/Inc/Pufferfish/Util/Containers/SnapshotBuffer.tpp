@@ -0,0 +1,83 @@
+/// \file
+/// \brief A lock-free double buffer for publishing consistent snapshots of a value.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+
+#include "SnapshotBuffer.h"
+
+namespace Pufferfish::Util::Containers {
+
+template <typename Value>
+SnapshotBuffer<Value>::SnapshotBuffer(const Value &initial) {
+  slots_[slot(0)] = initial;
+}
+
+template <typename Value>
+void SnapshotBuffer<Value>::write(const Value &value) {
+  static_assert(
+      std::is_trivially_copyable<Value>::value,
+      "SnapshotBuffer values must be trivially copyable");
+
+  uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+  Version next_version = sequence / 2 + 1;
+
+  // Mark the slot as being written before touching it
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slots_[slot(next_version)] = value;
+
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename Value>
+typename SnapshotBuffer<Value>::Status SnapshotBuffer<Value>::read(
+    Value &snapshot, size_t max_attempts) const {
+  for (size_t i = 0; i < max_attempts; ++i) {
+    // If the writer is in the middle of writing a new version, the published version is still
+    // readable in the other slot
+    uint32_t published = sequence_.load(std::memory_order_acquire) & ~1U;
+    snapshot = slots_[slot(published / 2)];
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // The slot was only overwritten if the writer published the next version and then started
+    // writing the version after that
+    uint32_t elapsed = sequence_.load(std::memory_order_relaxed) - published;
+    if (elapsed < 3) {
+      return Status::ok;
+    }
+  }
+
+  return Status::contended;
+}
+
+template <typename Value>
+typename SnapshotBuffer<Value>::Version SnapshotBuffer<Value>::version() const {
+  return sequence_.load(std::memory_order_acquire) / 2;
+}
+
+template <typename Value>
+size_t SnapshotBuffer<Value>::slot(Version version) {
+  return version % num_slots;
+}
+
+}  // namespace Pufferfish::Util::Containers
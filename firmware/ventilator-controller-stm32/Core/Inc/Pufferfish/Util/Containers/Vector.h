@@ -29,40 +29,62 @@ class Vector {
   using Iterator = typename Array::iterator;
   using ConstIterator = typename Array::const_iterator;
 
-  Vector() = default;
+  constexpr Vector() = default;
   // Construct the Vector with an initial list of elements, given as an
   // initializer list (e.g. Vector<uint8_t, 5> vec{1, 2, 3})
   // Note: this makes copies of the values!
   // clang-tidy says - member initializer for 'size_' is redundant
   // cppcheck-suppress noExplicitConstructor
-  Vector(std::initializer_list<Element> init) {
+  constexpr Vector(std::initializer_list<Element> init) {
     for (const Element &elem : init) {
       push_back(elem);
     }
   }
 
-  [[nodiscard]] size_t size() const;
+  [[nodiscard]] constexpr size_t size() const noexcept;
   [[nodiscard]] static constexpr size_t max_size() noexcept { return array_size; }
-  [[nodiscard]] bool empty() const;
-  [[nodiscard]] bool full() const;
-  [[nodiscard]] size_t available() const;
-
-  void clear();
-  IndexStatus resize(size_t new_size);
-  IndexStatus push_back(const Element &new_elem);
-  IndexStatus erase(size_t index);
+  [[nodiscard]] constexpr bool empty() const noexcept;
+  [[nodiscard]] constexpr bool full() const noexcept;
+  [[nodiscard]] constexpr size_t available() const noexcept;
+
+  constexpr void clear() noexcept;
+  // Note: this value-initializes any elements added to the end of the Vector
+  constexpr IndexStatus resize(size_t new_size);
+  // Note: this leaves any elements added to the end of the Vector with whatever values were last
+  // stored in them, so it should only be used when they will be overwritten, e.g. for byte
+  // buffers which are about to be filled in
+  constexpr IndexStatus resize_uninitialized(size_t new_size) noexcept;
+  constexpr IndexStatus push_back(const Element &new_elem);
+  // Note: this preserves the order of the remaining elements, so it's O(n)
+  constexpr IndexStatus erase(size_t index);
+  // Note: this replaces the erased element with the last element, so it's O(1) but doesn't
+  // preserve the order of the remaining elements
+  constexpr IndexStatus swap_erase(size_t index);
+  // Erases the elements from index first up to (but not including) index last, shifting the
+  // remaining elements down in a single pass
+  constexpr IndexStatus erase_range(size_t first, size_t last);
+  // Inserts new_elem before the element at index, which may be size() to insert at the end
+  constexpr IndexStatus insert(size_t index, const Element &new_elem);
 
   // Note: these don't perform bounds-checking!
   constexpr const Element &operator[](size_t position) const noexcept;
   constexpr Element &operator[](size_t position) noexcept;
 
-  // Note: these perform shallow copies!
+  // Note: these perform shallow copies! They use memcpy if Element is trivially copyable.
   template <size_t source_size>
   IndexStatus copy_from(
       const std::array<Element, source_size> &source, size_t dest_start_index = 0);
   IndexStatus copy_from(const Vector<Element, array_size> &source, size_t dest_start_index = 0);
   IndexStatus copy_from(const Element *source, size_t source_size, size_t dest_start_index = 0);
 
+  // Adds copies of the source elements to the end of the Vector. If there isn't enough space
+  // for all of them, nothing is added. These use memcpy if Element is trivially copyable.
+  template <size_t source_size>
+  IndexStatus append(const std::array<Element, source_size> &source);
+  template <size_t source_array_size>
+  IndexStatus append(const Vector<Element, source_array_size> &source);
+  IndexStatus append(const Element *source, size_t source_size);
+
   // TODO(lietk12): remove these methods!
   [[nodiscard]] constexpr const Element *buffer() const noexcept { return buffer_.data(); }
   constexpr Element *buffer() noexcept { return buffer_.data(); }
@@ -70,14 +92,19 @@ class Vector {
   // Note: these are std::array iterators, so their iterators can throw exceptions for bounds
   // errors! These methods are only provided to support range-based for loops, and they should not
   // be called directly by other code.
-  [[nodiscard]] Iterator begin() noexcept;
-  [[nodiscard]] ConstIterator cbegin() const noexcept;
-  [[nodiscard]] Iterator end() noexcept;
-  [[nodiscard]] ConstIterator cend() const noexcept;
+  [[nodiscard]] constexpr Iterator begin() noexcept;
+  [[nodiscard]] constexpr ConstIterator begin() const noexcept;
+  [[nodiscard]] constexpr ConstIterator cbegin() const noexcept;
+  [[nodiscard]] constexpr Iterator end() noexcept;
+  [[nodiscard]] constexpr ConstIterator end() const noexcept;
+  [[nodiscard]] constexpr ConstIterator cend() const noexcept;
 
  private:
   Array buffer_{};
   size_t size_ = 0;
+
+  // Copies source_size elements from source into the buffer, starting at dest_index
+  void copy_elements(const Element *source, size_t source_size, size_t dest_index);
 };
 
 template <size_t array_size>
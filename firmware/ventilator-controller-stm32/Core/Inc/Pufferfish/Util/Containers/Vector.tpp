@@ -8,47 +8,62 @@
 #pragma once
 
 #include <cstring>
+#include <type_traits>
 
 #include "Vector.h"
 
 namespace Pufferfish::Util::Containers {
 
 template <typename Element, size_t array_size>
-size_t Vector<Element, array_size>::size() const {
+constexpr size_t Vector<Element, array_size>::size() const noexcept {
   return size_;
 }
 
 template <typename Element, size_t array_size>
-bool Vector<Element, array_size>::empty() const {
+constexpr bool Vector<Element, array_size>::empty() const noexcept {
   return size_ == 0;
 }
 
 template <typename Element, size_t array_size>
-bool Vector<Element, array_size>::full() const {
+constexpr bool Vector<Element, array_size>::full() const noexcept {
   return size_ == array_size;
 }
 
 template <typename Element, size_t array_size>
-size_t Vector<Element, array_size>::available() const {
+constexpr size_t Vector<Element, array_size>::available() const noexcept {
   return array_size - size_;
 }
 
 template <typename Element, size_t array_size>
-void Vector<Element, array_size>::clear() {
+constexpr void Vector<Element, array_size>::clear() noexcept {
   size_ = 0;
 }
 
 template <typename Element, size_t array_size>
-IndexStatus Vector<Element, array_size>::resize(size_t new_size) {
+constexpr IndexStatus Vector<Element, array_size>::resize(size_t new_size) {
   if (new_size > array_size) {
     return IndexStatus::out_of_bounds;
   }
+
+  for (size_t i = size_; i < new_size; ++i) {
+    buffer_[i] = Element{};
+  }
+  size_ = new_size;
+  return IndexStatus::ok;
+}
+
+template <typename Element, size_t array_size>
+constexpr IndexStatus Vector<Element, array_size>::resize_uninitialized(size_t new_size) noexcept {
+  if (new_size > array_size) {
+    return IndexStatus::out_of_bounds;
+  }
+
   size_ = new_size;
   return IndexStatus::ok;
 }
 
 template <typename Element, size_t array_size>
-IndexStatus Vector<Element, array_size>::push_back(const Element &new_elem) {
+constexpr IndexStatus Vector<Element, array_size>::push_back(const Element &new_elem) {
   if (size_ == array_size) {
     return IndexStatus::out_of_bounds;
   }
@@ -58,16 +73,48 @@ IndexStatus Vector<Element, array_size>::push_back(const Element &new_elem) {
 }
 
 template <typename Element, size_t array_size>
-IndexStatus Vector<Element, array_size>::erase(size_t index) {
+constexpr IndexStatus Vector<Element, array_size>::erase(size_t index) {
+  return erase_range(index, index + 1);
+}
+
+template <typename Element, size_t array_size>
+constexpr IndexStatus Vector<Element, array_size>::swap_erase(size_t index) {
   if (index >= size_) {
     return IndexStatus::out_of_bounds;
   }
 
-  for (size_t i = index; i < size_ - 1; ++i) {
-    buffer_[i] = buffer_[i + 1];
+  --size_;
+  if (index != size_) {
+    buffer_[index] = buffer_[size_];
   }
+  return IndexStatus::ok;
+}
 
-  --size_;
+template <typename Element, size_t array_size>
+constexpr IndexStatus Vector<Element, array_size>::erase_range(size_t first, size_t last) {
+  if (first >= last || last > size_) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  size_t num_erased = last - first;
+  for (size_t i = first; i + num_erased < size_; ++i) {
+    buffer_[i] = buffer_[i + num_erased];
+  }
+  size_ -= num_erased;
+  return IndexStatus::ok;
+}
+
+template <typename Element, size_t array_size>
+constexpr IndexStatus Vector<Element, array_size>::insert(size_t index, const Element &new_elem) {
+  if (index > size_ || size_ == array_size) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  for (size_t i = size_; i > index; --i) {
+    buffer_[i] = buffer_[i - 1];
+  }
+  buffer_[index] = new_elem;
+  ++size_;
   return IndexStatus::ok;
 }
 
@@ -101,33 +148,83 @@ IndexStatus Vector<Element, array_size>::copy_from(
     return IndexStatus::out_of_bounds;
   }
   size_ = source_size + dest_start_index;
-  memcpy(
-      buffer_.data() + dest_start_index,
-      source_bytes,
-      sizeof(Element) * (size_ - dest_start_index));
+  copy_elements(source_bytes, source_size, dest_start_index);
+  return IndexStatus::ok;
+}
+
+template <typename Element, size_t array_size>
+template <size_t source_size>
+IndexStatus Vector<Element, array_size>::append(const std::array<Element, source_size> &source) {
+  return append(source.data(), source.size());
+}
+
+template <typename Element, size_t array_size>
+template <size_t source_array_size>
+IndexStatus Vector<Element, array_size>::append(const Vector<Element, source_array_size> &source) {
+  return append(source.buffer(), source.size());
+}
+
+template <typename Element, size_t array_size>
+IndexStatus Vector<Element, array_size>::append(const Element *source, size_t source_size) {
+  if (source_size > available()) {
+    return IndexStatus::out_of_bounds;
+  }
+
+  copy_elements(source, source_size, size_);
+  size_ += source_size;
   return IndexStatus::ok;
 }
 
 template <typename Element, size_t array_size>
-typename Vector<Element, array_size>::Iterator Vector<Element, array_size>::begin() noexcept {
+constexpr typename Vector<Element, array_size>::Iterator Vector<Element, array_size>::begin()
+    noexcept {
   return buffer_.begin();
 }
 
 template <typename Element, size_t array_size>
-typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::cbegin()
+constexpr typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::begin()
     const noexcept {
   return buffer_.cbegin();
 }
 
 template <typename Element, size_t array_size>
-typename Vector<Element, array_size>::Iterator Vector<Element, array_size>::end() noexcept {
+constexpr typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::cbegin()
+    const noexcept {
+  return buffer_.cbegin();
+}
+
+template <typename Element, size_t array_size>
+constexpr typename Vector<Element, array_size>::Iterator Vector<Element, array_size>::end()
+    noexcept {
   return buffer_.begin() + size_;
 }
 
 template <typename Element, size_t array_size>
-typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::cend()
+constexpr typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::end()
     const noexcept {
   return buffer_.cbegin() + size_;
 }
 
+template <typename Element, size_t array_size>
+constexpr typename Vector<Element, array_size>::ConstIterator Vector<Element, array_size>::cend()
+    const noexcept {
+  return buffer_.cbegin() + size_;
+}
+
+template <typename Element, size_t array_size>
+void Vector<Element, array_size>::copy_elements(
+    const Element *source, size_t source_size, size_t dest_index) {
+  if (source_size == 0) {
+    return;
+  }
+
+  if constexpr (std::is_trivially_copyable<Element>::value) {
+    memcpy(buffer_.data() + dest_index, source, sizeof(Element) * source_size);
+  } else {
+    for (size_t i = 0; i < source_size; ++i) {
+      buffer_[dest_index + i] = source[i];
+    }
+  }
+}
+
 }  // namespace Pufferfish::Util::Containers
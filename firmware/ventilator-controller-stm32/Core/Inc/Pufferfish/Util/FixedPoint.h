@@ -0,0 +1,103 @@
+/// \file
+/// \brief Saturating fixed-point numbers in the Q15 and Q31 formats
+///
+/// Fixed-point numbers represent values in [-1, 1) as integers scaled by a power of two, in the
+/// same formats as CMSIS-DSP's q15_t and q31_t, so that signal processing code can be
+/// instantiated with integer arithmetic instead of float. The arithmetic here is portable integer
+/// code, so it produces bit-identical results on the host and on the target.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Pufferfish::Util {
+
+/**
+ * A signed fixed-point number with fractional_bits bits after the binary point.
+ *
+ * Values are stored in Storage, and intermediate results are computed in Wide, which must be
+ * able to hold the product of any two Storage values. Every operation saturates instead of
+ * overflowing. Saturation is symmetric, to [-max(), max()], so that the most negative Storage
+ * value is never produced by arithmetic; it's reserved as a marker for "not a number", which
+ * float NaNs are converted to. Arithmetic on the marker gives meaningless results, so callers
+ * which may receive it must check is_nan() first, as they would check std::isnan for floats.
+ *
+ * Multiplication truncates its result, like arm_mult_q15; conversion from float rounds to the
+ * nearest value, like arm_float_to_q15 with ARM_MATH_ROUNDING.
+ */
+template <typename Storage, typename Wide, int fractional_bits>
+class FixedPoint {
+ public:
+  static_assert(std::is_signed<Storage>::value, "Storage must be a signed integer type");
+  static_assert(
+      sizeof(Wide) >= 2 * sizeof(Storage), "Wide must be able to hold a product of two values");
+  static_assert(
+      fractional_bits > 0 && fractional_bits < std::numeric_limits<Storage>::digits + 1,
+      "Storage must have room for the fractional bits");
+
+  static constexpr Storage raw_max = std::numeric_limits<Storage>::max();
+  static constexpr Storage raw_lowest = -raw_max;
+  static constexpr Storage raw_nan = std::numeric_limits<Storage>::min();
+
+  constexpr FixedPoint() = default;
+  /// Converts a float, saturating values outside of the representable range
+  explicit constexpr FixedPoint(float value) : raw_(from_float(value)) {}
+
+  [[nodiscard]] static constexpr FixedPoint from_raw(Storage raw);
+  [[nodiscard]] static constexpr FixedPoint max() { return from_raw(raw_max); }
+  [[nodiscard]] static constexpr FixedPoint lowest() { return from_raw(raw_lowest); }
+  [[nodiscard]] static constexpr FixedPoint nan() { return from_raw(raw_nan); }
+
+  [[nodiscard]] constexpr Storage raw() const { return raw_; }
+  [[nodiscard]] constexpr bool is_nan() const { return raw_ == raw_nan; }
+  explicit constexpr operator float() const;
+
+  constexpr FixedPoint operator+(FixedPoint other) const;
+  constexpr FixedPoint operator-(FixedPoint other) const;
+  constexpr FixedPoint operator*(FixedPoint other) const;
+  constexpr FixedPoint operator-() const;
+  constexpr FixedPoint &operator+=(FixedPoint other);
+  constexpr FixedPoint &operator-=(FixedPoint other);
+  constexpr FixedPoint &operator*=(FixedPoint other);
+
+  constexpr bool operator==(FixedPoint other) const { return raw_ == other.raw_; }
+  constexpr bool operator!=(FixedPoint other) const { return raw_ != other.raw_; }
+  constexpr bool operator<(FixedPoint other) const { return raw_ < other.raw_; }
+  constexpr bool operator<=(FixedPoint other) const { return raw_ <= other.raw_; }
+  constexpr bool operator>(FixedPoint other) const { return raw_ > other.raw_; }
+  constexpr bool operator>=(FixedPoint other) const { return raw_ >= other.raw_; }
+
+ private:
+  static constexpr float scale = static_cast<float>(Wide(1) << fractional_bits);
+
+  Storage raw_ = 0;
+
+  static constexpr Storage saturate(Wide value);
+  static constexpr Storage from_float(float value);
+};
+
+using Q15 = FixedPoint<int16_t, int32_t, 15>;
+using Q31 = FixedPoint<int32_t, int64_t, 31>;
+
+}  // namespace Pufferfish::Util
+
+#include "FixedPoint.tpp"
@@ -0,0 +1,121 @@
+/// \file
+/// \brief Saturating fixed-point numbers in the Q15 and Q31 formats
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "FixedPoint.h"
+
+namespace Pufferfish::Util {
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+FixedPoint<Storage, Wide, fractional_bits>::from_raw(Storage raw) {
+  FixedPoint result;
+  result.raw_ = raw;
+  return result;
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>::operator float() const {
+  if (is_nan()) {
+    return std::numeric_limits<float>::quiet_NaN();
+  }
+
+  return static_cast<float>(raw_) / scale;
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+FixedPoint<Storage, Wide, fractional_bits>::operator+(FixedPoint other) const {
+  return from_raw(saturate(Wide(raw_) + Wide(other.raw_)));
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+FixedPoint<Storage, Wide, fractional_bits>::operator-(FixedPoint other) const {
+  return from_raw(saturate(Wide(raw_) - Wide(other.raw_)));
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+FixedPoint<Storage, Wide, fractional_bits>::operator*(FixedPoint other) const {
+  // Right shifts of negative values are arithmetic on every compiler we support
+  return from_raw(saturate((Wide(raw_) * Wide(other.raw_)) >> fractional_bits));
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+FixedPoint<Storage, Wide, fractional_bits>::operator-() const {
+  return from_raw(saturate(-Wide(raw_)));
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+    &FixedPoint<Storage, Wide, fractional_bits>::operator+=(FixedPoint other) {
+  *this = *this + other;
+  return *this;
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+    &FixedPoint<Storage, Wide, fractional_bits>::operator-=(FixedPoint other) {
+  *this = *this - other;
+  return *this;
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr FixedPoint<Storage, Wide, fractional_bits>
+    &FixedPoint<Storage, Wide, fractional_bits>::operator*=(FixedPoint other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr Storage FixedPoint<Storage, Wide, fractional_bits>::saturate(Wide value) {
+  if (value > Wide(raw_max)) {
+    return raw_max;
+  }
+  if (value < Wide(raw_lowest)) {
+    return raw_lowest;
+  }
+  return static_cast<Storage>(value);
+}
+
+template <typename Storage, typename Wide, int fractional_bits>
+constexpr Storage FixedPoint<Storage, Wide, fractional_bits>::from_float(float value) {
+  // NOLINTNEXTLINE(misc-redundant-expression) - std::isnan isn't constexpr
+  if (value != value) {
+    return raw_nan;
+  }
+
+  float scaled = value * scale;
+  scaled += (scaled > 0) ? 0.5F : -0.5F;
+  // float(raw_max) may round up past raw_max, so values at the bounds are saturated before
+  // they're converted to integers
+  if (scaled >= static_cast<float>(raw_max)) {
+    return raw_max;
+  }
+  if (scaled <= static_cast<float>(raw_lowest)) {
+    return raw_lowest;
+  }
+  return static_cast<Storage>(scaled);
+}
+
+}  // namespace Pufferfish::Util
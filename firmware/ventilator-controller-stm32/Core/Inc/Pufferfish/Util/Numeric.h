@@ -0,0 +1,64 @@
+/// \file
+/// \brief Numeric policies for code which can be instantiated with float or fixed-point numbers
+///
+/// Control and signal processing code which is templated on its number type uses the ordinary
+/// arithmetic and comparison operators, which float and FixedPoint both provide, and uses
+/// Numeric<Number> for everything else (NaN markers, absolute values, and conversions from and
+/// to float at the boundaries with the rest of the firmware).
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include "FixedPoint.h"
+
+namespace Pufferfish::Util {
+
+template <typename Number>
+struct Numeric;
+
+template <>
+struct Numeric<float> {
+  /// Whether values must be scaled into [-1, 1) to be represented
+  static constexpr bool is_fixed_point = false;
+
+  static constexpr float nan() { return std::numeric_limits<float>::quiet_NaN(); }
+  static constexpr float from_float(float value) { return value; }
+  static constexpr float to_float(float value) { return value; }
+  static bool is_nan(float value) { return std::isnan(value); }
+  static float abs(float value) { return std::abs(value); }
+};
+
+template <typename Storage, typename Wide, int fractional_bits>
+struct Numeric<FixedPoint<Storage, Wide, fractional_bits>> {
+  using Number = FixedPoint<Storage, Wide, fractional_bits>;
+
+  static constexpr bool is_fixed_point = true;
+
+  static constexpr Number nan() { return Number::nan(); }
+  static constexpr Number from_float(float value) { return Number(value); }
+  static constexpr float to_float(Number value) { return static_cast<float>(value); }
+  static constexpr bool is_nan(Number value) { return value.is_nan(); }
+  // Saturation is symmetric, so the negation of any value other than NaN is exact
+  static constexpr Number abs(Number value) { return value < Number{} ? -value : value; }
+};
+
+}  // namespace Pufferfish::Util
@@ -0,0 +1,112 @@
+/// \file
+/// \brief A statically-allocated pool of objects of a single type
+///
+/// A pool lends out objects from a fixed set of slots through handles which return their objects
+/// to the pool when they go out of scope, so that large objects can be borrowed from a budget
+/// which is sized at compile time, in any order, instead of being placed on the stack.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "Pufferfish/Statuses.h"
+
+namespace Pufferfish::Util {
+
+/**
+ * A fixed number of slots for objects of type Object.
+ *
+ * Objects are value-initialized when they are acquired and destroyed when their Handle releases
+ * them. The pool records the most objects it has ever had in use at once, so that its capacity
+ * can be checked against real usage.
+ *
+ * A pool must only be used from a single context (e.g. only from the main loop), and it must
+ * outlive every Handle to its objects.
+ */
+template <typename Object, size_t capacity>
+class ObjectPool {
+ public:
+  /// Move-only ownership of an object acquired from the pool, which is released when the Handle
+  /// is destroyed or reassigned
+  class Handle {
+   public:
+    Handle() = default;
+    Handle(Handle &&other) noexcept;
+    Handle &operator=(Handle &&other) noexcept;
+    ~Handle();
+
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+
+    /// Returns whether the Handle currently owns an object
+    [[nodiscard]] bool valid() const;
+    /// Destroys the owned object and returns its slot to the pool, if the Handle owns an object
+    void release();
+
+    // Note: these don't check whether the Handle owns an object!
+    Object &operator*() const;
+    Object *operator->() const;
+
+   private:
+    friend class ObjectPool;
+
+    ObjectPool *pool_ = nullptr;
+    Object *object_ = nullptr;
+    size_t slot_ = 0;
+  };
+
+  ObjectPool() = default;
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] static constexpr size_t max_size() noexcept { return capacity; }
+  [[nodiscard]] size_t available() const;
+  /// The most objects which have been in use at once
+  [[nodiscard]] size_t high_water_mark() const;
+
+  /**
+   * Creates a value-initialized object in a free slot of the pool
+   * @param[out] handle ownership of the object, if a slot was free; any object previously owned
+   * by handle is released first
+   * @return ok on success, out_of_bounds if every slot is in use
+   */
+  IndexStatus acquire(Handle &handle);
+
+ private:
+  using Slot = typename std::aligned_storage<sizeof(Object), alignof(Object)>::type;
+
+  std::array<Slot, capacity> slots_{};
+  // Released slots are kept in a stack; slots from num_touched_ onwards were never acquired, so
+  // they don't need to be put on the stack up front.
+  std::array<size_t, capacity> free_slots_{};
+  size_t num_free_ = 0;
+  size_t num_touched_ = 0;
+  size_t size_ = 0;
+  size_t high_water_mark_ = 0;
+
+  void release(size_t slot);
+};
+
+}  // namespace Pufferfish::Util
+
+#include "ObjectPool.tpp"
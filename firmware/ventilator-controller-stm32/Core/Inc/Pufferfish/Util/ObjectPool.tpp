@@ -0,0 +1,133 @@
+/// \file
+/// \brief A statically-allocated pool of objects of a single type
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <new>
+
+#include "ObjectPool.h"
+
+namespace Pufferfish::Util {
+
+// ObjectPool::Handle
+
+template <typename Object, size_t capacity>
+ObjectPool<Object, capacity>::Handle::Handle(Handle &&other) noexcept
+    : pool_(other.pool_), object_(other.object_), slot_(other.slot_) {
+  other.pool_ = nullptr;
+  other.object_ = nullptr;
+}
+
+template <typename Object, size_t capacity>
+typename ObjectPool<Object, capacity>::Handle &ObjectPool<Object, capacity>::Handle::operator=(
+    Handle &&other) noexcept {
+  if (this != &other) {
+    release();
+    pool_ = other.pool_;
+    object_ = other.object_;
+    slot_ = other.slot_;
+    other.pool_ = nullptr;
+    other.object_ = nullptr;
+  }
+  return *this;
+}
+
+template <typename Object, size_t capacity>
+ObjectPool<Object, capacity>::Handle::~Handle() {
+  release();
+}
+
+template <typename Object, size_t capacity>
+bool ObjectPool<Object, capacity>::Handle::valid() const {
+  return object_ != nullptr;
+}
+
+template <typename Object, size_t capacity>
+void ObjectPool<Object, capacity>::Handle::release() {
+  if (object_ == nullptr) {
+    return;
+  }
+
+  object_->~Object();
+  pool_->release(slot_);
+  pool_ = nullptr;
+  object_ = nullptr;
+}
+
+template <typename Object, size_t capacity>
+Object &ObjectPool<Object, capacity>::Handle::operator*() const {
+  return *object_;
+}
+
+template <typename Object, size_t capacity>
+Object *ObjectPool<Object, capacity>::Handle::operator->() const {
+  return object_;
+}
+
+// ObjectPool
+
+template <typename Object, size_t capacity>
+size_t ObjectPool<Object, capacity>::size() const {
+  return size_;
+}
+
+template <typename Object, size_t capacity>
+size_t ObjectPool<Object, capacity>::available() const {
+  return capacity - size_;
+}
+
+template <typename Object, size_t capacity>
+size_t ObjectPool<Object, capacity>::high_water_mark() const {
+  return high_water_mark_;
+}
+
+template <typename Object, size_t capacity>
+IndexStatus ObjectPool<Object, capacity>::acquire(Handle &handle) {
+  handle.release();
+
+  size_t slot = 0;
+  if (num_free_ > 0) {
+    --num_free_;
+    slot = free_slots_[num_free_];
+  } else if (num_touched_ < capacity) {
+    slot = num_touched_;
+    ++num_touched_;
+  } else {
+    return IndexStatus::out_of_bounds;
+  }
+
+  handle.pool_ = this;
+  handle.object_ = new (&slots_[slot]) Object{};
+  handle.slot_ = slot;
+  ++size_;
+  if (size_ > high_water_mark_) {
+    high_water_mark_ = size_;
+  }
+  return IndexStatus::ok;
+}
+
+template <typename Object, size_t capacity>
+void ObjectPool<Object, capacity>::release(size_t slot) {
+  free_slots_[num_free_] = slot;
+  ++num_free_;
+  --size_;
+}
+
+}  // namespace Pufferfish::Util
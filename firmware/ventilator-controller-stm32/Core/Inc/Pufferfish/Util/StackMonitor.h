@@ -0,0 +1,78 @@
+/// \file
+/// \brief Stack high-water mark measurement by stack painting
+///
+/// The unused part of the stack is filled with a known pattern at startup; the deepest word which
+/// no longer holds the pattern marks the most stack which has ever been used.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pufferfish::Util {
+
+/**
+ * Measures the high-water mark of a descending stack.
+ *
+ * The stack occupies the words from bottom up to (but not including) top, and grows down from top.
+ * Scanning is incremental, so that it can be done a bounded number of words at a time from the
+ * main loop: each pass scans from the bottom of the stack up to the deepest word known to have
+ * been used, so that a used word is found even if the frames above it left gaps of unused words.
+ * A used word which happens to hold the paint pattern is not detected, so the high-water mark
+ * may be underestimated by a few words.
+ */
+class StackMonitor {
+ public:
+  static constexpr uint32_t paint_pattern = 0xa5a5a5a5;
+  // Bytes below the current stack pointer which are left unpainted, for the frames of paint itself
+  // and of any interrupts which occur while the stack is being painted
+  static constexpr size_t paint_guard = 1024;
+
+  StackMonitor(uint32_t *bottom, uint32_t *top);
+
+  /**
+   * Fills the unused part of the stack with the paint pattern
+   * @param stack_pointer the current stack pointer of the caller (e.g. from
+   * __builtin_frame_address(0)); only words below it, and below the paint guard, are painted
+   */
+  void paint(const void *stack_pointer);
+
+  /**
+   * Scans part of the stack for words which no longer hold the paint pattern
+   * @param max_words the most words to check in this call
+   * @return true if the high-water mark increased, false otherwise
+   */
+  bool update(size_t max_words);
+
+  /// Size of the stack, in bytes
+  [[nodiscard]] size_t size() const;
+  /// The most stack which has been used since the stack was painted, in bytes
+  [[nodiscard]] size_t high_water_mark() const;
+
+ private:
+  uint32_t *bottom_;
+  size_t num_words_;
+  // Offset from bottom_ of the deepest word known to have been used
+  size_t used_boundary_;
+  // Offset from bottom_ of the next word to scan in the current pass
+  size_t cursor_ = 0;
+};
+
+}  // namespace Pufferfish::Util
@@ -0,0 +1,64 @@
+/// \file
+/// \brief Timestamped captures of the byte stream received by the backend UART.
+///
+/// A capture is a text file with one event per line, in the form
+///
+///     <time in ms> <bytes as hex pairs, optionally separated by spaces>
+///
+/// Timestamps use the same millisecond clock as the firmware's main loop and must not decrease.
+/// Blank lines and lines starting with '#' are ignored. An event may contain any number of
+/// bytes, so a capture can record individual UART reads or whole frames at once.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Pufferfish::Replay {
+
+struct CaptureEvent {
+  uint32_t time = 0;  // ms
+  std::vector<uint8_t> bytes;
+};
+
+using Capture = std::vector<CaptureEvent>;
+
+enum class CaptureStatus { ok = 0, invalid_time, invalid_bytes, time_decreased };
+
+/**
+ * Parses a capture from a text stream.
+ * @param input the stream to parse
+ * @param capture the parsed events, in order
+ * @param error_line the (1-indexed) line number of the first invalid line, if parsing failed
+ * @return ok on success, otherwise the reason the first invalid line was rejected
+ */
+CaptureStatus read_capture(std::istream &input, Capture &capture, size_t &error_line);
+
+/// Writes a capture as text which read_capture can parse
+void write_capture(std::ostream &output, const Capture &capture, const std::string &comment = "");
+
+/// Returns a human-readable name of the status, for error messages
+const char *to_string(CaptureStatus status);
+
+}  // namespace Pufferfish::Replay
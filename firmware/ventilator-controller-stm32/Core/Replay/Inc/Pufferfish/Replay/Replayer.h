@@ -0,0 +1,99 @@
+/// \file
+/// \brief Replays captured backend traffic through UARTBackend on the host.
+///
+/// The replayer feeds a capture into a mock BufferedUART and drives UARTBackend with the same
+/// receive/update_clock/send sequence as the firmware's main loop, advancing a simulated
+/// millisecond clock through the capture's timestamps. Every RX byte is also decoded by a
+/// separate Receiver so that decode errors, which UARTBackend discards, can be classified; the
+/// MCU's TX stream is decoded in the same way. Changes to the Store's states and to the
+/// backend connection status are recorded as they happen.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Pufferfish/Replay/Capture.h"
+
+namespace Pufferfish::Replay {
+
+struct ReplayOptions {
+  // Sleep between clock ticks so that the capture is replayed at its original cadence;
+  // otherwise the capture is replayed as fast as possible.
+  bool paced = false;
+  // Number of main loop iterations to run within each ms, since the firmware's main loop
+  // runs many times per clock tick.
+  uint32_t loop_iterations_per_ms = 10;
+  // Keep running after the last event, e.g. to observe the connection timing out.
+  uint32_t tail_ms = 1000;
+};
+
+struct StreamStats {
+  uint64_t bytes = 0;
+  uint64_t dropped_bytes = 0;  // bytes which didn't fit in the UART buffer
+  uint64_t messages = 0;
+  std::map<std::string, uint64_t> messages_by_type;
+  std::map<std::string, uint64_t> errors;  // keyed by the Receiver status
+};
+
+struct TimedChange {
+  uint32_t time = 0;  // ms
+  std::string name;
+};
+
+struct ReplayReport {
+  uint32_t start_time = 0;  // ms
+  uint32_t end_time = 0;    // ms
+  uint64_t loop_iterations = 0;
+  double wall_time_s = 0;
+
+  StreamStats rx;
+  StreamStats tx;
+
+  std::vector<TimedChange> connection_changes;  // "connected" or "disconnected"
+  std::vector<TimedChange> state_changes;       // name of each Store state which changed
+  std::map<std::string, uint64_t> state_change_counts;
+
+  [[nodiscard]] uint64_t decode_errors() const;
+};
+
+/// Runs the capture through UARTBackend and reports what happened
+ReplayReport replay(const Capture &capture, const ReplayOptions &options);
+
+void write_json(std::ostream &output, const ReplayReport &report);
+
+struct SynthesisOptions {
+  uint32_t duration_ms = 10000;
+  // Every n-th frame has one byte flipped, to exercise the decoder's error handling;
+  // 0 disables corruption.
+  uint32_t corrupt_every = 0;
+};
+
+/**
+ * Generates the traffic which the backend server sends to the MCU: a state segment every
+ * 10 ms, cycling through the backend's MCU output schedule, with a ventilation parameters
+ * change halfway through.
+ */
+Capture synthesize(const SynthesisOptions &options);
+
+}  // namespace Pufferfish::Replay
@@ -0,0 +1,136 @@
+/// \file
+/// \brief Timestamped captures of the byte stream received by the backend UART.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Replay/Capture.h"
+
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+namespace Pufferfish::Replay {
+
+namespace {
+
+bool parse_nibble(char digit, uint8_t &nibble) {
+  static const uint8_t decimal_digits = 10;
+  if (digit >= '0' && digit <= '9') {
+    nibble = static_cast<uint8_t>(digit - '0');
+    return true;
+  }
+  auto lower = static_cast<char>(std::tolower(static_cast<unsigned char>(digit)));
+  if (lower >= 'a' && lower <= 'f') {
+    nibble = static_cast<uint8_t>(lower - 'a' + decimal_digits);
+    return true;
+  }
+  return false;
+}
+
+bool parse_hex(const std::string &text, std::vector<uint8_t> &bytes) {
+  static const uint8_t nibble_width = 4;
+  bytes.clear();
+  bool high_nibble = true;
+  uint8_t byte = 0;
+  for (char digit : text) {
+    if (std::isspace(static_cast<unsigned char>(digit)) != 0) {
+      if (!high_nibble) {
+        return false;  // split byte
+      }
+      continue;
+    }
+    uint8_t nibble = 0;
+    if (!parse_nibble(digit, nibble)) {
+      return false;
+    }
+    if (high_nibble) {
+      byte = static_cast<uint8_t>(nibble << nibble_width);
+    } else {
+      bytes.push_back(byte | nibble);
+    }
+    high_nibble = !high_nibble;
+  }
+  return high_nibble;
+}
+
+}  // namespace
+
+CaptureStatus read_capture(std::istream &input, Capture &capture, size_t &error_line) {
+  capture.clear();
+  error_line = 0;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(input, line)) {
+    ++line_number;
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '#') {
+      continue;
+    }
+
+    error_line = line_number;
+    std::istringstream fields(line.substr(start));
+    CaptureEvent event;
+    if (!(fields >> event.time)) {
+      return CaptureStatus::invalid_time;
+    }
+    if (!capture.empty() && event.time < capture.back().time) {
+      return CaptureStatus::time_decreased;
+    }
+    std::string hex;
+    std::getline(fields, hex);
+    if (!parse_hex(hex, event.bytes)) {
+      return CaptureStatus::invalid_bytes;
+    }
+    capture.push_back(std::move(event));
+  }
+
+  error_line = 0;
+  return CaptureStatus::ok;
+}
+
+void write_capture(std::ostream &output, const Capture &capture, const std::string &comment) {
+  output << "# Pufferfish backend UART capture: <time in ms> <bytes as hex>\n";
+  if (!comment.empty()) {
+    output << "# " << comment << "\n";
+  }
+  output << std::hex << std::setfill('0');
+  for (const CaptureEvent &event : capture) {
+    output << std::dec << event.time << " " << std::hex;
+    for (uint8_t byte : event.bytes) {
+      output << std::setw(2) << static_cast<unsigned int>(byte);
+    }
+    output << "\n";
+  }
+  output << std::dec;
+}
+
+const char *to_string(CaptureStatus status) {
+  switch (status) {
+    case CaptureStatus::ok:
+      return "ok";
+    case CaptureStatus::invalid_time:
+      return "invalid timestamp";
+    case CaptureStatus::invalid_bytes:
+      return "invalid hex bytes";
+    case CaptureStatus::time_decreased:
+      return "timestamp earlier than the previous event";
+  }
+  return "unknown";
+}
+
+}  // namespace Pufferfish::Replay
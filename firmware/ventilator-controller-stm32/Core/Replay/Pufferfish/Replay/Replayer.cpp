@@ -0,0 +1,471 @@
+/// \file
+/// \brief Replays captured backend traffic through UARTBackend on the host.
+///
+/// This is the only translation unit of the Replay executable which includes the backend
+/// transport headers, since they define non-inline functions.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Replay/Replayer.h"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <thread>
+
+#include "Pufferfish/Application/LogEvents.h"
+#include "Pufferfish/Application/States.h"
+#include "Pufferfish/Driver/Serial/Backend/Transport.h"
+#include "Pufferfish/Driver/Serial/Backend/UART.h"
+#include "Pufferfish/HAL/CRCChecker.h"
+#include "Pufferfish/HAL/Mock/BufferedUART.h"
+
+namespace Pufferfish::Replay {
+
+namespace {
+
+namespace BE = Driver::Serial::Backend;
+using Application::MessageTypes;
+using Application::MessageTypeValues;
+using Application::StateSegment;
+
+const char *to_string(MessageTypes type) {
+  switch (type) {
+    case MessageTypes::unknown:
+      return "unknown";
+    case MessageTypes::reserved:
+      return "reserved";
+    case MessageTypes::sensor_measurements:
+      return "sensor_measurements";
+    case MessageTypes::cycle_measurements:
+      return "cycle_measurements";
+    case MessageTypes::parameters:
+      return "parameters";
+    case MessageTypes::parameters_request:
+      return "parameters_request";
+    case MessageTypes::alarm_limits:
+      return "alarm_limits";
+    case MessageTypes::alarm_limits_request:
+      return "alarm_limits_request";
+    case MessageTypes::expected_log_event:
+      return "expected_log_event";
+    case MessageTypes::next_log_events:
+      return "next_log_events";
+    case MessageTypes::active_log_events:
+      return "active_log_events";
+    case MessageTypes::alarm_mute:
+      return "alarm_mute";
+    case MessageTypes::alarm_mute_request:
+      return "alarm_mute_request";
+    case MessageTypes::mcu_power_status:
+      return "mcu_power_status";
+    case MessageTypes::backend_connections:
+      return "backend_connections";
+    case MessageTypes::screen_status:
+      return "screen_status";
+    case MessageTypes::screen_status_request:
+      return "screen_status_request";
+    case MessageTypes::mcu_diagnostics:
+      return "mcu_diagnostics";
+    case MessageTypes::pleth_waveform:
+      return "pleth_waveform";
+    case MessageTypes::i2c_diagnostics:
+      return "i2c_diagnostics";
+  }
+  return "unrecognized";
+}
+
+const char *to_string(BE::Receiver::InputStatus status) {
+  switch (status) {
+    case BE::Receiver::InputStatus::ok:
+      return "ok";
+    case BE::Receiver::InputStatus::output_ready:
+      return "output_ready";
+    case BE::Receiver::InputStatus::invalid_frame_length:
+      return "invalid_frame_length";
+    case BE::Receiver::InputStatus::input_overwritten:
+      return "input_overwritten";
+  }
+  return "unrecognized";
+}
+
+const char *to_string(BE::Receiver::OutputStatus status) {
+  switch (status) {
+    case BE::Receiver::OutputStatus::available:
+      return "available";
+    case BE::Receiver::OutputStatus::waiting:
+      return "waiting";
+    case BE::Receiver::OutputStatus::invalid_frame_length:
+      return "invalid_frame_length";
+    case BE::Receiver::OutputStatus::invalid_frame_encoding:
+      return "invalid_frame_encoding";
+    case BE::Receiver::OutputStatus::invalid_crcelement_parse:
+      return "invalid_crcelement_parse";
+    case BE::Receiver::OutputStatus::invalid_crcelement_crc:
+      return "invalid_crcelement_crc";
+    case BE::Receiver::OutputStatus::invalid_datagram_parse:
+      return "invalid_datagram_parse";
+    case BE::Receiver::OutputStatus::invalid_datagram_length:
+      return "invalid_datagram_length";
+    case BE::Receiver::OutputStatus::invalid_datagram_sequence:
+      return "invalid_datagram_sequence";
+    case BE::Receiver::OutputStatus::invalid_message_length:
+      return "invalid_message_length";
+    case BE::Receiver::OutputStatus::invalid_message_type:
+      return "invalid_message_type";
+    case BE::Receiver::OutputStatus::invalid_message_encoding:
+      return "invalid_message_encoding";
+    case BE::Receiver::OutputStatus::insufficient_scratch:
+      return "insufficient_scratch";
+  }
+  return "unrecognized";
+}
+
+// Decodes a byte stream independently of UARTBackend, to classify the errors in it
+class StreamDecoder {
+ public:
+  explicit StreamDecoder(HAL::Interfaces::CRC32 &crc32c) : receiver_(crc32c, scratch_) {}
+
+  void input(uint8_t new_byte, StreamStats &stats) {
+    auto input_status = receiver_.input(new_byte);
+    switch (input_status) {
+      case BE::Receiver::InputStatus::output_ready:
+        break;
+      case BE::Receiver::InputStatus::ok:
+        return;
+      case BE::Receiver::InputStatus::invalid_frame_length:
+      case BE::Receiver::InputStatus::input_overwritten:
+        ++stats.errors[to_string(input_status)];
+        return;
+    }
+
+    auto output_status = receiver_.output(message_);
+    switch (output_status) {
+      case BE::Receiver::OutputStatus::waiting:
+        return;
+      case BE::Receiver::OutputStatus::invalid_datagram_sequence:
+        // The backend still accepts messages with unexpected sequence numbers
+        ++stats.errors[to_string(output_status)];
+        count_message(stats);
+        return;
+      case BE::Receiver::OutputStatus::available:
+        count_message(stats);
+        return;
+      default:
+        ++stats.errors[to_string(output_status)];
+        return;
+    }
+  }
+
+ private:
+  BE::ScratchArena scratch_;
+  BE::Receiver receiver_;
+  BE::Message message_;
+
+  void count_message(StreamStats &stats) const {
+    ++stats.messages;
+    ++stats.messages_by_type[to_string(message_.payload.tag)];
+  }
+};
+
+// Records changes to every state in the Store
+class StateTracker {
+ public:
+  explicit StateTracker(const Application::Store &store) : store_(store) {
+    for (size_t i = 0; i < snapshots_.size(); ++i) {
+      auto type = static_cast<MessageTypes>(i);
+      tracked_[i] = MessageTypeValues::includes(type) && type != MessageTypes::unknown &&
+                    store_.output(type, snapshots_[i]) == Application::Store::Status::ok;
+    }
+  }
+
+  void update(uint32_t current_time, ReplayReport &report) {
+    StateSegment current;
+    for (size_t i = 0; i < snapshots_.size(); ++i) {
+      auto type = static_cast<MessageTypes>(i);
+      if (!tracked_[i] || store_.output(type, current) != Application::Store::Status::ok ||
+          current == snapshots_[i]) {
+        continue;
+      }
+
+      snapshots_[i] = current;
+      report.state_changes.push_back(TimedChange{current_time, to_string(type)});
+      ++report.state_change_counts[to_string(type)];
+    }
+  }
+
+ private:
+  static const size_t num_types = MessageTypeValues::max() + 1;
+
+  const Application::Store &store_;
+  std::array<StateSegment, num_types> snapshots_{};
+  std::array<bool, num_types> tracked_{};
+};
+
+// The components of the firmware's backend communication, as set up in main.cpp
+struct Firmware {
+  HAL::SoftCRC32 crc32c{HAL::crc32c_params};
+  Application::Store store;
+  Application::LogEventsSender log_events_sender;
+  volatile HAL::Mock::LargeBufferedUART uart;
+  BE::UARTBackend backend{uart, crc32c, store, log_events_sender};
+};
+
+}  // namespace
+
+uint64_t ReplayReport::decode_errors() const {
+  uint64_t total = 0;
+  for (const auto &error : rx.errors) {
+    total += error.second;
+  }
+  return total;
+}
+
+ReplayReport replay(const Capture &capture, const ReplayOptions &options) {
+  using Clock = std::chrono::steady_clock;
+
+  // The firmware's objects are too large to comfortably keep on the stack
+  auto firmware = std::make_unique<Firmware>();
+  auto rx_decoder = std::make_unique<StreamDecoder>(firmware->crc32c);
+  auto tx_decoder = std::make_unique<StreamDecoder>(firmware->crc32c);
+  auto state_tracker = std::make_unique<StateTracker>(firmware->store);
+
+  ReplayReport report;
+  report.start_time = capture.empty() ? 0 : capture.front().time;
+  report.end_time = (capture.empty() ? 0 : capture.back().time) + options.tail_ms;
+
+  auto next_event = capture.begin();
+  bool connected = false;
+  auto wall_start = Clock::now();
+  for (uint32_t current_time = report.start_time;; ++current_time) {
+    if (options.paced) {
+      std::this_thread::sleep_until(
+          wall_start + std::chrono::milliseconds(current_time - report.start_time));
+    }
+
+    // UART RX
+    for (; next_event != capture.end() && next_event->time <= current_time; ++next_event) {
+      for (uint8_t byte : next_event->bytes) {
+        ++report.rx.bytes;
+        rx_decoder->input(byte, report.rx);
+        if (firmware->uart.set_read(byte) != BufferStatus::ok) {
+          ++report.rx.dropped_bytes;
+        }
+      }
+    }
+
+    // Main loop
+    for (uint32_t i = 0; i < options.loop_iterations_per_ms; ++i) {
+      firmware->backend.receive();
+      firmware->backend.update_clock(current_time);
+      firmware->backend.send();
+      firmware->store.backend_connected() = firmware->backend.connected();
+      ++report.loop_iterations;
+
+      // UART TX
+      uint8_t byte = 0;
+      while (firmware->uart.get_write(byte) == BufferStatus::ok) {
+        ++report.tx.bytes;
+        tx_decoder->input(byte, report.tx);
+      }
+    }
+
+    if (firmware->backend.connected() != connected) {
+      connected = firmware->backend.connected();
+      report.connection_changes.push_back(
+          TimedChange{current_time, connected ? "connected" : "disconnected"});
+    }
+    state_tracker->update(current_time, report);
+
+    if (current_time == report.end_time) {
+      break;
+    }
+  }
+  report.wall_time_s = std::chrono::duration<double>(Clock::now() - wall_start).count();
+  return report;
+}
+
+namespace {
+
+void write_json(std::ostream &output, const std::map<std::string, uint64_t> &counts) {
+  output << "{";
+  bool first = true;
+  for (const auto &count : counts) {
+    output << (first ? "" : ", ") << "\"" << count.first << "\": " << count.second;
+    first = false;
+  }
+  output << "}";
+}
+
+void write_json(std::ostream &output, const std::vector<TimedChange> &changes) {
+  output << "[";
+  for (size_t i = 0; i < changes.size(); ++i) {
+    output << (i == 0 ? "\n" : ",\n");
+    output << "    {\"time\": " << changes[i].time << ", \"name\": \"" << changes[i].name << "\"}";
+  }
+  output << (changes.empty() ? "]" : "\n  ]");
+}
+
+void write_json(std::ostream &output, const StreamStats &stats, double duration_s) {
+  output << "{";
+  output << "\"bytes\": " << stats.bytes << ", ";
+  output << "\"dropped_bytes\": " << stats.dropped_bytes << ", ";
+  output << "\"messages\": " << stats.messages << ", ";
+  output << "\"bytes_per_s\": " << static_cast<double>(stats.bytes) / duration_s << ", ";
+  output << "\"messages_per_s\": " << static_cast<double>(stats.messages) / duration_s << ", ";
+  output << "\"messages_by_type\": ";
+  write_json(output, stats.messages_by_type);
+  output << ", \"errors\": ";
+  write_json(output, stats.errors);
+  output << "}";
+}
+
+}  // namespace
+
+void write_json(std::ostream &output, const ReplayReport &report) {
+  static const double ms_per_s = 1000;
+  double duration_s = static_cast<double>(report.end_time - report.start_time + 1) / ms_per_s;
+
+  output << std::setprecision(6);
+  output << "{\n";
+  output << "  \"start_time\": " << report.start_time << ",\n";
+  output << "  \"end_time\": " << report.end_time << ",\n";
+  output << "  \"loop_iterations\": " << report.loop_iterations << ",\n";
+  output << "  \"wall_time_s\": " << report.wall_time_s << ",\n";
+  output << "  \"speedup\": " << duration_s / report.wall_time_s << ",\n";
+  output << "  \"ns_per_loop_iteration\": "
+         << report.wall_time_s * 1e9 / static_cast<double>(report.loop_iterations) << ",\n";
+  output << "  \"decode_errors\": " << report.decode_errors() << ",\n";
+  output << "  \"rx\": ";
+  write_json(output, report.rx, duration_s);
+  output << ",\n  \"tx\": ";
+  write_json(output, report.tx, duration_s);
+  output << ",\n  \"state_change_counts\": ";
+  write_json(output, report.state_change_counts);
+  output << ",\n  \"connection_changes\": ";
+  write_json(output, report.connection_changes);
+  output << ",\n  \"state_changes\": ";
+  write_json(output, report.state_changes);
+  output << "\n}\n";
+}
+
+// Synthesis
+
+namespace {
+
+// The MCU output schedule of the backend server (see ventserver/protocols/backend/states.py)
+const auto backend_output_sched = Util::Containers::make_array<MessageTypes>(
+    MessageTypes::expected_log_event,
+    MessageTypes::parameters_request,
+    MessageTypes::alarm_limits_request,
+    MessageTypes::alarm_mute_request,
+    MessageTypes::screen_status_request,
+    MessageTypes::backend_connections);
+const uint32_t backend_output_interval = 10;  // ms
+
+// Requests are timestamped when the frontend changes them, not when they're sent
+StateSegment make_segment(MessageTypes type, uint32_t change_time, bool ventilating) {
+  static const float room_air_fio2 = 21;
+  static const float hfnc_fio2 = 40;
+  static const float hfnc_flow = 30;
+
+  StateSegment segment;
+  switch (type) {
+    case MessageTypes::parameters_request: {
+      Application::ParametersRequest request{};
+      request.time = ventilating ? change_time : 0;
+      request.mode = Application::VentilationMode_hfnc;
+      request.ventilating = ventilating;
+      request.fio2 = ventilating ? hfnc_fio2 : room_air_fio2;
+      request.flow = ventilating ? hfnc_flow : 0;
+      segment.set(request);
+      break;
+    }
+    case MessageTypes::alarm_limits_request: {
+      Application::AlarmLimitsRequest request{};
+      request.has_fio2 = true;
+      request.fio2 = {21, 100};  // NOLINT(readability-magic-numbers)
+      request.has_flow = true;
+      request.flow = {0, 80};  // NOLINT(readability-magic-numbers)
+      request.has_spo2 = true;
+      request.spo2 = {90, 100};  // NOLINT(readability-magic-numbers)
+      request.has_hr = true;
+      request.hr = {60, 100};  // NOLINT(readability-magic-numbers)
+      segment.set(request);
+      break;
+    }
+    case MessageTypes::alarm_mute_request: {
+      Application::AlarmMuteRequest request{};
+      request.source = Application::AlarmMuteSource_initialization;
+      segment.set(request);
+      break;
+    }
+    case MessageTypes::screen_status_request:
+      segment.set(Application::ScreenStatusRequest{});
+      break;
+    case MessageTypes::backend_connections: {
+      Application::BackendConnections connections{};
+      connections.has_mcu = true;
+      connections.has_frontend = true;
+      segment.set(connections);
+      break;
+    }
+    case MessageTypes::expected_log_event:
+    default:
+      segment.set(Application::ExpectedLogEvent{});
+      break;
+  }
+  return segment;
+}
+
+}  // namespace
+
+Capture synthesize(const SynthesisOptions &options) {
+  static const uint8_t corruption_mask = 0x55;
+
+  HAL::SoftCRC32 crc32c{HAL::crc32c_params};
+  auto scratch = std::make_unique<BE::ScratchArena>();
+  auto sender = std::make_unique<BE::Sender>(crc32c, *scratch);
+  BE::FrameProps::ChunkBuffer chunk;
+
+  Capture capture;
+  size_t frame = 0;
+  for (uint32_t current_time = 0; current_time < options.duration_ms;
+       current_time += backend_output_interval, ++frame) {
+    MessageTypes type = backend_output_sched[frame % backend_output_sched.size()];
+    uint32_t change_time = options.duration_ms / 2;
+    bool ventilating = current_time >= change_time;
+    if (sender->transform(make_segment(type, change_time, ventilating), chunk) !=
+        BE::Sender::Status::ok) {
+      continue;
+    }
+
+    CaptureEvent event;
+    event.time = current_time;
+    event.bytes.assign(chunk.buffer(), chunk.buffer() + chunk.size());
+    if (options.corrupt_every > 0 && (frame + 1) % options.corrupt_every == 0) {
+      // never corrupt the frame delimiter at the end of the chunk
+      event.bytes[event.bytes.size() / 2] ^= corruption_mask;
+    }
+    capture.push_back(std::move(event));
+  }
+  return capture;
+}
+
+}  // namespace Pufferfish::Replay
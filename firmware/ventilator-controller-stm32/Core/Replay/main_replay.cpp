@@ -0,0 +1,155 @@
+/// \file
+/// \brief Replays a capture of backend UART traffic through UARTBackend, or synthesizes one.
+///
+/// Usage:
+///   Replay <capture.txt> [--paced] [--loop-iterations <n>] [--tail <ms>] [--max-errors <n>]
+///          [--out <report.json>]
+///   Replay --synthesize <duration ms> [--corrupt-every <n>] [--out <capture.txt>]
+///
+/// The replay report is written as JSON to stdout unless an output file is given. If
+/// --max-errors is given, the exit status is nonzero when the capture contains more decode
+/// errors than that, so that replays can be used as regression tests.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Pufferfish/Replay/Capture.h"
+#include "Pufferfish/Replay/Replayer.h"
+
+namespace {
+
+namespace Replay = Pufferfish::Replay;
+
+struct Arguments {
+  std::string capture_path;
+  std::string output_path;
+  Replay::ReplayOptions replay;
+  Replay::SynthesisOptions synthesis;
+  bool synthesize = false;
+  bool check_errors = false;
+  uint64_t max_errors = 0;
+};
+
+bool parse_arguments(int argc, char *argv[], Arguments &arguments) {
+  for (int i = 1; i < argc; ++i) {
+    std::string flag = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag == "--paced") {
+      arguments.replay.paced = true;
+      continue;
+    }
+    if (flag.rfind("--", 0) != 0) {
+      arguments.capture_path = flag;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << flag << std::endl;
+      return false;
+    }
+
+    std::string value = argv[++i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag == "--loop-iterations") {
+      arguments.replay.loop_iterations_per_ms = std::stoul(value);
+    } else if (flag == "--tail") {
+      arguments.replay.tail_ms = std::stoul(value);
+    } else if (flag == "--max-errors") {
+      arguments.check_errors = true;
+      arguments.max_errors = std::stoull(value);
+    } else if (flag == "--synthesize") {
+      arguments.synthesize = true;
+      arguments.synthesis.duration_ms = std::stoul(value);
+    } else if (flag == "--corrupt-every") {
+      arguments.synthesis.corrupt_every = std::stoul(value);
+    } else if (flag == "--out") {
+      arguments.output_path = value;
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+      return false;
+    }
+  }
+
+  if (!arguments.synthesize && arguments.capture_path.empty()) {
+    std::cerr << "No capture file given" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename Writer>
+int write_output(const std::string &output_path, Writer writer) {
+  if (output_path.empty()) {
+    writer(std::cout);
+    return EXIT_SUCCESS;
+  }
+
+  std::ofstream output_file(output_path);
+  if (!output_file) {
+    std::cerr << "Couldn't open " << output_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  writer(output_file);
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Arguments arguments;
+  if (!parse_arguments(argc, argv, arguments)) {
+    return EXIT_FAILURE;
+  }
+
+  if (arguments.synthesize) {
+    Replay::Capture capture = Replay::synthesize(arguments.synthesis);
+    return write_output(arguments.output_path, [&capture](std::ostream &output) {
+      Replay::write_capture(output, capture, "synthesized backend server output");
+    });
+  }
+
+  std::ifstream capture_file(arguments.capture_path);
+  if (!capture_file) {
+    std::cerr << "Couldn't open " << arguments.capture_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  Replay::Capture capture;
+  size_t error_line = 0;
+  Replay::CaptureStatus status = Replay::read_capture(capture_file, capture, error_line);
+  if (status != Replay::CaptureStatus::ok) {
+    std::cerr << arguments.capture_path << ":" << error_line << ": " << Replay::to_string(status)
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  Replay::ReplayReport report = Replay::replay(capture, arguments.replay);
+  int result = write_output(arguments.output_path, [&report](std::ostream &output) {
+    Replay::write_json(output, report);
+  });
+  if (result != EXIT_SUCCESS) {
+    return result;
+  }
+
+  if (arguments.check_errors && report.decode_errors() > arguments.max_errors) {
+    std::cerr << report.decode_errors() << " decode errors, more than the maximum of "
+              << arguments.max_errors << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
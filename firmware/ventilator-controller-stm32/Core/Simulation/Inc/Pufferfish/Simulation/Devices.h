@@ -0,0 +1,132 @@
+/// \file
+/// \brief Simulated HAL devices through which the firmware drives the breathing circuit model.
+///
+/// Valve implements the PWM interface of a proportional valve's driver, FlowSensor emulates the
+/// I2C command set of a Sensirion SFM3019 so that the real SFM3019 driver can be run against it,
+/// and Clock is a Time whose delays advance simulated time instead of blocking.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Pufferfish/Driver/I2C/SFM3019/Types.h"
+#include "Pufferfish/HAL/CRCChecker.h"
+#include "Pufferfish/HAL/Interfaces/I2CDevice.h"
+#include "Pufferfish/HAL/Interfaces/PWM.h"
+#include "Pufferfish/HAL/Interfaces/Time.h"
+
+namespace Pufferfish::Simulation {
+
+/// A simulated clock, which only advances when it's told to or when the firmware delays
+class Clock : public HAL::Interfaces::Time {
+ public:
+  uint32_t millis() override;
+  void delay(uint32_t ms) override;
+  uint32_t micros() override;
+  void delay_micros(uint32_t microseconds) override;
+
+  void advance_micros(uint32_t microseconds);
+  /// Microseconds which have passed since the previous call, e.g. from delays
+  uint32_t take_elapsed_micros();
+
+ private:
+  uint64_t micros_ = 0;
+  uint64_t prev_elapsed_micros_ = 0;
+};
+
+/// The PWM driver of a proportional valve, whose opening is its duty cycle while it's started
+class Valve : public HAL::Interfaces::PWM {
+ public:
+  uint32_t get_max_duty_cycle() override;
+  PWMStatus start() override;
+  PWMStatus stop() override;
+
+  /// Fraction of the valve's full opening, from 0 to 1
+  [[nodiscard]] float opening() const;
+
+ protected:
+  void set_duty_cycle_raw(uint32_t duty) override;
+
+ private:
+  static const uint32_t max_duty_cycle = 10000;
+
+  bool started_ = false;
+  uint32_t duty_ = 0;
+};
+
+/**
+ * An emulation of the I2C interface of a Sensirion SFM3019 flow sensor, which reports the flow
+ * given to it by the plant model. It implements the commands used by the SFM3019 driver,
+ * including the CRCs of every word it returns. The driver's general-call reset is sent to a
+ * separate I2C address, which is emulated by general_call().
+ */
+class FlowSensor : public HAL::Interfaces::I2CDevice {
+ public:
+  static const uint32_t product_number = 0x04020611;
+  static const int16_t scale_factor = 170;
+  static const int16_t offset = -24576;
+
+  explicit FlowSensor(Driver::I2C::SFM3019::GasType gas);
+
+  I2CDeviceStatus read(uint8_t *buf, size_t count) override;
+  I2CDeviceStatus read(uint16_t address, uint8_t *buf, size_t count) override;
+  I2CDeviceStatus write(uint8_t *buf, size_t count) override;
+
+  /// The I2C general-call address of the sensor's bus
+  HAL::Interfaces::I2CDevice &general_call();
+
+  /// Sets the flow which the sensor currently measures
+  void set_flow(float flow);  // L/min
+  [[nodiscard]] bool measuring() const;
+
+ private:
+  class GeneralCall : public HAL::Interfaces::I2CDevice {
+   public:
+    explicit GeneralCall(FlowSensor &sensor) : sensor_(sensor) {}
+
+    I2CDeviceStatus read(uint8_t *buf, size_t count) override;
+    I2CDeviceStatus read(uint16_t address, uint8_t *buf, size_t count) override;
+    I2CDeviceStatus write(uint8_t *buf, size_t count) override;
+
+   private:
+    FlowSensor &sensor_;
+  };
+
+  enum class Response { none, product_number, conversion_factors };
+
+  static const size_t max_words = 3;
+
+  const Driver::I2C::SFM3019::GasType gas_;
+  HAL::SoftCRC8 crc8_;
+  GeneralCall general_call_{*this};
+
+  Response response_ = Response::none;
+  bool measuring_ = false;
+  int16_t raw_flow_ = offset;
+
+  void reset();
+  // Writes words with their CRCs into buf, as the sensor would send them
+  I2CDeviceStatus respond(
+      const std::array<uint16_t, max_words> &words, size_t num_words, uint8_t *buf, size_t count);
+};
+
+}  // namespace Pufferfish::Simulation
@@ -0,0 +1,92 @@
+/// \file
+/// \brief A model of the HFNC breathing circuit's valves, gas mixing and flow sensors.
+///
+/// Each proportional valve has a static flow characteristic, scaled by its supply pressure and
+/// shifted by its deadband, followed by first-order flow dynamics. The two gas streams mix in a
+/// volume whose O2 fraction relaxes towards the fraction of the inflow with a time constant of
+/// the volume divided by the total flow. Each flow sensor sees its stream through a first-order
+/// lag, with Gaussian measurement noise. All noise comes from a seeded generator, so every run of
+/// a scenario is reproducible.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+#include "Pufferfish/Simulation/Devices.h"
+
+namespace Pufferfish::Simulation {
+
+struct ValveParameters {
+  // Supply pressure relative to the nominal supply pressure, which scales the valve's flow
+  float supply_scale = 1;
+  // Opening by which the valve's deadband is wider than the nominal valve's
+  float deadband_shift = 0;
+  float time_constant = 20;  // ms
+};
+
+struct PlantParameters {
+  ValveParameters air;
+  ValveParameters o2;
+  float mixing_volume = 0.2;         // L
+  float sensor_time_constant = 0.5;  // ms
+  float sensor_noise = 0.1;          // L/min, standard deviation
+  uint32_t seed = 1;
+};
+
+class Plant {
+ public:
+  explicit Plant(const PlantParameters &parameters);
+
+  /// Advances the model by elapsed time, with the valve openings held constant
+  void step(uint32_t elapsed_us);
+
+  Valve &valve_air() { return valve_air_; }
+  Valve &valve_o2() { return valve_o2_; }
+  FlowSensor &sensor_air() { return sensor_air_; }
+  FlowSensor &sensor_o2() { return sensor_o2_; }
+
+  [[nodiscard]] float flow_air() const { return flow_air_; }  // L/min
+  [[nodiscard]] float flow_o2() const { return flow_o2_; }    // L/min
+  [[nodiscard]] float flow() const { return flow_air_ + flow_o2_; }
+  [[nodiscard]] float fio2() const { return fio2_; }  // %
+
+  /// Steady-state flow through the nominal valve at an opening, at the nominal supply pressure
+  static float nominal_valve_flow(float opening);  // L/min
+
+ private:
+  const PlantParameters parameters_;
+
+  Valve valve_air_;
+  Valve valve_o2_;
+  FlowSensor sensor_air_{Driver::I2C::SFM3019::GasType::air};
+  FlowSensor sensor_o2_{Driver::I2C::SFM3019::GasType::o2};
+
+  float flow_air_ = 0;
+  float flow_o2_ = 0;
+  float sensed_flow_air_ = 0;
+  float sensed_flow_o2_ = 0;
+  float fio2_;
+
+  std::mt19937 noise_generator_;
+  std::normal_distribution<float> noise_;
+};
+
+}  // namespace Pufferfish::Simulation
@@ -0,0 +1,96 @@
+/// \file
+/// \brief Runs HFNCControlLoop in closed loop with the breathing circuit model.
+///
+/// Each scenario sets up the real SFM3019 drivers against the simulated sensors, holds an
+/// initial flow setpoint until the flow has settled, and then steps the flow setpoint and
+/// records the plant's response. The firmware is stepped every tick of simulated time, as its
+/// main loop would be, and the wall time of every control step of HFNCControlLoop is measured.
+/// Scenarios run as fast as the host allows, so thousands of them can be run for controller
+/// tuning.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Pufferfish/Simulation/Plant.h"
+
+namespace Pufferfish::Simulation {
+
+enum class ControllerType { pi, feedforward };
+
+struct SimulationOptions {
+  ControllerType controller = ControllerType::feedforward;
+  bool prefilter_flows = true;
+  uint32_t tick_us = 100;            // us of simulated time between main loop iterations
+  uint32_t initial_duration = 1000;  // ms at the initial setpoint, before the step
+  uint32_t step_duration = 3000;     // ms after the step
+  uint32_t steady_duration = 500;    // ms at the end, over which steady-state error is measured
+};
+
+struct Scenario {
+  float initial_flow = 0;  // L/min
+  float flow = 40;         // L/min
+  float fio2 = 21;         // %
+  PlantParameters plant;
+};
+
+struct ScenarioResult {
+  Scenario scenario;
+  // Whether the valves can deliver the flow setpoint at all, at their supply pressures; the
+  // response to an unreachable setpoint isn't included in the settling statistics
+  bool reachable = false;
+  bool sensors_ok = false;
+  bool settled = false;
+  float settling_time = 0;       // ms after the step, until the flow stays within the band
+  float overshoot = 0;           // L/min past the setpoint, in the direction of the step
+  float steady_state_error = 0;  // L/min, mean absolute error at the end
+  float fio2_error = 0;          // %, absolute error at the end
+  uint64_t control_steps = 0;
+  double control_wall_time_ns = 0;      // total wall time of the control steps
+  double max_control_wall_time_ns = 0;  // longest control step
+};
+
+struct SimulationReport {
+  SimulationOptions options;
+  std::vector<ScenarioResult> results;
+  double wall_time_s = 0;
+  double simulated_time_s = 0;
+};
+
+/// Settling band around the flow setpoint, in L/min
+float settling_band(float flow);
+/// Whether both valves can deliver their shares of the scenario's flow setpoint
+bool reachable(const Scenario &scenario);
+
+ScenarioResult run(const Scenario &scenario, const SimulationOptions &options);
+SimulationReport run(const std::vector<Scenario> &scenarios, const SimulationOptions &options);
+
+/// Generates scenarios with flow steps, FiO2 setpoints and plant variations drawn at random
+std::vector<Scenario> generate_scenarios(size_t count, uint32_t seed);
+
+/// Writes aggregate statistics, and the result of every scenario if details is set
+void write_json(std::ostream &output, const SimulationReport &report, bool details);
+
+const char *to_string(ControllerType type);
+
+}  // namespace Pufferfish::Simulation
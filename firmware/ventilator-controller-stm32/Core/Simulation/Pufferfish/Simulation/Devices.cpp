@@ -0,0 +1,242 @@
+/// \file
+/// \brief Simulated HAL devices through which the firmware drives the breathing circuit model.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Simulation/Devices.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Pufferfish/Util/Bytes.h"
+
+namespace Pufferfish::Simulation {
+
+namespace SFM3019 = Driver::I2C::SFM3019;
+
+// Clock
+
+uint32_t Clock::millis() {
+  static const uint64_t us_per_ms = 1000;
+  return static_cast<uint32_t>(micros_ / us_per_ms);
+}
+
+void Clock::delay(uint32_t ms) {
+  static const uint32_t us_per_ms = 1000;
+  micros_ += static_cast<uint64_t>(ms) * us_per_ms;
+}
+
+uint32_t Clock::micros() {
+  return static_cast<uint32_t>(micros_);
+}
+
+void Clock::delay_micros(uint32_t microseconds) {
+  micros_ += microseconds;
+}
+
+void Clock::advance_micros(uint32_t microseconds) {
+  micros_ += microseconds;
+}
+
+uint32_t Clock::take_elapsed_micros() {
+  auto elapsed = static_cast<uint32_t>(micros_ - prev_elapsed_micros_);
+  prev_elapsed_micros_ = micros_;
+  return elapsed;
+}
+
+// Valve
+
+uint32_t Valve::get_max_duty_cycle() {
+  return max_duty_cycle;
+}
+
+PWMStatus Valve::start() {
+  started_ = true;
+  return PWMStatus::ok;
+}
+
+PWMStatus Valve::stop() {
+  started_ = false;
+  return PWMStatus::ok;
+}
+
+float Valve::opening() const {
+  if (!started_) {
+    return 0;
+  }
+  return static_cast<float>(duty_) / max_duty_cycle;
+}
+
+void Valve::set_duty_cycle_raw(uint32_t duty) {
+  duty_ = duty;
+}
+
+// FlowSensor
+
+namespace {
+
+constexpr HAL::CRC8Parameters sensirion_crc_params = {0x31, 0xff, false, false, 0x00};
+
+uint16_t read_word(const uint8_t *buf) {
+  return static_cast<uint16_t>((static_cast<uint16_t>(buf[0]) << 8U) | buf[1]);
+}
+
+}  // namespace
+
+FlowSensor::FlowSensor(SFM3019::GasType gas) : gas_(gas), crc8_(sensirion_crc_params) {}
+
+I2CDeviceStatus FlowSensor::read(uint8_t *buf, size_t count) {
+  switch (response_) {
+    case Response::product_number:
+      response_ = Response::none;
+      return respond(
+          {static_cast<uint16_t>(product_number >> 16U),
+           static_cast<uint16_t>(product_number & 0xffffU),
+           0},
+          2,
+          buf,
+          count);
+    case Response::conversion_factors:
+      response_ = Response::none;
+      return respond(
+          {static_cast<uint16_t>(scale_factor),
+           static_cast<uint16_t>(offset),
+           SFM3019::make_flow_unit(
+               SFM3019::UnitPrefix::none,
+               SFM3019::TimeBase::per_min,
+               SFM3019::Unit::standard_liter_20deg)},
+          3,
+          buf,
+          count);
+    case Response::none:
+      break;
+  }
+
+  if (!measuring_) {
+    // The sensor doesn't acknowledge reads when it has nothing to send
+    return I2CDeviceStatus::read_error;
+  }
+  return respond({static_cast<uint16_t>(raw_flow_), 0, 0}, 1, buf, count);
+}
+
+I2CDeviceStatus FlowSensor::read(uint16_t /*address*/, uint8_t * /*buf*/, size_t /*count*/) {
+  return I2CDeviceStatus::not_supported;
+}
+
+I2CDeviceStatus FlowSensor::write(uint8_t *buf, size_t count) {
+  if (count < sizeof(uint16_t)) {
+    return I2CDeviceStatus::write_error;
+  }
+
+  auto command = static_cast<SFM3019::Command>(read_word(buf));
+  switch (command) {
+    case SFM3019::Command::read_product_id:
+      response_ = Response::product_number;
+      return I2CDeviceStatus::ok;
+    case SFM3019::Command::read_conversion:
+    case SFM3019::Command::set_averaging: {
+      // These commands have an argument, which is followed by its CRC
+      static const size_t command_with_arg_size = 2 * sizeof(uint16_t) + sizeof(uint8_t);
+      if (count != command_with_arg_size ||
+          crc8_.compute(buf + sizeof(uint16_t), sizeof(uint16_t)) != buf[4]) {
+        return I2CDeviceStatus::write_error;
+      }
+      if (command == SFM3019::Command::read_conversion) {
+        if (read_word(buf + sizeof(uint16_t)) != static_cast<uint16_t>(gas_)) {
+          return I2CDeviceStatus::write_error;
+        }
+        response_ = Response::conversion_factors;
+      }
+      return I2CDeviceStatus::ok;
+    }
+    case SFM3019::Command::stop_measure:
+      measuring_ = false;
+      return I2CDeviceStatus::ok;
+    default:
+      break;
+  }
+
+  if (static_cast<uint16_t>(command) == static_cast<uint16_t>(gas_)) {
+    measuring_ = true;
+    response_ = Response::none;
+    return I2CDeviceStatus::ok;
+  }
+  return I2CDeviceStatus::write_error;
+}
+
+HAL::Interfaces::I2CDevice &FlowSensor::general_call() {
+  return general_call_;
+}
+
+void FlowSensor::set_flow(float flow) {
+  float raw = std::round(flow * scale_factor + offset);
+  if (raw > std::numeric_limits<int16_t>::max()) {
+    raw = std::numeric_limits<int16_t>::max();
+  }
+  if (raw < std::numeric_limits<int16_t>::min()) {
+    raw = std::numeric_limits<int16_t>::min();
+  }
+  raw_flow_ = static_cast<int16_t>(raw);
+}
+
+bool FlowSensor::measuring() const {
+  return measuring_;
+}
+
+void FlowSensor::reset() {
+  response_ = Response::none;
+  measuring_ = false;
+}
+
+I2CDeviceStatus FlowSensor::respond(
+    const std::array<uint16_t, max_words> &words, size_t num_words, uint8_t *buf, size_t count) {
+  static const size_t word_size = sizeof(uint16_t) + sizeof(uint8_t);
+  if (count > num_words * word_size || count % word_size != 0) {
+    return I2CDeviceStatus::read_error;
+  }
+
+  for (size_t i = 0; i < count / word_size; ++i) {
+    uint8_t *word = buf + i * word_size;
+    word[0] = Util::get_byte<1>(words[i]);
+    word[1] = Util::get_byte<0>(words[i]);
+    word[2] = crc8_.compute(word, sizeof(uint16_t));
+  }
+  return I2CDeviceStatus::ok;
+}
+
+// FlowSensor::GeneralCall
+
+I2CDeviceStatus FlowSensor::GeneralCall::read(uint8_t * /*buf*/, size_t /*count*/) {
+  return I2CDeviceStatus::read_error;
+}
+
+I2CDeviceStatus FlowSensor::GeneralCall::read(
+    uint16_t /*address*/, uint8_t * /*buf*/, size_t /*count*/) {
+  return I2CDeviceStatus::not_supported;
+}
+
+I2CDeviceStatus FlowSensor::GeneralCall::write(uint8_t *buf, size_t count) {
+  if (count != sizeof(uint8_t) || buf[0] != static_cast<uint8_t>(SFM3019::Command::reset)) {
+    return I2CDeviceStatus::write_error;
+  }
+
+  sensor_.reset();
+  return I2CDeviceStatus::ok;
+}
+
+}  // namespace Pufferfish::Simulation
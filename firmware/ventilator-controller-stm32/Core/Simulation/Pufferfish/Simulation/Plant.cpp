@@ -0,0 +1,107 @@
+/// \file
+/// \brief A model of the HFNC breathing circuit's valves, gas mixing and flow sensors.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Simulation/Plant.h"
+
+#include <cmath>
+
+#include "Pufferfish/Driver/BreathingCircuit/Algorithms.h"
+#include "Pufferfish/Driver/BreathingCircuit/Controller.h"
+
+namespace Pufferfish::Simulation {
+
+namespace {
+
+constexpr float air_fio2 = Driver::BreathingCircuit::allowed_fio2.lower;  // %
+constexpr float o2_fio2 = Driver::BreathingCircuit::allowed_fio2.upper;   // %
+constexpr float us_per_ms = 1000;
+constexpr float ms_per_min = 60000;
+
+// The response of a first-order system over a time step, computed exactly so that the model is
+// stable for any step size
+float first_order_step(float value, float target, float elapsed, float time_constant) {
+  if (time_constant <= 0) {
+    return target;
+  }
+  return value + (1 - std::exp(-elapsed / time_constant)) * (target - value);
+}
+
+float valve_flow(const ValveParameters &parameters, float opening) {
+  if (opening <= 0) {
+    return 0;
+  }
+  return parameters.supply_scale * Plant::nominal_valve_flow(opening - parameters.deadband_shift);
+}
+
+}  // namespace
+
+Plant::Plant(const PlantParameters &parameters)
+    : parameters_(parameters),
+      fio2_(air_fio2),
+      noise_generator_(parameters.seed),
+      noise_(0, parameters.sensor_noise) {}
+
+float Plant::nominal_valve_flow(float opening) {
+  static const Driver::BreathingCircuit::LookupTable<8> characteristic{{{
+      {0, 0},      // opening, L/min
+      {0.2, 0},    // opening, L/min
+      {0.28, 5},   // opening, L/min
+      {0.34, 10},  // opening, L/min
+      {0.45, 20},  // opening, L/min
+      {0.62, 40},  // opening, L/min
+      {0.95, 80},  // opening, L/min
+      {1, 84}      // opening, L/min
+  }}};
+  return characteristic.interpolate(opening);
+}
+
+void Plant::step(uint32_t elapsed_us) {
+  const float elapsed = static_cast<float>(elapsed_us) / us_per_ms;  // ms
+
+  // Valves
+  flow_air_ = first_order_step(
+      flow_air_,
+      valve_flow(parameters_.air, valve_air_.opening()),
+      elapsed,
+      parameters_.air.time_constant);
+  flow_o2_ = first_order_step(
+      flow_o2_,
+      valve_flow(parameters_.o2, valve_o2_.opening()),
+      elapsed,
+      parameters_.o2.time_constant);
+
+  // Gas mixing
+  const float total_flow = flow();
+  if (total_flow > 0) {
+    const float inflow_fio2 = (air_fio2 * flow_air_ + o2_fio2 * flow_o2_) / total_flow;
+    const float mixing_time_constant = parameters_.mixing_volume * ms_per_min / total_flow;
+    fio2_ = first_order_step(fio2_, inflow_fio2, elapsed, mixing_time_constant);
+  }
+
+  // Sensors
+  sensed_flow_air_ =
+      first_order_step(sensed_flow_air_, flow_air_, elapsed, parameters_.sensor_time_constant);
+  sensed_flow_o2_ =
+      first_order_step(sensed_flow_o2_, flow_o2_, elapsed, parameters_.sensor_time_constant);
+  sensor_air_.set_flow(sensed_flow_air_ + noise_(noise_generator_));
+  sensor_o2_.set_flow(sensed_flow_o2_ + noise_(noise_generator_));
+}
+
+}  // namespace Pufferfish::Simulation
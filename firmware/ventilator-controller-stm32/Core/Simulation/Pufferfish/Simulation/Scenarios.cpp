@@ -0,0 +1,354 @@
+/// \file
+/// \brief Runs HFNCControlLoop in closed loop with the breathing circuit model.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Simulation/Scenarios.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+#include "Pufferfish/Driver/BreathingCircuit/ControlLoop.h"
+#include "Pufferfish/Driver/BreathingCircuit/Controller.h"
+#include "Pufferfish/Driver/I2C/SFM3019/Device.h"
+#include "Pufferfish/Driver/I2C/SFM3019/Sensor.h"
+
+namespace Pufferfish::Simulation {
+
+namespace BC = Driver::BreathingCircuit;
+namespace SFM3019 = Driver::I2C::SFM3019;
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+constexpr uint32_t setup_timeout = 1000;  // ms
+constexpr float us_per_ms = 1000;
+
+// Runs the sensors' setup, as the firmware's initializables are run before its main loop
+bool set_up_sensors(SFM3019::Sensor &air, SFM3019::Sensor &o2, Plant &plant, Clock &clock) {
+  while (clock.millis() < setup_timeout) {
+    InitializableState air_state = air.setup();
+    InitializableState o2_state = o2.setup();
+    if (air_state == InitializableState::failed || o2_state == InitializableState::failed) {
+      return false;
+    }
+    if (air_state == InitializableState::ok && o2_state == InitializableState::ok) {
+      return true;
+    }
+
+    plant.step(clock.take_elapsed_micros());
+    clock.advance_micros(static_cast<uint32_t>(us_per_ms));
+  }
+  return false;
+}
+
+template <typename Value>
+double percentile(std::vector<Value> values, double fraction) {
+  if (values.empty()) {
+    return 0;
+  }
+
+  std::sort(values.begin(), values.end());
+  auto index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+  return static_cast<double>(values[index]);
+}
+
+}  // namespace
+
+float settling_band(float flow) {
+  static const float min_band = 1;         // L/min
+  static const float relative_band = 0.05;
+  return std::max(min_band, relative_band * flow);
+}
+
+bool reachable(const Scenario &scenario) {
+  static const float max_opening = 1;
+
+  BC::Parameters parameters{};
+  parameters.ventilating = true;
+  parameters.fio2 = scenario.fio2;
+  parameters.flow = scenario.flow;
+  BC::ActuatorSetpoints setpoints{};
+  BC::transform_hfnc_setpoints(parameters, setpoints);
+
+  auto max_flow = [](const ValveParameters &valve) {
+    return valve.supply_scale * Plant::nominal_valve_flow(max_opening - valve.deadband_shift);
+  };
+  return setpoints.flow_air <= max_flow(scenario.plant.air) &&
+         setpoints.flow_o2 <= max_flow(scenario.plant.o2);
+}
+
+ScenarioResult run(const Scenario &scenario, const SimulationOptions &options) {
+  ScenarioResult result;
+  result.scenario = scenario;
+  result.reachable = reachable(scenario);
+
+  Plant plant(scenario.plant);
+  Clock clock;
+  SFM3019::Device device_air(
+      plant.sensor_air(), plant.sensor_air().general_call(), SFM3019::GasType::air);
+  SFM3019::Sensor sensor_air(device_air, true, clock);
+  SFM3019::Device device_o2(
+      plant.sensor_o2(), plant.sensor_o2().general_call(), SFM3019::GasType::o2);
+  SFM3019::Sensor sensor_o2(device_o2, true, clock);
+
+  BC::Parameters parameters{};
+  parameters.mode = Application::VentilationMode_hfnc;
+  parameters.ventilating = true;
+  parameters.fio2 = scenario.fio2;
+  parameters.flow = scenario.initial_flow;
+  BC::SensorMeasurements sensor_measurements{};
+
+  BC::HFNCController pi_controller;
+  BC::HFNCFeedforwardController feedforward_controller;
+  BC::Controller &controller = (options.controller == ControllerType::pi)
+                                   ? static_cast<BC::Controller &>(pi_controller)
+                                   : static_cast<BC::Controller &>(feedforward_controller);
+  BC::HFNCControlLoop control_loop(
+      parameters,
+      sensor_measurements,
+      sensor_air,
+      sensor_o2,
+      plant.valve_air(),
+      plant.valve_o2(),
+      controller,
+      options.prefilter_flows);
+
+  plant.valve_air().start();
+  plant.valve_air().set_duty_cycle(0);
+  plant.valve_o2().start();
+  plant.valve_o2().set_duty_cycle(0);
+
+  result.sensors_ok = set_up_sensors(sensor_air, sensor_o2, plant, clock);
+  if (!result.sensors_ok) {
+    return result;
+  }
+
+  const uint32_t start_time = clock.millis();
+  const uint32_t step_time = start_time + options.initial_duration;
+  const uint32_t end_time = step_time + options.step_duration;
+  const uint32_t steady_time = end_time - std::min(options.steady_duration, options.step_duration);
+  const float band = settling_band(scenario.flow);
+  const float direction = (scenario.flow >= scenario.initial_flow) ? 1 : -1;
+
+  // Mirrors the control loop's step timer, so that only the calls which run a control step are
+  // timed
+  uint32_t prev_control_time = start_time - BC::ControlLoop::update_interval;
+  float last_outside_band = 0;
+  double steady_error_sum = 0;
+  uint64_t steady_samples = 0;
+  while (clock.millis() < end_time) {
+    const uint32_t current_time = clock.millis();
+    if (current_time >= step_time) {
+      parameters.flow = scenario.flow;
+    }
+
+    if (current_time - prev_control_time >= BC::ControlLoop::update_interval) {
+      SteadyClock::time_point update_start = SteadyClock::now();
+      control_loop.update(current_time);
+      SteadyClock::time_point update_end = SteadyClock::now();
+      double update_ns =
+          std::chrono::duration<double, std::nano>(update_end - update_start).count();
+      result.control_wall_time_ns += update_ns;
+      result.max_control_wall_time_ns = std::max(result.max_control_wall_time_ns, update_ns);
+      ++result.control_steps;
+      prev_control_time = current_time;
+    } else {
+      control_loop.update(current_time);
+    }
+
+    plant.step(clock.take_elapsed_micros());
+    clock.advance_micros(options.tick_us);
+
+    if (current_time < step_time) {
+      continue;
+    }
+    const float error = plant.flow() - scenario.flow;
+    const float elapsed =
+        static_cast<float>(clock.micros()) / us_per_ms - static_cast<float>(step_time);
+    if (std::abs(error) > band) {
+      last_outside_band = elapsed;
+    }
+    result.overshoot = std::max(result.overshoot, direction * error);
+    if (current_time >= steady_time) {
+      steady_error_sum += std::abs(error);
+      ++steady_samples;
+    }
+  }
+
+  // The flow must have settled before the window over which steady-state error is measured
+  result.settling_time = last_outside_band;
+  result.settled = last_outside_band <= static_cast<float>(steady_time - step_time);
+  if (steady_samples > 0) {
+    result.steady_state_error = static_cast<float>(steady_error_sum / steady_samples);
+  }
+  result.fio2_error = std::abs(plant.fio2() - scenario.fio2);
+  return result;
+}
+
+SimulationReport run(const std::vector<Scenario> &scenarios, const SimulationOptions &options) {
+  static const double ms_per_s = 1000;
+
+  SimulationReport report;
+  report.options = options;
+  report.results.reserve(scenarios.size());
+  SteadyClock::time_point start = SteadyClock::now();
+  for (const Scenario &scenario : scenarios) {
+    report.results.push_back(run(scenario, options));
+  }
+  report.wall_time_s = std::chrono::duration<double>(SteadyClock::now() - start).count();
+  report.simulated_time_s = static_cast<double>(scenarios.size()) *
+                            (options.initial_duration + options.step_duration) / ms_per_s;
+  return report;
+}
+
+std::vector<Scenario> generate_scenarios(size_t count, uint32_t seed) {
+  std::mt19937 generator(seed);
+  auto uniform = [&generator](float lower, float upper) {
+    return std::uniform_real_distribution<float>(lower, upper)(generator);
+  };
+  static const float min_flow = 5;    // L/min
+  static const float max_flow = 80;   // L/min
+  static const float min_fio2 = 21;   // %
+  static const float max_fio2 = 100;  // %
+  static const float start_from_zero_probability = 0.25;
+
+  std::vector<Scenario> scenarios(count);
+  for (Scenario &scenario : scenarios) {
+    scenario.initial_flow =
+        (uniform(0, 1) < start_from_zero_probability) ? 0 : uniform(min_flow, max_flow);
+    scenario.flow = uniform(min_flow, max_flow);
+    scenario.fio2 = uniform(min_fio2, max_fio2);
+    for (ValveParameters *valve : {&scenario.plant.air, &scenario.plant.o2}) {
+      valve->supply_scale = uniform(0.8, 1.2);
+      valve->deadband_shift = uniform(-0.03, 0.05);
+      valve->time_constant = uniform(10, 40);
+    }
+    scenario.plant.mixing_volume = uniform(0.1, 0.5);
+    scenario.plant.sensor_noise = uniform(0, 0.3);
+    scenario.plant.seed = generator();
+  }
+  return scenarios;
+}
+
+const char *to_string(ControllerType type) {
+  switch (type) {
+    case ControllerType::pi:
+      return "pi";
+    case ControllerType::feedforward:
+      return "feedforward";
+  }
+  return "unknown";
+}
+
+// JSON
+
+namespace {
+
+void write_json(std::ostream &output, const ScenarioResult &result) {
+  const Scenario &scenario = result.scenario;
+  output << "{\"initial_flow\": " << scenario.initial_flow << ", \"flow\": " << scenario.flow
+         << ", \"fio2\": " << scenario.fio2
+         << ", \"air_supply_scale\": " << scenario.plant.air.supply_scale
+         << ", \"o2_supply_scale\": " << scenario.plant.o2.supply_scale
+         << ", \"reachable\": " << (result.reachable ? "true" : "false")
+         << ", \"sensors_ok\": " << (result.sensors_ok ? "true" : "false")
+         << ", \"settled\": " << (result.settled ? "true" : "false")
+         << ", \"settling_time\": " << result.settling_time
+         << ", \"overshoot\": " << result.overshoot
+         << ", \"steady_state_error\": " << result.steady_state_error
+         << ", \"fio2_error\": " << result.fio2_error << "}";
+}
+
+}  // namespace
+
+void write_json(std::ostream &output, const SimulationReport &report, bool details) {
+  std::vector<float> settling_times;
+  std::vector<float> overshoots;
+  std::vector<float> steady_state_errors;
+  std::vector<float> fio2_errors;
+  size_t sensor_failures = 0;
+  size_t unreachable = 0;
+  size_t unsettled = 0;
+  uint64_t control_steps = 0;
+  double control_wall_time_ns = 0;
+  double max_control_wall_time_ns = 0;
+  for (const ScenarioResult &result : report.results) {
+    if (!result.sensors_ok) {
+      ++sensor_failures;
+      continue;
+    }
+    if (!result.reachable) {
+      ++unreachable;
+      continue;
+    }
+    if (!result.settled) {
+      ++unsettled;
+    }
+    settling_times.push_back(result.settling_time);
+    overshoots.push_back(result.overshoot);
+    steady_state_errors.push_back(result.steady_state_error);
+    fio2_errors.push_back(result.fio2_error);
+    control_steps += result.control_steps;
+    control_wall_time_ns += result.control_wall_time_ns;
+    max_control_wall_time_ns = std::max(max_control_wall_time_ns, result.max_control_wall_time_ns);
+  }
+
+  auto write_distribution = [&output](const char *name, const std::vector<float> &values) {
+    output << "  \"" << name << "\": {\"p50\": " << percentile(values, 0.5)
+           << ", \"p95\": " << percentile(values, 0.95) << ", \"max\": " << percentile(values, 1)
+           << "},\n";
+  };
+
+  output << std::setprecision(6);
+  output << "{\n";
+  output << "  \"controller\": \"" << to_string(report.options.controller) << "\",\n";
+  output << "  \"prefilter_flows\": " << (report.options.prefilter_flows ? "true" : "false")
+         << ",\n";
+  output << "  \"scenarios\": " << report.results.size() << ",\n";
+  output << "  \"sensor_failures\": " << sensor_failures << ",\n";
+  output << "  \"unreachable\": " << unreachable << ",\n";
+  output << "  \"unsettled\": " << unsettled << ",\n";
+  write_distribution("settling_time", settling_times);
+  write_distribution("overshoot", overshoots);
+  write_distribution("steady_state_error", steady_state_errors);
+  write_distribution("fio2_error", fio2_errors);
+  output << "  \"control_steps\": " << control_steps << ",\n";
+  output << "  \"ns_per_control_step\": "
+         << (control_steps > 0 ? control_wall_time_ns / static_cast<double>(control_steps) : 0)
+         << ",\n";
+  output << "  \"max_ns_per_control_step\": " << max_control_wall_time_ns << ",\n";
+  output << "  \"simulated_time_s\": " << report.simulated_time_s << ",\n";
+  output << "  \"wall_time_s\": " << report.wall_time_s << ",\n";
+  output << "  \"speedup\": " << report.simulated_time_s / report.wall_time_s;
+  if (details) {
+    output << ",\n  \"results\": [";
+    for (size_t i = 0; i < report.results.size(); ++i) {
+      output << (i == 0 ? "\n    " : ",\n    ");
+      write_json(output, report.results[i]);
+    }
+    output << (report.results.empty() ? "]" : "\n  ]");
+  }
+  output << "\n}\n";
+}
+
+}  // namespace Pufferfish::Simulation
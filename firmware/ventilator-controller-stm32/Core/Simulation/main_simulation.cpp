@@ -0,0 +1,155 @@
+/// \file
+/// \brief Runs the HFNC control loop against a model of the breathing circuit, for tuning.
+///
+/// Usage:
+///   Simulation [--controller pi|feedforward] [--no-prefilter] [--scenarios <n>] [--seed <n>]
+///              [--details] [--max-settling-time <ms>] [--out <report.json>]
+///
+/// Scenarios are generated at random from the seed, so that a run is reproducible. The report is
+/// written as JSON to stdout unless an output file is given. If --max-settling-time is given, the
+/// exit status is nonzero when any scenario with a reachable setpoint doesn't settle, or when the
+/// 95th percentile of the settling times is longer than that, so that simulations can be used as
+/// regression tests.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Pufferfish/Simulation/Scenarios.h"
+
+namespace {
+
+namespace Simulation = Pufferfish::Simulation;
+
+struct Arguments {
+  std::string output_path;
+  Simulation::SimulationOptions simulation;
+  size_t num_scenarios = 1000;
+  uint32_t seed = 1;
+  bool details = false;
+  bool check_settling = false;
+  float max_settling_time = 0;  // ms
+};
+
+bool parse_arguments(int argc, char *argv[], Arguments &arguments) {
+  for (int i = 1; i < argc; ++i) {
+    std::string flag = argv[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag == "--no-prefilter") {
+      arguments.simulation.prefilter_flows = false;
+      continue;
+    }
+    if (flag == "--details") {
+      arguments.details = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << flag << std::endl;
+      return false;
+    }
+
+    std::string value = argv[++i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag == "--controller") {
+      if (value == "pi") {
+        arguments.simulation.controller = Simulation::ControllerType::pi;
+      } else if (value == "feedforward") {
+        arguments.simulation.controller = Simulation::ControllerType::feedforward;
+      } else {
+        std::cerr << "Unknown controller " << value << std::endl;
+        return false;
+      }
+    } else if (flag == "--scenarios") {
+      arguments.num_scenarios = std::stoul(value);
+    } else if (flag == "--seed") {
+      arguments.seed = std::stoul(value);
+    } else if (flag == "--max-settling-time") {
+      arguments.check_settling = true;
+      arguments.max_settling_time = std::stof(value);
+    } else if (flag == "--out") {
+      arguments.output_path = value;
+    } else {
+      std::cerr << "Unknown option " << flag << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns whether every scenario settled, within the maximum settling time at the 95th percentile
+bool check_settling(const Simulation::SimulationReport &report, float max_settling_time) {
+  static const double percentile = 0.95;
+
+  std::vector<float> settling_times;
+  for (const Simulation::ScenarioResult &result : report.results) {
+    if (!result.reachable) {
+      continue;
+    }
+    if (!result.sensors_ok || !result.settled) {
+      std::cerr << "A scenario from " << result.scenario.initial_flow << " to "
+                << result.scenario.flow << " L/min didn't settle" << std::endl;
+      return false;
+    }
+    settling_times.push_back(result.settling_time);
+  }
+  if (settling_times.empty()) {
+    return true;
+  }
+
+  std::sort(settling_times.begin(), settling_times.end());
+  float p95 = settling_times[static_cast<size_t>(
+      percentile * static_cast<double>(settling_times.size() - 1) + 0.5)];
+  if (p95 > max_settling_time) {
+    std::cerr << "95th percentile settling time of " << p95 << " ms, more than the maximum of "
+              << max_settling_time << " ms" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Arguments arguments;
+  if (!parse_arguments(argc, argv, arguments)) {
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Simulation::Scenario> scenarios =
+      Simulation::generate_scenarios(arguments.num_scenarios, arguments.seed);
+  Simulation::SimulationReport report = Simulation::run(scenarios, arguments.simulation);
+
+  if (arguments.output_path.empty()) {
+    Simulation::write_json(std::cout, report, arguments.details);
+  } else {
+    std::ofstream output_file(arguments.output_path);
+    if (!output_file) {
+      std::cerr << "Couldn't open " << arguments.output_path << std::endl;
+      return EXIT_FAILURE;
+    }
+    Simulation::write_json(output_file, report, arguments.details);
+  }
+
+  if (arguments.check_settling && !check_settling(report, arguments.max_settling_time)) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
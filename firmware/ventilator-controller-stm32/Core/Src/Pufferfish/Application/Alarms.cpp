@@ -106,9 +106,13 @@ IndexStatus AlarmsManager::transform(ActiveLogEvents &active_log_events) const {
     num_elems = Application::active_log_events_max_elems;
   }
   active_log_events.id_count = num_elems;
-  for (size_t i = 0; i < num_elems; ++i) {
-    active_log_events.id[i] = active_alarms_.items()[i].second;
-  }
+  size_t i = 0;
+  active_alarms_.for_each([&active_log_events, &i, num_elems](const auto &pair) {
+    if (i < num_elems) {
+      active_log_events.id[i] = pair.second;
+      ++i;
+    }
+  });
   return status;
 }
 
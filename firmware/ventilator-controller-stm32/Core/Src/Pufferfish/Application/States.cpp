@@ -51,6 +51,7 @@ namespace Pufferfish::Util {
 // Measurements
 STATESEGMENT_TAGGED_SETTER(SensorMeasurements, sensor_measurements)
 STATESEGMENT_TAGGED_SETTER(CycleMeasurements, cycle_measurements)
+STATESEGMENT_TAGGED_SETTER(PlethWaveform, pleth_waveform)
 // Parameters
 STATESEGMENT_TAGGED_SETTER(Parameters, parameters)
 STATESEGMENT_TAGGED_SETTER(ParametersRequest, parameters_request)
@@ -70,6 +71,9 @@ STATESEGMENT_TAGGED_SETTER(BackendConnections, backend_connections)
 // Screen Status
 STATESEGMENT_TAGGED_SETTER(ScreenStatus, screen_status)
 STATESEGMENT_TAGGED_SETTER(ScreenStatusRequest, screen_status_request)
+// Diagnostics
+STATESEGMENT_TAGGED_SETTER(MCUDiagnostics, mcu_diagnostics)
+STATESEGMENT_TAGGED_SETTER(I2CDiagnostics, i2c_diagnostics)
 
 }  // namespace Pufferfish::Util
 
@@ -105,6 +109,74 @@ bool operator==<ActiveLogEvents>(const ActiveLogEvents &first, const ActiveLogEv
       std::begin(first.id), std::begin(first.id) + first.id_count, std::begin(second.id));
 }
 
+template <>
+bool operator==<PlethWaveform>(const PlethWaveform &first, const PlethWaveform &second) {
+  if (first.time != second.time || first.sequence != second.sequence ||
+      first.samples.size != second.samples.size) {
+    return false;
+  }
+
+  return std::equal(
+      std::begin(first.samples.bytes),
+      std::begin(first.samples.bytes) + first.samples.size,
+      std::begin(second.samples.bytes));
+}
+
+template <>
+bool operator==<MCUDiagnostics>(const MCUDiagnostics &first, const MCUDiagnostics &second) {
+  if (first.stack_size != second.stack_size ||
+      first.stack_high_water_mark != second.stack_high_water_mark ||
+      first.scratch_size != second.scratch_size ||
+      first.scratch_high_water_mark != second.scratch_high_water_mark ||
+      first.setup_duration != second.setup_duration ||
+      first.setups_failed != second.setups_failed ||
+      first.setups_timed_out != second.setups_timed_out ||
+      first.times_to_ready_count != second.times_to_ready_count ||
+      first.reconnections_count != second.reconnections_count ||
+      first.air_flow_discrepancy != second.air_flow_discrepancy ||
+      first.air_flow_disagreements != second.air_flow_disagreements) {
+    return false;
+  }
+
+  return std::equal(
+             std::begin(first.times_to_ready),
+             std::begin(first.times_to_ready) + first.times_to_ready_count,
+             std::begin(second.times_to_ready)) &&
+         std::equal(
+             std::begin(first.reconnections),
+             std::begin(first.reconnections) + first.reconnections_count,
+             std::begin(second.reconnections));
+}
+
+template <>
+bool operator==<I2CDeviceHealth>(const I2CDeviceHealth &first, const I2CDeviceHealth &second) {
+  if (first.transactions != second.transactions || first.nacks != second.nacks ||
+      first.timeouts != second.timeouts || first.busy != second.busy ||
+      first.crc_failures != second.crc_failures || first.other_errors != second.other_errors ||
+      first.recoveries != second.recoveries ||
+      first.failed_recoveries != second.failed_recoveries ||
+      first.latencies_count != second.latencies_count) {
+    return false;
+  }
+
+  return std::equal(
+      std::begin(first.latencies),
+      std::begin(first.latencies) + first.latencies_count,
+      std::begin(second.latencies));
+}
+
+template <>
+bool operator==<I2CDiagnostics>(const I2CDiagnostics &first, const I2CDiagnostics &second) {
+  if (first.devices_count != second.devices_count) {
+    return false;
+  }
+
+  return std::equal(
+      std::begin(first.devices),
+      std::begin(first.devices) + first.devices_count,
+      std::begin(second.devices));
+}
+
 bool operator==(const StateSegment &first, const StateSegment &second) {
   if (first.tag != second.tag) {
     return false;
@@ -116,6 +188,8 @@ bool operator==(const StateSegment &first, const StateSegment &second) {
       return STATESEGMENT_EQ_TAGGED(sensor_measurements, first, second);
     case MessageTypes::cycle_measurements:
       return STATESEGMENT_EQ_TAGGED(cycle_measurements, first, second);
+    case MessageTypes::pleth_waveform:
+      return STATESEGMENT_EQ_TAGGED(pleth_waveform, first, second);
       // Parameters
     case MessageTypes::parameters:
       return STATESEGMENT_EQ_TAGGED(parameters, first, second);
@@ -148,6 +222,11 @@ bool operator==(const StateSegment &first, const StateSegment &second) {
       return STATESEGMENT_EQ_TAGGED(mcu_power_status, first, second);
     case MessageTypes::backend_connections:
       return STATESEGMENT_EQ_TAGGED(backend_connections, first, second);
+    // Diagnostics
+    case MessageTypes::mcu_diagnostics:
+      return STATESEGMENT_EQ_TAGGED(mcu_diagnostics, first, second);
+    case MessageTypes::i2c_diagnostics:
+      return STATESEGMENT_EQ_TAGGED(i2c_diagnostics, first, second);
     default:
       return false;
   }
@@ -163,6 +242,9 @@ SensorMeasurements &Store::sensor_measurements_filtered() {
 CycleMeasurements &Store::cycle_measurements() {
   return state_segments_.cycle_measurements;
 }
+PlethWaveform &Store::pleth_waveform() {
+  return state_segments_.pleth_waveform;
+}
 // Parameters
 Parameters &Store::parameters() {
   return state_segments_.parameters;
@@ -214,6 +296,13 @@ MCUPowerStatus &Store::mcu_power_status() {
 const BackendConnections &Store::backend_connections() const {
   return state_segments_.backend_connections;
 }
+// Diagnostics
+MCUDiagnostics &Store::mcu_diagnostics() {
+  return state_segments_.mcu_diagnostics;
+}
+I2CDiagnostics &Store::i2c_diagnostics() {
+  return state_segments_.i2c_diagnostics;
+}
 
 // Internal States
 SensorMeasurements &Store::sensor_measurements_raw() {
@@ -224,6 +313,26 @@ bool &Store::backend_connected() {
 }
 
 Store::Status Store::input(const StateSegment &input, bool default_initialization) {
+  // Inputs are often repeated without changes (e.g. the backend periodically resends its
+  // requests), so subscribers are only notified of actual changes
+  StateSegment previous;
+  bool changed = output(input.tag, previous) != Status::ok || !(previous == input);
+  bool had_parameters_request = has_parameters_request_;
+  bool had_alarm_limits_request = has_alarm_limits_request_;
+
+  Status status = write(input, default_initialization);
+  if (status != Status::ok) {
+    return status;
+  }
+
+  if (changed || had_parameters_request != has_parameters_request_ ||
+      had_alarm_limits_request != has_alarm_limits_request_) {
+    notify(input.tag);
+  }
+  return Status::ok;
+}
+
+Store::Status Store::write(const StateSegment &input, bool default_initialization) {
   switch (input.tag) {
     // Measurements
     case MessageTypes::sensor_measurements:
@@ -232,6 +341,9 @@ Store::Status Store::input(const StateSegment &input, bool default_initializatio
     case MessageTypes::cycle_measurements:
       STATESEGMENT_GET_TAGGED(cycle_measurements, input);
       return Status::ok;
+    case MessageTypes::pleth_waveform:
+      STATESEGMENT_GET_TAGGED(pleth_waveform, input);
+      return Status::ok;
     // Parameters
     case MessageTypes::parameters:
       STATESEGMENT_GET_TAGGED(parameters, input);
@@ -283,6 +395,13 @@ Store::Status Store::input(const StateSegment &input, bool default_initializatio
     case MessageTypes::backend_connections:
       STATESEGMENT_GET_TAGGED(backend_connections, input);
       return Status::ok;
+    // Diagnostics
+    case MessageTypes::mcu_diagnostics:
+      STATESEGMENT_GET_TAGGED(mcu_diagnostics, input);
+      return Status::ok;
+    case MessageTypes::i2c_diagnostics:
+      STATESEGMENT_GET_TAGGED(i2c_diagnostics, input);
+      return Status::ok;
     default:
       return Status::invalid_type;
   }
@@ -297,6 +416,9 @@ Store::Status Store::output(MessageTypes type, StateSegment &output) const {
     case MessageTypes::cycle_measurements:
       output.set(state_segments_.cycle_measurements);
       return Status::ok;
+    case MessageTypes::pleth_waveform:
+      output.set(state_segments_.pleth_waveform);
+      return Status::ok;
     // Parameters
     case MessageTypes::parameters:
       output.set(state_segments_.parameters);
@@ -342,9 +464,42 @@ Store::Status Store::output(MessageTypes type, StateSegment &output) const {
     case MessageTypes::backend_connections:
       output.set(state_segments_.backend_connections);
       return Status::ok;
+    // Diagnostics
+    case MessageTypes::mcu_diagnostics:
+      output.set(state_segments_.mcu_diagnostics);
+      return Status::ok;
+    case MessageTypes::i2c_diagnostics:
+      output.set(state_segments_.i2c_diagnostics);
+      return Status::ok;
     default:
       return Status::invalid_type;
   }
 }
 
+void Store::notify(MessageTypes type) {
+  versions_.notify(type);
+}
+
+const Store::Versions &Store::versions() const {
+  return versions_;
+}
+
+void Store::publish() {
+  published_.sensor_measurements = state_segments_.sensor_measurements;
+  published_.sensor_measurements_raw = state_segments_.sensor_measurements_raw;
+  published_.parameters = state_segments_.parameters;
+  published_.alarm_mute = state_segments_.alarm_mute;
+  published_.mcu_power_status = state_segments_.mcu_power_status;
+  published_.backend_connected = state_segments_.backend_connected;
+  snapshots_.write(published_);
+}
+
+Store::Snapshots::Status Store::snapshot(StateSnapshot &snapshot) const {
+  return snapshots_.read(snapshot);
+}
+
+Store::Snapshots::Version Store::snapshot_version() const {
+  return snapshots_.version();
+}
+
 }  // namespace Pufferfish::Application
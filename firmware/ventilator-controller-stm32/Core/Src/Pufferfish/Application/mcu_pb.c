@@ -12,6 +12,9 @@ PB_BIND(SensorMeasurements, SensorMeasurements, AUTO)
 PB_BIND(CycleMeasurements, CycleMeasurements, AUTO)
 
 
+PB_BIND(PlethWaveform, PlethWaveform, AUTO)
+
+
 PB_BIND(Parameters, Parameters, AUTO)
 
 
@@ -57,6 +60,18 @@ PB_BIND(ScreenStatusRequest, ScreenStatusRequest, AUTO)
 PB_BIND(ScreenStatus, ScreenStatus, AUTO)
 
 
+PB_BIND(MCUDiagnostics, MCUDiagnostics, AUTO)
+
+
+PB_BIND(SensorReconnections, SensorReconnections, AUTO)
+
+
+PB_BIND(I2CDeviceHealth, I2CDeviceHealth, AUTO)
+
+
+PB_BIND(I2CDiagnostics, I2CDiagnostics, AUTO)
+
+
 PB_BIND(Ping, Ping, AUTO)
 
 
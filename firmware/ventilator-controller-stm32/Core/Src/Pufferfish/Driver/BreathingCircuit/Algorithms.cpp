@@ -1,5 +1,5 @@
 /*
- * BreathingCircuit.tpp
+ * Algorithms.cpp
  *
  *  Created on: June 6, 2020
  *      Author: Ethan Li
@@ -7,27 +7,33 @@
 
 #include "Pufferfish/Driver/BreathingCircuit/Algorithms.h"
 
+#include "Pufferfish/HAL/Memory.h"
+
 namespace Pufferfish::Driver::BreathingCircuit {
 
-// PI
+// SetpointRamp
 
-void PI::transform(float measurement, float setpoint, float &actuation) {
-  error_ = setpoint - measurement;
-  error_integral_ += error_;
-  if (error_integral_ < i_min) {
-    error_integral_ = i_min;
-  }
-  if (error_integral_ > i_max) {
-    error_integral_ = i_max;
+PF_ITCM_FUNCTION void SetpointRamp::transform(
+    uint32_t current_time, float target, float &setpoint) {
+  if (started_) {
+    const float max_step = rate_ * static_cast<float>(current_time - prev_time_);
+    float step = target - setpoint_;
+    if (step > max_step) {
+      step = max_step;
+    }
+    if (step < -max_step) {
+      step = -max_step;
+    }
+    setpoint_ += step;
   }
+  started_ = true;
+  prev_time_ = current_time;
+  setpoint = setpoint_;
+}
 
-  actuation = error_ * p_gain + error_integral_ * i_gain;
-  if (actuation < out_min) {
-    actuation = out_min;
-  }
-  if (actuation > out_max) {
-    actuation = out_max;
-  }
+void SetpointRamp::reset(float value) {
+  setpoint_ = value;
+  started_ = false;
 }
 
 }  // namespace Pufferfish::Driver::BreathingCircuit
@@ -7,6 +7,8 @@
 
 #include "Pufferfish/Driver/BreathingCircuit/ControlLoop.h"
 
+#include "Pufferfish/HAL/Memory.h"
+
 namespace Pufferfish::Driver::BreathingCircuit {
 
 // ControlLoop
@@ -29,7 +31,7 @@ const SensorConnections &HFNCControlLoop::sensor_connections() const {
   return sensor_connections_;
 }
 
-void HFNCControlLoop::update(uint32_t current_time) {
+PF_ITCM_FUNCTION void HFNCControlLoop::update(uint32_t current_time) {
   if (step_timer().within_timeout(current_time)) {
     return;
   }
@@ -41,6 +43,10 @@ void HFNCControlLoop::update(uint32_t current_time) {
   // Update sensors
   InitializableState air_status = sfm3019_air_.output(sensor_vars_.flow_air);
   InitializableState o2_status = sfm3019_o2_.output(sensor_vars_.flow_o2);
+  if (prefilter_flows_) {
+    flow_air_prefilter_.transform(air_status == InitializableState::ok, sensor_vars_.flow_air);
+    flow_o2_prefilter_.transform(o2_status == InitializableState::ok, sensor_vars_.flow_o2);
+  }
   if (air_status == InitializableState::ok && o2_status == InitializableState::ok) {
     sensor_measurements_.flow = sensor_vars_.flow_air + sensor_vars_.flow_o2;
   }
@@ -7,11 +7,25 @@
 
 #include "Pufferfish/Driver/BreathingCircuit/Controller.h"
 
+#include "Pufferfish/HAL/Memory.h"
+
 namespace Pufferfish::Driver::BreathingCircuit {
 
+void transform_hfnc_setpoints(const Parameters &parameters, ActuatorSetpoints &actuator_setpoints) {
+  float flow_o2_ratio =
+      (parameters.fio2 - allowed_fio2.lower) / (allowed_fio2.upper - allowed_fio2.lower);
+  if (parameters.ventilating) {
+    actuator_setpoints.flow_o2 = flow_o2_ratio * parameters.flow;
+    actuator_setpoints.flow_air = parameters.flow - actuator_setpoints.flow_o2;
+  } else {
+    actuator_setpoints.flow_o2 = 0;
+    actuator_setpoints.flow_air = 0;
+  }
+}
+
 // HFNC Controller
 
-void HFNCController::transform(
+PF_ITCM_FUNCTION void HFNCController::transform(
     uint32_t /*current_time*/,
     const Parameters &parameters,
     const SensorVars &sensor_vars,
@@ -23,15 +37,7 @@ void HFNCController::transform(
   }
 
   // Open-loop setpoints
-  float flow_o2_ratio =
-      (parameters.fio2 - allowed_fio2.lower) / (allowed_fio2.upper - allowed_fio2.lower);
-  if (parameters.ventilating) {
-    actuator_setpoints.flow_o2 = flow_o2_ratio * parameters.flow;
-    actuator_setpoints.flow_air = parameters.flow - actuator_setpoints.flow_o2;
-  } else {
-    actuator_setpoints.flow_o2 = 0;
-    actuator_setpoints.flow_air = 0;
-  }
+  transform_hfnc_setpoints(parameters, actuator_setpoints);
 
   // PI Controller
   valve_air_.transform(
@@ -48,4 +54,43 @@ void HFNCController::transform(
   }
 }
 
+// HFNC Feedforward Controller
+
+PF_ITCM_FUNCTION void HFNCFeedforwardController::transform(
+    uint32_t current_time,
+    const Parameters &parameters,
+    const SensorVars &sensor_vars,
+    const SensorMeasurements & /*sensor_measurements*/,
+    ActuatorSetpoints &actuator_setpoints,
+    ActuatorVars &actuator_vars) {
+  if (parameters.mode != Application::VentilationMode_hfnc) {
+    return;
+  }
+
+  transform_hfnc_setpoints(parameters, actuator_setpoints);
+
+  // Closed valves are held closed, and their controllers are restarted from the measured flow
+  // when they're opened again
+  if (actuator_setpoints.flow_air == 0) {
+    valve_air_.reset(sensor_vars.flow_air);
+    actuator_vars.valve_air_opening = 0;
+  } else {
+    valve_air_.transform(
+        current_time,
+        sensor_vars.flow_air,
+        actuator_setpoints.flow_air,
+        actuator_vars.valve_air_opening);
+  }
+  if (actuator_setpoints.flow_o2 == 0) {
+    valve_o2_.reset(sensor_vars.flow_o2);
+    actuator_vars.valve_o2_opening = 0;
+  } else {
+    valve_o2_.transform(
+        current_time,
+        sensor_vars.flow_o2,
+        actuator_setpoints.flow_o2,
+        actuator_vars.valve_o2_opening);
+  }
+}
+
 }  // namespace Pufferfish::Driver::BreathingCircuit
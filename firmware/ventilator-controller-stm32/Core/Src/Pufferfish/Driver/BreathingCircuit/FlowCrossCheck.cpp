@@ -0,0 +1,52 @@
+/*
+ * FlowCrossCheck.cpp
+ *
+ *  Cross-checking of a flow measurement against a redundant flow estimate
+ */
+
+#include "Pufferfish/Driver/BreathingCircuit/FlowCrossCheck.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Pufferfish::Driver::BreathingCircuit {
+
+// FlowCrossCheck
+
+FlowCrossCheck::Status FlowCrossCheck::transform(
+    uint32_t current_time, float reference_flow, float check_flow) {
+  if (sampled_ && sampling_timer_.within_timeout(current_time)) {
+    return disagreeing_ ? Status::disagreement : Status::ok;
+  }
+
+  sampling_timer_.reset(current_time);
+  sampled_ = true;
+  smoother_.transform(check_flow - reference_flow, discrepancy_);
+  bool out_of_tolerance =
+      std::fabs(discrepancy_) > tolerance_ + relative_tolerance_ * std::fabs(reference_flow);
+  debouncer_.transform(out_of_tolerance, current_time, disagreeing_);
+  Protocols::Application::EdgeDetector::State edge{};
+  edge_detector_.transform(disagreeing_, edge);
+  if (edge == Protocols::Application::EdgeDetector::State::rising_edge) {
+    ++disagreements_;
+  }
+  return disagreeing_ ? Status::disagreement : Status::ok;
+}
+
+void FlowCrossCheck::reset() {
+  sampled_ = false;
+  float discarded = 0;
+  smoother_.transform(std::numeric_limits<float>::quiet_NaN(), discarded);
+  debouncer_.transform();
+  disagreeing_ = false;
+  Protocols::Application::EdgeDetector::State edge{};
+  edge_detector_.transform(disagreeing_, edge);
+  discrepancy_ = 0;
+}
+
+void FlowCrossCheck::output(Application::MCUDiagnostics &diagnostics) const {
+  diagnostics.air_flow_discrepancy = discrepancy_;
+  diagnostics.air_flow_disagreements = disagreements_;
+}
+
+}  // namespace Pufferfish::Driver::BreathingCircuit
@@ -1,23 +1,28 @@
 /*
- * BreathingCircuit.tpp
+ * SignalSmoothing.cpp
  *
- *  Created on: June 6, 2020
- *      Author: Ethan Li
+ *  Signal processing and denoising
  */
 
 #include "Pufferfish/Driver/BreathingCircuit/SignalSmoothing.h"
 
+#include "Pufferfish/HAL/Memory.h"
+
 namespace Pufferfish::Driver::BreathingCircuit {
 
-// DisplaySmoother
+// SensorPrefilter
+
+PF_ITCM_FUNCTION void SensorPrefilter::transform(bool valid, float &value) {
+  if (!valid) {
+    started_ = false;
+    return;
+  }
 
-void SensorMeasurementsSmoothers::transform(
-    uint32_t current_time, const SensorMeasurements &raw, SensorMeasurements &filtered) {
-  filtered.time = current_time;
-  fio2_.transform(current_time, raw.fio2, filtered.fio2);
-  flow_.transform(current_time, raw.flow, filtered.flow);
-  spo2_.transform(current_time, raw.spo2, filtered.spo2);
-  hr_.transform(current_time, raw.hr, filtered.hr);
+  if (!started_) {
+    filter_.reset(value);
+    started_ = true;
+  }
+  value = filter_.transform(value);
 }
 
 }  // namespace Pufferfish::Driver::BreathingCircuit
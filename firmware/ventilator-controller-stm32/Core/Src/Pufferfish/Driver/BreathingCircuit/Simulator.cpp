@@ -34,6 +34,11 @@ void Simulator::input_clock(uint32_t current_time) {
 uint32_t Simulator::current_time() const {
   return current_time_;
 }
+
+bool Simulator::within_age(uint32_t measurement_time, uint32_t max_age) const {
+  return initial_time_ + current_time_ - measurement_time <= max_age;
+}
+
 void Simulator::transform_fio2(float params_fio2, float &sensor_meas_fio2) {
   sensor_meas_fio2 +=
       (params_fio2 - sensor_meas_fio2) * fio2_responsiveness / sensor_update_interval;
@@ -138,7 +143,8 @@ void HFNCSimulator::transform(
     transform_flow(parameters.flow, sensor_measurements.flow);
   }
   // If sensor_states.fdo2 && sensor_states.abp, FiO2 should be calculated in ControlLoop
-  if (sensor_states.fdo2) {
+  // pO2 is only used while it's fresh, since the FDO2 measures it less often than this runs
+  if (sensor_states.fdo2 && within_age(sensor_vars.po2_time, po2_max_age)) {
     // simulate FiO2 from pO2
     sensor_measurements.fio2 = sensor_vars.po2 * po2_fio2_conversion;
   } else if (std::abs(sensor_vars.flow_air + sensor_vars.flow_o2) >= 1) {
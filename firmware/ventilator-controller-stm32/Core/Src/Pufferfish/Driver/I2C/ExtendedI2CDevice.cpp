@@ -17,6 +17,15 @@ I2CDeviceStatus ExtendedI2CDevice::read(uint8_t *buf, size_t count) {
   return dev_.read(buf, count);
 }
 
+I2CDeviceStatus ExtendedI2CDevice::read(uint16_t address, uint8_t *buf, size_t count) {
+  I2CDeviceStatus stat = mux_.select_slot(ext_slot);
+  if (stat != I2CDeviceStatus::ok) {
+    return stat;
+  }
+
+  return dev_.read(address, buf, count);
+}
+
 I2CDeviceStatus ExtendedI2CDevice::write(uint8_t *buf, size_t count) {
   I2CDeviceStatus stat = mux_.select_slot(ext_slot);
   if (stat != I2CDeviceStatus::ok) {
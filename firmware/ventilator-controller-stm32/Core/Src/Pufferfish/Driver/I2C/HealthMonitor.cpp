@@ -0,0 +1,89 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * HealthMonitor.cpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#include "Pufferfish/Driver/I2C/HealthMonitor.h"
+
+namespace Pufferfish::Driver::I2C {
+
+// MonitoredDevice
+
+I2CDeviceStatus MonitoredDevice::read(uint8_t *buf, size_t count) {
+  uint32_t start_time = time_.micros();
+  return record(start_time, dev_.read(buf, count));
+}
+
+I2CDeviceStatus MonitoredDevice::read(uint16_t address, uint8_t *buf, size_t count) {
+  uint32_t start_time = time_.micros();
+  return record(start_time, dev_.read(address, buf, count));
+}
+
+I2CDeviceStatus MonitoredDevice::write(uint8_t *buf, size_t count) {
+  uint32_t start_time = time_.micros();
+  return record(start_time, dev_.write(buf, count));
+}
+
+void MonitoredDevice::report(I2CDeviceStatus status) {
+  count_error(status);
+  dev_.report(status);
+}
+
+const Application::I2CDeviceHealth &MonitoredDevice::health() const {
+  return health_;
+}
+
+I2CDeviceStatus MonitoredDevice::record(uint32_t start_time, I2CDeviceStatus status) {
+  uint32_t latency = time_.micros() - start_time;
+  size_t bin = 0;
+  for (uint32_t bound = first_latency_bound; bin < num_latency_bins - 1 && latency >= bound;
+       bound *= 2) {
+    ++bin;
+  }
+  ++health_.latencies[bin];
+  ++health_.transactions;
+  count_error(status);
+
+  if (status != I2CDeviceStatus::timeout && status != I2CDeviceStatus::busy) {
+    bus_errors_ = 0;
+    return status;
+  }
+
+  ++bus_errors_;
+  if (bus_errors_ >= recovery_threshold_) {
+    if (bus_.recover() == I2CDeviceStatus::ok) {
+      ++health_.recoveries;
+    } else {
+      ++health_.failed_recoveries;
+    }
+    bus_errors_ = 0;
+  }
+  return status;
+}
+
+void MonitoredDevice::count_error(I2CDeviceStatus status) {
+  switch (status) {
+    case I2CDeviceStatus::ok:
+      break;
+    case I2CDeviceStatus::nack:
+      ++health_.nacks;
+      break;
+    case I2CDeviceStatus::timeout:
+      ++health_.timeouts;
+      break;
+    case I2CDeviceStatus::busy:
+      ++health_.busy;
+      break;
+    case I2CDeviceStatus::crc_check_failed:
+      ++health_.crc_failures;
+      break;
+    default:
+      ++health_.other_errors;
+      break;
+  }
+}
+
+}  // namespace Pufferfish::Driver::I2C
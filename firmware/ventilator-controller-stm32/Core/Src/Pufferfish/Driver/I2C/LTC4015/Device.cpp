@@ -99,4 +99,42 @@ I2CDeviceStatus Device::read_input_current(uint16_t &i_in) {
   return I2CDeviceStatus::ok;
 }
 
+I2CDeviceStatus Device::read_telemetry(Telemetry &telemetry) {
+  // The LTC4015 only supports word reads, so the registers are read in consecutive
+  // transactions and only committed together
+  std::array<uint16_t, num_telemetry_registers> values{};
+  auto address = static_cast<uint16_t>(Command::system_status);
+  for (uint16_t &value : values) {
+    I2CDeviceStatus ret = read_register(address, value);
+    if (ret != I2CDeviceStatus::ok) {
+      return ret;
+    }
+    address += register_address_step;
+  }
+
+  static const size_t vbat_index = 1;
+  static const size_t vin_index = 2;
+  static const size_t vsys_index = 3;
+  static const size_t ibat_index = 4;
+  static const size_t iin_index = 5;
+  telemetry.system_status = values[0];
+  telemetry.vbat = values[vbat_index];
+  telemetry.vin = values[vin_index];
+  telemetry.vsys = values[vsys_index];
+  telemetry.ibat = values[ibat_index];
+  telemetry.iin = values[iin_index];
+  return I2CDeviceStatus::ok;
+}
+
+I2CDeviceStatus Device::read_register(uint16_t address, uint16_t &value) {
+  std::array<uint8_t, sizeof(uint16_t)> buffer{};
+  I2CDeviceStatus ret = i2cdevice_.read(address, buffer);
+  if (ret != I2CDeviceStatus::ok) {
+    return ret;
+  }
+
+  Util::read_bigend(buffer.data(), value);
+  return I2CDeviceStatus::ok;
+}
+
 }  // namespace Pufferfish::Driver::I2C::LTC4015
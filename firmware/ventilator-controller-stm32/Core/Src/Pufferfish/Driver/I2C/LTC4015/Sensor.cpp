@@ -7,81 +7,46 @@
 
 #include "Pufferfish/Driver/I2C/LTC4015/Sensor.h"
 
-#include "Pufferfish/Util/Timeouts.h"
-
 namespace Pufferfish::Driver::I2C::LTC4015 {
 
-// StateMachine
+// Sensor
 
-StateMachine::Action StateMachine::update() {
-  switch (next_action_) {
-    case Action::initialize:
-      next_action_ = Action::measure;
-      break;
-    case Action::measure:
-      break;
-  }
-  return next_action_;
+Sensor::Action Sensor::get_state() const {
+  return lifecycle_.state();
 }
 
-// Sensor
+const LifecycleStatistics &Sensor::statistics(Action action) const {
+  return lifecycle_.statistics(action);
+}
 
 InitializableState Sensor::setup() {
-  switch (next_action_) {
-    case Action::initialize:
-      return initialize();
-    case Action::measure:
-      return InitializableState::ok;
-  }
-  return InitializableState::failed;
+  return lifecycle_.setup(time_.millis(), [this](Action /*action*/) { return initialize(); });
 }
 
 InitializableState Sensor::output(MCUPowerStatus &mcu_power_status) {
-  switch (next_action_) {
-    case Action::measure:
-      return measure(mcu_power_status);
-    default:
-      break;
+  InitializableState state =
+      lifecycle_.output(time_.millis(), [this](Action /*action*/) { return measure(); });
+  if (state == InitializableState::ok) {
+    // check if charger is connected
+    mcu_power_status.charging = telemetry_.charger_enabled();
   }
-  return InitializableState::failed;
+  return state;
 }
 
-InitializableState Sensor::initialize() {
-  if (retry_count_ > max_retries_setup) {
-    return InitializableState::failed;
-  }
-
-  retry_count_ = 0;
-  // measure
-  bool charging_status = false;
-  while (device_.read_charging_status(charging_status) != I2CDeviceStatus::ok) {
-    ++retry_count_;
-    if (retry_count_ > max_retries_setup) {
-      return InitializableState::failed;
-    }
+StepStatus Sensor::initialize() {
+  if (device_.read_telemetry(telemetry_) != I2CDeviceStatus::ok) {
+    return StepStatus::fault;
   }
 
-  next_action_ = fsm_.update();
-  retry_count_ = 0;  // reset retries to 0 for measuring
-  return InitializableState::setup;
+  return StepStatus::done;
 }
 
-InitializableState Sensor::measure(MCUPowerStatus &mcu_power_status) {
-  // check if charger is connected
-  bool charging_status = false;
-  if (device_.read_charging_status(charging_status) == I2CDeviceStatus::ok) {
-    retry_count_ = 0;  // reset retries to 0 for next measurement
-    mcu_power_status.charging = charging_status;
-    next_action_ = fsm_.update();
-    return InitializableState::ok;
-  }
-
-  ++retry_count_;
-  if (retry_count_ > max_retries_measure) {
-    return InitializableState::failed;
+StepStatus Sensor::measure() {
+  if (device_.read_telemetry(telemetry_) != I2CDeviceStatus::ok) {
+    return StepStatus::fault;
   }
 
-  return InitializableState::ok;
+  return StepStatus::done;
 }
 
 }  // namespace Pufferfish::Driver::I2C::LTC4015
@@ -117,7 +117,7 @@ I2CDeviceStatus SDPSensor::read_full_sample(SDPSample &sample) {
   std::array<uint8_t, full_reading_size> data{};
 
   I2CDeviceStatus ret = sensirion_.read(data);
-  if (ret == I2CDeviceStatus::read_error) {
+  if (ret == I2CDeviceStatus::read_error || ret == I2CDeviceStatus::nack) {
     /// get NACK, no new data is available
     return I2CDeviceStatus::no_new_data;
   }
@@ -125,7 +125,8 @@ I2CDeviceStatus SDPSensor::read_full_sample(SDPSample &sample) {
     return ret;
   }
 
-  if (data[full_reading_size - 2] != 0 && data[full_reading_size - 1] != 0) {
+  // a zero scale factor means the sample isn't valid yet
+  if (data[full_reading_size - 2] != 0 || data[full_reading_size - 1] != 0) {
     SDPSensor::parse_reading(data, sample);
   } else {
     return I2CDeviceStatus::no_new_data;
@@ -153,6 +154,7 @@ void SDPSensor::parse_reading(
   int16_t temp_raw = (data[temp_raw_high] << static_cast<uint16_t>(CHAR_BIT)) + data[temp_raw_low];
   int16_t dp_scale = (data[dp_scale_high] << static_cast<uint16_t>(CHAR_BIT)) + data[dp_scale_low];
 
+  sample.differential_pressure_scale = dp_scale;
   if (dp_scale != 0) {
     sample.differential_pressure = static_cast<float>(dp_raw) / static_cast<float>(dp_scale);
   }
@@ -260,7 +262,7 @@ I2CDeviceStatus SDPSensor::read_pressure_sample(
   std::array<uint8_t, data_len> data{{0}};
 
   I2CDeviceStatus ret = sensirion_.read(data);
-  if (ret == I2CDeviceStatus::read_error) {
+  if (ret == I2CDeviceStatus::read_error || ret == I2CDeviceStatus::nack) {
     // get NACK, no new data is available
     return I2CDeviceStatus::no_new_data;
   }
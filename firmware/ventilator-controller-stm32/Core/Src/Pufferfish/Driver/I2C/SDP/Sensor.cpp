@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Sensor.cpp
+ *
+ *  Created on: Oct 19, 2020
+ *
+ *  High-level measurement driver for the SDP differential pressure sensors.
+ */
+
+#include "Pufferfish/Driver/I2C/SDP/Sensor.h"
+
+#include <cmath>
+
+#include "Pufferfish/Util/Ranges.h"
+#include "Pufferfish/Util/Timeouts.h"
+
+namespace Pufferfish::Driver::I2C::SDP {
+
+float compute_flow(float differential_pressure, float temperature, float flow_coefficient) {
+  static const float celsius_offset = 273.15;         // K
+  static const float reference_temperature = 293.15;  // K
+  float density_correction = (temperature + celsius_offset) / reference_temperature;
+  float flow = flow_coefficient * std::sqrt(std::fabs(differential_pressure) * density_correction);
+  return differential_pressure < 0 ? -flow : flow;
+}
+
+// Sensor
+
+Sensor::Action Sensor::get_state() const {
+  return lifecycle_.state();
+}
+
+const LifecycleStatistics &Sensor::statistics(Action action) const {
+  return lifecycle_.statistics(action);
+}
+
+InitializableState Sensor::setup() {
+  return lifecycle_.setup(time_.micros(), [this](Action action) { return step(action); });
+}
+
+void Sensor::reconnect() {
+  lifecycle_.reset();
+  sample_ = SDPSample{};
+}
+
+InitializableState Sensor::output(float &flow) {
+  return lifecycle_.output(
+      time_.micros(), [this, &flow](Action /*action*/) { return measure(flow); });
+}
+
+StepStatus Sensor::step(Action action) {
+  switch (action) {
+    case Action::stop:
+      // the sensor only accepts other commands after continuous measurement is stopped
+      return device_.stop_continuous() == I2CDeviceStatus::ok ? StepStatus::done
+                                                              : StepStatus::fault;
+    case Action::start_measure:
+      return device_.start_continuous(true) == I2CDeviceStatus::ok ? StepStatus::done
+                                                                   : StepStatus::fault;
+    case Action::check_range:
+      return check_range();
+    case Action::measure:
+      break;
+  }
+  return StepStatus::failed;
+}
+
+StepStatus Sensor::check_range() {
+  StepStatus status = read_full_sample();
+  if (status != StepStatus::done) {
+    return status;
+  }
+
+  if (sample_.differential_pressure_scale == 0 ||
+      !Util::within(sample_.differential_pressure, min_dp, max_dp) ||
+      !Util::within(sample_.temperature, min_temp, max_temp)) {
+    return StepStatus::fault;
+  }
+
+  return StepStatus::done;
+}
+
+StepStatus Sensor::measure(float &flow) {
+  if (!Util::within_timeout(temperature_time_, temperature_interval, time_.micros())) {
+    StepStatus status = read_full_sample();
+    if (status != StepStatus::done) {
+      return status;
+    }
+  } else {
+    switch (device_.read_pressure_sample(
+        sample_.differential_pressure_scale, sample_.differential_pressure)) {
+      case I2CDeviceStatus::ok:
+        break;
+      case I2CDeviceStatus::no_new_data:
+        return StepStatus::waiting;
+      default:
+        return StepStatus::fault;
+    }
+  }
+
+  flow = compute_flow(sample_.differential_pressure, sample_.temperature, flow_coefficient_);
+  return StepStatus::done;
+}
+
+StepStatus Sensor::read_full_sample() {
+  SDPSample sample{};
+  switch (device_.read_full_sample(sample)) {
+    case I2CDeviceStatus::ok:
+      break;
+    case I2CDeviceStatus::no_new_data:
+      return StepStatus::waiting;
+    default:
+      return StepStatus::fault;
+  }
+
+  sample_ = sample;
+  temperature_time_ = time_.micros();
+  return StepStatus::done;
+}
+
+}  // namespace Pufferfish::Driver::I2C::SDP
@@ -23,6 +23,8 @@ I2CDeviceStatus TCA9548A::select_slot(uint8_t slot) {
   uint8_t cmd = 1U << slot;
   I2CDeviceStatus ret = dev_.write(&cmd, 1);
   if (ret != I2CDeviceStatus::ok) {
+    // the mux may or may not have switched, so the next select must not be skipped
+    current_slot_ = default_slot;
     return ret;
   }
   current_slot_ = slot;
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Reconnector.cpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#include "Pufferfish/Driver/Reconnector.h"
+
+#include <algorithm>
+
+#include "Pufferfish/Util/Timeouts.h"
+
+namespace Pufferfish::Driver {
+
+InitializableState Reconnector::update(uint32_t current_time) {
+  status_ = step(current_time);
+  return status_;
+}
+
+InitializableState Reconnector::step(uint32_t current_time) {
+  switch (state_) {
+    case State::connected:
+      // setup doesn't run any steps once the device has finished or failed setup
+      switch (device_.setup()) {
+        case InitializableState::ok:
+          return InitializableState::ok;
+        case InitializableState::setup:
+          // the device isn't connected until it has finished setup
+          return InitializableState::setup;
+        case InitializableState::failed:
+          break;
+      }
+      ++statistics_.disconnections;
+      disconnect_time_ = current_time;
+      backoff_ = initial_backoff_;
+      wait_start_time_ = current_time;
+      state_ = State::backing_off;
+      return InitializableState::failed;
+    case State::backing_off:
+      if (Util::within_timeout(wait_start_time_, backoff_, current_time)) {
+        return InitializableState::failed;
+      }
+      ++statistics_.attempts;
+      device_.reconnect();
+      wait_start_time_ = current_time;
+      state_ = State::reconnecting;
+      return InitializableState::failed;
+    case State::reconnecting:
+      break;
+  }
+
+  switch (device_.setup()) {
+    case InitializableState::ok:
+      ++statistics_.reconnections;
+      statistics_.last_latency = current_time - disconnect_time_;
+      statistics_.max_latency = std::max(statistics_.max_latency, statistics_.last_latency);
+      state_ = State::connected;
+      return InitializableState::ok;
+    case InitializableState::setup:
+      if (attempt_timeout_ == 0 ||
+          Util::within_timeout(wait_start_time_, attempt_timeout_, current_time)) {
+        return InitializableState::failed;
+      }
+      back_off(current_time);
+      return InitializableState::failed;
+    case InitializableState::failed:
+      back_off(current_time);
+      return InitializableState::failed;
+  }
+  return InitializableState::failed;
+}
+
+void Reconnector::back_off(uint32_t current_time) {
+  backoff_ = backoff_ > max_backoff_ / 2 ? max_backoff_ : std::max(backoff_ * 2, initial_backoff_);
+  wait_start_time_ = current_time;
+  state_ = State::backing_off;
+}
+
+}  // namespace Pufferfish::Driver
@@ -7,27 +7,13 @@
 
 #include "Pufferfish/Driver/Serial/FDO2/Commands.h"
 
-#include <algorithm>
-#include <cstdio>
-#include <cstdlib>
+#include <climits>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 namespace FDO2 = Pufferfish::Driver::Serial::FDO2;
 
-// This macro is used to call the parser for a specified response type with an associated
-// union field and enum value. We use a macro because it makes the code more maintainable here,
-// while allowing us to ensure union tagging.
-// clang-format off
-// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define RESPONSE_PARSE_TAGGED(type, field, input_buffer, output_response) \
-  if (std::equal(Headers::field.begin(), Headers::field.end(), (input_buffer).buffer())) {\
-    type response{};\
-    parse(input_buffer, response);\
-    (output_response).set(response);\
-    return Status::ok;\
-  }
-// clang-format on
-
 // This macro is used to add a setter for a specified response type with an associated
 // union field and enum value. We use a macro because it makes the code more maintainable here,
 // while allowing us to ensure union tagging.
@@ -66,238 +52,273 @@ namespace Pufferfish::Driver::Serial::FDO2 {
 
 namespace Responses {
 
-// Vers
-
-template <>
-ParseStatus parse<Vers>(const ChunkBuffer &input_buffer, Vers &response) {
-  const char *end = input_buffer.buffer() + input_buffer.size() - 1;
-  const char *parse_start = input_buffer.buffer() + Headers::length;
-  char *parse_end = nullptr;
-  if (*parse_start != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
-
-  // device_id
-  parse_start = parse_start + 1;
-  parse_end = nullptr;
-  response.device_id = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
-
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
-
-  // num_channels
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.num_channels = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
-
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
-
-  // firmware_rev
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.firmware_rev = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
-
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
-
-  // type
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.type = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end != end) {
-    return ParseStatus::unexpected_arg;
-  }
-
-  return ParseStatus::ok;
-}
-
 bool operator==(const Vers &left, const Vers &right) {
   return left.device_id == right.device_id && left.num_channels == right.num_channels &&
          left.firmware_rev == right.firmware_rev && left.type == right.type;
 }
 
-// Mraw
+bool operator==(const Bcst &left, const Bcst &right) {
+  return left.interval == right.interval;
+}
 
-template <>
-ParseStatus parse<Mraw>(const ChunkBuffer &input_buffer, Mraw &response) {
-  const char *end = input_buffer.buffer() + input_buffer.size() - 1;
-  const char *parse_start = input_buffer.buffer() + Headers::length;
-  char *parse_end = nullptr;
-  if (*parse_start != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+}  // namespace Responses
 
-  // po2
-  parse_start = parse_start + 1;
-  parse_end = nullptr;
-  response.po2 = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+// Response layouts
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+namespace {
 
-  // temperature
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.temperature = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+// The header and arguments of a response type. Each argument is parsed into a raw value, as by
+// strtol if its field is signed or as by strtoul otherwise, and the raw values are narrowed to the
+// types of their fields when the response is output.
+struct Layout {
+  uint64_t header;  // packed by pack_header
+  size_t num_fields;
+  uint8_t signed_fields;  // bit i is set if field i is signed
+  void (*output)(const ResponseParser::Fields &fields, Response &output_response);
+};
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
+constexpr uint64_t pack_header(const Headers::Header &header) {
+  uint64_t packed = 0;
+  for (char byte : header) {
+    packed = (packed << CHAR_BIT) | static_cast<uint8_t>(byte);
   }
+  return packed;
+}
 
-  // status
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.status = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+template <typename Type, typename Value>
+Value field_type(Value Type::*field);
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+template <auto... fields>
+constexpr uint8_t signed_fields() {
+  uint8_t bits = 0;
+  size_t i = 0;
+  ((bits |= static_cast<uint8_t>(std::is_signed<decltype(field_type(fields))>::value << i++)),
+   ...);
+  return bits;
+}
 
-  // phase_shift
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.phase_shift = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+template <typename Type, auto... fields>
+void output_fields(const ResponseParser::Fields &raw_fields, Response &output_response) {
+  Type response{};
+  size_t i = 0;
+  ((response.*fields = static_cast<decltype(field_type(fields))>(raw_fields[i++])), ...);
+  output_response.set(response);
+}
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+template <typename Type, auto... fields>
+constexpr Layout make_layout(const Headers::Header &header) {
+  static_assert(sizeof...(fields) <= Responses::max_num_fields, "Too many fields");
+  return Layout{
+      pack_header(header),
+      sizeof...(fields),
+      signed_fields<fields...>(),
+      output_fields<Type, fields...>};
+}
 
-  // signal_intensity
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.signal_intensity = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+using Responses::Vers;
+using Responses::Mraw;
+using Responses::Logo;
+using Responses::Bcst;
+using Responses::Erro;
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+// The fields of each response type, in the order of its arguments
+// clang-format off
+constexpr std::array<Layout, 5> layouts{{
+    make_layout<Vers, &Vers::device_id, &Vers::num_channels, &Vers::firmware_rev, &Vers::type>(
+        Headers::vers),
+    make_layout<Mraw,
+        &Mraw::po2, &Mraw::temperature, &Mraw::status, &Mraw::phase_shift,
+        &Mraw::signal_intensity, &Mraw::ambient_light, &Mraw::ambient_pressure,
+        &Mraw::relative_humidity>(Headers::mraw),
+    make_layout<Logo>(Headers::logo),
+    make_layout<Bcst, &Bcst::interval>(Headers::bcst),
+    make_layout<Erro, &Erro::code>(Headers::erro)
+}};
+// clang-format on
 
-  // ambient_light
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.ambient_light = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+constexpr bool is_digit(char byte) {
+  return byte >= '0' && byte <= '9';
+}
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+// Whitespace which strtoul/strtol skip before a number, except for frame_end
+constexpr bool is_other_space(char byte) {
+  return byte == '\t' || byte == '\n' || byte == '\v' || byte == '\f';
+}
 
-  // ambient_pressure
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.ambient_pressure = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end >= end) {
-    return ParseStatus::missing_arg;
-  }
+}  // namespace
 
-  if (*parse_end != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
-  }
+// ResponseParser
 
-  // relative_humidity
-  parse_start = parse_end + 1;
-  parse_end = nullptr;
-  response.relative_humidity = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end != end) {
-    return ParseStatus::unexpected_arg;
+ResponseParser::Status ResponseParser::input_other(char new_byte) {
+  if (new_byte == frame_end) {
+    return end_frame();
   }
 
-  return ParseStatus::ok;
+  switch (state_) {
+    case State::header:
+      // This is handled by input
+      break;
+    case State::first_delimiter:
+      if (num_fields_ == 0) {
+        fail(Responses::ParseStatus::unexpected_arg);
+      } else if (new_byte == arg_delimiter) {
+        start_field();
+      } else {
+        fail(Responses::ParseStatus::invalid_arg_delimiter);
+      }
+      break;
+    case State::leading:
+      if (is_digit(new_byte)) {
+        magnitude_ = static_cast<uint32_t>(new_byte - '0');
+        state_ = State::digits;
+      } else if (new_byte == ' ') {
+        if (!other_leading_) {
+          ++leading_spaces_;
+        }
+      } else if (is_other_space(new_byte)) {
+        other_leading_ = true;
+      } else if (new_byte == '+' || new_byte == '-') {
+        other_leading_ = true;
+        negative_ = new_byte == '-';
+        state_ = State::sign;
+      } else {
+        resolve_no_digits(new_byte);
+      }
+      break;
+    case State::sign:
+      if (is_digit(new_byte)) {
+        magnitude_ = static_cast<uint32_t>(new_byte - '0');
+        state_ = State::digits;
+      } else {
+        resolve_no_digits(new_byte);
+      }
+      break;
+    case State::digits: {
+      if (is_digit(new_byte)) {
+        static const uint32_t max = std::numeric_limits<uint32_t>::max();
+        auto digit = static_cast<uint32_t>(new_byte - '0');
+        if (magnitude_ > (max - digit) / arg_base) {
+          overflowed_ = true;
+        } else {
+          magnitude_ = magnitude_ * arg_base + digit;
+        }
+        break;
+      }
+
+      store_field();
+      if (field_ + 1 == num_fields_) {
+        fail(Responses::ParseStatus::unexpected_arg);
+      } else if (new_byte == arg_delimiter) {
+        ++field_;
+        start_field();
+      } else {
+        fail(Responses::ParseStatus::invalid_arg_delimiter);
+      }
+      break;
+    }
+    case State::invalid_header:
+    case State::skip:
+      break;
+  }
+  return Status::waiting;
 }
 
-// Logo
+void ResponseParser::output(Response &output_response) const {
+  layouts[layout_].output(fields_, output_response);
+}
 
-template <>
-ParseStatus parse<Logo>(const ChunkBuffer &input_buffer, Logo & /*response*/) {
-  const char *end = input_buffer.buffer() + input_buffer.size() - 1;
-  const char *parse_start = input_buffer.buffer() + Headers::length;
-  const char *parse_end = parse_start + 1;
-  if (parse_end != end) {
-    return ParseStatus::unexpected_arg;
+void ResponseParser::match_header() {
+  for (size_t i = 0; i < layouts.size(); ++i) {
+    if (layouts[i].header == header_) {
+      layout_ = i;
+      num_fields_ = layouts[i].num_fields;
+      signed_fields_ = layouts[i].signed_fields;
+      fields_.fill(0);
+      field_ = 0;
+      args_status_ = Responses::ParseStatus::ok;
+      state_ = State::first_delimiter;
+      return;
+    }
   }
 
-  return ParseStatus::ok;
+  state_ = State::invalid_header;
 }
 
-// Bcst
+ResponseParser::Status ResponseParser::end_frame() {
+  Status status = frame_status();
+  state_ = State::header;
+  frame_length_ = 0;
+  header_ = 0;
+  return status;
+}
 
-template <>
-ParseStatus parse<Bcst>(const ChunkBuffer &input_buffer, Bcst &response) {
-  const char *end = input_buffer.buffer() + input_buffer.size() - 1;
-  const char *parse_start = input_buffer.buffer() + Headers::length;
-  char *parse_end = nullptr;
-  if (*parse_start != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
+ResponseParser::Status ResponseParser::frame_status() {
+  if (frame_length_ > Responses::max_len) {
+    return Status::invalid_frame_length;
   }
 
-  // interval
-  parse_start = parse_start + 1;
-  parse_end = nullptr;
-  response.interval = std::strtoul(parse_start, &parse_end, arg_base);
-  if (parse_end != end) {
-    return ParseStatus::unexpected_arg;
+  switch (state_) {
+    case State::header:
+    case State::invalid_header:
+      return Status::invalid_header;
+    case State::first_delimiter:
+      if (num_fields_ != 0) {
+        args_status_ = Responses::ParseStatus::invalid_arg_delimiter;
+      }
+      break;
+    case State::leading:
+    case State::sign:
+      resolve_no_digits(frame_end);
+      break;
+    case State::digits:
+      store_field();
+      if (field_ + 1 != num_fields_) {
+        args_status_ = Responses::ParseStatus::missing_arg;
+      }
+      break;
+    case State::skip:
+      break;
   }
 
-  return ParseStatus::ok;
-}
-
-bool operator==(const Bcst &left, const Bcst &right) {
-  return left.interval == right.interval;
+  if (args_status_ != Responses::ParseStatus::ok) {
+    return Status::invalid_args;
+  }
+  return Status::ok;
 }
 
-// Erro
-
-template <>
-ParseStatus parse<Erro>(const ChunkBuffer &input_buffer, Erro &response) {
-  const char *end = input_buffer.buffer() + input_buffer.size() - 1;
-  const char *parse_start = input_buffer.buffer() + Headers::length;
-  char *parse_end = nullptr;
-  if (*parse_start != arg_delimiter) {
-    return ParseStatus::invalid_arg_delimiter;
+void ResponseParser::resolve_no_digits(char new_byte) {
+  // When strtoul/strtol find no digits, they leave the number's whitespace and sign unparsed.
+  // The strtoul-based parser then took the first of those bytes as the delimiter after the
+  // field, and started the next field at the byte after it, so each leading space ends an
+  // empty field with a value of zero.
+  for (; leading_spaces_ > 0; --leading_spaces_) {
+    if (field_ + 1 == num_fields_) {
+      fail(Responses::ParseStatus::unexpected_arg);
+      return;
+    }
+    ++field_;
   }
 
-  // code
-  parse_start = parse_start + 1;
-  parse_end = nullptr;
-  response.code = std::strtol(parse_start, &parse_end, arg_base);
-  if (parse_end != end) {
-    return ParseStatus::unexpected_arg;
+  bool last_field = field_ + 1 == num_fields_;
+  if (!other_leading_ && new_byte == frame_end) {
+    // An empty last field is zero, but any other field is missing
+    if (!last_field) {
+      fail(Responses::ParseStatus::missing_arg);
+    }
+    return;
   }
 
-  return ParseStatus::ok;
+  if (last_field) {
+    fail(Responses::ParseStatus::unexpected_arg);
+  } else {
+    fail(Responses::ParseStatus::invalid_arg_delimiter);
+  }
 }
 
-}  // namespace Responses
+void ResponseParser::fail(Responses::ParseStatus status) {
+  args_status_ = status;
+  state_ = State::skip;
+}
 
 namespace Requests {
 
@@ -326,7 +347,8 @@ void write<Bcst>(const Bcst &request, ChunkBuffer &output_buffer) {
       output_buffer.buffer() + output_buffer.size(),
       ChunkBuffer::max_size() - output_buffer.size());
   stream << request.interval;
-  if (output_buffer.resize(output_buffer.size() + stream.tellp()) != IndexStatus::ok) {
+  if (output_buffer.resize_uninitialized(output_buffer.size() + stream.tellp()) !=
+      IndexStatus::ok) {
     // TODO(lietk12): return error
     return;
   }
@@ -338,13 +360,26 @@ void write<Bcst>(const Bcst &request, ChunkBuffer &output_buffer) {
 
 CommandReceiver::Status CommandReceiver::transform(
     const Responses::ChunkBuffer &input_buffer, Response &output_response) {
-  RESPONSE_PARSE_TAGGED(Responses::Vers, vers, input_buffer, output_response);
-  RESPONSE_PARSE_TAGGED(Responses::Mraw, mraw, input_buffer, output_response);
-  RESPONSE_PARSE_TAGGED(Responses::Logo, logo, input_buffer, output_response);
-  RESPONSE_PARSE_TAGGED(Responses::Bcst, bcst, input_buffer, output_response);
-  RESPONSE_PARSE_TAGGED(Responses::Erro, erro, input_buffer, output_response);
+  ResponseParser parser;
+  for (size_t i = 0; i < input_buffer.size(); ++i) {
+    switch (parser.input(input_buffer[i])) {
+      case ResponseParser::Status::waiting:
+        continue;
+      case ResponseParser::Status::ok:
+        parser.output(output_response);
+        return Status::ok;
+      case ResponseParser::Status::invalid_frame_length:
+        // ChunkBuffer can't hold a frame which is too long, so this shouldn't happen
+      case ResponseParser::Status::invalid_header:
+        return Status::invalid_header;
+      case ResponseParser::Status::invalid_args:
+        parser.output(output_response);
+        return Status::invalid_args;
+    }
+  }
 
-  return Status::invalid_header;
+  // The buffer doesn't end with frame_end
+  return Status::invalid_args;
 }
 
 // CommandSender
@@ -38,51 +38,46 @@ namespace Pufferfish::Driver::Serial::FDO2 {
 // ResponseReceiver
 
 ResponseReceiver::InputStatus ResponseReceiver::input(uint8_t new_byte) {
-  bool input_overwritten = false;
-  auto status = chunks_.input(new_byte, input_overwritten);
-  if (input_overwritten) {
-    return InputStatus::input_overwritten;
-  }
-
-  using ChunkInputStatus = Protocols::Transport::ChunkInputStatus;
-  switch (status) {
-    case ChunkInputStatus::output_ready:
-      return InputStatus::output_ready;
-    case ChunkInputStatus::invalid_length:
-      return InputStatus::invalid_frame_length;
-    case ChunkInputStatus::ok:
+  // The parser doesn't buffer frames, so a new frame overwrites any response which wasn't output
+  bool input_overwritten = output_status_ != OutputStatus::waiting;
+  output_status_ = OutputStatus::waiting;
+
+  switch (parser_.input(static_cast<char>(new_byte))) {
+    case ResponseParser::Status::waiting:
+      if (input_overwritten) {
+        return InputStatus::input_overwritten;
+      }
+      if (parser_.frame_length() == Responses::max_len + 1) {
+        return InputStatus::invalid_frame_length;
+      }
+      return InputStatus::ok;
+    case ResponseParser::Status::ok:
+      output_status_ = OutputStatus::available;
+      break;
+    case ResponseParser::Status::invalid_header:
+      output_status_ = OutputStatus::invalid_header;
+      break;
+    case ResponseParser::Status::invalid_args:
+      output_status_ = OutputStatus::invalid_args;
+      break;
+    case ResponseParser::Status::invalid_frame_length:
+      output_status_ = OutputStatus::invalid_frame_length;
       break;
   }
 
-  return InputStatus::ok;
+  if (input_overwritten) {
+    return InputStatus::input_overwritten;
+  }
+  return InputStatus::output_ready;
 }
 
 ResponseReceiver::OutputStatus ResponseReceiver::output(Response &output_response) {
-  Responses::ChunkBuffer temp_buffer;
-
-  // Chunk
-  using ChunkOutputStatus = Protocols::Transport::ChunkOutputStatus;
-  switch (chunks_.output(temp_buffer)) {
-    case ChunkOutputStatus::waiting:
-      return OutputStatus::waiting;
-    case ChunkOutputStatus::invalid_length:
-      return OutputStatus::invalid_frame_length;
-    case ChunkOutputStatus::ok:
-      break;
+  OutputStatus status = output_status_;
+  output_status_ = OutputStatus::waiting;
+  if (status == OutputStatus::available) {
+    parser_.output(output_response);
   }
-
-  // Command
-  switch (
-      Pufferfish::Driver::Serial::FDO2::CommandReceiver::transform(temp_buffer, output_response)) {
-    case CommandReceiver::Status::invalid_header:
-      return OutputStatus::invalid_header;
-    case CommandReceiver::Status::invalid_args:
-      return OutputStatus::invalid_args;
-    case CommandReceiver::Status::ok:
-      break;
-  }
-
-  return OutputStatus::available;
+  return status;
 }
 
 // RequestSender
@@ -108,9 +103,9 @@ RequestSender::Status RequestSender::transform(
 
 // Device
 
-Device::Status Device::start_broadcast() {
+Device::Status Device::start_broadcast(uint16_t interval) {
   Requests::ChunkBuffer request_buffer;
-  Requests::Bcst bcst{broadcast_interval};
+  Requests::Bcst bcst{interval};
   Request request{};
   request.set(bcst);
   requests_.transform(request, request_buffer);
@@ -7,6 +7,8 @@
 
 #include "Pufferfish/Driver/Serial/FDO2/Sensor.h"
 
+#include "Pufferfish/Util/Timeouts.h"
+
 // This macro is used to add a checker for the value of a specified request type with an associated
 // union field and enum value. We use a macro because it makes the code more maintainable here,
 // while allowing us to ensure union tagging.
@@ -22,79 +24,100 @@
 
 namespace Pufferfish::Driver::Serial::FDO2 {
 
-// StateMachine
+namespace {
 
-StateMachine::Action StateMachine::update(uint32_t current_time, bool passed_check) {
-  switch (next_action_) {
-    case Action::request_version:
-      response_timer_.reset(current_time);
-      next_action_ = Action::check_version;
-      break;
-    case Action::check_version:
-      if (passed_check) {
-        next_action_ = Action::start_broadcast;
-      } else if (!response_timer_.within_timeout(current_time)) {
-        next_action_ = Action::request_version;
-      }
-      break;
-    case Action::start_broadcast:
-      response_timer_.reset(current_time);
-      next_action_ = Action::check_broadcast;
-      break;
-    case Action::check_broadcast:
-      if (passed_check) {
-        next_action_ = Action::wait_measurement;
-      } else if (!response_timer_.within_timeout(current_time)) {
-        next_action_ = Action::start_broadcast;
-      }
-    case Action::wait_measurement:
-      break;
+int32_t average(int64_t sum, size_t count) {
+  return static_cast<int32_t>(sum / static_cast<int64_t>(count));
+}
+
+template <typename Buffer>
+void push_dropping_oldest(Buffer &buffer, const Sample &sample) {
+  if (buffer.push(sample) == BufferStatus::ok) {
+    return;
   }
-  return next_action_;
+
+  Sample dropped{};
+  buffer.pop(dropped);  // after this, buffer is guaranteed to have capacity
+  buffer.push(sample);
 }
 
+}  // namespace
+
+// SampleDecimator
+
+SampleDecimator::Status SampleDecimator::transform(const Sample &input, Sample &output) {
+  if (count_ == 0) {
+    start_time_ = input.time;
+    status_ = 0;
+    po2_ = 0;
+    temperature_ = 0;
+    phase_shift_ = 0;
+    signal_intensity_ = 0;
+    ambient_light_ = 0;
+    ambient_pressure_ = 0;
+    relative_humidity_ = 0;
+  }
+
+  ++count_;
+  status_ |= input.mraw.status;
+  po2_ += input.mraw.po2;
+  temperature_ += input.mraw.temperature;
+  phase_shift_ += input.mraw.phase_shift;
+  signal_intensity_ += input.mraw.signal_intensity;
+  ambient_light_ += input.mraw.ambient_light;
+  ambient_pressure_ += input.mraw.ambient_pressure;
+  relative_humidity_ += input.mraw.relative_humidity;
+  if (count_ < factor_) {
+    return Status::waiting;
+  }
+
+  output.time = start_time_ + (input.time - start_time_) / 2;
+  output.mraw.po2 = average(po2_, count_);
+  output.mraw.temperature = average(temperature_, count_);
+  output.mraw.status = status_;
+  output.mraw.phase_shift = average(phase_shift_, count_);
+  output.mraw.signal_intensity = average(signal_intensity_, count_);
+  output.mraw.ambient_light = average(ambient_light_, count_);
+  output.mraw.ambient_pressure = average(ambient_pressure_, count_);
+  output.mraw.relative_humidity = average(relative_humidity_, count_);
+  count_ = 0;
+  return Status::ok;
+}
+
+// Sensor
+
 RESPONSE_TAGGED_COMPARISON(Responses::Vers, vers)
 RESPONSE_TAGGED_COMPARISON(Responses::Bcst, bcst)
 
 // Sensor
 
+Sensor::Action Sensor::get_state() const {
+  return lifecycle_.state();
+}
+
+const LifecycleStatistics &Sensor::statistics(Action action) const {
+  return lifecycle_.statistics(action);
+}
+
 InitializableState Sensor::setup() {
-  if (retry_count_ > max_retries_setup) {
-    return InitializableState::failed;
-  }
+  return lifecycle_.setup(time_.millis(), [this](Action action) { return step(action); });
+}
 
-  switch (next_action_) {
-    case Action::request_version:
-      device_.request_version();
-      next_action_ = fsm_.update(time_.millis());
-      return InitializableState::setup;
-    case Action::check_version:
-      return check_version(time_.millis());
-    case Action::start_broadcast:
-      device_.start_broadcast();
-      next_action_ = fsm_.update(time_.millis());
-      return InitializableState::setup;
-    case Action::check_broadcast:
-      return check_broadcast(time_.millis());
-    case Action::wait_measurement:
-      next_action_ = fsm_.update(time_.millis());
-      return InitializableState::ok;
-  }
-  return InitializableState::failed;
+void Sensor::reconnect() {
+  lifecycle_.reset();
+  decimator_.reset();
 }
 
-InitializableState Sensor::output(uint32_t &po2) {
-  if (next_action_ != Action::wait_measurement) {
-    return InitializableState::failed;
-  }
+InitializableState Sensor::output() {
+  return lifecycle_.output(time_.millis(), [this](Action /*action*/) { return measure(); });
+}
 
-  Response response;
-  device_.receive(response);
-  // This is a tagged union access
-  if (response.tag == CommandTypes::mraw) {
-    po2 = response.value.mraw.po2;  // NOLINT(cppcoreguidelines-pro-type-union-access)
-  }
-  return InitializableState::ok;
+BufferStatus Sensor::read_raw(Sample &sample) {
+  return raw_.pop(sample);
+}
+
+BufferStatus Sensor::read_decimated(Sample &sample) {
+  return decimated_.pop(sample);
 }
 
 bool Sensor::get_response(CommandTypes type, Response &response) {
@@ -109,42 +132,62 @@ bool Sensor::get_response(CommandTypes type, Response &response) {
   }
 }
 
-InitializableState Sensor::check_version(uint32_t current_time) {
+StepStatus Sensor::step(Action action) {
   Response response;
-  if (!get_response(CommandTypes::vers, response)) {
-    next_action_ = fsm_.update(current_time);
-    if (next_action_ != Action::check_version) {
-      ++retry_count_;
-    }
-    return InitializableState::setup;
-  }
+  switch (action) {
+    case Action::request_version:
+      device_.request_version();
+      return StepStatus::done;
+    case Action::check_version:
+      if (!get_response(CommandTypes::vers, response)) {
+        return StepStatus::waiting;
+      }
+      return response == expected_vers ? StepStatus::done : StepStatus::fault;
+    case Action::start_broadcast:
+      device_.start_broadcast(expected_bcst_.interval);
+      return StepStatus::done;
+    case Action::check_broadcast:
+      if (!get_response(CommandTypes::bcst, response)) {
+        return StepStatus::waiting;
+      }
+      if (!(response == expected_bcst_)) {
+        return StepStatus::fault;
+      }
 
-  if (response == expected_vers) {
-    next_action_ = fsm_.update(current_time, true);
-  } else {
-    next_action_ = fsm_.update(current_time);
-    ++retry_count_;
+      // Measurements are expected within a few broadcast intervals from now on
+      last_sample_time_ = time_.millis();
+      return StepStatus::done;
+    case Action::measure:
+      break;
   }
-  return InitializableState::setup;
+  return StepStatus::failed;
 }
 
-InitializableState Sensor::check_broadcast(uint32_t current_time) {
+StepStatus Sensor::measure() {
+  uint32_t current_time = time_.millis();
   Response response;
-  if (!get_response(CommandTypes::bcst, response)) {
-    next_action_ = fsm_.update(current_time);
-    if (next_action_ != Action::check_broadcast) {
-      ++retry_count_;
+  while (device_.receive(response) == Device::Status::ok) {
+    if (response.tag != CommandTypes::mraw) {
+      continue;
+    }
+
+    // This is a tagged union access
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+    Sample sample{current_time, response.value.mraw};
+    last_sample_time_ = current_time;
+    push_dropping_oldest(raw_, sample);
+    Sample decimated{};
+    if (decimator_.transform(sample, decimated) == SampleDecimator::Status::ok) {
+      push_dropping_oldest(decimated_, decimated);
     }
-    return InitializableState::setup;
   }
 
-  if (response == expected_bcst) {
-    next_action_ = fsm_.update(current_time, true);
-  } else {
-    next_action_ = fsm_.update(current_time);
-    ++retry_count_;
+  uint32_t stale_timeout = stale_intervals * expected_bcst_.interval;
+  if (!Util::within_timeout(last_sample_time_, stale_timeout, current_time)) {
+    return StepStatus::fault;
   }
-  return InitializableState::setup;
+
+  return StepStatus::done;
 }
 
 }  // namespace Pufferfish::Driver::Serial::FDO2
@@ -21,48 +21,70 @@
 
 #include "Pufferfish/Driver/Serial/Nonin/Device.h"
 
+#include <algorithm>
+
 namespace Pufferfish::Driver::Serial::Nonin {
 
 PacketStatus Device::output(Sample &sensor_measurements) {
   uint8_t read_byte = 0;
-  Frame frame_buffer;
-
   if (nonin_uart_.read(read_byte) == BufferStatus::empty) {
     return PacketStatus::waiting;
   }
 
-  switch (frame_receiver_.input(read_byte)) {
-    case FrameInputStatus::invalid_header:
-      return PacketStatus::invalid_header;
-    case FrameInputStatus::invalid_checksum:
-      return PacketStatus::invalid_checksum;
-    case FrameInputStatus::ok:
-      return PacketStatus::waiting;
-    case FrameInputStatus::output_ready:
-      break;
+  if (!synchronized_) {
+    return synchronize(read_byte);
   }
 
-  if (frame_receiver_.output(frame_buffer) == FrameOutputStatus::waiting) {
+  packet_[received_length_ / frame_max_size][received_length_ % frame_max_size] = read_byte;
+  ++received_length_;
+  if (received_length_ != packet_size * frame_max_size) {
     return PacketStatus::waiting;
   }
 
-  switch (packet_receiver_.input(frame_buffer)) {
-    case PacketInputStatus::waiting:
-      return PacketStatus::waiting;
-    case PacketInputStatus::frame_loss:
-      return PacketStatus::frame_loss;
-    case PacketInputStatus::output_ready:
-      break;
+  return complete_packet(sensor_measurements);
+}
+
+PacketStatus Device::synchronize(uint8_t new_byte) {
+  // Until it has found a frame, FrameReceiver only returns ok or output_ready
+  if (frame_receiver_.input(new_byte) != FrameInputStatus::output_ready) {
+    return PacketStatus::waiting;
+  }
+
+  Frame frame{};
+  if (frame_receiver_.output(frame) == FrameOutputStatus::waiting) {
+    return PacketStatus::waiting;
   }
 
-  switch (packet_receiver_.output(sensor_measurements)) {
-    case PacketOutputStatus::waiting:
-      return PacketStatus::waiting;
-    case PacketOutputStatus::ok:
+  // The first frame found by FrameReceiver always starts a packet
+  packet_[0] = frame;
+  received_length_ = frame_max_size;
+  synchronized_ = true;
+  frame_receiver_ = FrameReceiver();
+  return PacketStatus::waiting;
+}
+
+PacketStatus Device::complete_packet(Sample &sensor_measurements) {
+  received_length_ = 0;
+  switch (validate_packet(packet_)) {
+    case PacketValidation::ok:
+      read_packet_measurements(sensor_measurements, packet_);
+      return PacketStatus::ok;
+    case PacketValidation::invalid_header:
+      synchronized_ = false;
+      return PacketStatus::invalid_header;
+    case PacketValidation::invalid_checksum:
+      synchronized_ = false;
+      return PacketStatus::invalid_checksum;
+    case PacketValidation::frame_loss:
       break;
   }
 
-  return PacketStatus::ok;
+  // Frames were lost, so the next packet started before this one was complete; its frames are
+  // kept as the start of the next packet
+  const auto *next_start = std::find_if(packet_.begin() + 1, packet_.end(), check_packet_sync);
+  std::copy(next_start, packet_.cend(), packet_.begin());
+  received_length_ = static_cast<size_t>(packet_.cend() - next_start) * frame_max_size;
+  return PacketStatus::frame_loss;
 }
 
 }  // namespace Pufferfish::Driver::Serial::Nonin
@@ -1,6 +1,5 @@
-/// PacketReceiver.cpp
-/// Packet receiver takes the input frames and output the packet
-/// measurements on availability
+/// Packet.cpp
+/// Validation of packets of frames from the Nonin OEM III, and parsing of their measurements
 
 // Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
 // SPDX-License-Identifier: Apache-2.0
@@ -19,8 +18,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "Pufferfish/Driver/Serial/Nonin/PacketReceiver.h"
+#include "Pufferfish/Driver/Serial/Nonin/Packet.h"
 
+#include <climits>
 #include <cstddef>
 #include <cstdint>
 
@@ -90,45 +90,43 @@ bool check_packet_sync(const Frame &frame) {
   return (frame[FrameBytes::status] & StatusMasks::sync) == StatusMasks::sync;
 }
 
-PacketInputStatus PacketReceiver::input(const Frame &frame) {
-  if (check_packet_sync(frame)) {
-    if (received_length_ != packet_size) {
-      received_length_ = 0;
-      packet_data_[received_length_] = frame;
-      received_length_ += 1;
-
-      input_status_ = PacketInputStatus::frame_loss;
-      return input_status_;
-    }
-
-    received_length_ = 0;
+PacketValidation validate_packet(const Packet &packet) {
+  static_assert(packet_size <= sizeof(uint32_t) * CHAR_BIT, "Frame bitmasks are too narrow");
+  static const uint8_t frame_header = 0x01;
+
+  // Every frame is checked without branching on the results, so that the loop can be unrolled
+  // and its loads pipelined; each check sets the frame's bit in a mask of failures
+  uint32_t invalid_headers = 0;
+  uint32_t invalid_checksums = 0;
+  uint32_t syncs = 0;
+  for (size_t index = 0; index < packet_size; ++index) {
+    const Frame &frame = packet[index];
+    const uint32_t frame_bit = 1UL << index;
+    bool valid_header = frame[FrameBytes::header] == frame_header &&
+                        (frame[FrameBytes::status] & StatusMasks::start_of_frame) != 0;
+    auto sum = static_cast<uint8_t>(
+        frame[FrameBytes::header] + frame[FrameBytes::status] + frame[FrameBytes::pleth] +
+        frame[FrameBytes::data]);
+    invalid_headers |= valid_header ? 0 : frame_bit;
+    invalid_checksums |= sum == frame[FrameBytes::checksum] ? 0 : frame_bit;
+    syncs |= check_packet_sync(frame) ? frame_bit : 0;
   }
 
-  if (received_length_ >= packet_size) {
-    input_status_ = PacketInputStatus::frame_loss;
-    return input_status_;
+  // Only the first frame of a packet should have its sync bit set
+  static const uint32_t first_frame_bit = 1;
+  uint32_t invalid = invalid_headers | invalid_checksums | (syncs ^ first_frame_bit);
+  if (invalid == 0) {
+    return PacketValidation::ok;
   }
 
-  packet_data_[received_length_] = frame;
-  ++received_length_;
-
-  if (received_length_ != packet_size) {
-    input_status_ = PacketInputStatus::waiting;
-    return input_status_;
+  uint32_t first_invalid = invalid & (~invalid + 1);
+  if ((invalid_headers & first_invalid) != 0) {
+    return PacketValidation::invalid_header;
   }
-
-  input_status_ = PacketInputStatus::output_ready;
-  return input_status_;
-}
-
-PacketOutputStatus PacketReceiver::output(Sample &sensor_measurements) {
-  if (input_status_ != PacketInputStatus::output_ready) {
-    return PacketOutputStatus::waiting;
+  if ((invalid_checksums & first_invalid) != 0) {
+    return PacketValidation::invalid_checksum;
   }
-
-  read_packet_measurements(sensor_measurements, packet_data_);
-
-  return PacketOutputStatus::ok;
+  return PacketValidation::frame_loss;
 }
 
 }  // namespace Pufferfish::Driver::Serial::Nonin
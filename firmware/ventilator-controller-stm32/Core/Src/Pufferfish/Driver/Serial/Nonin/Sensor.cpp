@@ -26,6 +26,7 @@ InitializableState Sensor::setup() {
   switch (device_.output(measurements_)) {
     case PacketStatus::ok:
       waiting_timer_.reset(time_.millis());
+      buffer_pleth();
       prev_state_ = InitializableState::ok;
       return prev_state_;
     case PacketStatus::invalid_checksum:
@@ -65,6 +66,7 @@ InitializableState Sensor::output(SensorConnections &sensor_connections, float &
       return prev_state_;
     case PacketStatus::ok:
       waiting_timer_.reset(time_.millis());
+      buffer_pleth();
       break;
   }
 
@@ -88,4 +90,38 @@ InitializableState Sensor::output(SensorConnections &sensor_connections, float &
   return InitializableState::ok;
 }
 
+BufferStatus Sensor::output(Application::PlethWaveform &waveform) {
+  static_assert(
+      sizeof(waveform.samples.bytes) >= packet_size,
+      "PlethWaveform.samples must be able to hold a packet of samples");
+  static const uint32_t ms_per_s = 1000;
+
+  if (pleth_.size() < packet_size) {
+    return BufferStatus::empty;
+  }
+
+  auto remaining = static_cast<uint32_t>(pleth_.size() - packet_size);
+  waveform.sequence = pleth_count_ - static_cast<uint32_t>(pleth_.size());
+  // Samples which stay buffered were received after the last sample of this batch
+  waveform.time = pleth_time_ - remaining * ms_per_s / frame_rate;
+  waveform.samples.size = 0;
+  for (size_t i = 0; i < packet_size; ++i) {
+    pleth_.pop(waveform.samples.bytes[waveform.samples.size]);
+    ++waveform.samples.size;
+  }
+  return BufferStatus::ok;
+}
+
+void Sensor::buffer_pleth() {
+  for (uint8_t amplitude : measurements_.packet_pleth) {
+    if (pleth_.push(amplitude) != BufferStatus::ok) {
+      uint8_t dropped = 0;
+      pleth_.pop(dropped);  // after this, pleth_ is guaranteed to have capacity
+      pleth_.push(amplitude);
+    }
+  }
+  pleth_count_ += packet_size;
+  pleth_time_ = time_.millis();
+}
+
 }  // namespace Pufferfish::Driver::Serial::Nonin
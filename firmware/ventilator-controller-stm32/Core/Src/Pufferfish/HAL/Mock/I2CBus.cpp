@@ -0,0 +1,44 @@
+/// I2CBus.cpp
+/// This file has methods for mock abstract interfaces for testing I2C buses.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/HAL/Mock/I2CBus.h"
+
+namespace Pufferfish::HAL::Mock {
+
+I2CDeviceStatus I2CBus::recover() {
+  ++recoveries_;
+  if (recover_status_queue_.empty()) {
+    return I2CDeviceStatus::ok;
+  }
+
+  I2CDeviceStatus status = recover_status_queue_.front();
+  recover_status_queue_.pop();
+  return status;
+}
+
+void I2CBus::add_recover_status(I2CDeviceStatus status) {
+  recover_status_queue_.push(status);
+}
+
+size_t I2CBus::recoveries() const {
+  return recoveries_;
+}
+
+}  // namespace Pufferfish::HAL::Mock
@@ -52,9 +52,18 @@ I2CDeviceStatus I2CDevice::read(uint8_t *buf, size_t count) {
   return return_status;
 }
 
-// TODO(lietk12): Add implementation of this method
-// NOLINTNEXTLINE(misc-unused-parameters)
 I2CDeviceStatus I2CDevice::read(uint16_t address, uint8_t *buf, size_t count) {
+  read_address_queue_.push(address);
+  return read(buf, count);
+}
+
+I2CDeviceStatus I2CDevice::get_read_address(uint16_t &address) {
+  if (read_address_queue_.empty()) {
+    return I2CDeviceStatus::no_new_data;
+  }
+
+  address = read_address_queue_.front();
+  read_address_queue_.pop();
   return I2CDeviceStatus::ok;
 }
 
@@ -75,8 +84,12 @@ void I2CDevice::add_read(const uint8_t *buf, size_t count, I2CDeviceStatus statu
 }
 
 I2CDeviceStatus I2CDevice::write(uint8_t *buf, size_t count) {
-  I2CDeviceStatus return_status = write_status_queue_.front();
-  write_status_queue_.pop();
+  // Writes succeed by default once the queued write statuses have been used up
+  I2CDeviceStatus return_status = I2CDeviceStatus::ok;
+  if (!write_status_queue_.empty()) {
+    return_status = write_status_queue_.front();
+    write_status_queue_.pop();
+  }
 
   // count size should not exceedes ReadBuffer max size.
   REQUIRE(count <= WriteBuffer::max_size());
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * I2CBus.cpp
+ *
+ *  Created on: Oct 19, 2020
+ */
+
+#include "Pufferfish/HAL/STM32/I2CBus.h"
+
+namespace Pufferfish::HAL::STM32 {
+
+I2CDeviceStatus I2CBus::recover() {
+  // Take the pins away from the peripheral, as open-drain outputs
+  HAL_I2C_DeInit(&hi2c_);
+  GPIO_InitTypeDef gpio_init{};
+  gpio_init.Mode = GPIO_MODE_OUTPUT_OD;
+  gpio_init.Pull = GPIO_PULLUP;
+  gpio_init.Speed = GPIO_SPEED_FREQ_LOW;
+  gpio_init.Pin = scl_pin;
+  HAL_GPIO_Init(&scl_port_, &gpio_init);
+  gpio_init.Pin = sda_pin;
+  HAL_GPIO_Init(&sda_port_, &gpio_init);
+  write_sda(true);
+  write_scl(true);
+  time_.delay_micros(half_clock_period);
+
+  // Clock out the rest of the byte which the device is sending
+  for (size_t i = 0; i < max_recovery_clocks && !sda_high(); ++i) {
+    write_scl(false);
+    time_.delay_micros(half_clock_period);
+    write_scl(true);
+    time_.delay_micros(half_clock_period);
+  }
+
+  // Send a STOP condition
+  write_scl(false);
+  time_.delay_micros(half_clock_period);
+  write_sda(false);
+  time_.delay_micros(half_clock_period);
+  write_scl(true);
+  time_.delay_micros(half_clock_period);
+  write_sda(true);
+  time_.delay_micros(half_clock_period);
+  bool released = sda_high();
+
+  // Give the pins back to the peripheral
+  HAL_GPIO_DeInit(&scl_port_, scl_pin);
+  HAL_GPIO_DeInit(&sda_port_, sda_pin);
+  if (HAL_I2C_Init(&hi2c_) != HAL_OK) {
+    return I2CDeviceStatus::write_error;
+  }
+  if (!released) {
+    return I2CDeviceStatus::busy;
+  }
+  return I2CDeviceStatus::ok;
+}
+
+void I2CBus::write_scl(bool high) {
+  HAL_GPIO_WritePin(&scl_port_, scl_pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+void I2CBus::write_sda(bool high) {
+  HAL_GPIO_WritePin(&sda_port_, sda_pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+bool I2CBus::sda_high() const {
+  return HAL_GPIO_ReadPin(&sda_port_, sda_pin) == GPIO_PIN_SET;
+}
+
+}  // namespace Pufferfish::HAL::STM32
@@ -16,28 +16,39 @@ namespace Pufferfish::HAL::STM32 {
 I2CDeviceStatus I2CDevice::read(uint8_t *buf, size_t count) {
   HAL_StatusTypeDef stat =
       HAL_I2C_Master_Receive(&dev_, addr << 1U, buf, count, I2CDevice::default_timeout);
-  if (stat == HAL_OK) {
-    return I2CDeviceStatus::ok;
-  }
-  return I2CDeviceStatus::read_error;
+  return to_status(stat, I2CDeviceStatus::read_error);
 }
 
 I2CDeviceStatus I2CDevice::read(uint16_t address, uint8_t *buf, size_t count) {
   HAL_StatusTypeDef stat = HAL_I2C_Mem_Read(
       &dev_, addr, address, sizeof(address), buf, count, I2CDevice::default_timeout);
-  if (stat == HAL_OK) {
-    return I2CDeviceStatus::ok;
-  }
-  return I2CDeviceStatus::read_error;
+  return to_status(stat, I2CDeviceStatus::read_error);
 }
 
 I2CDeviceStatus I2CDevice::write(uint8_t *buf, size_t count) {
   HAL_StatusTypeDef stat =
       HAL_I2C_Master_Transmit(&dev_, addr << 1U, buf, count, I2CDevice::default_timeout);
-  if (stat == HAL_OK) {
-    return I2CDeviceStatus::ok;
+  return to_status(stat, I2CDeviceStatus::write_error);
+}
+
+I2CDeviceStatus I2CDevice::to_status(HAL_StatusTypeDef stat, I2CDeviceStatus error) {
+  switch (stat) {
+    case HAL_OK:
+      return I2CDeviceStatus::ok;
+    case HAL_TIMEOUT:
+      return I2CDeviceStatus::timeout;
+    case HAL_BUSY:
+      return I2CDeviceStatus::busy;
+    case HAL_ERROR:
+      if ((HAL_I2C_GetError(&dev_) & HAL_I2C_ERROR_AF) != 0U) {
+        return I2CDeviceStatus::nack;
+      }
+      if ((HAL_I2C_GetError(&dev_) & HAL_I2C_ERROR_TIMEOUT) != 0U) {
+        return I2CDeviceStatus::timeout;
+      }
+      break;
   }
-  return I2CDeviceStatus::write_error;
+  return error;
 }
 
 }  // namespace Pufferfish::HAL::STM32
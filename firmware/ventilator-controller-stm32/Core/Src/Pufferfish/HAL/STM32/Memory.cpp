@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Memory.cpp
+ *
+ *  Memory protection and cache configuration
+ */
+
+#include "Pufferfish/HAL/STM32/Memory.h"
+
+#include "stm32h7xx_hal.h"
+
+// Symbols defined by the linker script; only their addresses are meaningful
+extern "C" {
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint8_t _Min_Heap_Size;
+}
+
+namespace Pufferfish::HAL::STM32 {
+
+void configure_memory() {
+  HAL_MPU_Disable();
+
+  // D2 SRAM (0x30000000, 288 KB) is covered by a 512 KB region; the rest of the
+  // region is reserved address space. Normal, shareable, non-cacheable memory
+  // (TEX = 1, C = 0, B = 0), so that DMA never reads or writes stale cache lines.
+  static const uint32_t d2_sram_address = 0x30000000;
+  MPU_Region_InitTypeDef region{};
+  region.Enable = MPU_REGION_ENABLE;
+  region.Number = MPU_REGION_NUMBER0;
+  region.BaseAddress = d2_sram_address;
+  region.Size = MPU_REGION_SIZE_512KB;
+  region.SubRegionDisable = 0x00;
+  region.TypeExtField = MPU_TEX_LEVEL1;
+  region.AccessPermission = MPU_REGION_FULL_ACCESS;
+  region.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+  region.IsShareable = MPU_ACCESS_SHAREABLE;
+  region.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+  region.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+  HAL_MPU_ConfigRegion(&region);
+
+  // All other memory keeps the default memory map's attributes
+  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+
+  // The data cache stays disabled until DMA users and their cache maintenance are audited
+  SCB_EnableICache();
+}
+
+uint32_t *stack_bottom() {
+  auto heap_end =
+      reinterpret_cast<uintptr_t>(&_end) + reinterpret_cast<uintptr_t>(&_Min_Heap_Size);
+  static const uintptr_t word_mask = sizeof(uint32_t) - 1;
+  return reinterpret_cast<uint32_t *>((heap_end + word_mask) & ~word_mask);
+}
+
+uint32_t *stack_top() {
+  return reinterpret_cast<uint32_t *>(&_estack);
+}
+
+}  // namespace Pufferfish::HAL::STM32
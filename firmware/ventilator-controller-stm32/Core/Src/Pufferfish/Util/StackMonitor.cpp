@@ -0,0 +1,81 @@
+/// \file
+/// \brief Stack high-water mark measurement by stack painting
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/StackMonitor.h"
+
+namespace Pufferfish::Util {
+
+StackMonitor::StackMonitor(uint32_t *bottom, uint32_t *top)
+    : bottom_(bottom),
+      num_words_(top > bottom ? static_cast<size_t>(top - bottom) : 0),
+      used_boundary_(num_words_) {}
+
+void StackMonitor::paint(const void *stack_pointer) {
+  auto limit = reinterpret_cast<uintptr_t>(stack_pointer);
+  auto bottom = reinterpret_cast<uintptr_t>(bottom_);
+  size_t num_painted = 0;
+  if (limit > bottom + paint_guard) {
+    num_painted = (limit - paint_guard - bottom) / sizeof(uint32_t);
+  }
+  if (num_painted > num_words_) {
+    num_painted = num_words_;
+  }
+
+  // The stack is accessed through a volatile pointer so that the compiler can't assume it knows
+  // what the unused part of the stack holds
+  volatile uint32_t *words = bottom_;
+  for (size_t i = 0; i < num_painted; ++i) {
+    words[i] = paint_pattern;
+  }
+  used_boundary_ = num_painted;
+  cursor_ = 0;
+}
+
+bool StackMonitor::update(size_t max_words) {
+  const volatile uint32_t *words = bottom_;
+  size_t end = cursor_ + max_words;
+  if (end > used_boundary_) {
+    end = used_boundary_;
+  }
+
+  for (; cursor_ < end; ++cursor_) {
+    if (words[cursor_] != paint_pattern) {
+      used_boundary_ = cursor_;
+      cursor_ = 0;
+      return true;
+    }
+  }
+
+  if (cursor_ >= used_boundary_) {
+    // Pass completed without finding any new usage
+    cursor_ = 0;
+  }
+  return false;
+}
+
+size_t StackMonitor::size() const {
+  return num_words_ * sizeof(uint32_t);
+}
+
+size_t StackMonitor::high_water_mark() const {
+  return (num_words_ - used_boundary_) * sizeof(uint32_t);
+}
+
+}  // namespace Pufferfish::Util
@@ -40,16 +40,20 @@
 #include "Pufferfish/Driver/BreathingCircuit/Alarms.h"
 #include "Pufferfish/Driver/BreathingCircuit/AlarmsService.h"
 #include "Pufferfish/Driver/BreathingCircuit/ControlLoop.h"
+#include "Pufferfish/Driver/BreathingCircuit/FlowCrossCheck.h"
 #include "Pufferfish/Driver/BreathingCircuit/ParametersService.h"
 #include "Pufferfish/Driver/BreathingCircuit/SensorAlarmsService.h"
 #include "Pufferfish/Driver/BreathingCircuit/SignalSmoothing.h"
 #include "Pufferfish/Driver/BreathingCircuit/Simulator.h"
 #include "Pufferfish/Driver/Button/Button.h"
 #include "Pufferfish/Driver/I2C/ExtendedI2CDevice.h"
+#include "Pufferfish/Driver/I2C/HealthMonitor.h"
 #include "Pufferfish/Driver/I2C/HoneywellABP/Device.h"
 #include "Pufferfish/Driver/I2C/HoneywellABP/Sensor.h"
 #include "Pufferfish/Driver/I2C/LTC4015/Sensor.h"
+#include "Pufferfish/Driver/I2C/MuxScheduler.h"
 #include "Pufferfish/Driver/I2C/SDP.h"
+#include "Pufferfish/Driver/I2C/SDP/Sensor.h"
 #include "Pufferfish/Driver/I2C/SFM3000.h"
 #include "Pufferfish/Driver/I2C/SFM3019/Sensor.h"
 #include "Pufferfish/Driver/I2C/TCA9548A.h"
@@ -58,6 +62,7 @@
 #include "Pufferfish/Driver/Indicators/PulseGenerator.h"
 #include "Pufferfish/Driver/Power/AlarmsService.h"
 #include "Pufferfish/Driver/Power/Simulator.h"
+#include "Pufferfish/Driver/Reconnector.h"
 #include "Pufferfish/Driver/Serial/Backend/AlarmsService.h"
 #include "Pufferfish/Driver/Serial/Backend/UART.h"
 #include "Pufferfish/Driver/Serial/FDO2/Sensor.h"
@@ -65,8 +70,10 @@
 #include "Pufferfish/Driver/Serial/Nonin/SensorAlarmService.h"
 #include "Pufferfish/Driver/ShiftedOutput.h"
 #include "Pufferfish/HAL/Endian.h"
+#include "Pufferfish/HAL/Memory.h"
 #include "Pufferfish/HAL/STM32/HAL.h"
 #include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/StackMonitor.h"
 #include "Pufferfish/Util/Timeouts.h"
 
 /* USER CODE END Includes */
@@ -116,7 +123,19 @@ UART_HandleTypeDef huart3;
 namespace PF = Pufferfish;
 
 // Application State
-PF::Application::Store store;
+PF_DTCM_DATA PF::Application::Store store;
+
+// Diagnostics
+PF::Util::StackMonitor stack_monitor(
+    PF::HAL::STM32::stack_bottom(), PF::HAL::STM32::stack_top());
+// Scanning the entire unused stack takes too long for a single iteration of the main loop
+static const size_t stack_scan_words = 256;
+static const uint32_t i2c_diagnostics_interval = 1000;  // ms
+PF::Util::MsTimer i2c_diagnostics_timer(i2c_diagnostics_interval);
+// Snapshots for readers outside the main loop are published at a bounded rate, since each
+// publish copies the snapshotted states
+static const uint32_t store_snapshot_interval = 10;  // ms
+PF::Util::MsTimer store_snapshot_timer(store_snapshot_interval);
 
 // Event Logging
 PF::Application::LogEventsSender log_events_sender;
@@ -253,22 +272,6 @@ PF::HAL::STM32::PWM drive2_ch7(htim12, TIM_CHANNEL_2);
 
 // Base I2C Devices
 // Note: I2C1 is marked I2C2 in the control board v1.0 schematic, and vice versa
-/*PF::HAL::STM32::I2CDevice i2c_hal_mux1(hi2c2, PF::Driver::I2C::TCA9548A::default_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_mux2(hi2c1, PF::Driver::I2C::TCA9548A::default_i2c_addr);
-
-PF::HAL::STM32::I2CDevice i2c_hal_press1(hi2c1, PF::Driver::I2C::abpxxxx001pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press2(hi2c1, PF::Driver::I2C::abpxxxx001pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press3(hi2c1, PF::Driver::I2C::abpxxxx001pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press7(hi2c1, PF::Driver::I2C::abpxxxx030pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press8(hi2c1, PF::Driver::I2C::abpxxxx030pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press9(hi2c1, PF::Driver::I2C::abpxxxx001pg2a3.i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press13(hi2c2, PF::Driver::I2C::SDPSensor::sdp8xx_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press14(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press15(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press16(hi2c2, PF::Driver::I2C::SFM3000::default_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press17(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
-PF::HAL::STM32::I2CDevice i2c_hal_press18(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);*/
-
 PF::HAL::STM32::I2CDevice i2c1_hal_global(hi2c1, 0x00);
 PF::HAL::STM32::I2CDevice i2c2_hal_global(hi2c2, 0x00);
 PF::HAL::STM32::I2CDevice i2c4_hal_global(hi2c4, 0x00);
@@ -277,7 +280,65 @@ PF::HAL::STM32::I2CDevice i2c_hal_abp(
 PF::HAL::STM32::I2CDevice i2c_hal_ltc4015(hi2c1, PF::Driver::I2C::LTC4015::device_addr);
 PF::HAL::STM32::I2CDevice i2c_hal_sfm3019_air(hi2c2, PF::Driver::I2C::SFM3019::default_i2c_addr);
 PF::HAL::STM32::I2CDevice i2c_hal_sfm3019_o2(hi2c4, PF::Driver::I2C::SFM3019::default_i2c_addr);
-/*
+PF::HAL::STM32::I2CDevice i2c_hal_sdp(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
+
+// I2C Health
+PF::HAL::STM32::I2CBus i2c1_bus(
+    hi2c1,
+    *GPIOB,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_8,
+    *GPIOB,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_9,
+    hal_time);
+PF::HAL::STM32::I2CBus i2c2_bus(
+    hi2c2,
+    *GPIOB,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_10,
+    *GPIOB,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_11,
+    hal_time);
+PF::HAL::STM32::I2CBus i2c4_bus(
+    hi2c4,
+    *GPIOF,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_14,
+    *GPIOD,  // @suppress("C-Style cast instead of C++ cast") // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    GPIO_PIN_13,
+    hal_time);
+PF::Driver::I2C::MonitoredDevice i2c_abp(i2c_hal_abp, i2c1_bus, hal_time);
+PF::Driver::I2C::MonitoredDevice i2c_ltc4015(i2c_hal_ltc4015, i2c1_bus, hal_time);
+PF::Driver::I2C::MonitoredDevice i2c_sfm3019_air(i2c_hal_sfm3019_air, i2c2_bus, hal_time);
+PF::Driver::I2C::MonitoredDevice i2c_sfm3019_o2(i2c_hal_sfm3019_o2, i2c4_bus, hal_time);
+PF::Driver::I2C::MonitoredDevice i2c_sdp(i2c_hal_sdp, i2c2_bus, hal_time);
+auto i2c_health_monitors = PF::Driver::I2C::make_health_monitors(
+    i2c_sfm3019_air, i2c_sfm3019_o2, i2c_abp, i2c_ltc4015, i2c_sdp);
+
+// I2C Mux Test Bench
+// The 14-sensor test bench puts 12 pressure and flow sensors behind two muxes on I2C1 and I2C2.
+// Its ABP and SDP sensors share the addresses of the ventilator's own ABP and SDP sensors, so
+// they're only read in builds for the test bench.
+#ifdef PF_I2C_MUX_TEST_BENCH
+PF::HAL::STM32::I2CDevice i2c_hal_mux1(hi2c2, PF::Driver::I2C::TCA9548A::default_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_mux2(hi2c1, PF::Driver::I2C::TCA9548A::default_i2c_addr);
+
+PF::HAL::STM32::I2CDevice i2c_hal_press1(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press2(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press3(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press7(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx030pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press8(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx030pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press9(
+    hi2c1, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3.i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press13(hi2c2, PF::Driver::I2C::SDPSensor::sdp8xx_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press14(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press15(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press16(hi2c2, PF::Driver::I2C::SFM3000::default_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press17(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
+PF::HAL::STM32::I2CDevice i2c_hal_press18(hi2c2, PF::Driver::I2C::SDPSensor::sdp3x_i2c_addr);
+
 // I2C Mux
 PF::Driver::I2C::TCA9548A i2c_mux1(i2c_hal_mux1);
 PF::Driver::I2C::TCA9548A i2c_mux2(i2c_hal_mux2);
@@ -303,72 +364,169 @@ PF::Driver::I2C::ExtendedI2CDevice i2c_ext_press18(
     5);
 
 // Actual usable sensor
-PF::Driver::I2C::HoneywellABP i2c_press1(i2c_ext_press1, PF::Driver::I2C::abpxxxx001pg2a3);
-PF::Driver::I2C::HoneywellABP i2c_press2(i2c_ext_press2, PF::Driver::I2C::abpxxxx001pg2a3);
-PF::Driver::I2C::HoneywellABP i2c_press3(i2c_ext_press3, PF::Driver::I2C::abpxxxx001pg2a3);
-PF::Driver::I2C::HoneywellABP i2c_press7(i2c_ext_press7, PF::Driver::I2C::abpxxxx030pg2a3);
-PF::Driver::I2C::HoneywellABP i2c_press8(i2c_ext_press8, PF::Driver::I2C::abpxxxx030pg2a3);
-PF::Driver::I2C::HoneywellABP i2c_press9(i2c_ext_press9, PF::Driver::I2C::abpxxxx001pg2a3);
-PF::Driver::I2C::SDPSensor i2c_press13(i2c_ext_press13);
-PF::Driver::I2C::SDPSensor i2c_press14(i2c_ext_press14);
-PF::Driver::I2C::SDPSensor i2c_press15(i2c_ext_press15);
-PF::Driver::I2C::SFM3000 i2c_press16(i2c_ext_press16);
-PF::Driver::I2C::SDPSensor i2c_press17(i2c_ext_press17);
-PF::Driver::I2C::SDPSensor i2c_press18(i2c_ext_press18);
-*/
+PF::Driver::I2C::HoneywellABP::Device i2c_press1(
+    i2c_ext_press1, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
+PF::Driver::I2C::HoneywellABP::Device i2c_press2(
+    i2c_ext_press2, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
+PF::Driver::I2C::HoneywellABP::Device i2c_press3(
+    i2c_ext_press3, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
+PF::Driver::I2C::HoneywellABP::Device i2c_press7(
+    i2c_ext_press7, PF::Driver::I2C::HoneywellABP::abpxxxx030pg2a3);
+PF::Driver::I2C::HoneywellABP::Device i2c_press8(
+    i2c_ext_press8, PF::Driver::I2C::HoneywellABP::abpxxxx030pg2a3);
+PF::Driver::I2C::HoneywellABP::Device i2c_press9(
+    i2c_ext_press9, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
+PF::Driver::I2C::SDPSensor i2c_press13(i2c_ext_press13, hal_time);
+PF::Driver::I2C::SDPSensor i2c_press14(i2c_ext_press14, hal_time);
+PF::Driver::I2C::SDPSensor i2c_press15(i2c_ext_press15, hal_time);
+PF::Driver::I2C::SFM3000 i2c_press16(i2c_ext_press16, hal_time);
+PF::Driver::I2C::SDPSensor i2c_press17(i2c_ext_press17, hal_time);
+PF::Driver::I2C::SDPSensor i2c_press18(i2c_ext_press18, hal_time);
+
+// Test list
+// NOLINTNEXTLINE(readability-magic-numbers)
+auto i2c_mux_test_list = PF::Util::Containers::make_array<PF::Driver::Testable *>(
+    &i2c_mux1,
+    &i2c_mux2,
+    &i2c_press13,
+    &i2c_press14,
+    &i2c_press15,
+    &i2c_press16,
+    &i2c_press17,
+    &i2c_press18);
+std::array<PF::I2CDeviceStatus, i2c_mux_test_list.size()> i2c_mux_test_statuses{};
+
+// Mux Scheduler
+// Devices are listed by sensor type, so that each type's readings have consecutive indices
+auto i2c_mux_abps = PF::Util::Containers::make_array<
+    std::reference_wrapper<PF::Driver::I2C::HoneywellABP::Device>>(
+    i2c_press1, i2c_press2, i2c_press3, i2c_press7, i2c_press8, i2c_press9);
+auto i2c_mux_sdps = PF::Util::Containers::make_array<
+    std::reference_wrapper<PF::Driver::I2C::SDPSensor>>(
+    i2c_press13, i2c_press14, i2c_press15, i2c_press17, i2c_press18);
+auto i2c_mux_scheduler = PF::Driver::I2C::make_mux_scheduler(
+    i2c_ext_press1,
+    i2c_ext_press2,
+    i2c_ext_press3,
+    i2c_ext_press7,
+    i2c_ext_press8,
+    i2c_ext_press9,
+    i2c_ext_press13,
+    i2c_ext_press14,
+    i2c_ext_press15,
+    i2c_ext_press17,
+    i2c_ext_press18,
+    i2c_ext_press16);
+static const uint32_t i2c_mux_interval = 10;  // ms
+PF::Util::MsTimer i2c_mux_timer(i2c_mux_interval);
+// The latest reading of each device, indexed as in the scheduler: ABP pressures in psi, SDP
+// differential pressures in Pa, and the SFM3000 flow in L/min
+std::array<float, i2c_mux_abps.size() + i2c_mux_sdps.size() + 1> i2c_mux_readings{};
+
+void read_i2c_mux_sensor(size_t index) {
+  if (index < i2c_mux_abps.size()) {
+    PF::Driver::I2C::HoneywellABP::Sample sample{};
+    if (i2c_mux_abps[index].get().read_sample(sample) == PF::I2CDeviceStatus::ok) {
+      i2c_mux_readings[index] = sample.pressure;
+    }
+    return;
+  }
+
+  size_t sdp_index = index - i2c_mux_abps.size();
+  if (sdp_index < i2c_mux_sdps.size()) {
+    PF::Driver::I2C::SDPSample sample{};
+    if (i2c_mux_sdps[sdp_index].get().read_full_sample(sample) == PF::I2CDeviceStatus::ok) {
+      i2c_mux_readings[index] = sample.differential_pressure;
+    }
+    return;
+  }
+
+  PF::Driver::I2C::SFM3000Sample sample{};
+  if (i2c_press16.read_sample(sample) == PF::I2CDeviceStatus::ok) {
+    i2c_mux_readings[index] = sample.flow;
+  }
+}
+#endif
 
 // HoneyWell ABP
 PF::Driver::I2C::HoneywellABP::Device abp_dev(
-    i2c_hal_abp, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
+    i2c_abp, PF::Driver::I2C::HoneywellABP::abpxxxx001pg2a3);
 PF::Driver::I2C::HoneywellABP::Sensor abp(abp_dev, hal_time);
 
 // SFM3019
 
 PF::Driver::I2C::SFM3019::Device sfm3019_dev_air(
-    i2c_hal_sfm3019_air, i2c2_hal_global, PF::Driver::I2C::SFM3019::GasType::air);
+    i2c_sfm3019_air, i2c2_hal_global, PF::Driver::I2C::SFM3019::GasType::air);
 PF::Driver::I2C::SFM3019::Sensor sfm3019_air(sfm3019_dev_air, true, hal_time);
 PF::Driver::I2C::SFM3019::Device sfm3019_dev_o2(
-    i2c_hal_sfm3019_o2, i2c4_hal_global, PF::Driver::I2C::SFM3019::GasType::o2);
+    i2c_sfm3019_o2, i2c4_hal_global, PF::Driver::I2C::SFM3019::GasType::o2);
 PF::Driver::I2C::SFM3019::Sensor sfm3019_o2(sfm3019_dev_o2, true, hal_time);
 
+// SDP
+// The SDP3x measures the differential pressure across the restriction in the air line, as a
+// redundant estimate of the air flow. The restriction is sized so that the SDP3x's full scale of
+// 500 Pa corresponds to 100 L/min, i.e. 25% above the maximum flow setting of 80 L/min, which
+// gives a flow coefficient of 100 L/min / sqrt(500 Pa). This must be recalibrated whenever the
+// restriction is changed.
+static const float sdp_flow_coefficient = 4.47;  // L/min at 1 Pa
+PF::Driver::I2C::SDPSensor sdp_dev(i2c_sdp, hal_time);
+PF::Driver::I2C::SDP::Sensor sdp(sdp_dev, sdp_flow_coefficient, hal_time);
+
+// Air Flow Cross-Check
+// The SDP's flow resolution is coarse at low flows, where an offset of 0.2 Pa is already about
+// 2 L/min, and its flow coefficient is nominal until it's calibrated; so the cross-check is
+// reported in diagnostics rather than raising alarms.
+static const float air_flow_tolerance = 5;             // L/min
+static const float air_flow_relative_tolerance = 0.15;  // of the SFM3019 air flow
+PF::Driver::BreathingCircuit::FlowCrossCheck air_flow_check(
+    air_flow_tolerance, air_flow_relative_tolerance);
+
 // FDO2
 PF::Driver::Serial::FDO2::Device fdo2_dev(fdo2_uart);
-PF::Driver::Serial::FDO2::Sensor fdo2(fdo2_dev, hal_time);
+// Measurements are broadcast at twice the default rate and averaged in pairs, so that the
+// decimated pO2 keeps the default 100 ms interval with less noise
+static const uint16_t fdo2_broadcast_interval = 50;  // ms
+static const size_t fdo2_decimation = 2;
+PF::Driver::Serial::FDO2::Sensor fdo2(
+    fdo2_dev, hal_time, fdo2_broadcast_interval, fdo2_decimation);
 
 // Nonin OEM III
 PF::Driver::Serial::Nonin::Device nonin_oem_dev(nonin_oem_uart);
 PF::Driver::Serial::Nonin::Sensor nonin_oem(nonin_oem_dev, hal_time);
 
 // LTC4015
-PF::Driver::I2C::LTC4015::Device ltc4015_dev(i2c_hal_ltc4015);
-PF::Driver::I2C::LTC4015::Sensor ltc4015(ltc4015_dev);
+PF::Driver::I2C::LTC4015::Device ltc4015_dev(i2c_ltc4015);
+PF::Driver::I2C::LTC4015::Sensor ltc4015(ltc4015_dev, hal_time);
 
 // Power
 PF::Driver::Power::Simulator power_simulator;
 
 // Initializables
-auto initializables =
-    PF::Driver::make_initializables(sfm3019_air, sfm3019_o2, abp, fdo2, nonin_oem, ltc4015);
-
-/*
-// Test list
-// NOLINTNEXTLINE(readability-magic-numbers)
-auto i2c_test_list = PF::Util::make_array<PF::Driver::Testable *>(
-     &i2c_mux1,
-     &i2c_mux2,
-     &i2c_press1,
-     &i2c_press2,
-     &i2c_press3,
-     &i2c_press7,
-     &i2c_press8,
-     &i2c_press9,
-     &i2c_press13,
-     &i2c_press14,
-     &i2c_press15,
-     &i2c_press16,
-     &i2c_press17,
-     &i2c_press18);
-*/
+// The order of these is the order of the sensors in the setup progress of MCUDiagnostics
+static const uint32_t sensor_setup_timeout = 10000;  // ms
+auto initializables = PF::Driver::make_initializables(
+    sensor_setup_timeout, sfm3019_air, sfm3019_o2, abp, fdo2, nonin_oem, ltc4015, sdp);
+
+// Reconnectors
+static const uint32_t reconnect_initial_backoff = 100;  // ms
+static const uint32_t reconnect_max_backoff = 5000;     // ms
+PF::Driver::Reconnector sfm3019_air_reconnector(
+    sfm3019_air, reconnect_initial_backoff, reconnect_max_backoff, sensor_setup_timeout);
+PF::Driver::Reconnector sfm3019_o2_reconnector(
+    sfm3019_o2, reconnect_initial_backoff, reconnect_max_backoff, sensor_setup_timeout);
+PF::Driver::Reconnector abp_reconnector(
+    abp, reconnect_initial_backoff, reconnect_max_backoff, sensor_setup_timeout);
+PF::Driver::Reconnector fdo2_reconnector(
+    fdo2, reconnect_initial_backoff, reconnect_max_backoff, sensor_setup_timeout);
+PF::Driver::Reconnector sdp_reconnector(
+    sdp, reconnect_initial_backoff, reconnect_max_backoff, sensor_setup_timeout);
+// The order of these is the order of the sensors in the reconnections of MCUDiagnostics
+auto reconnectors = PF::Driver::make_reconnectors(
+    sfm3019_air_reconnector,
+    sfm3019_o2_reconnector,
+    abp_reconnector,
+    fdo2_reconnector,
+    sdp_reconnector);
 
 int interface_test_state = 0;
 int interface_test_millis = 0;
@@ -382,17 +540,44 @@ PF::Application::AlarmMuteService alarm_mute;
 PF::Driver::BreathingCircuit::AlarmsServices breathing_circuit_alarms;
 PF::Driver::Power::AlarmsService power_alarms;
 
+// State Change Subscriptions
+// Only services which are idempotent in their inputs are gated on state changes. Alarm services
+// advance debouncers and timers, so they run on every main loop iteration.
+using PF::Application::MessageTypes;
+PF::Application::Store::Subscription<1> parameters_subscription(
+    store.versions(),
+    PF::Util::Containers::make_array<MessageTypes>(MessageTypes::parameters_request));
+PF::Application::Store::Subscription<2> alarm_limits_subscription(
+    store.versions(),
+    PF::Util::Containers::make_array<MessageTypes>(
+        MessageTypes::parameters, MessageTypes::alarm_limits_request));
+PF::Application::Store::Subscription<1> screen_lock_subscription(
+    store.versions(),
+    PF::Util::Containers::make_array<MessageTypes>(MessageTypes::screen_status_request));
+
 // Breathing Circuit Control
-PF::Driver::BreathingCircuit::HFNCControlLoop hfnc(
+// Low-pass filtering of the SFM3019 flow measurements before the controller uses them is off until
+// its effect on the closed loop has been validated on hardware
+static const bool prefilter_flows = false;
+// The feed-forward controller's valve characteristic and gains are nominal values which haven't
+// been calibrated against the real valves, so it's only used in builds which opt into it
+#ifdef PF_HFNC_FEEDFORWARD_CONTROLLER
+PF_DTCM_DATA PF::Driver::BreathingCircuit::HFNCFeedforwardController hfnc_controller;
+#else
+PF_DTCM_DATA PF::Driver::BreathingCircuit::HFNCController hfnc_controller;
+#endif
+PF_DTCM_DATA PF::Driver::BreathingCircuit::HFNCControlLoop hfnc(
     store.parameters(),
     store.sensor_measurements_raw(),
     sfm3019_air,
     sfm3019_o2,
     drive1_ch1,
-    drive1_ch2);
+    drive1_ch2,
+    hfnc_controller,
+    prefilter_flows);
 
 // Signal processing
-PF::Driver::BreathingCircuit::SensorMeasurementsSmoothers sensor_smoothers;
+PF_DTCM_DATA PF::Driver::BreathingCircuit::SensorMeasurementsSmoothers<> sensor_smoothers;
 
 /* USER CODE END PV */
 
@@ -497,6 +682,12 @@ int main(void)
   static const uint32_t loop_delay = 50;
   */
 
+  PF::HAL::STM32::configure_memory();
+  // Interrupts aren't enabled yet, so nothing else is using the stack while it's painted
+  stack_monitor.paint(__builtin_frame_address(0));
+  store.mcu_diagnostics().stack_size = stack_monitor.size();
+  store.mcu_diagnostics().scratch_size = static_cast<uint32_t>(backend.scratch().max_size());
+
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -585,44 +776,48 @@ int main(void)
 
   board_led1.write(true);
   while (true) {
-    initializables.setup();
-    if (initializables.setup_failed()) {
-      setup_indicator_timer.reset(hal_time.millis());
-      // Flash the LED rapidly to indicate failure
-      while (setup_indicator_timer.within_timeout(hal_time.millis())) {
-        flasher.input(hal_time.millis());
-        board_led1.write(flasher.output());
-      }
-    } else if (initializables.setup_in_progress()) {
-      board_led1.write(true);
-    } else {  // All are done with setup and ok
+    initializables.setup(hal_time.millis());
+    if (!initializables.setup_in_progress()) {
       break;
     }
   }
+  initializables.output(store.mcu_diagnostics());
+  store.notify(MessageTypes::mcu_diagnostics);
+#ifdef PF_I2C_MUX_TEST_BENCH
+  for (size_t i = 0; i < i2c_mux_test_list.size(); ++i) {
+    i2c_mux_test_statuses[i] = i2c_mux_test_list[i]->test();
+  }
+  for (PF::Driver::I2C::SDPSensor &sdp : i2c_mux_sdps) {
+    sdp.start_continuous();
+  }
+  i2c_press16.start_measure();
+#endif
 
-  // Blink the LED somewhat slowly to indicate success
+  // Sensors which failed setup are set up again in the background by their reconnectors, or are
+  // replaced by the simulators, so a failure is only indicated before the normal loop starts
   setup_indicator_timer.reset(hal_time.millis());
-  while (setup_indicator_timer.within_timeout(hal_time.millis())) {
-    blinker.input(hal_time.millis());
-    board_led1.write(blinker.output());
+  if (initializables.setup_failed()) {
+    // Flash the LED rapidly to indicate failure
+    while (setup_indicator_timer.within_timeout(hal_time.millis())) {
+      flasher.input(hal_time.millis());
+      board_led1.write(flasher.output());
+    }
+  } else {
+    // Blink the LED somewhat slowly to indicate success
+    while (setup_indicator_timer.within_timeout(hal_time.millis())) {
+      blinker.input(hal_time.millis());
+      board_led1.write(blinker.output());
+    }
   }
   board_led1.write(false);
 
   // Configure the simulators
+  // The breathing circuit sensor states are updated from the reconnectors on every iteration
   PF::Driver::Serial::Nonin::SensorConnections sensor_connections{};
   PF::Driver::BreathingCircuit::SensorStates breathing_circuit_sensor_states{};
-  uint32_t discard_i = 0;
-  float discard_f = 0;
-  breathing_circuit_sensor_states.sfm3019_air =
-      sfm3019_air.output(discard_f) == PF::InitializableState::ok;
-  breathing_circuit_sensor_states.sfm3019_o2 =
-      sfm3019_o2.output(discard_f) == PF::InitializableState::ok;
-  breathing_circuit_sensor_states.fdo2 = fdo2.output(discard_i) == PF::InitializableState::ok;
   bool ltc4015_status = ltc4015.output(store.mcu_power_status()) == PF::InitializableState::ok;
   // Reset nonin timer
   nonin_oem.post_setup_reset();
-  breathing_circuit_sensor_states.nonin_oem =
-      nonin_oem.output(sensor_connections, discard_f, discard_f) == PF::InitializableState::ok;
 
   // Normal loop
   while (true) {
@@ -638,29 +833,56 @@ int main(void)
     alarms_manager.update_time(current_time);
 
     // Request/response services update
-    parameters_service.transform(
-        store.parameters_request(),
-        store.has_parameters_request(),
-        store.parameters(),
-        log_events_manager,
-        alarms_manager);
-    alarm_limits_service.transform(
-        store.parameters(),
-        store.alarm_limits_request(),
-        store.has_parameters_request() && store.has_alarm_limits_request(),
-        store.alarm_limits(),
-        log_events_manager);
+    if (parameters_subscription.changed()) {
+      parameters_service.transform(
+          store.parameters_request(),
+          store.has_parameters_request(),
+          store.parameters(),
+          log_events_manager,
+          alarms_manager);
+      store.notify(MessageTypes::parameters);
+    }
+    if (alarm_limits_subscription.changed()) {
+      alarm_limits_service.transform(
+          store.parameters(),
+          store.alarm_limits_request(),
+          store.has_parameters_request() && store.has_alarm_limits_request(),
+          store.alarm_limits(),
+          log_events_manager);
+      store.notify(MessageTypes::alarm_limits);
+    }
+
+    // Sensor reconnection
+    breathing_circuit_sensor_states.sfm3019_air =
+        sfm3019_air_reconnector.update(current_time) == PF::InitializableState::ok;
+    breathing_circuit_sensor_states.sfm3019_o2 =
+        sfm3019_o2_reconnector.update(current_time) == PF::InitializableState::ok;
+    abp_reconnector.update(current_time);
+    breathing_circuit_sensor_states.fdo2 =
+        fdo2_reconnector.update(current_time) == PF::InitializableState::ok;
+    bool sdp_connected = sdp_reconnector.update(current_time) == PF::InitializableState::ok;
 
     // Independent Sensors
-    fdo2.output(hfnc.sensor_vars().po2);
+    fdo2.output();
+    PF::Driver::Serial::FDO2::Sample fdo2_sample{};
+    while (fdo2.read_decimated(fdo2_sample) == PF::BufferStatus::ok) {
+      hfnc.sensor_vars().po2 = static_cast<uint32_t>(fdo2_sample.mraw.po2);
+      hfnc.sensor_vars().po2_time = fdo2_sample.time;
+    }
     auto nonin_status = nonin_oem.output(
         sensor_connections,
         store.sensor_measurements_raw().spo2,
         store.sensor_measurements_raw().hr);
+    breathing_circuit_sensor_states.nonin_oem = nonin_status == PF::InitializableState::ok;
     PF::Driver::Serial::Nonin::SensorAlarmsService::transform(
         nonin_status, sensor_connections, alarms_manager);
+    if (nonin_oem.output(store.pleth_waveform()) == PF::BufferStatus::ok) {
+      store.notify(MessageTypes::pleth_waveform);
+    }
     // *temporary* should be used in the breathing circuit
     abp.output(hfnc.sensor_vars().p_out_above_atm);
+    float sdp_flow = 0;  // L/min
+    sdp.output(sdp_flow);
 
     // Breathing Circuit Sensor Simulator
     simulator.transform(
@@ -673,8 +895,16 @@ int main(void)
 
     // Breathing Circuit Control Loop
     hfnc.update(current_time);
-    sensor_smoothers.transform(
-        current_time, store.sensor_measurements_raw(), store.sensor_measurements_filtered());
+    if (breathing_circuit_sensor_states.sfm3019_air && sdp_connected) {
+      air_flow_check.transform(current_time, hfnc.sensor_vars().flow_air, sdp_flow);
+    } else {
+      air_flow_check.reset();
+    }
+    if (sensor_smoothers.transform(
+            current_time, store.sensor_measurements_raw(), store.sensor_measurements_filtered()) ==
+        PF::Driver::BreathingCircuit::SensorMeasurementsSmoothers<>::Status::ok) {
+      store.notify(MessageTypes::sensor_measurements);
+    }
     breathing_circuit_alarms.transform(
         store.parameters(),
         store.alarm_limits(),
@@ -695,7 +925,10 @@ int main(void)
     power_alarms.transform(store.mcu_power_status(), alarms_manager);
 
     // Screen lock
-    PF::Application::ScreenLock::transform(store.screen_status_request(), store.screen_status());
+    if (screen_lock_subscription.changed()) {
+      PF::Application::ScreenLock::transform(store.screen_status_request(), store.screen_status());
+      store.notify(MessageTypes::screen_status);
+    }
 
     // Indicators for debugging
     /*static constexpr float valve_opening_indicator_threshold = 0.00001;
@@ -714,6 +947,8 @@ int main(void)
 
     // Alarms
     alarms_manager.transform(store.active_log_events());
+    // Alarm muting counts down its remaining time, so it runs on every iteration rather than only
+    // when the alarm mute request changes.
     // TODO(lietk12): allow toggling alarm mute state with the hardware button, but only when
     // both the backend and frontend are connected. This should use the
     // alarm_mute.transform(current_time, bool, ...) method.
@@ -757,6 +992,39 @@ int main(void)
     store.backend_connected() = backend.connected();
     backend_alarms.transform(store.backend_connected(), alarms_manager, log_events_manager);
 
+    // Diagnostics
+    if (stack_monitor.update(stack_scan_words)) {
+      store.mcu_diagnostics().stack_high_water_mark = stack_monitor.high_water_mark();
+      store.notify(MessageTypes::mcu_diagnostics);
+    }
+    if (backend.scratch().high_water_mark() > store.mcu_diagnostics().scratch_high_water_mark) {
+      store.mcu_diagnostics().scratch_high_water_mark =
+          static_cast<uint32_t>(backend.scratch().high_water_mark());
+      store.notify(MessageTypes::mcu_diagnostics);
+    }
+    if (reconnectors.output(store.mcu_diagnostics())) {
+      store.notify(MessageTypes::mcu_diagnostics);
+    }
+    if (!i2c_diagnostics_timer.within_timeout(current_time)) {
+      i2c_diagnostics_timer.reset(current_time);
+      i2c_health_monitors.output(store.i2c_diagnostics());
+      store.notify(MessageTypes::i2c_diagnostics);
+      air_flow_check.output(store.mcu_diagnostics());
+      store.notify(MessageTypes::mcu_diagnostics);
+    }
+#ifdef PF_I2C_MUX_TEST_BENCH
+    if (!i2c_mux_timer.within_timeout(current_time)) {
+      i2c_mux_timer.reset(current_time);
+      i2c_mux_scheduler.run(read_i2c_mux_sensor);
+    }
+#endif
+
+    // Consistent snapshot of the states needed by readers outside the main loop
+    if (!store_snapshot_timer.within_timeout(current_time)) {
+      store_snapshot_timer.reset(current_time);
+      store.publish();
+    }
+
     /*
     PF::AlarmManagerStatus stat = h_alarms.update(hal_time.millis());
     if (stat != PF::AlarmManagerStatus::ok) {
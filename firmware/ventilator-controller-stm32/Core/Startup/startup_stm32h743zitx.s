@@ -89,6 +89,38 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+/* Copy the hot code from flash to ITCM */
+  ldr  r0, =_sitcm_text
+  ldr  r1, =_eitcm_text
+  ldr  r2, =_siitcm_text
+  b  LoopCopyITCM
+
+CopyITCM:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyITCM:
+  cmp  r0, r1
+  bcc  CopyITCM
+
+/* Copy the hot data from flash to DTCM */
+  ldr  r0, =_sdtcm_data
+  ldr  r1, =_edtcm_data
+  ldr  r2, =_sidtcm_data
+  b  LoopCopyDTCM
+
+CopyDTCM:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyDTCM:
+  cmp  r0, r1
+  bcc  CopyDTCM
+
+/* Make sure the copied code is visible to instruction fetches */
+  dsb
+  isb
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
 /* Call static constructors */
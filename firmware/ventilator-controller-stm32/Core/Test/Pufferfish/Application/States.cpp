@@ -10,12 +10,20 @@
 
 #include <utility>
 
+#include "Pufferfish/Util/Containers/Array.h"
 #include "catch2/catch.hpp"
 
 using Pufferfish::Application::ActiveLogEvents;
 using Pufferfish::Application::AlarmLimits;
+using Pufferfish::Application::MessageTypes;
 using Pufferfish::Application::NextLogEvents;
+using Pufferfish::Application::ParametersRequest;
 using Pufferfish::Application::Range;
+using Pufferfish::Application::ScreenStatusRequest;
+using Pufferfish::Application::StateSegment;
+using Pufferfish::Application::StateSnapshot;
+using Pufferfish::Application::Store;
+using Pufferfish::Util::Containers::make_array;
 
 SCENARIO(
     "The equality operator works correctly for simple POD structs from nanopb",
@@ -312,3 +320,133 @@ SCENARIO(
     }
   }
 }
+
+SCENARIO(
+    "Store subscriptions are notified of changes to their dependencies", "[Application::States]") {
+  GIVEN("A store and a subscription to its parameters_request and screen_status_request states") {
+    Store store;
+    Store::Subscription<2> subscription(
+        store.versions(),
+        make_array<MessageTypes>(
+            MessageTypes::parameters_request, MessageTypes::screen_status_request));
+
+    WHEN("the subscription is checked for the first time") {
+      bool changed = subscription.changed();
+
+      THEN("the changed method returns true") { REQUIRE(changed); }
+    }
+
+    WHEN("the subscription is checked twice without any inputs to the store") {
+      subscription.changed();
+      bool changed = subscription.changed();
+
+      THEN("the second call of the changed method returns false") { REQUIRE(!changed); }
+    }
+
+    WHEN("a new parameters_request is input to the store after the subscription is checked") {
+      subscription.changed();
+      ParametersRequest request{};
+      request.fio2 = 40;
+      StateSegment segment;
+      segment.set(request);
+      auto status = store.input(segment);
+      bool changed = subscription.changed();
+      bool changed_again = subscription.changed();
+
+      THEN("the input method reports ok status") { REQUIRE(status == Store::Status::ok); }
+      THEN("the changed method returns true") { REQUIRE(changed); }
+      THEN("the next call of the changed method returns false") { REQUIRE(!changed_again); }
+    }
+
+    WHEN("the same screen_status_request is input to the store twice") {
+      ScreenStatusRequest request{};
+      request.lock = true;
+      StateSegment segment;
+      segment.set(request);
+      store.input(segment);
+      subscription.changed();
+      store.input(segment);
+      bool changed = subscription.changed();
+
+      THEN("the changed method returns false after the repeated input") { REQUIRE(!changed); }
+    }
+
+    WHEN(
+        "a parameters_request equal to the initial one is input to the store for the first time, "
+        "not as a default initialization") {
+      subscription.changed();
+      StateSegment segment;
+      segment.set(ParametersRequest{});
+      store.input(segment);
+      bool changed = subscription.changed();
+
+      THEN("the store reports that it has a parameters request") {
+        REQUIRE(store.has_parameters_request());
+      }
+      THEN("the changed method returns true") { REQUIRE(changed); }
+    }
+
+    WHEN("a state which is not a dependency is notified as changed") {
+      subscription.changed();
+      store.notify(MessageTypes::parameters);
+      bool changed = subscription.changed();
+
+      THEN("the changed method returns false") { REQUIRE(!changed); }
+    }
+
+    WHEN("a dependency is modified through its mutable reference and notified as changed") {
+      subscription.changed();
+      store.screen_status_request().lock = true;
+      store.notify(MessageTypes::screen_status_request);
+      bool changed = subscription.changed();
+
+      THEN("the changed method returns true") { REQUIRE(changed); }
+    }
+  }
+}
+
+SCENARIO("Store snapshots only change when the store is published") {
+  GIVEN("A store whose parameters have been published with fio2 set to 21") {
+    Store store;
+    store.parameters().fio2 = 21;
+    store.sensor_measurements_raw().flow = 30;
+    store.backend_connected() = true;
+    store.publish();
+
+    WHEN("a snapshot is taken") {
+      StateSnapshot snapshot{};
+      auto status = store.snapshot(snapshot);
+
+      THEN("the snapshot method reports ok status") {
+        REQUIRE(status == Store::Snapshots::Status::ok);
+      }
+      THEN("the snapshot has the published states") {
+        REQUIRE(snapshot.parameters.fio2 == 21);
+        REQUIRE(snapshot.sensor_measurements_raw.flow == 30);
+        REQUIRE(snapshot.backend_connected);
+      }
+      THEN("the snapshot version is 1") { REQUIRE(store.snapshot_version() == 1); }
+    }
+
+    WHEN("fio2 is changed to 60 without publishing the store, and a snapshot is taken") {
+      store.parameters().fio2 = 60;
+      StateSnapshot snapshot{};
+      store.snapshot(snapshot);
+
+      THEN("the snapshot still has the published fio2") {
+        REQUIRE(snapshot.parameters.fio2 == 21);
+      }
+      THEN("the snapshot version is unchanged") { REQUIRE(store.snapshot_version() == 1); }
+    }
+
+    WHEN("fio2 is changed to 60, the store is published, and a snapshot is taken") {
+      store.parameters().fio2 = 60;
+      store.publish();
+      StateSnapshot snapshot{};
+      store.snapshot(snapshot);
+
+      THEN("the snapshot has the new fio2") { REQUIRE(snapshot.parameters.fio2 == 60); }
+      THEN("the snapshot version is 2") { REQUIRE(store.snapshot_version() == 2); }
+    }
+  }
+}
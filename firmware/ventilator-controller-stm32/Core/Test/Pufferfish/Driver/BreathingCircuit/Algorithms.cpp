@@ -0,0 +1,128 @@
+/// Algorithms.cpp
+/// Unit tests to confirm behavior of the breathing circuit control algorithms.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/BreathingCircuit/Algorithms.h"
+
+#include <cmath>
+
+#include "Pufferfish/Util/FixedPoint.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Driver::BreathingCircuit::PI;
+using PF::Util::Q15;
+using PF::Util::Q31;
+
+namespace {
+
+// Runs the controller in a loop with a first-order plant, and returns the final actuation
+template <typename Number>
+float run_closed_loop(PI<Number> &controller, float setpoint, size_t steps) {
+  static const float plant_responsiveness = 0.1;
+  float measurement = 0;
+  Number actuation{};
+  for (size_t i = 0; i < steps; ++i) {
+    controller.transform(Number(measurement), Number(setpoint), actuation);
+    measurement += plant_responsiveness * (static_cast<float>(actuation) - measurement);
+  }
+  return static_cast<float>(actuation);
+}
+
+}  // namespace
+
+SCENARIO("The PI controller integrates its error and clamps its actuation", "[pi]") {
+  GIVEN("A float PI controller with a proportional gain of 0.5 and an integral gain of 0.25") {
+    PI<float> controller{0.5, 0.25};
+
+    WHEN("The measurement is 0.2 below the setpoint for two steps") {
+      float first = 0;
+      float second = 0;
+      controller.transform(0, 0.2, first);
+      controller.transform(0, 0.2, second);
+
+      THEN("The actuation is the sum of the proportional and integral terms") {
+        REQUIRE(first == Approx(0.15));
+        REQUIRE(second == Approx(0.2));
+      }
+    }
+
+    WHEN("The error saturates the actuation for many steps and then reverses") {
+      float actuation = 0;
+      for (size_t i = 0; i < 100; ++i) {
+        controller.transform(0, 1, actuation);
+      }
+      float saturated = actuation;
+      controller.transform(0.2, 0, actuation);
+
+      THEN("The actuation is clamped to 1") { REQUIRE(saturated == 1); }
+
+      THEN("The integral term doesn't wind up past the clamp") {
+        REQUIRE(actuation == Approx(1 - 0.05 - 0.1));
+      }
+    }
+
+    WHEN("The measurement is above the setpoint") {
+      float actuation = 1;
+      controller.transform(1, 0, actuation);
+
+      THEN("The actuation is clamped to 0") { REQUIRE(actuation == 0); }
+    }
+  }
+
+  GIVEN("A Q15 PI controller with a proportional gain of 0.5 and an integral gain of 0.25") {
+    PI<Q15> controller{0.5, 0.25};
+
+    WHEN("The measurement is 0.2 below the setpoint for two steps") {
+      Q15 first{};
+      Q15 second{};
+      controller.transform(Q15(0), Q15(0.2F), first);
+      controller.transform(Q15(0), Q15(0.2F), second);
+
+      THEN("The actuations are bit-exact with the truncating integer arithmetic") {
+        REQUIRE(first.raw() == 3277 + 1638);
+        REQUIRE(second.raw() == 3277 + 3276);
+      }
+    }
+
+    WHEN("The error saturates the actuation") {
+      Q15 actuation{};
+      for (size_t i = 0; i < 100; ++i) {
+        controller.transform(Q15(0), Q15(1), actuation);
+      }
+
+      THEN("The actuation is clamped just below 1") { REQUIRE(actuation == Q15::max()); }
+    }
+  }
+
+  GIVEN("Float and Q31 PI controllers with the default gains, scaled for a full scale of 1") {
+    PI<float> float_controller;
+    PI<Q31> q31_controller;
+
+    WHEN("They control a first-order plant towards the same setpoint") {
+      float float_actuation = run_closed_loop(float_controller, 0.5, 2000);
+      float q31_actuation = run_closed_loop(q31_controller, 0.5, 2000);
+
+      THEN("Their actuations agree to within the precision of float") {
+        REQUIRE(q31_actuation == Approx(float_actuation).margin(1e-5));
+      }
+    }
+  }
+}
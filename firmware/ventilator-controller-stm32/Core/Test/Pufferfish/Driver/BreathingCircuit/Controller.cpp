@@ -0,0 +1,217 @@
+/// Controller.cpp
+/// Unit tests to confirm behavior of the breathing circuit flow controllers, in closed loop with a
+/// model of the valves.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/BreathingCircuit/Controller.h"
+
+#include <cmath>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Driver::BreathingCircuit::ActuatorSetpoints;
+using PF::Driver::BreathingCircuit::ActuatorVars;
+using PF::Driver::BreathingCircuit::GainSchedule;
+using PF::Driver::BreathingCircuit::LookupTable;
+using PF::Driver::BreathingCircuit::Parameters;
+using PF::Driver::BreathingCircuit::SensorVars;
+using PF::Driver::BreathingCircuit::SetpointRamp;
+
+namespace {
+
+constexpr uint32_t control_interval = 2;  // ms
+
+// A model of one proportional valve with a first-order flow response. Its steady-state flow
+// differs from the controllers' nominal valve characteristic: it has a wider deadband and delivers
+// less flow at every opening, as a valve at a lower inlet pressure would.
+class ValvePlant {
+ public:
+  void step(float opening) {
+    static const float time_constant = 20;  // ms
+    flow_ += (static_cast<float>(control_interval) / time_constant) *
+             (steady_state_.interpolate(opening) - flow_);
+  }
+
+  [[nodiscard]] float flow() const { return flow_; }
+
+ private:
+  LookupTable<7> steady_state_{{{
+      {0, 0},      // opening, L/min
+      {0.22, 0},   // opening, L/min
+      {0.3, 4},    // opening, L/min
+      {0.37, 9},   // opening, L/min
+      {0.49, 18},  // opening, L/min
+      {0.67, 36},  // opening, L/min
+      {1, 75}      // opening, L/min
+  }}};
+  float flow_ = 0;
+};
+
+struct StepResponse {
+  float settling_time;  // ms, until the flow stays within 2 L/min of the setpoint
+  float overshoot;      // L/min
+  float final_error;    // L/min
+};
+
+// Steps the flow setpoint from 0 and runs the controller against the air valve model
+StepResponse run_step(
+    PF::Driver::BreathingCircuit::Controller &controller, float flow, uint32_t duration) {
+  static const float settling_band = 2;  // L/min
+
+  Parameters parameters{};
+  parameters.mode = PF::Application::VentilationMode_hfnc;
+  parameters.ventilating = true;
+  parameters.fio2 = 21;
+  parameters.flow = flow;
+  SensorVars sensor_vars{};
+  PF::Application::SensorMeasurements sensor_measurements{};
+  ActuatorSetpoints actuator_setpoints{};
+  ActuatorVars actuator_vars{};
+  ValvePlant plant;
+
+  StepResponse response{0, 0, 0};
+  for (uint32_t time = 0; time < duration; time += control_interval) {
+    sensor_vars.flow_air = plant.flow();
+    controller.transform(
+        time,
+        parameters,
+        sensor_vars,
+        sensor_measurements,
+        actuator_setpoints,
+        actuator_vars);
+    plant.step(actuator_vars.valve_air_opening);
+
+    float error = plant.flow() - flow;
+    if (std::abs(error) > settling_band) {
+      response.settling_time = static_cast<float>(time + control_interval);
+    }
+    if (error > response.overshoot) {
+      response.overshoot = error;
+    }
+    response.final_error = error;
+  }
+  return response;
+}
+
+}  // namespace
+
+SCENARIO("The lookup table interpolates linearly between its points", "[flow_control]") {
+  GIVEN("A lookup table with three points") {
+    LookupTable<3> table{{{{0, 0}, {10, 1}, {20, 5}}}};
+
+    WHEN("It's evaluated between its points") {
+      THEN("It interpolates linearly within each segment") {
+        REQUIRE(table.interpolate(5) == Approx(0.5));
+        REQUIRE(table.interpolate(10) == Approx(1));
+        REQUIRE(table.interpolate(15) == Approx(3));
+      }
+    }
+
+    WHEN("It's evaluated outside of its points") {
+      THEN("It's clamped to the values of the first and last points") {
+        REQUIRE(table.interpolate(-5) == 0);
+        REQUIRE(table.interpolate(25) == 5);
+      }
+    }
+  }
+}
+
+SCENARIO("The gain schedule selects gains by the range of the setpoint", "[flow_control]") {
+  GIVEN("A gain schedule with ranges starting at 5 and 20") {
+    GainSchedule<2> schedule{{{{5, {1, 2}}, {20, {3, 4}}}}};
+
+    WHEN("It's evaluated within and below the ranges") {
+      THEN("Each setpoint gets the gains of the range it's in, or of the first range") {
+        REQUIRE(schedule.gains(0).p == 1);
+        REQUIRE(schedule.gains(10).p == 1);
+        REQUIRE(schedule.gains(20).i == 4);
+        REQUIRE(schedule.gains(50).p == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("The setpoint ramp limits the rate of change of its setpoint", "[flow_control]") {
+  GIVEN("A setpoint ramp with a rate of 0.5 per ms") {
+    SetpointRamp ramp{0.5};
+    float setpoint = 0;
+    ramp.transform(100, 10, setpoint);
+
+    WHEN("The target steps up from 0") {
+      THEN("The setpoint stays put on the first call, then rises by the rate per ms elapsed") {
+        REQUIRE(setpoint == 0);
+        ramp.transform(104, 10, setpoint);
+        REQUIRE(setpoint == Approx(2));
+        ramp.transform(120, 10, setpoint);
+        REQUIRE(setpoint == Approx(10));
+      }
+    }
+
+    WHEN("The ramp is reset to a value") {
+      ramp.reset(8);
+      ramp.transform(200, 0, setpoint);
+
+      THEN("The setpoint restarts from that value") {
+        REQUIRE(setpoint == Approx(8));
+        ramp.transform(204, 0, setpoint);
+        REQUIRE(setpoint == Approx(6));
+      }
+    }
+  }
+}
+
+SCENARIO(
+    "The feed-forward controller tracks flow steps faster than the PI controller",
+    "[flow_control]") {
+  GIVEN("The PI and feed-forward HFNC controllers, driving a valve unlike their nominal valve") {
+    PF::Driver::BreathingCircuit::HFNCController pi_controller;
+    PF::Driver::BreathingCircuit::HFNCFeedforwardController feedforward_controller;
+
+    WHEN("The flow setpoint steps from 0 to 40 L/min") {
+      static const uint32_t duration = 5000;  // ms
+      StepResponse pi = run_step(pi_controller, 40, duration);
+      StepResponse feedforward = run_step(feedforward_controller, 40, duration);
+
+      THEN("The feed-forward controller settles in less than half of the time") {
+        REQUIRE(feedforward.settling_time < 200);
+        REQUIRE(feedforward.settling_time < pi.settling_time / 2);
+      }
+
+      THEN("The feed-forward controller overshoots by less than the settling band") {
+        REQUIRE(feedforward.overshoot < 2);
+      }
+
+      THEN("The feed-forward controller has no steady-state error") {
+        REQUIRE(std::abs(feedforward.final_error) < 0.1);
+      }
+    }
+
+    WHEN("The flow setpoint steps from 0 to 5 L/min") {
+      static const uint32_t duration = 5000;  // ms
+      StepResponse feedforward = run_step(feedforward_controller, 5, duration);
+
+      THEN("The feed-forward controller settles in the low-flow range too") {
+        REQUIRE(feedforward.settling_time < 200);
+        REQUIRE(std::abs(feedforward.final_error) < 0.1);
+      }
+    }
+  }
+}
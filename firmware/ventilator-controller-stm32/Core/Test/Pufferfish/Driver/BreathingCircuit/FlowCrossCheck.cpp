@@ -0,0 +1,177 @@
+/// FlowCrossCheck.cpp
+/// Unit tests to confirm behavior of the cross-check of the air flow against a redundant flow
+/// estimate.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/BreathingCircuit/FlowCrossCheck.h"
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Driver::BreathingCircuit::FlowCrossCheck;
+
+namespace {
+
+constexpr float tolerance = 2;             // L/min
+constexpr float relative_tolerance = 0.1;  // of the reference flow
+
+// Compares the flows at every sampling interval from start_time until before end_time, and
+// returns the status of the last comparison
+FlowCrossCheck::Status compare(
+    FlowCrossCheck &check,
+    uint32_t start_time,
+    uint32_t end_time,
+    float reference_flow,
+    float check_flow) {
+  FlowCrossCheck::Status status = FlowCrossCheck::Status::ok;
+  for (uint32_t time = start_time; time < end_time; time += FlowCrossCheck::sampling_interval) {
+    status = check.transform(time, reference_flow, check_flow);
+  }
+  return status;
+}
+
+}  // namespace
+
+SCENARIO("The flow cross-check tolerates small differences between the flows") {
+  GIVEN("A flow cross-check with a tolerance of 2 L/min plus 10% of the reference flow") {
+    FlowCrossCheck check{tolerance, relative_tolerance};
+
+    WHEN("The check flow is 1.5 L/min above a reference flow of 10 L/min for 2 s") {
+      auto status = compare(check, 0, 2000, 10, 11.5);
+
+      THEN("The flows agree, with a discrepancy of 1.5 L/min") {
+        REQUIRE(status == FlowCrossCheck::Status::ok);
+        REQUIRE(check.discrepancy() == Approx(1.5));
+        REQUIRE(check.disagreements() == 0);
+      }
+    }
+
+    WHEN("The check flow is 7 L/min below a reference flow of 60 L/min for 2 s") {
+      auto status = compare(check, 0, 2000, 60, 53);
+
+      THEN("The flows agree, since the difference is within the relative tolerance") {
+        REQUIRE(status == FlowCrossCheck::Status::ok);
+        REQUIRE(check.discrepancy() == Approx(-7));
+        REQUIRE(check.disagreements() == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("The flow cross-check debounces and counts disagreements") {
+  GIVEN("A flow cross-check with a tolerance of 2 L/min plus 10% of the reference flow") {
+    FlowCrossCheck check{tolerance, relative_tolerance};
+
+    WHEN("The check flow is 5 L/min above a reference flow of 10 L/min") {
+      auto before_debouncing = compare(check, 0, 490, 10, 15);
+      auto debounced = compare(check, 490, 500, 10, 15);
+      auto persisting = compare(check, 500, 2000, 10, 15);
+
+      THEN("The flows disagree after 50 samples, and the disagreement is counted once") {
+        REQUIRE(before_debouncing == FlowCrossCheck::Status::ok);
+        REQUIRE(debounced == FlowCrossCheck::Status::disagreement);
+        REQUIRE(persisting == FlowCrossCheck::Status::disagreement);
+        REQUIRE(check.discrepancy() == Approx(5));
+        REQUIRE(check.disagreements() == 1);
+      }
+
+      THEN("The flows agree again after they have agreed for a while") {
+        REQUIRE(compare(check, 2000, 2100, 10, 10) == FlowCrossCheck::Status::disagreement);
+        REQUIRE(compare(check, 2100, 4000, 10, 10) == FlowCrossCheck::Status::ok);
+        REQUIRE(check.discrepancy() == Approx(0).margin(0.01));
+        REQUIRE(check.disagreements() == 1);
+      }
+
+      THEN("A new disagreement after the flows agreed again is counted") {
+        compare(check, 2000, 4000, 10, 10);
+        REQUIRE(compare(check, 4000, 6000, 10, 5) == FlowCrossCheck::Status::disagreement);
+        REQUIRE(check.disagreements() == 2);
+      }
+    }
+
+    WHEN("The flows briefly disagree between longer periods of agreement") {
+      compare(check, 0, 1000, 10, 10);
+      auto spike = compare(check, 1000, 1100, 10, 30);
+      auto after_spike = compare(check, 1100, 3000, 10, 10);
+
+      THEN("No disagreement is reported") {
+        REQUIRE(spike == FlowCrossCheck::Status::ok);
+        REQUIRE(after_spike == FlowCrossCheck::Status::ok);
+        REQUIRE(check.disagreements() == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("The flow cross-check only samples the flows at its sampling interval") {
+  GIVEN("A flow cross-check which has compared agreeing flows at 0 ms") {
+    FlowCrossCheck check{tolerance, relative_tolerance};
+    check.transform(0, 10, 10);
+
+    WHEN("Very different flows are input before the sampling interval has passed") {
+      check.transform(FlowCrossCheck::sampling_interval - 1, 10, 100);
+
+      THEN("They're ignored") {
+        REQUIRE(check.discrepancy() == 0);
+      }
+    }
+
+    WHEN("Very different flows are input once the sampling interval has passed") {
+      check.transform(FlowCrossCheck::sampling_interval, 10, 100);
+
+      THEN("They're compared") {
+        REQUIRE(check.discrepancy() == Approx(9));
+      }
+    }
+  }
+}
+
+SCENARIO("The flow cross-check can be reset while either sensor is disconnected") {
+  GIVEN("A flow cross-check whose flows disagree") {
+    FlowCrossCheck check{tolerance, relative_tolerance};
+    REQUIRE(compare(check, 0, 1000, 10, 20) == FlowCrossCheck::Status::disagreement);
+
+    WHEN("It's reset") {
+      check.reset();
+
+      THEN("The discrepancy is forgotten, but the count of disagreements is kept") {
+        REQUIRE(check.discrepancy() == 0);
+        REQUIRE(check.disagreements() == 1);
+      }
+
+      THEN("The next comparison starts from the new flows without debouncing history") {
+        REQUIRE(check.transform(1005, 10, 20) == FlowCrossCheck::Status::ok);
+        REQUIRE(check.discrepancy() == Approx(10));
+        REQUIRE(compare(check, 1015, 1500, 10, 20) == FlowCrossCheck::Status::disagreement);
+        REQUIRE(check.disagreements() == 2);
+      }
+    }
+
+    WHEN("It outputs to MCU diagnostics") {
+      PF::Application::MCUDiagnostics diagnostics{};
+      check.output(diagnostics);
+
+      THEN("The discrepancy and the count of disagreements are reported") {
+        REQUIRE(diagnostics.air_flow_discrepancy == Approx(10));
+        REQUIRE(diagnostics.air_flow_disagreements == 1);
+      }
+    }
+  }
+}
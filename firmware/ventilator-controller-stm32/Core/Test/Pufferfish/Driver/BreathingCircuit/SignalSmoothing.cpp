@@ -0,0 +1,156 @@
+/// SignalSmoothing.cpp
+/// Unit tests to confirm behavior of the breathing circuit's sensor prefilter.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/BreathingCircuit/SignalSmoothing.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Driver::BreathingCircuit::SensorPrefilter;
+
+namespace {
+
+constexpr float sample_rate = 500;  // Hz, as in the HFNC control loop
+
+}  // namespace
+
+SCENARIO("The sensor prefilter starts from the first valid sample", "[prefilter]") {
+  GIVEN("A sensor prefilter at 500 Hz which hasn't received any samples") {
+    SensorPrefilter prefilter{sample_rate};
+
+    WHEN("A valid sample of 30 is filtered") {
+      float value = 30;
+      prefilter.transform(true, value);
+
+      THEN("The value is unchanged, without a transient from a zero history") {
+        REQUIRE(value == Approx(30));
+      }
+    }
+
+    WHEN("A constant valid signal of 30 is filtered for 100 samples") {
+      float value = 0;
+      for (size_t i = 0; i < 100; ++i) {
+        value = 30;
+        prefilter.transform(true, value);
+        REQUIRE(value == Approx(30));
+      }
+
+      THEN("The value stays at 30") { REQUIRE(value == Approx(30)); }
+    }
+
+    WHEN("An invalid sample is filtered") {
+      float value = 12;
+      prefilter.transform(false, value);
+
+      THEN("The value is left unchanged") { REQUIRE(value == 12); }
+    }
+  }
+}
+
+SCENARIO("The sensor prefilter low-pass filters its signal", "[prefilter]") {
+  GIVEN("A sensor prefilter at 500 Hz which has settled at 0") {
+    SensorPrefilter prefilter{sample_rate};
+    float value = 0;
+    prefilter.transform(true, value);
+
+    WHEN("The signal steps up to 10") {
+      value = 10;
+      prefilter.transform(true, value);
+      float first = value;
+      for (size_t i = 0; i < 50; ++i) {
+        value = 10;
+        prefilter.transform(true, value);
+      }
+
+      THEN("The first filtered sample is between the old and new values") {
+        REQUIRE(first > 0);
+        REQUIRE(first < 10);
+      }
+      THEN("The filtered signal settles at the new value within 100 ms") {
+        REQUIRE(value == Approx(10).margin(0.01));
+      }
+    }
+
+    WHEN("A square wave at the Nyquist frequency with an amplitude of 1 is filtered") {
+      float max_magnitude = 0;
+      for (size_t i = 0; i < 200; ++i) {
+        value = (i % 2 == 0) ? 1 : -1;
+        prefilter.transform(true, value);
+        if (i >= 100) {
+          max_magnitude = std::max(max_magnitude, std::fabs(value));
+        }
+      }
+
+      THEN("Its amplitude is attenuated to below 0.01 once the filter has settled") {
+        REQUIRE(max_magnitude < 0.01);
+      }
+    }
+
+    WHEN("A 10 Hz sine wave with an amplitude of 1, below the cutoff, is filtered") {
+      float max_magnitude = 0;
+      for (size_t i = 0; i < 500; ++i) {
+        static const float pi = 3.14159265F;
+        value = std::sin(2 * pi * 10 * static_cast<float>(i) / sample_rate);
+        prefilter.transform(true, value);
+        if (i >= 250) {
+          max_magnitude = std::max(max_magnitude, std::fabs(value));
+        }
+      }
+
+      THEN("Its amplitude is mostly preserved") {
+        REQUIRE(max_magnitude > 0.95);
+        REQUIRE(max_magnitude < 1.05);
+      }
+    }
+  }
+
+  GIVEN("A sensor prefilter at 500 Hz which has settled at 10") {
+    SensorPrefilter prefilter{sample_rate};
+    float value = 0;
+    for (size_t i = 0; i < 100; ++i) {
+      value = 10;
+      prefilter.transform(true, value);
+    }
+
+    WHEN("The signal drops out for a sample, and then resumes at 40") {
+      value = 0;
+      prefilter.transform(false, value);
+      float dropped = value;
+      value = 40;
+      prefilter.transform(true, value);
+
+      THEN("The invalid sample is left unchanged") { REQUIRE(dropped == 0); }
+      THEN("The filter restarts at the resumed value, without a transient from its old history") {
+        REQUIRE(value == Approx(40));
+      }
+    }
+
+    WHEN("The signal steps up to 40 without dropping out") {
+      value = 40;
+      prefilter.transform(true, value);
+
+      THEN("The filtered sample is smoothed from the old history") { REQUIRE(value < 40); }
+    }
+  }
+}
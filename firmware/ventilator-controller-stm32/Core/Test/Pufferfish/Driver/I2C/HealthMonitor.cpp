@@ -0,0 +1,201 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * HealthMonitor.cpp
+ *
+ * Unit tests to confirm behavior of the I2C health monitor
+ *
+ */
+#include "Pufferfish/Driver/I2C/HealthMonitor.h"
+
+#include <array>
+
+#include "Pufferfish/Driver/I2C/SensirionDevice.h"
+#include "Pufferfish/HAL/CRCChecker.h"
+#include "Pufferfish/HAL/Mock/I2CBus.h"
+#include "Pufferfish/HAL/Mock/I2CDevice.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "Pufferfish/Util/Containers/Array.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::I2CDeviceStatus;
+using PF::Driver::I2C::MonitoredDevice;
+
+namespace {
+
+// A mock device whose transactions take a given time
+class SlowDevice : public PF::HAL::Mock::I2CDevice {
+ public:
+  explicit SlowDevice(PF::HAL::Mock::Time &time) : time_(time) {}
+
+  I2CDeviceStatus read(uint8_t *buf, size_t count) override {
+    time_.set_micros(time_.micros() + latency);
+    return PF::HAL::Mock::I2CDevice::read(buf, count);
+  }
+
+  I2CDeviceStatus write(uint8_t *buf, size_t count) override {
+    time_.set_micros(time_.micros() + latency);
+    return PF::HAL::Mock::I2CDevice::write(buf, count);
+  }
+
+  uint32_t latency = 0;  // us
+
+ private:
+  PF::HAL::Mock::Time &time_;
+};
+
+void write_with_status(
+    SlowDevice &dev, MonitoredDevice &monitored, I2CDeviceStatus status, size_t times = 1) {
+  std::array<uint8_t, 1> command{{0x00}};
+  for (size_t i = 0; i < times; ++i) {
+    dev.add_write_status(status);
+    REQUIRE(monitored.write(command.data(), command.size()) == status);
+  }
+}
+
+}  // namespace
+
+SCENARIO("MonitoredDevice records the errors and latencies of transactions") {
+  GIVEN("A monitored device") {
+    PF::HAL::Mock::Time time;
+    PF::HAL::Mock::I2CBus bus;
+    SlowDevice dev(time);
+    MonitoredDevice monitored(dev, bus, time);
+
+    WHEN("Writes fail with different errors") {
+      write_with_status(dev, monitored, I2CDeviceStatus::ok, 2);
+      write_with_status(dev, monitored, I2CDeviceStatus::nack, 3);
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout);
+      write_with_status(dev, monitored, I2CDeviceStatus::busy);
+      write_with_status(dev, monitored, I2CDeviceStatus::write_error);
+
+      THEN("Each kind of error is counted separately") {
+        const auto &health = monitored.health();
+        REQUIRE(health.transactions == 8);
+        REQUIRE(health.nacks == 3);
+        REQUIRE(health.timeouts == 1);
+        REQUIRE(health.busy == 1);
+        REQUIRE(health.crc_failures == 0);
+        REQUIRE(health.other_errors == 1);
+      }
+    }
+
+    WHEN("Reads take different times") {
+      std::array<uint8_t, 2> buf{};
+      for (uint32_t latency : {0U, 249U, 250U, 999U, 3999U, 4000U, 100000U}) {
+        dev.latency = latency;
+        dev.add_read(buf.data(), buf.size(), I2CDeviceStatus::ok);
+        monitored.read(buf.data(), buf.size());
+      }
+
+      THEN("Their latencies are counted in bins whose bounds double from 250 us") {
+        const auto &health = monitored.health();
+        REQUIRE(health.latencies_count == MonitoredDevice::num_latency_bins);
+        REQUIRE(health.latencies[0] == 2);
+        REQUIRE(health.latencies[1] == 1);
+        REQUIRE(health.latencies[2] == 1);
+        REQUIRE(health.latencies[3] == 0);
+        REQUIRE(health.latencies[4] == 1);
+        REQUIRE(health.latencies[5] == 2);
+      }
+    }
+  }
+
+  GIVEN("A Sensirion device behind a monitored device") {
+    PF::HAL::Mock::Time time;
+    PF::HAL::Mock::I2CBus bus;
+    SlowDevice dev(time);
+    MonitoredDevice monitored(dev, bus, time);
+    PF::HAL::SoftCRC8 crc8(PF::HAL::CRC8Parameters{0x31, 0xff, false, false, 0x00});
+    PF::Driver::I2C::SensirionDevice sensirion(monitored, crc8);
+
+    WHEN("A word is read with an incorrect CRC") {
+      auto data = PF::Util::Containers::make_array<uint8_t>(0xa0, 0x00, 0x00);
+      dev.add_read(data.data(), data.size(), I2CDeviceStatus::ok);
+      std::array<uint8_t, 2> buf{};
+      auto status = sensirion.read(buf);
+
+      THEN("The CRC failure is counted") {
+        REQUIRE(status == I2CDeviceStatus::crc_check_failed);
+        REQUIRE(monitored.health().transactions == 1);
+        REQUIRE(monitored.health().crc_failures == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("MonitoredDevice recovers its bus after repeated timeouts") {
+  GIVEN("A monitored device which recovers its bus after 3 timeouts in a row") {
+    PF::HAL::Mock::Time time;
+    PF::HAL::Mock::I2CBus bus;
+    SlowDevice dev(time);
+    MonitoredDevice monitored(dev, bus, time, 3);
+
+    WHEN("Transactions time out or find the bus busy 3 times in a row") {
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout);
+      write_with_status(dev, monitored, I2CDeviceStatus::busy);
+      size_t recoveries_before = bus.recoveries();
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout);
+
+      THEN("The bus is recovered once, after the third") {
+        REQUIRE(recoveries_before == 0);
+        REQUIRE(bus.recoveries() == 1);
+        REQUIRE(monitored.health().recoveries == 1);
+        REQUIRE(monitored.health().failed_recoveries == 0);
+      }
+    }
+
+    WHEN("The bus stays stuck after it's recovered") {
+      bus.add_recover_status(I2CDeviceStatus::busy);
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout, 3);
+
+      THEN("The recovery is counted as failed") {
+        REQUIRE(bus.recoveries() == 1);
+        REQUIRE(monitored.health().recoveries == 0);
+        REQUIRE(monitored.health().failed_recoveries == 1);
+      }
+    }
+
+    WHEN("Timeouts are interrupted by successful transactions") {
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout, 2);
+      write_with_status(dev, monitored, I2CDeviceStatus::ok);
+      write_with_status(dev, monitored, I2CDeviceStatus::timeout, 2);
+
+      THEN("The bus isn't recovered") { REQUIRE(bus.recoveries() == 0); }
+    }
+
+    WHEN("The device keeps not acknowledging") {
+      write_with_status(dev, monitored, I2CDeviceStatus::nack, 10);
+
+      THEN("The bus isn't recovered") { REQUIRE(bus.recoveries() == 0); }
+    }
+  }
+}
+
+SCENARIO("HealthMonitors collects the health of devices into diagnostics") {
+  GIVEN("Two monitored devices with different errors") {
+    PF::HAL::Mock::Time time;
+    PF::HAL::Mock::I2CBus bus;
+    SlowDevice first_dev(time);
+    SlowDevice second_dev(time);
+    MonitoredDevice first(first_dev, bus, time);
+    MonitoredDevice second(second_dev, bus, time);
+    write_with_status(first_dev, first, I2CDeviceStatus::nack);
+    write_with_status(second_dev, second, I2CDeviceStatus::timeout, 2);
+    auto monitors = PF::Driver::I2C::make_health_monitors(first, second);
+
+    WHEN("The diagnostics are output") {
+      PF::Application::I2CDiagnostics diagnostics{};
+      monitors.output(diagnostics);
+
+      THEN("They contain the health of each device, in order") {
+        REQUIRE(diagnostics.devices_count == 2);
+        REQUIRE(diagnostics.devices[0] == first.health());
+        REQUIRE(diagnostics.devices[0].nacks == 1);
+        REQUIRE(diagnostics.devices[1] == second.health());
+        REQUIRE(diagnostics.devices[1].timeouts == 2);
+      }
+    }
+  }
+}
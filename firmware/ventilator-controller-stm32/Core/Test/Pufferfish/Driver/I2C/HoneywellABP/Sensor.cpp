@@ -0,0 +1,200 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Sensor.cpp
+ *
+ * Unit tests to confirm behavior of HoneywellABP Sensor
+ *
+ */
+#include "Pufferfish/Driver/I2C/HoneywellABP/Sensor.h"
+
+#include <array>
+
+#include "Pufferfish/HAL/Mock/I2CDevice.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "Pufferfish/Util/Containers/Array.h"
+#include "catch2/catch.hpp"
+namespace PF = Pufferfish;
+namespace HoneywellABP = PF::Driver::I2C::HoneywellABP;
+using Action = HoneywellABP::Sensor::Action;
+using PF::Util::Containers::make_array;
+
+namespace {
+
+// 0x2000 is halfway between the minimum and maximum outputs, so it's 0.5 psi
+void add_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x20, 0x00);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+// The same sample, but with the stale data status bits set
+void add_stale_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0xa0, 0x00);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+void add_failed_read(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x20, 0x00);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::read_error);
+}
+
+// Calls setup at the time, and returns its result
+PF::InitializableState setup_at(
+    HoneywellABP::Sensor &sensor, PF::HAL::Mock::Time &time, uint32_t ms) {
+  time.set_millis(ms);
+  return sensor.setup();
+}
+
+}  // namespace
+
+SCENARIO("HoneywellABP Sensor checks its first sample after power-up") {
+  GIVEN("A sensor whose device responds with a valid sample") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    HoneywellABP::Device device{mock_device, HoneywellABP::abpxxxx001pg2a3};
+    PF::HAL::Mock::Time time;
+    HoneywellABP::Sensor sensor{device, time};
+    add_sample(mock_device);
+
+    WHEN("setup is called before and after the power-up delay") {
+      auto before_power_up = setup_at(sensor, time, 0);
+      auto still_powering_up = setup_at(sensor, time, 2);
+      auto powered_up = setup_at(sensor, time, 3);
+
+      THEN("Setup only finishes once the sample is read after power-up") {
+        REQUIRE(before_power_up == PF::InitializableState::setup);
+        REQUIRE(still_powering_up == PF::InitializableState::setup);
+        REQUIRE(powered_up == PF::InitializableState::ok);
+        REQUIRE(sensor.get_state() == Action::measure);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 0);
+        REQUIRE(sensor.statistics(Action::check_range).total_time == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("HoneywellABP Sensor retries setup when its samples are invalid") {
+  GIVEN("A sensor whose device first responds with stale data, and then a failed read") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    HoneywellABP::Device device{mock_device, HoneywellABP::abpxxxx001pg2a3};
+    PF::HAL::Mock::Time time;
+    HoneywellABP::Sensor sensor{device, time};
+    add_stale_sample(mock_device);
+    add_failed_read(mock_device);
+    add_sample(mock_device);
+    setup_at(sensor, time, 0);
+
+    WHEN("setup is called as each backoff passes") {
+      auto first = setup_at(sensor, time, 3);
+      auto before_second = setup_at(sensor, time, 5);
+      auto second = setup_at(sensor, time, 6);
+      auto before_third = setup_at(sensor, time, 8);
+      auto third = setup_at(sensor, time, 9);
+
+      THEN("The range check is retried after at least the power-up delay, until it succeeds") {
+        REQUIRE(first == PF::InitializableState::setup);
+        REQUIRE(before_second == PF::InitializableState::setup);
+        REQUIRE(second == PF::InitializableState::setup);
+        REQUIRE(before_third == PF::InitializableState::setup);
+        REQUIRE(third == PF::InitializableState::ok);
+        REQUIRE(sensor.statistics(Action::check_range).entries == 3);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 2);
+      }
+    }
+  }
+
+  GIVEN("A sensor whose device never responds") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    HoneywellABP::Device device{mock_device, HoneywellABP::abpxxxx001pg2a3};
+    PF::HAL::Mock::Time time;
+    HoneywellABP::Sensor sensor{device, time};
+
+    WHEN("setup is called every 10 ms until it stops making progress") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      uint32_t ms = 0;
+      for (; ms < 1000 && status == PF::InitializableState::setup; ms += 10) {
+        status = setup_at(sensor, time, ms);
+      }
+
+      THEN("Setup fails after more than 8 faults, and stays failed") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 9);
+        REQUIRE(setup_at(sensor, time, ms) == PF::InitializableState::failed);
+        float pressure = -1;
+        REQUIRE(sensor.output(pressure) == PF::InitializableState::failed);
+        REQUIRE(pressure == -1);
+      }
+    }
+  }
+}
+
+SCENARIO("HoneywellABP Sensor measures the pressure at its measuring interval") {
+  GIVEN("A sensor which has been set up") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    HoneywellABP::Device device{mock_device, HoneywellABP::abpxxxx001pg2a3};
+    PF::HAL::Mock::Time time;
+    HoneywellABP::Sensor sensor{device, time};
+    add_sample(mock_device);
+    setup_at(sensor, time, 0);
+    REQUIRE(setup_at(sensor, time, 3) == PF::InitializableState::ok);
+    float pressure = -1;
+
+    WHEN("output is called before and after the measuring interval") {
+      add_sample(mock_device);
+      time.set_millis(3);
+      auto before_interval = sensor.output(pressure);
+      float pressure_before = pressure;
+      time.set_millis(4);
+      auto after_interval = sensor.output(pressure);
+
+      THEN("The pressure is only read once the interval has passed") {
+        REQUIRE(before_interval == PF::InitializableState::ok);
+        REQUIRE(pressure_before == -1);
+        REQUIRE(after_interval == PF::InitializableState::ok);
+        REQUIRE(pressure == Approx(0.5).epsilon(0.001));
+      }
+    }
+
+    WHEN("A stale sample and a failed read are followed by a valid sample") {
+      add_stale_sample(mock_device);
+      add_failed_read(mock_device);
+      add_sample(mock_device);
+      time.set_millis(4);
+      auto stale = sensor.output(pressure);
+      float pressure_after_stale = pressure;
+      time.set_millis(5);
+      auto failed = sensor.output(pressure);
+      float pressure_after_failed = pressure;
+      time.set_millis(6);
+      auto valid = sensor.output(pressure);
+
+      THEN("The invalid samples are skipped without changing the pressure") {
+        REQUIRE(stale == PF::InitializableState::ok);
+        REQUIRE(pressure_after_stale == -1);
+        REQUIRE(failed == PF::InitializableState::ok);
+        REQUIRE(pressure_after_failed == -1);
+        REQUIRE(valid == PF::InitializableState::ok);
+        REQUIRE(pressure == Approx(0.5).epsilon(0.001));
+        REQUIRE(sensor.statistics(Action::measure).faults == 2);
+      }
+    }
+
+    WHEN("More than 8 samples in a row are stale") {
+      for (size_t i = 0; i < 9; ++i) {
+        add_stale_sample(mock_device);
+      }
+      PF::InitializableState status = PF::InitializableState::ok;
+      for (uint32_t ms = 4; ms < 12; ++ms) {
+        time.set_millis(ms);
+        REQUIRE(sensor.output(pressure) == PF::InitializableState::ok);
+      }
+      time.set_millis(12);
+      status = sensor.output(pressure);
+
+      THEN("Output fails without changing the pressure") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(pressure == -1);
+        REQUIRE(sensor.statistics(Action::measure).faults == 9);
+      }
+    }
+  }
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Sensor.cpp
+ *
+ * Unit tests to confirm behavior of LTC4015 Sensor
+ *
+ */
+#include "Pufferfish/Driver/I2C/LTC4015/Sensor.h"
+
+#include <array>
+#include <vector>
+
+#include "Pufferfish/HAL/Mock/I2CDevice.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "Pufferfish/Util/Containers/Array.h"
+#include "catch2/catch.hpp"
+namespace PF = Pufferfish;
+namespace LTC4015 = PF::Driver::I2C::LTC4015;
+using Action = LTC4015::Sensor::Action;
+using PF::Util::Containers::make_array;
+
+namespace {
+
+// Adds the registers from system_status to iin, with the charger enabled if charging
+void add_telemetry(PF::HAL::Mock::I2CDevice &mock_device, bool charging) {
+  auto registers = make_array<uint16_t>(
+      charging ? 0x2000 : 0x0000, 0x1234, 0x2345, 0x3456, 0x4567, 0x5678);
+  for (uint16_t value : registers) {
+    auto read_buffer = make_array<uint8_t>(value >> 8U, value & 0xffU);
+    mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+  }
+}
+
+// Pops the register addresses which were read from the mock device
+std::vector<uint16_t> get_read_addresses(PF::HAL::Mock::I2CDevice &mock_device) {
+  std::vector<uint16_t> addresses;
+  uint16_t address = 0;
+  while (mock_device.get_read_address(address) == PF::I2CDeviceStatus::ok) {
+    addresses.push_back(address);
+  }
+  return addresses;
+}
+
+}  // namespace
+
+SCENARIO("LTC4015 Device reads all telemetry registers together") {
+  GIVEN("A device which responds with telemetry") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    LTC4015::Device device(mock_device);
+    add_telemetry(mock_device, true);
+
+    WHEN("The telemetry is read") {
+      LTC4015::Telemetry telemetry{};
+      auto status = device.read_telemetry(telemetry);
+
+      THEN("The contiguous registers are read in order") {
+        REQUIRE(status == PF::I2CDeviceStatus::ok);
+        REQUIRE(
+            get_read_addresses(mock_device) ==
+            std::vector<uint16_t>{0x3900, 0x3a00, 0x3b00, 0x3c00, 0x3d00, 0x3e00});
+        REQUIRE(telemetry.charger_enabled());
+        REQUIRE(telemetry.vbat == 0x1234);
+        REQUIRE(telemetry.vin == 0x2345);
+        REQUIRE(telemetry.vsys == 0x3456);
+        REQUIRE(telemetry.ibat == 0x4567);
+        REQUIRE(telemetry.iin == 0x5678);
+      }
+    }
+  }
+
+  GIVEN("A device which stops responding partway through the telemetry") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    LTC4015::Device device(mock_device);
+    auto read_buffer = make_array<uint8_t>(0x20, 0x00);
+    mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+    mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::nack);
+
+    WHEN("The telemetry is read") {
+      LTC4015::Telemetry telemetry{};
+      auto status = device.read_telemetry(telemetry);
+
+      THEN("The error is returned, and the telemetry isn't partially updated") {
+        REQUIRE(status == PF::I2CDeviceStatus::nack);
+        REQUIRE(get_read_addresses(mock_device).size() == 2);
+        REQUIRE(!telemetry.charger_enabled());
+      }
+    }
+  }
+}
+
+SCENARIO("LTC4015 Sensor polls its telemetry once per second") {
+  GIVEN("A sensor which has been set up") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    LTC4015::Device device(mock_device);
+    LTC4015::Sensor sensor(device, time);
+    add_telemetry(mock_device, true);
+    time.set_millis(0);
+    REQUIRE(sensor.setup() == PF::InitializableState::ok);
+    REQUIRE(get_read_addresses(mock_device).size() == 6);
+
+    WHEN("output is called every ms for a second") {
+      PF::Application::MCUPowerStatus power_status{};
+      add_telemetry(mock_device, false);
+      bool ok = true;
+      for (uint32_t ms = 0; ms < 1000; ++ms) {
+        time.set_millis(ms);
+        ok = ok && sensor.output(power_status) == PF::InitializableState::ok;
+      }
+      auto reads_before = get_read_addresses(mock_device).size();
+      bool charging_before = power_status.charging;
+      time.set_millis(1000);
+      auto status = sensor.output(power_status);
+
+      THEN("The device is only read once the interval has passed") {
+        REQUIRE(ok);
+        REQUIRE(reads_before == 0);
+        REQUIRE(charging_before);
+        REQUIRE(status == PF::InitializableState::ok);
+        REQUIRE(get_read_addresses(mock_device).size() == 6);
+        REQUIRE(!power_status.charging);
+        REQUIRE(sensor.statistics(Action::measure).entries == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("LTC4015 Sensor retries faulty telemetry reads") {
+  GIVEN("A sensor whose device doesn't respond at first") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    LTC4015::Device device(mock_device);
+    LTC4015::Sensor sensor(device, time);
+
+    WHEN("setup is called before and after the device starts responding") {
+      time.set_millis(0);
+      auto fault = sensor.setup();
+      add_telemetry(mock_device, true);
+      auto before_retry = sensor.setup();
+      time.set_millis(1);
+      auto retry = sensor.setup();
+
+      THEN("The telemetry is read again after a 1 ms backoff") {
+        REQUIRE(fault == PF::InitializableState::setup);
+        REQUIRE(before_retry == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::ok);
+        REQUIRE(sensor.statistics(Action::initialize).faults == 1);
+        REQUIRE(sensor.statistics(Action::initialize).entries == 2);
+        REQUIRE(sensor.get_state() == Action::measure);
+      }
+    }
+
+    WHEN("setup is called every 10 ms while the device never responds") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      uint32_t ms = 0;
+      for (; ms < 1000 && status == PF::InitializableState::setup; ms += 10) {
+        time.set_millis(ms);
+        status = sensor.setup();
+      }
+
+      THEN("Setup fails after more than 8 faults, and stays failed") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::initialize).faults == 9);
+        time.set_millis(ms);
+        REQUIRE(sensor.setup() == PF::InitializableState::failed);
+        PF::Application::MCUPowerStatus power_status{};
+        REQUIRE(sensor.output(power_status) == PF::InitializableState::failed);
+      }
+    }
+  }
+
+  GIVEN("A sensor which has been set up while the charger is enabled") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    LTC4015::Device device(mock_device);
+    LTC4015::Sensor sensor(device, time);
+    add_telemetry(mock_device, true);
+    time.set_millis(0);
+    REQUIRE(sensor.setup() == PF::InitializableState::ok);
+    PF::Application::MCUPowerStatus power_status{};
+
+    WHEN("A poll fails, and the next poll succeeds") {
+      time.set_millis(1000);
+      auto fault = sensor.output(power_status);
+      add_telemetry(mock_device, false);
+      time.set_millis(1999);
+      auto before_retry = sensor.output(power_status);
+      bool charging_before = power_status.charging;
+      time.set_millis(2000);
+      auto retry = sensor.output(power_status);
+
+      THEN("The previous telemetry is kept until the poll is retried an interval later") {
+        REQUIRE(fault == PF::InitializableState::ok);
+        REQUIRE(before_retry == PF::InitializableState::ok);
+        REQUIRE(charging_before);
+        REQUIRE(retry == PF::InitializableState::ok);
+        REQUIRE(!power_status.charging);
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+      }
+    }
+
+    WHEN("More than 8 polls fail in a row") {
+      PF::InitializableState status = PF::InitializableState::ok;
+      for (uint32_t i = 1; i <= 9; ++i) {
+        time.set_millis(1000 * i);
+        status = sensor.output(power_status);
+        if (i < 9) {
+          REQUIRE(status == PF::InitializableState::ok);
+        }
+      }
+
+      THEN("Output fails") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::measure).faults == 9);
+      }
+    }
+  }
+}
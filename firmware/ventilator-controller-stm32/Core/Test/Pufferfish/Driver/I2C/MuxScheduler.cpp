@@ -0,0 +1,157 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * MuxScheduler.cpp
+ *
+ * Unit tests to confirm behavior of the I2C mux scheduler
+ *
+ */
+#include "Pufferfish/Driver/I2C/MuxScheduler.h"
+
+#include <array>
+#include <vector>
+
+#include "Pufferfish/Driver/I2C/TCA9548A.h"
+#include "Pufferfish/HAL/Mock/I2CDevice.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::I2CDeviceStatus;
+using PF::Driver::I2C::ExtendedI2CDevice;
+using PF::Driver::I2C::TCA9548A;
+
+namespace {
+
+// Pops the slot selects which were written to a mock TCA9548A
+std::vector<uint8_t> get_selects(PF::HAL::Mock::I2CDevice &mux_dev) {
+  std::vector<uint8_t> selects;
+  std::array<uint8_t, 1> buf{};
+  size_t count = 0;
+  while (mux_dev.get_write(buf.data(), count) == I2CDeviceStatus::ok) {
+    selects.push_back(buf[0]);
+  }
+  return selects;
+}
+
+}  // namespace
+
+SCENARIO("MuxScheduler selects each mux slot once per round") {
+  GIVEN("Devices behind two muxes, given out of order of their slots") {
+    PF::HAL::Mock::I2CDevice mux1_dev;
+    PF::HAL::Mock::I2CDevice mux2_dev;
+    TCA9548A mux1(mux1_dev);
+    TCA9548A mux2(mux2_dev);
+    std::array<PF::HAL::Mock::I2CDevice, 5> devs{};
+    ExtendedI2CDevice ext0(devs[0], mux2, 3);
+    ExtendedI2CDevice ext1(devs[1], mux1, 2);
+    ExtendedI2CDevice ext2(devs[2], mux2, 1);
+    ExtendedI2CDevice ext3(devs[3], mux1, 0);
+    ExtendedI2CDevice ext4(devs[4], mux2, 3);
+    auto scheduler = PF::Driver::I2C::make_mux_scheduler(ext0, ext1, ext2, ext3, ext4);
+
+    std::array<ExtendedI2CDevice *, 5> exts{{&ext0, &ext1, &ext2, &ext3, &ext4}};
+    std::vector<size_t> transacted;
+    auto transact = [&](size_t index) {
+      uint8_t command = 0x00;
+      REQUIRE(exts[index]->write(&command, 1) == I2CDeviceStatus::ok);
+      transacted.push_back(index);
+    };
+
+    WHEN("The order of the devices is computed") {
+      THEN("Devices are grouped by mux in order of appearance, then by slot") {
+        REQUIRE(scheduler.order() == std::array<size_t, 5>{{2, 0, 4, 3, 1}});
+      }
+    }
+
+    WHEN("Two rounds are run") {
+      auto first = scheduler.run(transact);
+      auto second = scheduler.run(transact);
+
+      THEN("Every device is transacted with in each round, in the scheduled order") {
+        REQUIRE(first == I2CDeviceStatus::ok);
+        REQUIRE(second == I2CDeviceStatus::ok);
+        REQUIRE(transacted == std::vector<size_t>{2, 0, 4, 3, 1, 2, 0, 4, 3, 1});
+      }
+
+      THEN("Each slot is selected once per round, without any selects from the devices") {
+        REQUIRE(get_selects(mux2_dev) == std::vector<uint8_t>{0x02, 0x08, 0x02, 0x08});
+        REQUIRE(get_selects(mux1_dev) == std::vector<uint8_t>{0x01, 0x04, 0x01, 0x04});
+        REQUIRE(scheduler.statistics().rounds == 2);
+        REQUIRE(scheduler.statistics().selects == 8);
+        REQUIRE(scheduler.statistics().skipped_selects == 0);
+      }
+    }
+  }
+
+  GIVEN("Two devices behind the same slot of a mux") {
+    PF::HAL::Mock::I2CDevice mux_dev;
+    TCA9548A mux(mux_dev);
+    std::array<PF::HAL::Mock::I2CDevice, 2> devs{};
+    ExtendedI2CDevice ext0(devs[0], mux, 5);
+    ExtendedI2CDevice ext1(devs[1], mux, 5);
+    auto scheduler = PF::Driver::I2C::make_mux_scheduler(ext0, ext1);
+
+    WHEN("Three rounds are run") {
+      size_t transactions = 0;
+      for (size_t i = 0; i < 3; ++i) {
+        scheduler.run([&](size_t /*index*/) { ++transactions; });
+      }
+
+      THEN("The slot is only selected in the first round") {
+        REQUIRE(transactions == 6);
+        REQUIRE(get_selects(mux_dev) == std::vector<uint8_t>{0x20});
+        REQUIRE(scheduler.statistics().selects == 1);
+        REQUIRE(scheduler.statistics().skipped_selects == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("MuxScheduler skips the devices behind a slot which can't be selected") {
+  GIVEN("Devices behind two slots of a mux, whose first select fails") {
+    PF::HAL::Mock::I2CDevice mux_dev;
+    TCA9548A mux(mux_dev);
+    std::array<PF::HAL::Mock::I2CDevice, 3> devs{};
+    ExtendedI2CDevice ext0(devs[0], mux, 0);
+    ExtendedI2CDevice ext1(devs[1], mux, 0);
+    ExtendedI2CDevice ext2(devs[2], mux, 1);
+    auto scheduler = PF::Driver::I2C::make_mux_scheduler(ext0, ext1, ext2);
+    mux_dev.add_write_status(I2CDeviceStatus::nack);
+
+    WHEN("Two rounds are run") {
+      std::vector<size_t> transacted;
+      auto first = scheduler.run([&](size_t index) { transacted.push_back(index); });
+      auto transacted_first = transacted;
+      auto second = scheduler.run([&](size_t index) { transacted.push_back(index); });
+
+      THEN("The devices behind the failed slot are skipped, and the slot is selected again") {
+        REQUIRE(first == I2CDeviceStatus::nack);
+        REQUIRE(transacted_first == std::vector<size_t>{2});
+        REQUIRE(second == I2CDeviceStatus::ok);
+        REQUIRE(transacted == std::vector<size_t>{2, 0, 1, 2});
+        REQUIRE(scheduler.statistics().select_errors == 1);
+        REQUIRE(get_selects(mux_dev) == std::vector<uint8_t>{0x01, 0x02, 0x01, 0x02});
+      }
+    }
+  }
+}
+
+SCENARIO("TCA9548A doesn't skip selects after a failed select") {
+  GIVEN("A mux whose select of a slot fails") {
+    PF::HAL::Mock::I2CDevice mux_dev;
+    TCA9548A mux(mux_dev);
+    REQUIRE(mux.select_slot(2) == I2CDeviceStatus::ok);
+    mux_dev.add_write_status(I2CDeviceStatus::timeout);
+    REQUIRE(mux.select_slot(3) == I2CDeviceStatus::timeout);
+
+    WHEN("The previously selected slot is selected again") {
+      auto status = mux.select_slot(2);
+
+      THEN("The select is written to the mux") {
+        REQUIRE(status == I2CDeviceStatus::ok);
+        REQUIRE(get_selects(mux_dev) == std::vector<uint8_t>{0x04, 0x08, 0x04});
+        REQUIRE(mux.get_current_slot() == 2);
+      }
+    }
+  }
+}
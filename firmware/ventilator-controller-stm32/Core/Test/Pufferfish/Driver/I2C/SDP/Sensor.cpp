@@ -0,0 +1,249 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Sensor.cpp
+ *
+ * Unit tests to confirm behavior of SDP Sensor
+ *
+ */
+#include "Pufferfish/Driver/I2C/SDP/Sensor.h"
+
+#include <array>
+#include <cmath>
+
+#include "Pufferfish/HAL/Mock/I2CDevice.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "Pufferfish/Util/Containers/Array.h"
+#include "catch2/catch.hpp"
+namespace PF = Pufferfish;
+namespace SDP = PF::Driver::I2C::SDP;
+using Action = SDP::Sensor::Action;
+using PF::Util::Containers::make_array;
+
+namespace {
+
+const uint16_t stop_command = 0x3FF9;
+const uint16_t start_measure_average_command = 0x3615;
+const float flow_coefficient = 2;  // L/min at 1 Pa and 20 deg C
+
+// 0x0708 is 1800 / 60 = 30 Pa, 0x1388 is 5000 / 200 = 25 deg C, 0x003c is a scale of 60
+void add_full_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x07, 0x08, 0x96, 0x13, 0x88, 0x01, 0x00, 0x3c, 0x39);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+// 0x7530 is 30000 / 200 = 150 deg C
+void add_out_of_range_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x07, 0x08, 0x96, 0x75, 0x30, 0x08, 0x00, 0x3c, 0x39);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+// 0x0e10 is 3600 / 60 = 60 Pa
+void add_pressure_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x0e, 0x10, 0xaf);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+// Returns the command of the oldest write to the mock device, or 0 if nothing was written
+uint16_t next_command(PF::HAL::Mock::I2CDevice &mock_device) {
+  std::array<uint8_t, 16> buffer{};
+  size_t count = buffer.size();
+  if (mock_device.get_write(buffer.data(), count) != PF::I2CDeviceStatus::ok) {
+    return 0;
+  }
+
+  return static_cast<uint16_t>((buffer[0] << 8U) | buffer[1]);
+}
+
+// Calls setup at the time, and returns its result
+PF::InitializableState setup_at(SDP::Sensor &sensor, PF::HAL::Mock::Time &time, uint32_t us) {
+  time.set_micros(us);
+  return sensor.setup();
+}
+
+// Calls output at the time, and returns its result
+PF::InitializableState output_at(
+    SDP::Sensor &sensor, PF::HAL::Mock::Time &time, uint32_t us, float &flow) {
+  time.set_micros(us);
+  return sensor.output(flow);
+}
+
+}  // namespace
+
+SCENARIO("SDP compute_flow follows the square root of differential pressure") {
+  GIVEN("A flow coefficient of 2 L/min at 1 Pa") {
+    WHEN("Flow is computed from differential pressures at 20 deg C") {
+      float forward = SDP::compute_flow(100, 20, flow_coefficient);
+      float reverse = SDP::compute_flow(-25, 20, flow_coefficient);
+      float none = SDP::compute_flow(0, 20, flow_coefficient);
+
+      THEN("Flow is the coefficient times the square root, with the sign of the pressure") {
+        REQUIRE(forward == Approx(20));
+        REQUIRE(reverse == Approx(-10));
+        REQUIRE(none == Approx(0));
+      }
+    }
+
+    WHEN("Flow is computed from the same differential pressure at a higher temperature") {
+      float flow = SDP::compute_flow(100, 40, flow_coefficient);
+
+      THEN("Flow is corrected for the lower gas density") {
+        REQUIRE(flow == Approx(20 * std::sqrt(313.15 / 293.15)));
+      }
+    }
+  }
+}
+
+SCENARIO("SDP Sensor sets up continuous measurement without blocking") {
+  GIVEN("A sensor whose device responds with a valid sample") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    PF::Driver::I2C::SDPSensor device(mock_device, time);
+    SDP::Sensor sensor(device, flow_coefficient, time);
+    add_full_sample(mock_device);
+
+    WHEN("setup is called until the warm-up has passed") {
+      auto stop = setup_at(sensor, time, 0);
+      auto early_start = setup_at(sensor, time, 499);
+      auto start = setup_at(sensor, time, 500);
+      auto early_check = setup_at(sensor, time, 20499);
+      auto check = setup_at(sensor, time, 20500);
+
+      THEN("Measurement is stopped, then started with averaging, then checked") {
+        REQUIRE(stop == PF::InitializableState::setup);
+        REQUIRE(early_start == PF::InitializableState::setup);
+        REQUIRE(start == PF::InitializableState::setup);
+        REQUIRE(early_check == PF::InitializableState::setup);
+        REQUIRE(check == PF::InitializableState::ok);
+        REQUIRE(sensor.get_state() == Action::measure);
+        REQUIRE(next_command(mock_device) == stop_command);
+        REQUIRE(next_command(mock_device) == start_measure_average_command);
+        REQUIRE(next_command(mock_device) == 0);
+        REQUIRE(sensor.sample().differential_pressure == Approx(30));
+        REQUIRE(sensor.sample().temperature == Approx(25));
+        REQUIRE(sensor.sample().differential_pressure_scale == 60);
+      }
+    }
+  }
+
+  GIVEN("A sensor whose first sample isn't ready yet") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    PF::Driver::I2C::SDPSensor device(mock_device, time);
+    SDP::Sensor sensor(device, flow_coefficient, time);
+    setup_at(sensor, time, 0);
+    setup_at(sensor, time, 500);
+
+    WHEN("setup is called until the sample is ready") {
+      auto waiting = setup_at(sensor, time, 20500);
+      add_full_sample(mock_device);
+      auto ready = setup_at(sensor, time, 21000);
+
+      THEN("Setup waits for the sample without a fault") {
+        REQUIRE(waiting == PF::InitializableState::setup);
+        REQUIRE(ready == PF::InitializableState::ok);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 0);
+      }
+    }
+  }
+
+  GIVEN("A sensor whose device responds with a temperature out of range") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    PF::Driver::I2C::SDPSensor device(mock_device, time);
+    SDP::Sensor sensor(device, flow_coefficient, time);
+    add_out_of_range_sample(mock_device);
+
+    WHEN("setup is called until the sample is checked") {
+      setup_at(sensor, time, 0);
+      setup_at(sensor, time, 500);
+      auto status = setup_at(sensor, time, 20500);
+
+      THEN("The check faults, and setup is restarted by stopping measurement") {
+        REQUIRE(status == PF::InitializableState::setup);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 1);
+        REQUIRE(sensor.get_state() == Action::stop);
+      }
+    }
+  }
+
+  GIVEN("A sensor whose device doesn't acknowledge any writes") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    PF::Driver::I2C::SDPSensor device(mock_device, time);
+    SDP::Sensor sensor(device, flow_coefficient, time);
+    for (size_t i = 0; i < 9; ++i) {
+      mock_device.add_write_status(PF::I2CDeviceStatus::nack);
+    }
+
+    WHEN("setup is called every ms") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      for (uint32_t us = 0; us < 200000 && status == PF::InitializableState::setup; us += 1000) {
+        status = setup_at(sensor, time, us);
+      }
+
+      THEN("Setup fails after its retries, and can be restarted by reconnect") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::stop).faults == 9);
+        sensor.reconnect();
+        REQUIRE(sensor.get_state() == Action::stop);
+        REQUIRE(setup_at(sensor, time, 300000) == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::start_measure);
+      }
+    }
+  }
+}
+
+SCENARIO("SDP Sensor measures flow at the sensor's update rate") {
+  GIVEN("A sensor which has been set up") {
+    PF::HAL::Mock::I2CDevice mock_device;
+    PF::HAL::Mock::Time time;
+    PF::Driver::I2C::SDPSensor device(mock_device, time);
+    SDP::Sensor sensor(device, flow_coefficient, time);
+    add_full_sample(mock_device);
+    setup_at(sensor, time, 0);
+    setup_at(sensor, time, 500);
+    REQUIRE(setup_at(sensor, time, 20500) == PF::InitializableState::ok);
+
+    WHEN("output is called before and after the update interval") {
+      float flow = -1;
+      add_pressure_sample(mock_device);
+      auto early = output_at(sensor, time, 20999, flow);
+      float early_flow = flow;
+      auto status = output_at(sensor, time, 21000, flow);
+
+      THEN("Only the differential pressure is read, once the interval has passed") {
+        REQUIRE(early == PF::InitializableState::ok);
+        REQUIRE(early_flow == -1);
+        REQUIRE(status == PF::InitializableState::ok);
+        REQUIRE(sensor.sample().differential_pressure == Approx(60));
+        REQUIRE(sensor.sample().temperature == Approx(25));
+        REQUIRE(flow == Approx(SDP::compute_flow(60, 25, flow_coefficient)));
+      }
+    }
+
+    WHEN("output is called after the temperature interval has passed") {
+      float flow = -1;
+      add_full_sample(mock_device);
+      auto status = output_at(sensor, time, 1020500, flow);
+
+      THEN("The full sample is read") {
+        REQUIRE(status == PF::InitializableState::ok);
+        REQUIRE(flow == Approx(SDP::compute_flow(30, 25, flow_coefficient)));
+      }
+    }
+
+    WHEN("No new measurement is available until after the timeout") {
+      float flow = -1;
+      auto waiting = output_at(sensor, time, 21000, flow);
+      auto timed_out = output_at(sensor, time, 30500, flow);
+
+      THEN("The measurement faults without failing") {
+        REQUIRE(waiting == PF::InitializableState::ok);
+        REQUIRE(timed_out == PF::InitializableState::ok);
+        REQUIRE(flow == -1);
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+      }
+    }
+  }
+}
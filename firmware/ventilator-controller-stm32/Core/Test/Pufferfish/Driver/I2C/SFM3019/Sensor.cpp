@@ -6,2205 +6,617 @@
  *  Created on:
  *      Author: Raavi Lagoo
  *
- * Unit tests to confirm behavior of SFM3019  Device
+ * Unit tests to confirm behavior of SFM3019 Sensor
  *
  */
 #include "Pufferfish/Driver/I2C/SFM3019/Sensor.h"
 
-#include <string>
+#include <array>
 
 #include "Pufferfish/HAL/Mock/I2CDevice.h"
 #include "Pufferfish/HAL/Mock/Time.h"
-#include "Pufferfish/Test/Util.h"
-#include "Pufferfish/Util/Endian.h"
+#include "Pufferfish/Util/Containers/Array.h"
 #include "catch2/catch.hpp"
 namespace PF = Pufferfish;
+namespace SFM3019 = PF::Driver::I2C::SFM3019;
+using Action = SFM3019::Sensor::Action;
+using PF::Util::Containers::make_array;
 
-SCENARIO(
-    "The StateMachine::update method works correctly when update is called with normal interval of "
-    "time for wait_warmup - check range cycle ") {
-  GIVEN(" A freshly constructed state machine") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    WHEN("The update method is called twice with [0, 30000]us as input parameter ") {
-      // Action returns wait_warmup action
-      uint32_t time = 0;
-      auto status1 = state_machine.update(time);
-      THEN("The first update method returns wait_warmup action") {
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the first update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time1 = 30000;
-      auto status = state_machine.update(time1);
-      THEN("The second update method returns check_range action") {
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      THEN("After the second update method, output method returns check_range action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-    }
-  }
+namespace {
+
+const uint16_t request_product_id_command = 0xE102;
+const uint16_t read_conversion_command = 0x3661;
+const uint16_t set_averaging_command = 0x366A;
+const uint16_t start_measure_o2_command = 0x3603;
+const uint16_t stop_measure_command = 0x3ff9;
+
+void add_product_id(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The StateMachine::update method works correctly when update is called with normal interval of "
-    "time for wait_measurement-measure cycle ") {
-  GIVEN(" A state machine is updated till Action returns check range") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    uint32_t time = 0;
-    auto status1 = state_machine.update(time);
-    REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    auto op_state = state_machine.output();
-    REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    uint32_t time1 = 30000;
-    auto status = state_machine.update(time1);
-    REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    auto op_state1 = state_machine.output();
-    REQUIRE(op_state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    WHEN(
-        "The update method is called three times with [30001, 30502, 30503]us as input parameter") {
-      // Action cycles between  wait_measurement and measure
-      uint32_t time2 = 30001;
-      auto action_status1 = state_machine.update(time2);
-      THEN("The first update method call returns wait_measurement action") {
-        REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the first update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time3 = 30502;
-      auto action_status2 = state_machine.update(time3);
-      THEN("The second update method call returns measure action") {
-        REQUIRE(action_status2 == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
-      THEN("After the second update method output method returns measure action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
-      uint32_t time4 = 30503;
-      auto action_status3 = state_machine.update(time4);
-      THEN("The third update method call returns wait_measurement action") {
-        REQUIRE(action_status3 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the third update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-    }
-  }
+void add_conversion_factors(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The StateMachine::update method works correctly when update is called multiple times for edge "
-    "cases for wait_warmup - check_range cycle") {
-  GIVEN("The freshly constructed state machine") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    WHEN("The update method is called three times with [0, 29999, 30000]us as input parameter ") {
-      // for edge cases, action remains wait_warmup for 29999 time,
-      // action returns check_range for 30000 input time
-      uint32_t time = 0;
-      auto status1 = state_machine.update(time);
-      THEN("The first update method call returns wait_warmup action") {
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the first update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time1 = 29999;
-      auto status = state_machine.update(time1);
-      THEN("The second update method call returns wait_warmup action") {
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the second update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time2 = 30000;
-      auto status2 = state_machine.update(time2);
-      THEN("The third update method call returns check_range action") {
-        REQUIRE(status2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      THEN("After the third update method, output method returns check_range action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-    }
-  }
+// 0xa200 is a flow of (0xa200 + 24576) / 170 = 3.01 L/min
+void add_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0xa2, 0x00, 0xa7);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The StateMachine::update method works correctly when update is called multiple times for edge "
-    "cases for wait_measurement-measure cycle") {
-  GIVEN("A  state machine is updated till Action returns check range") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    uint32_t time2 = 0;
-    auto action_status1 = state_machine.update(time2);
-    REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    auto op_state = state_machine.output();
-    REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    uint32_t time3 = 30001;
-    auto action_status2 = state_machine.update(time3);
-    REQUIRE(action_status2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    auto op_state1 = state_machine.output();
-    REQUIRE(op_state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-
-    WHEN(
-        "The update method is called two times with [30000, 30499]us as input "
-        "parameter ") {
-      // enough time is not elaspsed, action remains wait_measurement instead of measure
-      uint32_t time4 = 30000;
-      auto action_status3 = state_machine.update(time4);
-      THEN("The first update method call returns wait_measurement action") {
-        REQUIRE(action_status3 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the first update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time5 = 30499;
-      auto action_status4 = state_machine.update(time5);
-      THEN("The second update method call returns wait_measurement action") {
-        REQUIRE(action_status4 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the second update method output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-    }
-    WHEN(
-        "The update method is called four times with [30000, 30499, 30500]us as input "
-        "parameter") {
-      // enough time has elapsed, action returns measure
-      uint32_t time4 = 30000;
-      auto action_status3 = state_machine.update(time4);
-      THEN("The first update method call returns wait_measurement action") {
-        REQUIRE(action_status3 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the first update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time5 = 30499;
-      auto action_status4 = state_machine.update(time5);
-      THEN("The second update method call returns wait_measurement action") {
-        REQUIRE(action_status4 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the second update method output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time6 = 30500;
-      auto action_status5 = state_machine.update(time6);
-      THEN("The third update method call returns measure action") {
-        REQUIRE(action_status5 == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
-      THEN("After the third update method output method returns measure action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
-    }
-  }
+// 0x3000 is a flow of (0x3000 + 24576) / 170 = 216.8 L/min
+void add_out_of_range_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x30, 0x00, 0x33);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The update method works correctly  when enough time is not elapsed between consecutive "
-    "calls for wait_warmup - check_range action") {
-  GIVEN("The freshly constructed state machine") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    // Enough time is not elapsed , action remains wait_warmup
-    WHEN("The update method is called three times with [4000, 5000, 6000]us as input parameter ") {
-      uint32_t time = 4000;
-      auto status1 = state_machine.update(time);
-      THEN("The first update method call returns wait_warmup action") {
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the first update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time1 = 5000;
-      auto status = state_machine.update(time1);
-      THEN("The second update method call returns wait_warmup action") {
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the second update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time2 = 6000;
-      auto action_status1 = state_machine.update(time2);
-      THEN("The third update method call returns wait_warmup action") {
-        REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the third update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-    }
-  }
+// Reads the product number 0x04020612 instead of 0x04020611
+void add_wrong_product_id(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x12, 0xfa);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The update method works correctly  when enough time is not elapsed between consecutive "
-    "calls for wait_measurement-measure action") {
-  GIVEN("The state machine is updated till Action returns check_range") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    uint32_t time = 500;
-    auto status1 = state_machine.update(time);
-    REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    auto op_state = state_machine.output();
-    REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    uint32_t time1 = 250;
-    auto status = state_machine.update(time1);
-    REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    auto op_state1 = state_machine.output();
-    REQUIRE(op_state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    // Not enough time has elapsed, action remains wait_measurement instead of measure
-    WHEN(
-        "The update method is called twice  with [300, 300]us as input "
-        "parameter") {
-      uint32_t time2 = 300;
-      auto action_status1 = state_machine.update(time2);
-      THEN("The first update method call returns wait_measurement action") {
-        REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the first update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time3 = 300;
-      auto action_status2 = state_machine.update(time3);
-      THEN("The second update method call returns wait_measurement action") {
-        REQUIRE(action_status2 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the second update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-    }
-  }
+// Reads the correct product number, but with a wrong CRC for its second word
+void add_corrupted_product_id(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa8);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The StateMachine::update method works correctly for relatively small interval of time as "
-    "input for wait_warmup - check range cycle") {
-  GIVEN(" A freshly contructed state machine") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    WHEN(
-        "The update method is called three times with [100, 299, 300]us as input "
-        "parameter ") {
-      // action remains  wait_warmup
-      uint32_t time = 100;
-      auto status1 = state_machine.update(time);
-      THEN("The first update method call returns wait_warmup action") {
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the first update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time1 = 299;
-      auto status = state_machine.update(time1);
-      THEN("The second update method call returns wait_warmup action") {
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the second update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      uint32_t time2 = 300;
-      auto action_status1 = state_machine.update(time2);
-      THEN("The third update method call returns wait_warmup action") {
-        REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("After the third update method, output method returns wait_warmup action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-    }
-  }
+// Reads a scale factor of 171 instead of 170
+void add_wrong_conversion_factors(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0x00, 0xab, 0x97, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
 }
 
-SCENARIO(
-    "The StateMachine::update method works correctly for relatively small interval of time as "
-    "input for wait_measurement - measure cycle") {
-  GIVEN(" The state machine is updated till Action returns check_range") {
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    uint32_t time = 0;
-    auto status1 = state_machine.update(time);
-    REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    auto op_state = state_machine.output();
-    REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    uint32_t time1 = 30000;
-    auto status = state_machine.update(time1);
-    REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-    auto op_state1 = state_machine.output();
-    REQUIRE(op_state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-
-    WHEN(
-        "The update method is called twice  with [300, 301]us as input "
-        "parameter ") {
-      // action remains  wait_measurement instead of measure
-      uint32_t time2 = 300;
-      auto action_status1 = state_machine.update(time2);
-      THEN("The first update method call returns wait_measurement action") {
-        REQUIRE(action_status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the first update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      uint32_t time3 = 301;
-      auto action_status2 = state_machine.update(time3);
-      THEN("The second update method call returns wait_measurement action") {
-        REQUIRE(action_status2 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("After the second update method, output method returns wait_measurement action") {
-        auto op_state = state_machine.output();
-        REQUIRE(op_state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-    }
+// Reads the sample 0xa200, but with a wrong CRC
+void add_corrupted_sample(PF::HAL::Mock::I2CDevice &mock_device) {
+  auto read_buffer = make_array<uint8_t>(0xa2, 0x00, 0xa6);
+  mock_device.add_read(read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::ok);
+}
+
+// Returns the command of the oldest write to the mock device, or 0 if nothing was written
+uint16_t next_command(PF::HAL::Mock::I2CDevice &mock_device) {
+  std::array<uint8_t, 16> buffer{};
+  size_t count = buffer.size();
+  if (mock_device.get_write(buffer.data(), count) != PF::I2CDeviceStatus::ok) {
+    return 0;
   }
+
+  return static_cast<uint16_t>((buffer[0] << 8U) | buffer[1]);
 }
 
-SCENARIO(
-    "The Sensor::setup method works correctly for normal cases when action cycles form "
-    "wait_warmup-check_range") {
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting of[04 02 60 06 "
-      "11 a9 00 00 81] (as a read_product_id response) and[00 aa a6 a0 00 7e 00 00 81]"
-      "(as read_conversion_factor response) and [97 38 1e](as read_sample response) followed by "
-      "junk bytes [01 02], reseter is set to false and mock time is set to 100us, global"
-      "device's mock write buffer is set to [01] byte and read buffer has [01 02] bytes") {
+// Calls setup at the time, and returns its result
+PF::InitializableState setup_at(SFM3019::Sensor &sensor, PF::HAL::Mock::Time &time, uint32_t us) {
+  time.set_micros(us);
+  return sensor.setup();
+}
+
+}  // namespace
+
+SCENARIO("SFM3019 Sensor runs one setup step per call, without blocking on delays") {
+  GIVEN("A sensor whose device responds with its product id and conversion factors") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    auto read_status = PF::I2CDeviceStatus::ok;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), read_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), read_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x97, 0x38, 0x1e);
-    mock_device.add_read(input_data.data(), input_data.size(), read_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), read_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), read_status);
-
-    // normal case, get_state goes from wait_warmup-check_range action
-
-    WHEN(
-        "The setup method is called twice , mock time is set to [100, 31000]us before each "
-        "corresponding setup call") {
-      PF::Driver::I2C::SFM3019::StateMachine state_machine;
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    add_conversion_factors(mock_device);
+    add_sample(mock_device);
+
+    REQUIRE(setup_at(sensor, time, 100) == PF::InitializableState::setup);
+    REQUIRE(sensor.get_state() == Action::request_product_id);
+
+    WHEN("setup is called again before the sensor has powered up") {
+      auto status = setup_at(sensor, time, 2099);
+
+      THEN("No command is sent yet") {
         REQUIRE(status == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::request_product_id);
+        REQUIRE(next_command(mock_device) == 0);
       }
-      THEN("After first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
+    }
 
-      time.set_micros(31000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
+    WHEN("setup is called after power-up until it waits for the conversion factors") {
+      for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(setup_at(sensor, time, 2100) == PF::InitializableState::setup);
       }
-      THEN("After second setup method call, get_state returns check_range action ") {
-        auto state4 = sensor.get_state();
-        REQUIRE(state4 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
+
+      THEN("The product id is checked and the conversion factors are requested") {
+        REQUIRE(sensor.get_state() == Action::read_conversion_factors);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == read_conversion_command);
+        REQUIRE(next_command(mock_device) == 0);
       }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = 2;
-      auto status_write = mock_device.get_write(input_buffer.buffer(), count);
-      REQUIRE(status_write == PF::I2CDeviceStatus::ok);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 02](request_product_id),"
-          "[36 61](read_conversion), [36 6A](set_averaging) and[36 03](O2 gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
+    }
+
+    WHEN("setup is called until the sensor waits for warm-up") {
+      for (size_t i = 0; i < 3; ++i) {
+        setup_at(sensor, time, 2100);
       }
-      PF::Util::Containers::ByteVector<buffer_size> input_read;
-      PF::Util::Containers::ByteVector<buffer_size> input_read1;
-      PF::Util::Containers::ByteVector<buffer_size> input_read2;
-      PF::Util::Containers::ByteVector<buffer_size> input_read3;
-      auto read_status = mock_device.read(input_read.buffer(), 3);
-      auto read_status1 = mock_device.read(input_read1.buffer(), 2);
-      auto read_status2 = mock_device.read(input_read2.buffer(), count);
-      THEN("The mock_device I2C's read buffer contains bytes [97 38 1e] and junk bytes [01 02]") {
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_read[0] == 0x97);
-        REQUIRE(input_read[1] == 0x38);
-        REQUIRE(input_read[2] == 0x1e);
-        REQUIRE(read_status1 == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_read1[0] == 0x01);
-        REQUIRE(input_read1[1] == 0x02);
+      for (size_t i = 0; i < 3; ++i) {
+        REQUIRE(setup_at(sensor, time, 2120) == PF::InitializableState::setup);
       }
-      THEN("The mock_device I2C's read buffer is empty") {
-        REQUIRE(read_status2 == PF::I2CDeviceStatus::no_new_data);
+
+      THEN("Measurement is started") {
+        REQUIRE(sensor.get_state() == Action::check_range);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == read_conversion_command);
+        REQUIRE(next_command(mock_device) == set_averaging_command);
+        REQUIRE(next_command(mock_device) == start_measure_o2_command);
       }
 
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
+      THEN("The sample is only checked once the sensor has warmed up") {
+        REQUIRE(setup_at(sensor, time, 32119) == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::check_range);
+        REQUIRE(setup_at(sensor, time, 32120) == PF::InitializableState::ok);
+        REQUIRE(sensor.get_state() == Action::measure);
+        REQUIRE(setup_at(sensor, time, 32121) == PF::InitializableState::ok);
       }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+
+      THEN("The time spent waiting in each state is recorded") {
+        setup_at(sensor, time, 32120);
+        REQUIRE(sensor.statistics(Action::request_product_id).entries == 1);
+        REQUIRE(sensor.statistics(Action::request_product_id).total_time == 2000);
+        REQUIRE(sensor.statistics(Action::read_conversion_factors).total_time == 20);
+        REQUIRE(sensor.statistics(Action::check_range).entries == 1);
+        REQUIRE(sensor.statistics(Action::check_range).total_time == 30000);
+        REQUIRE(sensor.statistics(Action::check_range).max_time == 30000);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 0);
       }
     }
   }
 }
 
-SCENARIO(
-    "The Sensor::setup method works correctly for normal cases when action cycles form "
-    "check_range-wait_measurement") {
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting of[04 02 60 06 "
-      "11 a9 00 00 81] (as a read_product_id response) and[00 aa a6 a0 00 7e 00 00 81]"
-      "(as read_conversion_factor response) and [97 38 1e](as read_sample response) followed by "
-      "junk bytes [01 02], reseter is set to false and mock time is set to 100us. global"
-      "device's mock write buffer is set to [01] "
-      "byte and read buffer is set to [01 02]") {
+SCENARIO("SFM3019 Sensor resets all sensors on the bus if it's the resetter") {
+  GIVEN("A sensor which is the resetter") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x97, 0x38, 0x1e);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    // normal case, get_state goes from check_range to wait_measurement action
-    WHEN(
-        "The setup method is called thrice , mock time is set to [100, 31000, 31000]us before each "
-        "corresponding setup call") {
-      PF::Driver::I2C::SFM3019::StateMachine state_machine;
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
+    SFM3019::Sensor sensor{device, true, time};
+
+    WHEN("setup is called once") {
+      auto status = setup_at(sensor, time, 0);
+
+      THEN("The reset command is sent to the global device") {
         REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(31000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After second setup method call, get_state returns check_range action ") {
-        auto state4 = sensor.get_state();
-        REQUIRE(state4 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      auto status2 = sensor.setup();
-      THEN("The third setup method call retuns ok state") {
-        REQUIRE(status2 == PF::InitializableState::ok);
-      }
-      THEN("After the third setup method call, get_state method returns wait_measurement action") {
-        auto state1 = sensor.get_state();
-        REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) and  [36 "
-          "03](O2 gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x01);
-        REQUIRE(input[1] == 0x02);
-      }
-      THEN("The global_device I2C's read remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+        REQUIRE(sensor.get_state() == Action::request_product_id);
+        std::array<uint8_t, 16> buffer{};
+        size_t count = buffer.size();
+        REQUIRE(global_device.get_write(buffer.data(), count) == PF::I2CDeviceStatus::ok);
+        REQUIRE(count == 1);
+        REQUIRE(buffer[0] == 0x06);
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
-  }
-}
 
-SCENARIO(
-    "The Sensor::setup method works correctly when enough time is not elapsed and for cycle "
-    "wait_warmup-check_range action") {
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of[04 02 60 06 11"
-      "a9 00 00 81] (as a read_product_id response) and[00 aa a6 a0 00 7e 00 00 81]"
-      "(as read_conversion_factor response) and [15 35 a8](as read_sample response) followed by "
-      "junk bytes [01 02] , reseter is set to false and mock time set to 100us , global"
-      "device's mock write buffer is set to [01] byte "
-      "and read buffer is set to [01 02]") {
-    PF::HAL::Mock::I2CDevice mock_device;
-    PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
-    PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x15, 0x35, 0xa8);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    // Enough time is not elapsed between two setup calls, timeout condition is not satisfied
-    //  get_state returns wait_warmup instead of check_range
-    WHEN(
-        "The setup method is called twice, mock time is set to [100, 5000]us before each "
-        "corresponding setup call") {
-      PF::Driver::I2C::SFM3019::StateMachine state_machine;
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method returns setup state") {
+    WHEN("The reset command fails") {
+      global_device.add_write_status(PF::I2CDeviceStatus::write_error);
+      auto status = setup_at(sensor, time, 0);
+
+      THEN("The reset is retried after a backoff") {
         REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(5000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns wait_warmup action ") {
-        auto state1 = sensor.get_state();
-        REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) "
-          "and [36 03](O2 "
-          "gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-      }
-      PF::Util::Containers::ByteVector<buffer_size> input_read;
-      PF::Util::Containers::ByteVector<buffer_size> input_read1;
-      auto read_status = mock_device.read(input_read.buffer(), 3);
-      auto read_status1 = mock_device.read(input_read1.buffer(), 2);
-      THEN("The mock_device I2C's read buffer contains bytes [15 35 a8] and junk bytes [01 02]") {
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_read[0] == 0x15);
-        REQUIRE(input_read[1] == 0x35);
-        REQUIRE(input_read[2] == 0xa8);
-        REQUIRE(read_status1 == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_read1[0] == 0x01);
-        REQUIRE(input_read1[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+        REQUIRE(sensor.get_state() == Action::reset);
+        REQUIRE(sensor.statistics(Action::reset).faults == 1);
+        REQUIRE(setup_at(sensor, time, 999) == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::reset);
+        REQUIRE(setup_at(sensor, time, 1000) == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::request_product_id);
       }
     }
   }
 }
 
-SCENARIO("The Sensor::setup method works correctly for different mock read buffer ") {
-  // Data in mock read buffer contains wrong product id
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting of[97 38 1e] "
-      "(as invalid read_product_id response), "
-      " reseter is set to false and mock time is set to 100us, global device's mock write buffer "
-      "is set to [01] byte and read buffer is set to [01 02]") {
+SCENARIO("SFM3019 Sensor doesn't reset the other sensors on the bus when it's reconnected") {
+  GIVEN("A resetter sensor which has failed setup and is then reconnected") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    WHEN("The setup method is called once ,time is set to 100us") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns failed state") {
-        REQUIRE(status == PF::InitializableState::failed);
-      }
-      THEN("After first setup method call, get_state method returns initialize action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::initialize);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      THEN("The mock_device I2C's write buffer contains request_product_id command byte [E1 02]") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), count);
-        REQUIRE(read_status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
-      }
+    SFM3019::Sensor sensor{device, true, time};
+    PF::InitializableState status = PF::InitializableState::setup;
+    for (size_t calls = 0; calls < 100 && status == PF::InitializableState::setup; ++calls) {
+      status = setup_at(sensor, time, static_cast<uint32_t>(10000 * calls));
     }
-  }
-  // wrong mock buffer for read_conversion_factors
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting of[04 02 60 06"
-      "11 a9 00 00 81] (as valid read_product_id response) followed by [97 38 1e]"
-      "(as invalid read_conversion_factors response) "
-      " reseter is set to false and mock time is set to 100us, global device's mock write buffer "
-      "is set to [01] byte and read buffer is set to [01 02]") {
-    PF::HAL::Mock::I2CDevice mock_device;
-    PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
-    PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    WHEN("The setup method is called once ,time is set to 100us") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns failed state") {
-        REQUIRE(status == PF::InitializableState::failed);
-      }
-      THEN("After first setup method call, get_state method returns initialize action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::initialize);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 02](request_product_id) "
-          "and [36 61](read_conversion)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), count);
-        REQUIRE(read_status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    REQUIRE(status == PF::InitializableState::failed);
+    std::array<uint8_t, 16> buffer{};
+    size_t count = buffer.size();
+    REQUIRE(global_device.get_write(buffer.data(), count) == PF::I2CDeviceStatus::ok);
+    while (next_command(mock_device) != 0) {
+    }
+    sensor.reconnect();
+    add_product_id(mock_device);
+
+    WHEN("setup is called until the product id has been checked") {
+      setup_at(sensor, time, 1000000);
+      auto before_power_up = setup_at(sensor, time, 1001999);
+      setup_at(sensor, time, 1002000);
+      setup_at(sensor, time, 1002000);
+
+      THEN("The sensor is stopped instead of sending a general call reset") {
+        REQUIRE(before_power_up == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::request_conversion_factors);
+        count = buffer.size();
+        REQUIRE(global_device.get_write(buffer.data(), count) != PF::I2CDeviceStatus::ok);
+        REQUIRE(next_command(mock_device) == stop_measure_command);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
   }
 }
 
-SCENARIO(
-    "The Sensor::setup method works correctly when flow is greater than the pre-defined limit") {
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of[04 02 60 06"
-      "11 a9 00 00 81] (as valid read_product_id response) "
-      "and[00 aa a6 a0 00 7e 00 00 81](as valid read_conversion_factor response) [01 00 b1](as "
-      "valid read_sample response)"
-      "followed by junk bytes [01 02] , reseter is set to "
-      "false and mock time is set to 100us, global device's mock write buffer is set to [01] "
-      "byte and read buffer is set to [01 02] bytes") {
+SCENARIO("SFM3019 Sensor retries faulty setup steps with exponential backoff") {
+  GIVEN("A sensor whose device rejects the averaging command three times") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto input_data2 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data2.data(), input_data2.size(), write_status);
-    auto input_data3 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data3.data(), input_data3.size(), write_status);
-    auto input_data4 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data4.data(), input_data4.size(), write_status);
-    auto input_data5 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data5.data(), input_data5.size(), write_status);
-    auto input_data6 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data6.data(), input_data6.size(), write_status);
-    auto input_data7 = PF::Util::Containers::make_array<uint8_t>(0x31, 0x38, 0xbb);
-    mock_device.add_read(input_data7.data(), input_data7.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    // in check_range method, read_sample condition flow is 218.682 greater than flow max
-    WHEN(
-        "The setup method is called thrice , mock time is set to [100, 55000, 55001]us before each "
-        "corresponding setup call") {
-      PF::Driver::I2C::SFM3019::StateMachine state_machine;
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
-        REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(55000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns check_range action") {
-        auto state2 = sensor.get_state();
-        REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      time.set_micros(55001);
-      auto status2 = sensor.setup();
-      THEN("The third setup method call returns setup state") {
-        REQUIRE(status2 == PF::InitializableState::setup);
-      }
-      THEN("After the third setup method call, get_state method returns check_range action") {
-        auto state2 = sensor.get_state();
-        REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) and [36"
-          "03](O2 gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 3);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    add_conversion_factors(mock_device);
+    mock_device.add_write_status(PF::I2CDeviceStatus::ok);
+    mock_device.add_write_status(PF::I2CDeviceStatus::ok);
+    for (size_t i = 0; i < 3; ++i) {
+      mock_device.add_write_status(PF::I2CDeviceStatus::write_error);
+    }
+
+    setup_at(sensor, time, 0);
+    for (size_t i = 0; i < 3; ++i) {
+      setup_at(sensor, time, 2000);
+    }
+    setup_at(sensor, time, 2020);
+    REQUIRE(sensor.get_state() == Action::set_averaging);
+
+    WHEN("setup is called as each backoff passes") {
+      auto first = setup_at(sensor, time, 2020);
+      auto before_second = setup_at(sensor, time, 3019);
+      auto second = setup_at(sensor, time, 3020);
+      auto before_third = setup_at(sensor, time, 5019);
+      auto third = setup_at(sensor, time, 5020);
+      auto before_fourth = setup_at(sensor, time, 9019);
+      auto fourth = setup_at(sensor, time, 9020);
+
+      THEN("The command is retried after 1 ms, then 2 ms, then 4 ms, until it succeeds") {
+        REQUIRE(first == PF::InitializableState::setup);
+        REQUIRE(before_second == PF::InitializableState::setup);
+        REQUIRE(second == PF::InitializableState::setup);
+        REQUIRE(before_third == PF::InitializableState::setup);
+        REQUIRE(third == PF::InitializableState::setup);
+        REQUIRE(before_fourth == PF::InitializableState::setup);
+        REQUIRE(fourth == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::start_measure);
+        REQUIRE(sensor.statistics(Action::set_averaging).entries == 4);
+        REQUIRE(sensor.statistics(Action::set_averaging).faults == 3);
+        REQUIRE(sensor.statistics(Action::set_averaging).max_time == 4000);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == read_conversion_command);
+        for (size_t i = 0; i < 4; ++i) {
+          REQUIRE(next_command(mock_device) == set_averaging_command);
+        }
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
   }
 }
 
-SCENARIO("The Sensor::setup method works correctly when resetter is set to true") {
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of[04 02 60 06 11"
-      "a9 00 00 81] (as valid read_product_id response) and[00 aa a6 a0 00 7e 00 00 81](as valid "
-      "read_conversion_factor response), [15 35 a8](as valid read_sample response)"
-      "followed by junk bytes [01 02], reseter is set to true and mock time is set to 100us,"
-      "global device's mock write buffer is set to [01] byte "
-      "and read buffer is set to [01 02] bytes") {
+SCENARIO("SFM3019 Sensor setup fails after too many faults") {
+  GIVEN("A sensor whose device never responds with its product id") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x15, 0x35, 0xa8);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    WHEN(
-        "The setup method is called thrice , where mock time is set to [100, 55000, 55001]us "
-        "before each corresponding setup call") {
-      PF::Driver::I2C::SFM3019::StateMachine state_machine;
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, true, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
-        REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        sensor.get_state();
-        // REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(55000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns check_range action") {
-        auto state2 = sensor.get_state();
-        REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      time.set_micros(55001);
-      auto status3 = sensor.setup();
-      THEN("The third setup method call retuns ok status") {
-        REQUIRE(status3 == PF::InitializableState::ok);
-      }
-      THEN("After the third setup method call, get_state method returns wait_measurement action") {
-        auto state1 = sensor.get_state();
-        REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) and [36 03](O2 "
-          "gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        //  REQUIRE(input1[0] == 0x36);
-        //  REQUIRE(input1[1] == 0x61);
-        //  REQUIRE(input2[0] == 0x36);
-        //  REQUIRE(input2[1] == 0x6A);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x01);
-        REQUIRE(input[1] == 0x02);
+    SFM3019::Sensor sensor{device, false, time};
+
+    WHEN("setup is called every 10 ms until it stops making progress") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      size_t calls = 0;
+      for (; calls < 100 && status == PF::InitializableState::setup; ++calls) {
+        status = setup_at(sensor, time, static_cast<uint32_t>(10000 * calls));
       }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
+
+      THEN("The product id is requested 9 times before setup fails") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::request_product_id).entries == 9);
+        REQUIRE(sensor.statistics(Action::read_product_id).faults == 9);
+        REQUIRE(sensor.get_state() == Action::read_product_id);
       }
-      THEN("The global_device I2C's write buffer contains [06] byte") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x06);
+
+      THEN("The sensor stays failed") {
+        float flow = 0;
+        REQUIRE(
+            setup_at(sensor, time, static_cast<uint32_t>(10000 * calls)) ==
+            PF::InitializableState::failed);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::failed);
       }
     }
   }
 }
 
-SCENARIO(
-    "The Sensor::setup method works correctly when mock read buffer is different than expected, "
-    "setup method retries for maximum allowed times") {
-  // wrong data for product id, after 8 fault_counts it fails
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting of[00 aa a6 a0"
-      " 00 7e 01 48 f1]  (as  invalid read_product_id response) reseter is set to false and"
-      "mock time set to 100us, global device's mock write buffer is "
-      "set to [01] byte and read buffer is set to [01 02] bytes") {
+SCENARIO("SFM3019 Sensor retries setup when its product number is wrong") {
+  GIVEN("A sensor whose device first responds with a wrong product number") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    WHEN("The setup method is called once ,time is set to 100us") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The setup method call returns failed state") {
-        REQUIRE(status == PF::InitializableState::failed);
-      }
+    SFM3019::Sensor sensor{device, false, time};
+    add_wrong_product_id(mock_device);
+    add_product_id(mock_device);
 
-      THEN("After setup method call, get_state method returns initialize action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::initialize);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      THEN("The mock_device I2C's write buffer contains request_product_id command byte [E1 02]") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), count);
-        REQUIRE(read_status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
-      }
+    setup_at(sensor, time, 0);
+    for (size_t i = 0; i < 2; ++i) {
+      setup_at(sensor, time, 2000);
     }
-  }
 
-  // First 36 bytes fails read_product_id conditions(first 4 fault_counts fails), it passes on next
-  // count
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of 4 repetition"
-      " of[00 aa a6 a0 00 "
-      "7e 00 00 81](as invalid read_product_id response) [04 02 60 06 11"
-      "a9 00 00 81] (as valid "
-      "read_product_id "
-      "response) "
-      "and[00 aa a6 a0 00 7e 00 00"
-      "81](as valid read_conversion_factor response) [15 35 "
-      "a8](as valid read_sample"
-      "response)followed by junk bytes [01 02], reseter is set to "
-      "false and mock time set to"
-      "100us,global device's mock write buffer is set to [01] byte and "
-      "read buffer is set to [01 02] bytes") {
-    PF::HAL::Mock::I2CDevice mock_device;
-    PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
-    PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer2 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer2.data(), read_buffer2.size(), write_status);
-    auto read_buffer3 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    auto read_buffer4 =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer4.data(), read_buffer4.size(), write_status);
-    auto read_buffer5 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer5.data(), read_buffer5.size(), write_status);
-    auto read_buffer6 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer6.data(), read_buffer6.size(), write_status);
-
-    WHEN(
-        "The setup method is called thrice , where  mock time is set to [100, 55000, 55100]us "
-        "before "
-        "each corresponding setup call") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      auto input_data = PF::Util::Containers::make_array<uint8_t>(0x15, 0x35, 0xa8);
-      mock_device.add_read(input_data.data(), input_data.size(), write_status);
-      auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-      mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
-        REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(55000);
-      auto status1 = sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns check_range action") {
-        auto state2 = sensor.get_state();
-        REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      time.set_micros(55100);
-      auto status3 = sensor.setup();
-      THEN("The third setup method call retuns ok status") {
-        REQUIRE(status3 == PF::InitializableState::ok);
-      }
-      THEN("After the third setup method call, get_state method returns wait_measurement action") {
-        auto state1 = sensor.get_state();
-        REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) and [36 "
-          "03](O2gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x01);
-        REQUIRE(input[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    WHEN("setup is called as the product id is requested again") {
+      auto before_retry = setup_at(sensor, time, 3999);
+      auto retry = setup_at(sensor, time, 4000);
+      auto check = setup_at(sensor, time, 4000);
+
+      THEN("The product id is requested again after the power-up delay, and then accepted") {
+        REQUIRE(before_retry == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::setup);
+        REQUIRE(check == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::request_conversion_factors);
+        REQUIRE(sensor.statistics(Action::read_product_id).faults == 1);
+        REQUIRE(sensor.statistics(Action::request_product_id).entries == 2);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
   }
-}
 
-SCENARIO(
-    "The Sensor::setup method works correctly when mock read buffer for read_product_id is "
-    "different than expected, setup method retries for maximum allowed tries") {
-  // wrong read buffer for read_product_id conditions(first 7 fault_counts fails), it passes on last
-  // count
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of 7 repetition"
-      "of[00 aa a6 a0 00 7e 00 00 81] bytes (as invalid response)  [04 02 60 06 11 a9 00 00 81]"
-      "(as valid read_product_id response) and[00 aa a6 a0 00 7e 00 00 81](as valid"
-      "read_conversion_factor response) [15 35 a8](as read_sample response) followd by junk bytes"
-      "[01 02], reseter is set to false and mock time set to 100us, global device's mock"
-      "write buffer is set to [01] byte and "
-      "read buffer is set to [01 02] bytes") {
+  GIVEN("A sensor whose device always responds with a wrong product number") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer2 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer2.data(), read_buffer2.size(), write_status);
-    auto read_buffer3 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    auto read_buffer4 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer4.data(), read_buffer4.size(), write_status);
-    auto read_buffer5 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer5.data(), read_buffer5.size(), write_status);
-    auto read_buffer6 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer6.data(), read_buffer6.size(), write_status);
-    auto read_buffer7 =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer7.data(), read_buffer7.size(), write_status);
-    auto read_buffer8 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer8.data(), read_buffer8.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x15, 0x35, 0xa8);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto read_buffer9 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer9.data(), read_buffer9.size(), write_status);
-    WHEN(
-        "The setup method is called thrice , where  mock time is set to [100, 55000,55200]us "
-        "before each corresponding setup call") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(500);
-      sensor.setup();
-      THEN("The first setup method call returns setup state") {
-        // REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        sensor.get_state();
-        // REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(55000);
-      sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        // REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns check_range action") {
-        sensor.get_state();
-        // REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      time.set_micros(55200);
-      sensor.setup();
-      THEN("The third setup method call retuns ok status") {
-        // REQUIRE(status3 == PF::InitializableState::ok);
-      }
-      THEN("After the third setup method call, get_state method returns wait_measurement action") {
-        sensor.get_state();
-        // REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input3;
-      mock_device.get_write(input3.buffer(), count);
-
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging) and [36 03](O2 "
-          "gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-        REQUIRE(input3[0] == 0x36);
-        REQUIRE(input3[1] == 0x03);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x01);
-        REQUIRE(input[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
-      }
+    SFM3019::Sensor sensor{device, false, time};
+    for (size_t i = 0; i < 9; ++i) {
+      add_wrong_product_id(mock_device);
     }
-  }
-}
 
-SCENARIO(
-    "The Sensor::setup method works correctly when mock read buffer for read_conversion_factor is "
-    "different than expected, setup method retries for maximum allowed times") {
-  // read buffer for read_conversion_factor is wrong, after 8 fault_counts it fails
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of[04 02 60 06 11"
-      "a9 00 00 81] (as a valid read_product_id response) and[04 02 60 06 11 a9 00 00"
-      "81](as invalid read_conversion_factor response), reseter is set to false and mock time is"
-      "set to 100us, global device's mock write buffer is set to [01] byte and read"
-      "buffer is set to [01 02] bytes") {
-    PF::HAL::Mock::I2CDevice mock_device;
-    PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
-    PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    WHEN(
-        "The setup method is called once , where mock time is set to 100us before corresponding "
-        "setup call") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns failed state") {
-        REQUIRE(status == PF::InitializableState::failed);
-      }
-      THEN("After the first setup method call, get_state method returns initialize action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::initialize);
+    WHEN("setup is called every 10 ms until it stops making progress") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      for (size_t calls = 0; calls < 100 && status == PF::InitializableState::setup; ++calls) {
+        status = setup_at(sensor, time, static_cast<uint32_t>(10000 * calls));
       }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 02](request_product_id)and "
-          "[36 61](read_conversion)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), count);
-        REQUIRE(read_status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+
+      THEN("Setup fails without ever requesting the conversion factors") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::read_product_id).faults == 9);
+        REQUIRE(sensor.statistics(Action::request_conversion_factors).entries == 0);
+        for (size_t i = 0; i < 9; ++i) {
+          REQUIRE(next_command(mock_device) == request_product_id_command);
+        }
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
   }
 
-  // wrong read buffer for read_conversion_factors conditions(first 7 fault_counts fails), it passes
-  // on last count
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consists of[04 02 60 06"
-      "11 a9 00 00 81] (as a valid read_product_id response) and 7 repetition of [04 02 60"
-      "06 11 a9 00 00 81] bytes(invalid read_conversion_factor response) and [00 aa a6 a0 00"
-      " 7e 00 00 81](as valid read_conversion_factor response) [15 35 a8](as read_sample"
-      "response) followd by junk bytes [01 02], reseter is set to false and mock time set to"
-      "100us, global device's mock write buffer is set to [01] byte and read buffer is set to [01 "
-      "02] bytes") {
+  GIVEN("A sensor whose device first responds with a product id which fails its CRC check") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer2 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer2.data(), read_buffer2.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    auto read_buffer4 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer4.data(), read_buffer4.size(), write_status);
-    auto read_buffer5 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer5.data(), read_buffer5.size(), write_status);
-    auto read_buffer6 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer6.data(), read_buffer6.size(), write_status);
-    auto read_buffer7 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer7.data(), read_buffer7.size(), write_status);
-    auto read_buffer8 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer8.data(), read_buffer8.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x15, 0x35, 0xa8);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto read_buffer9 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer9.data(), read_buffer9.size(), write_status);
-
-    WHEN(
-        "The setup method is called thrice , where  mock time is set to [100, 55000, 55200]us "
-        "before "
-        "each corresponding setup call") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns setup state") {
+    SFM3019::Sensor sensor{device, false, time};
+    add_corrupted_product_id(mock_device);
+    add_product_id(mock_device);
+
+    setup_at(sensor, time, 0);
+    for (size_t i = 0; i < 2; ++i) {
+      setup_at(sensor, time, 2000);
+    }
+
+    WHEN("setup is called as the product id is requested again") {
+      setup_at(sensor, time, 4000);
+      auto status = setup_at(sensor, time, 4000);
+
+      THEN("The corrupted product id is rejected, and the valid one is accepted") {
         REQUIRE(status == PF::InitializableState::setup);
-      }
-      THEN("After the first setup method call, get_state method returns wait_warmup action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      time.set_micros(55000);
-      sensor.setup();
-      THEN("The second setup method call returns setup state") {
-        // REQUIRE(status1 == PF::InitializableState::setup);
-      }
-      THEN("After the second setup method call, get_state method returns check_range action") {
-        auto state2 = sensor.get_state();
-        REQUIRE(state2 == PF::Driver::I2C::SFM3019::StateMachine::Action::check_range);
-      }
-      time.set_micros(55200);
-      auto status3 = sensor.setup();
-      THEN("The third setup method call retuns ok status") {
-        REQUIRE(status3 == PF::InitializableState::ok);
-      }
-      THEN("After the third setup method call, get_state method returns wait_measurement action") {
-        auto state1 = sensor.get_state();
-        REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input1;
-      mock_device.get_write(input1.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input2;
-      mock_device.get_write(input2.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 "
-          "02](request_product_id),[36 61](read_conversion), [36 6A](set_averaging)and [36 03](O2 "
-          "gas)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-        REQUIRE(input1[0] == 0x36);
-        REQUIRE(input1[1] == 0x61);
-        REQUIRE(input2[0] == 0x36);
-        REQUIRE(input2[1] == 0x6A);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x01);
-        REQUIRE(input[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+        REQUIRE(sensor.get_state() == Action::request_conversion_factors);
+        REQUIRE(sensor.statistics(Action::read_product_id).faults == 1);
+        REQUIRE(sensor.statistics(Action::read_product_id).entries == 2);
       }
     }
   }
 }
 
-SCENARIO(
-    "The Sensor::setup method works correctly when mock read buffer is different than expected "
-    ",setup method retries for maximum allowed times and fails") {
-  // 4 invalid read product id , 1 valid read_product_id, 5 invalid read_conversion_factor and 1
-  // valid one.
-  // Exceeds max fault_counts, setup returns failed state
-  GIVEN(
-      "SFMC3019 sensor is created with mock I2C device with read buffer consisting 4 repetition "
-      "of[00 aa a6 a0 "
-      "00 7e 01 48 f1] bytes  (invalid read_product_id response) and [04 02 60 06 11 a9 00 00 "
-      "81](as "
-      "valid read_product_id response), as 5 repetition of [04 02 60 06 11 a9 00 00 81]bytes "
-      "(invalid "
-      "read_conversion_factor response) [00 aa a6 a0 00 7e 01 48 f1] (as valid "
-      "read_conversion_factor response )reseter is set to"
-      "false and mock time set to 100us, global device's mock write buffer is "
-      "set to [01] byte and read buffer is set to [01 02] bytes") {
+SCENARIO("SFM3019 Sensor retries setup when its conversion factors are wrong") {
+  GIVEN("A sensor whose device first responds with a wrong scale factor") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    PF::Driver::I2C::SFM3019::ConversionFactors conversion;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto read_buffer2 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer2.data(), read_buffer2.size(), write_status);
-    auto read_buffer3 =
-        PF::Util::Containers::make_array<uint8_t>(0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e);
-    mock_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    auto read_buffer4 =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer4.data(), read_buffer4.size(), write_status);
-    auto read_buffer5 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer5.data(), read_buffer5.size(), write_status);
-    auto read_buffer6 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer6.data(), read_buffer6.size(), write_status);
-    auto read_buffer8 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer8.data(), read_buffer8.size(), write_status);
-    auto read_buffer9 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer9.data(), read_buffer9.size(), write_status);
-    auto read_buffer10 = PF::Util::Containers::make_array<uint8_t>(
-        0x04, 0x02, 0x60, 0x06, 0x11, 0xa9, 0x00, 0x00, 0x81);
-    mock_device.add_read(read_buffer10.data(), read_buffer10.size(), write_status);
-    auto read_buffer7 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer7.data(), read_buffer7.size(), write_status);
-    auto read_buffer11 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer11.data(), read_buffer11.size(), write_status);
-
-    WHEN("The setup method is called once ,time is set to 100us before setup call") {
-      PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-      time.set_micros(100);
-      auto status = sensor.setup();
-      THEN("The first setup method call returns failed state") {
-        REQUIRE(status == PF::InitializableState::failed);
-      }
-      THEN("After first setup method call, get_state method returns initialize action") {
-        auto state = sensor.get_state();
-        REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::initialize);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-      size_t count = buffer_size;
-      mock_device.get_write(input_buffer.buffer(), count);
-      PF::Util::Containers::ByteVector<buffer_size> input;
-      mock_device.get_write(input.buffer(), count);
-      THEN(
-          "The mock_device I2C's write buffer contains command byte [E1 02](request_product_id) "
-          "and [36 61](read_conversion)") {
-        REQUIRE(input_buffer[0] == 0xE1);
-        REQUIRE(input_buffer[1] == 0x02);
-        REQUIRE(input[0] == 0x36);
-        REQUIRE(input[1] == 0x61);
-      }
-      THEN("The mock_device I2C's read buffer only contains [04 02 60 06 11 a9 00 00 81]") {
-        PF::Util::Containers::ByteVector<buffer_size> input;
-        auto read_status = mock_device.read(input.buffer(), 9);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input[0] == 0x04);
-        REQUIRE(input[1] == 0x02);
-        REQUIRE(input[2] == 0x60);
-        REQUIRE(input[3] == 0x06);
-        REQUIRE(input[4] == 0x11);
-        REQUIRE(input[5] == 0xa9);
-        REQUIRE(input[6] == 0x00);
-        REQUIRE(input[7] == 0x00);
-        REQUIRE(input[8] == 0x81);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    add_wrong_conversion_factors(mock_device);
+    add_conversion_factors(mock_device);
+
+    setup_at(sensor, time, 0);
+    for (size_t i = 0; i < 3; ++i) {
+      setup_at(sensor, time, 2000);
+    }
+    REQUIRE(sensor.get_state() == Action::read_conversion_factors);
+
+    WHEN("setup is called as each delay passes") {
+      auto fault = setup_at(sensor, time, 2020);
+      auto before_retry = setup_at(sensor, time, 3019);
+      auto retry = setup_at(sensor, time, 3020);
+      auto check = setup_at(sensor, time, 3040);
+
+      THEN("The conversion factors are requested again after 1 ms, and then accepted") {
+        REQUIRE(fault == PF::InitializableState::setup);
+        REQUIRE(before_retry == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::setup);
+        REQUIRE(check == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::set_averaging);
+        REQUIRE(sensor.statistics(Action::read_conversion_factors).faults == 1);
+        REQUIRE(sensor.statistics(Action::request_conversion_factors).entries == 2);
+        REQUIRE(next_command(mock_device) == request_product_id_command);
+        REQUIRE(next_command(mock_device) == read_conversion_command);
+        REQUIRE(next_command(mock_device) == read_conversion_command);
+        REQUIRE(next_command(mock_device) == 0);
       }
     }
   }
-}
 
-SCENARIO(
-    "The Sensor::output method works correctly for action cycles from wait_measurement - measure "
-    "-wait_measurement") {
-  GIVEN(
-      "SFMC3019 sensor is fully initialised by calling setup method until it returns ok and"
-      "action returns wait_measurement with the mock read buffer consisting of [97 38 1e 97 38"
-      "1e](as read_sample response) followed by junk bytes [01 02],  and with the mock time set"
-      " to 100us, global device's mock write buffer is set to [01] byte and read buffer is set to"
-      "[01 02] bytes and mock_device I2C's write buffer contains command byte [E1"
-      "02](request_product_id), [36 61](read_conversion), [36 6A](set_averaging) and [36 03](O2 "
-      "gas)") {
+  GIVEN("A sensor whose device never responds with the right conversion factors") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    float flow = 20.5;
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    time.set_micros(100);
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x97, 0x38, 0x1e);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x97, 0x38, 0x1e);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto junk_data = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(junk_data.data(), junk_data.size(), write_status);
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-    auto status = sensor.setup();
-    REQUIRE(status == PF::InitializableState::setup);
-    auto state = sensor.get_state();
-    REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    time.set_micros(40000);
-    auto status1 = sensor.setup();
-    REQUIRE(status1 == PF::InitializableState::setup);
-    for (size_t i = 0; i < 3; i++) {
-      auto status2 = sensor.setup();
-      REQUIRE(status2 == PF::InitializableState::ok);
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    for (size_t i = 0; i < 9; ++i) {
+      add_wrong_conversion_factors(mock_device);
     }
-    auto state1 = sensor.get_state();
-    REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    constexpr size_t buffer_size = 50UL;
-    PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-    size_t count = buffer_size;
-    mock_device.get_write(input_buffer.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input;
-    mock_device.get_write(input.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input1;
-    mock_device.get_write(input1.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input2;
-    mock_device.get_write(input2.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input3;
-    mock_device.get_write(input3.buffer(), count);
-    REQUIRE(input_buffer[0] == 0xE1);
-    REQUIRE(input_buffer[1] == 0x02);
-    REQUIRE(input[0] == 0x36);
-    REQUIRE(input[1] == 0x61);
-    REQUIRE(input1[0] == 0x36);
-    REQUIRE(input1[1] == 0x61);
-    REQUIRE(input2[0] == 0x36);
-    REQUIRE(input2[1] == 0x6A);
-    REQUIRE(input3[0] == 0x36);
-    REQUIRE(input3[1] == 0x03);
-
-    // Normal case, output returns ok state
-    // updates flow according to read buffer
-    WHEN(
-        "The output method is called thrice with mock time set to [40000,1000, 2000]us and output "
-        "parameter flow is initialized to 20.5") {
-      auto output_status = sensor.output(flow);
-      THEN("The first output method call returns ok state") {
-        REQUIRE(output_status == PF::InitializableState::ok);
-      }
-      THEN("After the first output method call, get_state method returns wait_measurement action") {
-        auto status = sensor.get_state();
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("The output parameter flow remains 20.5") { REQUIRE(flow == 20.5F); }
-      time.set_micros(1000);
-      for (size_t i = 0; i < 2; i++) {
-        auto output_status1 = sensor.output(flow);
-        THEN("The second output method call returns ok state") {
-          REQUIRE(output_status1 == PF::InitializableState::ok);
-        }
-      }
-      THEN(
-          "After the second output method call, get_state method returns wait_measurement action") {
-        auto status = sensor.get_state();
-        REQUIRE(status == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      }
-      THEN("The output parameter flow gets updated to -13.22353F value") {
-        REQUIRE(flow == -13.22353F);
-      }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer3;
-      size_t count = buffer_size;
-      auto status = mock_device.get_write(input_buffer3.buffer(), count);
-      THEN("The mock_device I2C's write buffer remains empty") {
-        REQUIRE(status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The mock_device I2C's read buffer only contains junk bytes [01 02]") {
-        auto read_status = mock_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
+
+    WHEN("setup is called every 10 ms until it stops making progress") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      for (size_t calls = 0; calls < 100 && status == PF::InitializableState::setup; ++calls) {
+        status = setup_at(sensor, time, static_cast<uint32_t>(10000 * calls));
       }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        size_t count = buffer_size;
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+
+      THEN("Setup fails without ever starting measurement") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::read_conversion_factors).faults == 9);
+        REQUIRE(sensor.statistics(Action::set_averaging).entries == 0);
+        REQUIRE(sensor.statistics(Action::start_measure).entries == 0);
       }
     }
   }
 }
 
-SCENARIO("The Sensor::output method works correctly, when sensor is partially initialized") {
-  GIVEN(
-      "SFMC3019 sensor is partially initialised by calling setup method once where it returns "
-      "setup state and get_state returns wait_warmup, with the mock read buffer consisting of [d5"
-      "64 4d](as "
-      "read_sample response) and with the mock time set to 500us, global device's"
-      "mock write "
-      "buffer is set to [01] byte and read buffer is set to [01 02] bytes and"
-      "mock_device I2C's write buffer contains command byte [E1 02](request_product_id), [36"
-      "61](read_conversion), [36 6A](set_averaging) and [36 03](O2 gas)") {
-    // Action is wait_warmup, output method remains in setup state
-    // flow does not get updated
+SCENARIO("SFM3019 Sensor checks that the flow is within range before setup finishes") {
+  GIVEN("A sensor whose first sample is out of range") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    float flow = 20.5;
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0xd5, 0x64, 0x4d);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    time.set_micros(500);
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-    sensor.setup();
-    // REQUIRE(status == PF::InitializableState::setup);
-    sensor.get_state();
-    // REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-    constexpr size_t buffer_size = 50UL;
-    PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-    size_t count = buffer_size;
-    mock_device.get_write(input_buffer.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input;
-    mock_device.get_write(input.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input1;
-    mock_device.get_write(input1.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input2;
-    mock_device.get_write(input2.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input3;
-    mock_device.get_write(input3.buffer(), count);
-    REQUIRE(input_buffer[0] == 0xE1);
-    REQUIRE(input_buffer[1] == 0x02);
-    REQUIRE(input[0] == 0x36);
-    REQUIRE(input[1] == 0x61);
-    REQUIRE(input1[0] == 0x36);
-    REQUIRE(input1[1] == 0x61);
-    REQUIRE(input2[0] == 0x36);
-    REQUIRE(input2[1] == 0x6A);
-    REQUIRE(input3[0] == 0x36);
-    REQUIRE(input3[1] == 0x03);
-
-    WHEN(
-        "The output method is called once, mock time is set to 250us and output parameter flow is "
-        "initialized to 20.5") {
-      time.set_micros(250);
-      sensor.output(flow);
-      THEN("The output method returns setup state") {
-        // REQUIRE(output_status == PF::InitializableState::setup);
-      }
-      THEN("After  output method call, get_state method returns wait_warmup action") {
-        auto status1 = sensor.get_state();
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-      }
-      THEN("The output parameter flow remains 20.5") { REQUIRE(flow == 20.5F); }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer3;
-      size_t count = buffer_size;
-      auto status = mock_device.get_write(input_buffer3.buffer(), count);
-      THEN("The mock_device I2C's write buffer remains empty") {
-        REQUIRE(status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The mock_device I2C's read buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        auto read_status = mock_device.read(input_buffer1.buffer(), 3);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer1[0] == 0xd5);
-        REQUIRE(input_buffer1[1] == 0x64);
-        REQUIRE(input_buffer1[2] == 0x4d);
-      }
-      THEN("The global_device I2C's read buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        size_t count = buffer_size;
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    add_conversion_factors(mock_device);
+    add_out_of_range_sample(mock_device);
+    add_sample(mock_device);
+
+    setup_at(sensor, time, 0);
+    for (size_t i = 0; i < 3; ++i) {
+      setup_at(sensor, time, 2000);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      setup_at(sensor, time, 2020);
+    }
+    REQUIRE(sensor.get_state() == Action::check_range);
+
+    WHEN("setup is called after warm-up") {
+      auto status = setup_at(sensor, time, 32020);
+
+      THEN("The range check is retried after another warm-up period") {
+        REQUIRE(status == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::check_range);
+        REQUIRE(sensor.statistics(Action::check_range).faults == 1);
+        REQUIRE(setup_at(sensor, time, 62019) == PF::InitializableState::setup);
+        REQUIRE(setup_at(sensor, time, 62020) == PF::InitializableState::ok);
+        REQUIRE(sensor.get_state() == Action::measure);
       }
     }
   }
 }
 
-// read_sample data is incorrect, output should return failed state
-SCENARIO("The Sensor::output method works correctly when read buffer is not as expected") {
-  GIVEN(
-      "SFMC3019 sensor is fully initialised by calling setup method until it returns ok and"
-      "action returns wait_measurement with the mock read buffer consisting of 8 repition of[0f"
-      "80 4b](as invalid read_sample response) followed by junk bytes [01 02],  and with the"
-      "mock time set to 100us, global device's mock write buffer is set to [01] byte and read "
-      "buffer is set to "
-      "[01 02]and mock_device I2C's write buffer contains command byte [E1 "
-      "02](request_product_id), [36 61](read_conversion), [36 6A](set_averaging) and [36 03](O2 "
-      "gas)") {
+SCENARIO("SFM3019 Sensor measures the flow at its measuring interval") {
+  GIVEN("A sensor which hasn't been set up") {
     PF::HAL::Mock::I2CDevice mock_device;
     PF::HAL::Mock::I2CDevice global_device;
-    auto write_status = PF::I2CDeviceStatus::ok;
-    mock_device.add_write_status(write_status);
-    global_device.add_write_status(write_status);
-    float flow = 20.5;
-    PF::Driver::I2C::SFM3019::GasType gas = PF::Driver::I2C::SFM3019::GasType::o2;
-    PF::Driver::I2C::SFM3019::Device device{mock_device, global_device, gas};
+    SFM3019::Device device{mock_device, global_device, SFM3019::GasType::o2};
     PF::HAL::Mock::Time time;
-    time.set_micros(40000);
-    auto read_buffer =
-        PF::Util::Containers::make_array<uint8_t>(0x04, 0x02, 0x60, 0x06, 0x11, 0xa9);
-    mock_device.add_read(read_buffer.data(), read_buffer.size(), write_status);
-    auto read_buffer1 = PF::Util::Containers::make_array<uint8_t>(
-        0x00, 0xaa, 0xa6, 0xa0, 0x00, 0x7e, 0x01, 0x48, 0xf1);
-    mock_device.add_read(read_buffer1.data(), read_buffer1.size(), write_status);
-    auto input_data = PF::Util::Containers::make_array<uint8_t>(0x97, 0x38, 0x1e);
-    mock_device.add_read(input_data.data(), input_data.size(), write_status);
-    auto input_data1 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(input_data1.data(), input_data1.size(), write_status);
-    auto junk_data = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data.data(), junk_data.size(), write_status);
-    auto junk_data2 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data2.data(), junk_data2.size(), write_status);
-    auto junk_data3 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data3.data(), junk_data3.size(), write_status);
-    auto junk_data4 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data4.data(), junk_data4.size(), write_status);
-    auto junk_data5 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data5.data(), junk_data5.size(), write_status);
-    auto junk_data6 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data6.data(), junk_data6.size(), write_status);
-    auto junk_data7 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data7.data(), junk_data7.size(), write_status);
-    auto junk_data8 = PF::Util::Containers::make_array<uint8_t>(0x0f, 0x80, 0x4b);
-    mock_device.add_read(junk_data8.data(), junk_data8.size(), write_status);
-    auto junk_data9 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    mock_device.add_read(junk_data9.data(), junk_data9.size(), write_status);
-    auto read_buffer3 = PF::Util::Containers::make_array<uint8_t>(0x01, 0x02);
-    global_device.add_read(read_buffer3.data(), read_buffer3.size(), write_status);
-
-    PF::Driver::I2C::SFM3019::StateMachine state_machine;
-    PF::Driver::I2C::SFM3019::Sensor sensor{device, false, time};
-    sensor.setup();
-    // REQUIRE(status == PF::InitializableState::setup);
-    sensor.get_state();
-    // REQUIRE(state == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_warmup);
-    time.set_micros(85000);
-    sensor.setup();
-    // REQUIRE(status1 == PF::InitializableState::setup);
-    time.set_micros(70000);
-    for (size_t i = 0; i < 3; i++) {
-      sensor.setup();
-      // REQUIRE(status2 == PF::InitializableState::ok);
-    }
-    sensor.get_state();
-    // REQUIRE(state1 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-    constexpr size_t buffer_size = 50UL;
-    PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-    size_t count = buffer_size;
-    mock_device.get_write(input_buffer.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input;
-    mock_device.get_write(input.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input1;
-    mock_device.get_write(input1.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input2;
-    mock_device.get_write(input2.buffer(), count);
-    PF::Util::Containers::ByteVector<buffer_size> input3;
-    mock_device.get_write(input3.buffer(), count);
-    REQUIRE(input_buffer[0] == 0xE1);
-    REQUIRE(input_buffer[1] == 0x02);
-    REQUIRE(input[0] == 0x36);
-    REQUIRE(input[1] == 0x61);
-    REQUIRE(input1[0] == 0x36);
-    REQUIRE(input1[1] == 0x61);
-    REQUIRE(input2[0] == 0x36);
-    REQUIRE(input2[1] == 0x6A);
-    REQUIRE(input3[0] == 0x36);
-    REQUIRE(input3[1] == 0x03);
-
-    // read buffer for read_sample is wrong, returns failed state
-    // flow remains same
-    // Action returns measure
-    WHEN(
-        "The output method is called eighteen times with mock time set to [1000, 1500, 2000,2500,"
-        "3000, 3500, 4000, 4500, 5000]us and output parameter flow is initialized to 20.5") {
-      auto output_status0 = sensor.output(flow);
-      sensor.get_state();
-      // REQUIRE(status0 == PF::Driver::I2C::SFM3019::StateMachine::Action::wait_measurement);
-      time.set_micros(1000);
-      auto output_status1 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status2 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(1500);
-      auto output_status3 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status4 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(2000);
-      auto output_status5 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status6 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(2500);
-      auto output_status7 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status8 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(3000);
-      auto output_status9 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status10 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(3500);
-      auto output_status11 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status12 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(4000);
-      auto output_status13 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status14 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(4500);
-      auto output_status15 = sensor.output(flow);
-      sensor.get_state();
-      auto output_status16 = sensor.output(flow);
-      sensor.get_state();
-      time.set_micros(5000);
-      auto output_status17 = sensor.output(flow);
-      sensor.get_state();
-      THEN("Each of eighteen output method calls return ok state") {
-        REQUIRE(output_status0 == PF::InitializableState::ok);
-        REQUIRE(output_status1 == PF::InitializableState::ok);
-        REQUIRE(output_status2 == PF::InitializableState::ok);
-        REQUIRE(output_status3 == PF::InitializableState::ok);
-        REQUIRE(output_status4 == PF::InitializableState::ok);
-        REQUIRE(output_status5 == PF::InitializableState::ok);
-        REQUIRE(output_status6 == PF::InitializableState::ok);
-        REQUIRE(output_status7 == PF::InitializableState::ok);
-        REQUIRE(output_status8 == PF::InitializableState::ok);
-        REQUIRE(output_status9 == PF::InitializableState::ok);
-        REQUIRE(output_status10 == PF::InitializableState::ok);
-        REQUIRE(output_status11 == PF::InitializableState::ok);
-        REQUIRE(output_status12 == PF::InitializableState::ok);
-        REQUIRE(output_status13 == PF::InitializableState::ok);
-        REQUIRE(output_status14 == PF::InitializableState::ok);
-        REQUIRE(output_status15 == PF::InitializableState::ok);
-        REQUIRE(output_status16 == PF::InitializableState::ok);
-        REQUIRE(output_status17 == PF::InitializableState::ok);
-      }
-      THEN("After each of thoese output method calls, output parameter flow remains 20.5") {
-        REQUIRE(flow == 20.5F);
-      }
-      time.set_micros(5500);
-      auto output_status18 = sensor.output(flow);
-      THEN("The 19th output method call returns failed state") {
-        REQUIRE(output_status18 == PF::InitializableState::failed);
-      }
-      THEN("After the 19th output method call, get_state method returns measure action") {
-        auto status1 = sensor.get_state();
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
-      time.set_micros(5500);
-      auto output_status19 = sensor.output(flow);
-      THEN("The 20th output method call returns failed state") {
-        REQUIRE(output_status19 == PF::InitializableState::failed);
-      }
-      THEN("After the 20th output method call, get_state method returns measure action") {
-        auto status1 = sensor.get_state();
-        REQUIRE(status1 == PF::Driver::I2C::SFM3019::StateMachine::Action::measure);
-      }
+    SFM3019::Sensor sensor{device, false, time};
+    add_product_id(mock_device);
+    add_conversion_factors(mock_device);
+    add_sample(mock_device);
 
-      THEN("The output parameter flow remains 20.5") { REQUIRE(flow == 20.5F); }
-      constexpr size_t buffer_size = 50UL;
-      PF::Util::Containers::ByteVector<buffer_size> input_buffer3;
-      size_t count = buffer_size;
-      auto status = mock_device.get_write(input_buffer3.buffer(), count);
-      THEN("The mock_device I2C's write buffer remains unchanged") {
-        REQUIRE(status == PF::I2CDeviceStatus::no_new_data);
-      }
-      THEN("The mock_device I2C's read buffer is empty") {
-        auto read_status = mock_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
-      }
-      THEN("The global_device I2C's read buffer reamains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer;
-        auto read_status = global_device.read(input_buffer.buffer(), 2);
-        REQUIRE(read_status == PF::I2CDeviceStatus::ok);
-        REQUIRE(input_buffer[0] == 0x01);
-        REQUIRE(input_buffer[1] == 0x02);
+    WHEN("output is called") {
+      float flow = -1;
+      auto status = sensor.output(flow);
+
+      THEN("It fails without changing the flow") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(flow == -1);
       }
-      THEN("The global_device I2C's write buffer remains unchanged") {
-        constexpr size_t buffer_size = 254UL;
-        PF::Util::Containers::ByteVector<buffer_size> input_buffer1;
-        size_t count = buffer_size;
-        PF::Util::Containers::ByteVector<buffer_size> global_buffer;
-        auto input_data = PF::Util::Containers::make_array<uint8_t>(0x01);
-        global_device.write(input_data.data(), input_data.size());
-        global_device.get_write(global_buffer.buffer(), count);
-        REQUIRE(global_buffer[0] == 0x01);
+    }
+
+    WHEN("The sensor has been set up") {
+      setup_at(sensor, time, 0);
+      for (size_t i = 0; i < 3; ++i) {
+        setup_at(sensor, time, 2000);
+      }
+      for (size_t i = 0; i < 3; ++i) {
+        setup_at(sensor, time, 2020);
+      }
+      REQUIRE(setup_at(sensor, time, 32020) == PF::InitializableState::ok);
+      add_sample(mock_device);
+      float flow = -1;
+
+      THEN("The flow is only read once the measuring interval has passed") {
+        time.set_micros(32519);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == -1);
+        time.set_micros(32520);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == Approx(3.0118).epsilon(0.001));
+        REQUIRE(sensor.get_state() == Action::measure);
+        REQUIRE(sensor.statistics(Action::measure).entries == 2);
+      }
+
+      THEN("A sample which fails its CRC check is skipped without changing the flow") {
+        time.set_micros(32520);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        add_corrupted_sample(mock_device);
+        add_sample(mock_device);
+        flow = -1;
+        time.set_micros(33020);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == -1);
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+        time.set_micros(33519);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == -1);
+        time.set_micros(33520);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == Approx(3.0118).epsilon(0.001));
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+      }
+
+      THEN("A failed read is skipped without changing the flow") {
+        time.set_micros(32520);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        auto read_buffer = make_array<uint8_t>(0xa2, 0x00, 0xa7);
+        mock_device.add_read(
+            read_buffer.data(), read_buffer.size(), PF::I2CDeviceStatus::read_error);
+        flow = -1;
+        time.set_micros(33020);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        REQUIRE(flow == -1);
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+      }
+
+      THEN("Output fails after more than 8 faulty measurements in a row") {
+        uint32_t current_time = 32520;
+        time.set_micros(current_time);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        for (size_t i = 0; i < 8; ++i) {
+          current_time += 500;
+          time.set_micros(current_time);
+          REQUIRE(sensor.output(flow) == PF::InitializableState::ok);
+        }
+        current_time += 500;
+        time.set_micros(current_time);
+        REQUIRE(sensor.output(flow) == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::measure).faults == 9);
       }
     }
   }
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Initializable.cpp
+ *
+ * Unit tests to confirm behavior of Initializables
+ *
+ */
+#include "Pufferfish/Driver/Initializable.h"
+
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::InitializableState;
+
+namespace {
+
+// Becomes ok or failed at a given time, without blocking before then
+class TimedSetup : public PF::Driver::Initializable {
+ public:
+  TimedSetup(PF::HAL::Mock::Time &time, uint32_t finish_time, InitializableState result)
+      : time_(time), finish_time_(finish_time), result_(result) {}
+
+  InitializableState setup() override {
+    ++steps;
+    if (time_.millis() < finish_time_) {
+      return InitializableState::setup;
+    }
+    return result_;
+  }
+
+  size_t steps = 0;
+
+ private:
+  PF::HAL::Mock::Time &time_;
+  uint32_t finish_time_;
+  InitializableState result_;
+};
+
+// Runs setup every 10 ms until nothing is in progress, and returns the time it stopped at
+template <size_t size>
+uint32_t run_setup(
+    PF::Driver::Initializables<size> &initializables,
+    PF::HAL::Mock::Time &time,
+    uint32_t start_time) {
+  uint32_t current_time = start_time;
+  while (true) {
+    time.set_millis(current_time);
+    initializables.setup(current_time);
+    if (!initializables.setup_in_progress()) {
+      return current_time;
+    }
+    current_time += 10;
+  }
+}
+
+}  // namespace
+
+SCENARIO("Initializables sets up all hardware concurrently") {
+  GIVEN("Three initializables which take different times to become ready") {
+    PF::HAL::Mock::Time time;
+    TimedSetup fast(time, 100, InitializableState::ok);
+    TimedSetup slow(time, 300, InitializableState::ok);
+    TimedSetup medium(time, 200, InitializableState::ok);
+    auto initializables = PF::Driver::make_initializables(1000, fast, slow, medium);
+
+    WHEN("setup is called until nothing is in progress") {
+      uint32_t end_time = run_setup(initializables, time, 0);
+
+      THEN("Setup finishes when the slowest one is ready") {
+        REQUIRE(end_time == 300);
+        REQUIRE(!initializables.setup_failed());
+        REQUIRE(initializables.setup_duration() == 300);
+      }
+
+      THEN("The time to ready of each one is recorded") {
+        REQUIRE(initializables.progress(0).time_to_ready == 100);
+        REQUIRE(initializables.progress(1).time_to_ready == 300);
+        REQUIRE(initializables.progress(2).time_to_ready == 200);
+        REQUIRE(initializables.progress(1).state == InitializableState::ok);
+      }
+
+      THEN("Each one isn't stepped again after it's ready") {
+        REQUIRE(fast.steps == 11);
+        REQUIRE(medium.steps == 21);
+        REQUIRE(slow.steps == 31);
+      }
+    }
+  }
+
+  GIVEN("An initializable which fails while another is still in progress") {
+    PF::HAL::Mock::Time time;
+    TimedSetup failing(time, 50, InitializableState::failed);
+    TimedSetup slow(time, 200, InitializableState::ok);
+    auto initializables = PF::Driver::make_initializables(1000, failing, slow);
+
+    WHEN("setup is called until nothing is in progress") {
+      run_setup(initializables, time, 0);
+
+      THEN("The other one still finishes its setup") {
+        REQUIRE(initializables.setup_failed());
+        REQUIRE(initializables.progress(0).state == InitializableState::failed);
+        REQUIRE(!initializables.progress(0).timed_out);
+        REQUIRE(initializables.progress(0).time_to_ready == 50);
+        REQUIRE(initializables.progress(1).state == InitializableState::ok);
+        REQUIRE(failing.steps == 6);
+      }
+    }
+  }
+}
+
+SCENARIO("Initializables fails hardware which isn't ready by its timeout") {
+  GIVEN("An initializable which is slower than its own timeout, and one with the default") {
+    PF::HAL::Mock::Time time;
+    TimedSetup slow(time, 500, InitializableState::ok);
+    TimedSetup other(time, 500, InitializableState::ok);
+    auto initializables = PF::Driver::make_initializables(1000, slow, other);
+    initializables.set_timeout(0, 250);
+
+    WHEN("setup is called until nothing is in progress") {
+      uint32_t end_time = run_setup(initializables, time, 0);
+
+      THEN("Only the one with the shorter timeout fails, at its timeout") {
+        REQUIRE(end_time == 500);
+        REQUIRE(initializables.setup_failed());
+        REQUIRE(initializables.progress(0).state == InitializableState::failed);
+        REQUIRE(initializables.progress(0).timed_out);
+        REQUIRE(initializables.progress(0).time_to_ready == 250);
+        REQUIRE(initializables.progress(1).state == InitializableState::ok);
+        REQUIRE(!initializables.progress(1).timed_out);
+      }
+    }
+  }
+
+  GIVEN("An initializable with no timeout") {
+    PF::HAL::Mock::Time time;
+    TimedSetup slow(time, 5000, InitializableState::ok);
+    auto initializables = PF::Driver::make_initializables(0, slow);
+
+    WHEN("setup is called until nothing is in progress") {
+      run_setup(initializables, time, 0);
+
+      THEN("It's allowed to take as long as it needs") {
+        REQUIRE(initializables.progress(0).state == InitializableState::ok);
+        REQUIRE(initializables.setup_duration() == 5000);
+      }
+    }
+  }
+}
+
+SCENARIO("Initializables reports its setup progress in the MCU diagnostics") {
+  GIVEN("One initializable which becomes ok, one which fails, and one which times out") {
+    PF::HAL::Mock::Time time;
+    TimedSetup ok(time, 300, InitializableState::ok);
+    TimedSetup failed(time, 100, InitializableState::failed);
+    TimedSetup slow(time, 5000, InitializableState::ok);
+    auto initializables = PF::Driver::make_initializables(1000, ok, failed, slow);
+    run_setup(initializables, time, 0);
+
+    WHEN("The progress is output to MCU diagnostics which have other fields set") {
+      PF::Application::MCUDiagnostics diagnostics{};
+      diagnostics.stack_size = 1024;
+      diagnostics.setups_failed = 0xff;
+      initializables.output(diagnostics);
+
+      THEN("The setup duration and the progress of each initializable are reported") {
+        REQUIRE(diagnostics.setup_duration == 1000);
+        REQUIRE(diagnostics.setups_failed == 0x6);
+        REQUIRE(diagnostics.setups_timed_out == 0x4);
+        REQUIRE(diagnostics.times_to_ready_count == 3);
+        REQUIRE(diagnostics.times_to_ready[0] == 300);
+        REQUIRE(diagnostics.times_to_ready[1] == 100);
+        REQUIRE(diagnostics.times_to_ready[2] == 1000);
+      }
+
+      THEN("The other fields are unchanged") { REQUIRE(diagnostics.stack_size == 1024); }
+    }
+  }
+}
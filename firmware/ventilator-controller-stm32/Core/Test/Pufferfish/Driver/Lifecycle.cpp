@@ -0,0 +1,277 @@
+/// Lifecycle.cpp
+/// Unit tests to confirm behavior of the table-driven sensor lifecycle.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/Lifecycle.h"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::InitializableState;
+using PF::Driver::StepStatus;
+
+namespace {
+
+enum class State { request, check, measure };
+
+constexpr PF::Driver::RetryPolicy setup_retries{2, 5, 20};
+constexpr PF::Driver::RetryPolicy measure_retries{1, 0, 0};
+
+constexpr std::array<PF::Driver::LifecycleState<State>, 3> table{{
+    {State::request,
+     InitializableState::setup,
+     0,
+     0,
+     State::check,
+     State::request,
+     setup_retries},
+    {State::check,
+     InitializableState::setup,
+     0,
+     50,
+     State::measure,
+     State::request,
+     setup_retries},
+    {State::measure,
+     InitializableState::ok,
+     10,
+     0,
+     State::measure,
+     State::measure,
+     measure_retries},
+}};
+static_assert(PF::Driver::valid_lifecycle(table), "The test table must be valid");
+
+// Runs steps with results given in advance, and records which states they were run in
+class ScriptedSteps {
+ public:
+  explicit ScriptedSteps(std::vector<StepStatus> results) : results_(std::move(results)) {}
+
+  StepStatus operator()(State state) {
+    states.push_back(state);
+    if (next_ >= results_.size()) {
+      return StepStatus::waiting;
+    }
+    return results_[next_++];
+  }
+
+  std::vector<State> states;
+
+ private:
+  std::vector<StepStatus> results_;
+  size_t next_ = 0;
+};
+
+}  // namespace
+
+SCENARIO("valid_lifecycle checks the layout of a transition table") {
+  GIVEN("A table whose rows aren't in the order of their states") {
+    constexpr std::array<PF::Driver::LifecycleState<State>, 2> swapped{{
+        {State::check,
+         InitializableState::setup,
+         0,
+         0,
+         State::request,
+         State::request,
+         setup_retries},
+        {State::request,
+         InitializableState::setup,
+         0,
+         0,
+         State::check,
+         State::check,
+         setup_retries},
+    }};
+
+    WHEN("The table is checked") {
+      constexpr bool valid = PF::Driver::valid_lifecycle(swapped);
+
+      THEN("It isn't valid") { REQUIRE(!valid); }
+    }
+  }
+}
+
+SCENARIO("Lifecycle runs one step per call and follows the transition table") {
+  GIVEN("A lifecycle whose steps are all done") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps({StepStatus::done, StepStatus::done, StepStatus::done});
+
+    WHEN("output is called before setup") {
+      auto status = lifecycle.output(0, steps);
+
+      THEN("It fails without running a step") {
+        REQUIRE(status == InitializableState::failed);
+        REQUIRE(steps.states.empty());
+      }
+    }
+
+    WHEN("setup is called until the measurement phase is reached") {
+      auto first = lifecycle.setup(0, steps);
+      auto second = lifecycle.setup(1, steps);
+      auto third = lifecycle.setup(2, steps);
+
+      THEN("Each call runs the step of the next state") {
+        REQUIRE(first == InitializableState::setup);
+        REQUIRE(second == InitializableState::ok);
+        REQUIRE(third == InitializableState::ok);
+        REQUIRE(steps.states == std::vector<State>{State::request, State::check});
+        REQUIRE(lifecycle.state() == State::measure);
+        REQUIRE(lifecycle.phase() == InitializableState::ok);
+      }
+
+      THEN("Measurement steps only run once the state's delay has passed") {
+        lifecycle.setup(2, steps);
+        REQUIRE(lifecycle.output(10, steps) == InitializableState::ok);
+        REQUIRE(steps.states.size() == 2);
+        REQUIRE(lifecycle.output(11, steps) == InitializableState::ok);
+        REQUIRE(steps.states.size() == 3);
+        REQUIRE(steps.states.back() == State::measure);
+        REQUIRE(lifecycle.statistics(State::measure).entries == 2);
+        REQUIRE(lifecycle.statistics(State::measure).total_time == 10);
+      }
+    }
+  }
+}
+
+SCENARIO("Lifecycle retries states after timeouts and faults") {
+  GIVEN("A lifecycle whose check step doesn't get a response in time") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps({StepStatus::done});
+    lifecycle.setup(100, steps);
+
+    WHEN("setup is called until the timeout passes") {
+      auto before_timeout = lifecycle.setup(149, steps);
+      auto state_before_timeout = lifecycle.state();
+      auto at_timeout = lifecycle.setup(150, steps);
+
+      THEN("The retry state is entered, and is run once the backoff has passed") {
+        REQUIRE(before_timeout == InitializableState::setup);
+        REQUIRE(state_before_timeout == State::check);
+        REQUIRE(at_timeout == InitializableState::setup);
+        REQUIRE(lifecycle.state() == State::request);
+        REQUIRE(lifecycle.statistics(State::check).faults == 1);
+        REQUIRE(lifecycle.statistics(State::check).max_time == 50);
+        size_t num_steps = steps.states.size();
+        lifecycle.setup(154, steps);
+        REQUIRE(steps.states.size() == num_steps);
+        lifecycle.setup(155, steps);
+        REQUIRE(steps.states.size() == num_steps + 1);
+      }
+    }
+  }
+
+  GIVEN("A lifecycle whose check step keeps faulting, although its request step is done") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps(
+        {StepStatus::done,
+         StepStatus::fault,
+         StepStatus::done,
+         StepStatus::fault,
+         StepStatus::done,
+         StepStatus::fault});
+
+    WHEN("setup is called every 100 ms") {
+      std::vector<InitializableState> statuses;
+      for (uint32_t time = 0; time < 600; time += 100) {
+        statuses.push_back(lifecycle.setup(time, steps));
+      }
+
+      THEN("Faults are counted over all setup steps, and setup fails after the third") {
+        REQUIRE(statuses[4] == InitializableState::setup);
+        REQUIRE(statuses[5] == InitializableState::failed);
+        REQUIRE(lifecycle.phase() == InitializableState::failed);
+        REQUIRE(lifecycle.setup(600, steps) == InitializableState::failed);
+        REQUIRE(steps.states.size() == 6);
+      }
+    }
+  }
+
+  GIVEN("A lifecycle in the measurement phase whose measurements fault") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps(
+        {StepStatus::done,
+         StepStatus::done,
+         StepStatus::fault,
+         StepStatus::done,
+         StepStatus::fault,
+         StepStatus::fault});
+    lifecycle.setup(0, steps);
+    lifecycle.setup(0, steps);
+
+    WHEN("output is called after every measurement delay") {
+      std::vector<InitializableState> statuses;
+      for (uint32_t time = 10; time <= 40; time += 10) {
+        statuses.push_back(lifecycle.output(time, steps));
+      }
+
+      THEN("Faults are only counted between measurements") {
+        REQUIRE(statuses[0] == InitializableState::ok);
+        REQUIRE(statuses[1] == InitializableState::ok);
+        REQUIRE(statuses[2] == InitializableState::ok);
+        REQUIRE(statuses[3] == InitializableState::failed);
+        REQUIRE(lifecycle.statistics(State::measure).faults == 3);
+      }
+    }
+  }
+
+  GIVEN("A lifecycle whose first step fails irrecoverably") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps({StepStatus::failed});
+
+    WHEN("setup is called") {
+      auto status = lifecycle.setup(0, steps);
+
+      THEN("The lifecycle fails without retrying") {
+        REQUIRE(status == InitializableState::failed);
+        REQUIRE(lifecycle.setup(1000, steps) == InitializableState::failed);
+        REQUIRE(steps.states.size() == 1);
+        REQUIRE(lifecycle.statistics(State::request).faults == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("Lifecycle can be restarted after it has failed") {
+  GIVEN("A lifecycle whose first step failed") {
+    PF::Driver::Lifecycle<State, 3> lifecycle(table);
+    ScriptedSteps steps({StepStatus::failed, StepStatus::done, StepStatus::done});
+    lifecycle.setup(0, steps);
+
+    WHEN("The lifecycle is reset and setup is called again") {
+      lifecycle.reset();
+      auto state_after_reset = lifecycle.state();
+      auto phase_after_reset = lifecycle.phase();
+      lifecycle.setup(100, steps);
+      auto status = lifecycle.setup(101, steps);
+
+      THEN("Setup restarts from the first state, and statistics are kept") {
+        REQUIRE(state_after_reset == State::request);
+        REQUIRE(phase_after_reset == InitializableState::setup);
+        REQUIRE(status == InitializableState::ok);
+        REQUIRE(
+            steps.states == std::vector<State>{State::request, State::request, State::check});
+        REQUIRE(lifecycle.statistics(State::request).entries == 2);
+      }
+    }
+  }
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2020, the Pez Globo team and the Pufferfish project contributors
+ *
+ * Reconnector.cpp
+ *
+ * Unit tests to confirm behavior of Reconnector
+ *
+ */
+#include "Pufferfish/Driver/Reconnector.h"
+
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::InitializableState;
+using State = PF::Driver::Reconnector::State;
+
+namespace {
+
+// Returns setup results given in advance, and repeats the last one afterwards
+class ScriptedDevice : public PF::Driver::Reconnectable {
+ public:
+  explicit ScriptedDevice(std::vector<InitializableState> results) : results_(std::move(results)) {}
+
+  InitializableState setup() override {
+    ++setups;
+    if (next_ + 1 < results_.size()) {
+      return results_[next_++];
+    }
+    return results_.back();
+  }
+
+  void reconnect() override { ++reconnects; }
+
+  size_t setups = 0;
+  size_t reconnects = 0;
+
+ private:
+  std::vector<InitializableState> results_;
+  size_t next_ = 0;
+};
+
+const uint32_t initial_backoff = 100;
+const uint32_t max_backoff = 300;
+const uint32_t attempt_timeout = 1000;
+
+}  // namespace
+
+SCENARIO("Reconnector leaves a connected device alone") {
+  GIVEN("A device which has finished setup") {
+    ScriptedDevice device({InitializableState::ok});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+
+    WHEN("update is called repeatedly") {
+      std::vector<InitializableState> statuses;
+      for (uint32_t time = 0; time < 50; time += 10) {
+        statuses.push_back(reconnector.update(time));
+      }
+
+      THEN("The device stays connected and isn't reconnected") {
+        REQUIRE(statuses == std::vector<InitializableState>(5, InitializableState::ok));
+        REQUIRE(reconnector.state() == State::connected);
+        REQUIRE(device.reconnects == 0);
+        REQUIRE(reconnector.statistics().disconnections == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("Reconnector doesn't report a device as connected before it has finished setup") {
+  GIVEN("A device which hasn't finished setup") {
+    ScriptedDevice device({InitializableState::setup});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+
+    WHEN("update is called repeatedly") {
+      std::vector<InitializableState> statuses;
+      for (uint32_t time = 0; time < 50; time += 10) {
+        statuses.push_back(reconnector.update(time));
+      }
+
+      THEN("The device is reported as still in setup, and isn't reconnected") {
+        REQUIRE(statuses == std::vector<InitializableState>(5, InitializableState::setup));
+        REQUIRE(reconnector.status() == InitializableState::setup);
+        REQUIRE(device.reconnects == 0);
+        REQUIRE(reconnector.statistics().disconnections == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("Reconnector restarts the setup of a failed device") {
+  GIVEN("A device which fails, and then finishes setup two steps after it's reconnected") {
+    ScriptedDevice device(
+        {InitializableState::ok,
+         InitializableState::failed,
+         InitializableState::setup,
+         InitializableState::ok});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+    reconnector.update(0);
+
+    WHEN("update is called after the failure until the backoff has passed") {
+      auto at_failure = reconnector.update(1000);
+      auto state_at_failure = reconnector.state();
+      auto before_backoff = reconnector.update(1099);
+      auto reconnects_before_backoff = device.reconnects;
+      auto at_backoff = reconnector.update(1100);
+
+      THEN("Setup is only restarted once the backoff has passed") {
+        REQUIRE(at_failure == InitializableState::failed);
+        REQUIRE(state_at_failure == State::backing_off);
+        REQUIRE(before_backoff == InitializableState::failed);
+        REQUIRE(reconnects_before_backoff == 0);
+        REQUIRE(at_backoff == InitializableState::failed);
+        REQUIRE(device.reconnects == 1);
+        REQUIRE(reconnector.state() == State::reconnecting);
+      }
+
+      THEN("Setup runs one step per update, until the device is connected again") {
+        REQUIRE(reconnector.update(1110) == InitializableState::failed);
+        REQUIRE(reconnector.update(1120) == InitializableState::ok);
+        REQUIRE(reconnector.state() == State::connected);
+        REQUIRE(device.setups == 4);
+      }
+
+      THEN("The latency of the reconnection is recorded") {
+        reconnector.update(1110);
+        reconnector.update(1120);
+        const auto &statistics = reconnector.statistics();
+        REQUIRE(statistics.disconnections == 1);
+        REQUIRE(statistics.attempts == 1);
+        REQUIRE(statistics.reconnections == 1);
+        REQUIRE(statistics.last_latency == 120);
+        REQUIRE(statistics.max_latency == 120);
+      }
+    }
+  }
+
+  GIVEN("A device which keeps failing setup") {
+    ScriptedDevice device({InitializableState::failed});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+
+    WHEN("update is called every 10 ms") {
+      std::vector<uint32_t> attempt_times;
+      for (uint32_t time = 0; time <= 1500; time += 10) {
+        size_t reconnects = device.reconnects;
+        reconnector.update(time);
+        if (device.reconnects != reconnects) {
+          attempt_times.push_back(time);
+        }
+      }
+
+      THEN("The backoff between attempts doubles, up to its maximum") {
+        REQUIRE(attempt_times == std::vector<uint32_t>{100, 310, 620, 930, 1240});
+        REQUIRE(reconnector.statistics().reconnections == 0);
+      }
+    }
+  }
+
+  GIVEN("A device which is disconnected again after it's been reconnected") {
+    ScriptedDevice device(
+        {InitializableState::failed,
+         InitializableState::failed,
+         InitializableState::ok,
+         InitializableState::failed,
+         InitializableState::ok});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+
+    WHEN("update is called every 10 ms") {
+      for (uint32_t time = 0; time <= 1000; time += 10) {
+        reconnector.update(time);
+      }
+
+      THEN("The backoff restarts from its initial value") {
+        const auto &statistics = reconnector.statistics();
+        REQUIRE(statistics.disconnections == 2);
+        REQUIRE(statistics.attempts == 3);
+        REQUIRE(statistics.reconnections == 2);
+        REQUIRE(statistics.last_latency == 110);
+        REQUIRE(statistics.max_latency == 320);
+      }
+    }
+  }
+
+  GIVEN("A device whose setup never finishes after it's reconnected") {
+    ScriptedDevice device({InitializableState::failed, InitializableState::setup});
+    PF::Driver::Reconnector reconnector(device, initial_backoff, max_backoff, attempt_timeout);
+    reconnector.update(0);
+    reconnector.update(100);
+
+    WHEN("update is called until the attempt times out") {
+      reconnector.update(1099);
+      auto state_before_timeout = reconnector.state();
+      reconnector.update(1100);
+
+      THEN("The attempt is abandoned and retried after a backoff") {
+        REQUIRE(state_before_timeout == State::reconnecting);
+        REQUIRE(reconnector.state() == State::backing_off);
+        reconnector.update(1299);
+        REQUIRE(device.reconnects == 1);
+        reconnector.update(1300);
+        REQUIRE(device.reconnects == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("Reconnectors reports its reconnections in the MCU diagnostics") {
+  GIVEN("A connected device and a device which fails, and then finishes setup when reconnected") {
+    ScriptedDevice connected({InitializableState::ok});
+    ScriptedDevice failing(
+        {InitializableState::ok, InitializableState::failed, InitializableState::ok});
+    PF::Driver::Reconnector connected_reconnector(
+        connected, initial_backoff, max_backoff, attempt_timeout);
+    PF::Driver::Reconnector failing_reconnector(
+        failing, initial_backoff, max_backoff, attempt_timeout);
+    auto reconnectors = PF::Driver::make_reconnectors(connected_reconnector, failing_reconnector);
+    PF::Application::MCUDiagnostics diagnostics{};
+    connected_reconnector.update(0);
+    failing_reconnector.update(0);
+
+    WHEN("The reconnections are output before and after the failure") {
+      bool first_changed = reconnectors.output(diagnostics);
+      bool repeated_changed = reconnectors.output(diagnostics);
+      connected_reconnector.update(10);
+      failing_reconnector.update(10);
+      bool failure_changed = reconnectors.output(diagnostics);
+      auto failure_reconnections = diagnostics.reconnections[1];
+
+      THEN("The output only reports a change when the reconnections change") {
+        REQUIRE(first_changed);
+        REQUIRE(!repeated_changed);
+        REQUIRE(failure_changed);
+      }
+      THEN("The failed device is reported as disconnected after its failure") {
+        REQUIRE(diagnostics.reconnections_count == 2);
+        REQUIRE(diagnostics.reconnections[0].connected);
+        REQUIRE(diagnostics.reconnections[0].disconnections == 0);
+        REQUIRE(!failure_reconnections.connected);
+        REQUIRE(failure_reconnections.disconnections == 1);
+      }
+      THEN("The failed device is reported as connected once it's reconnected") {
+        for (uint32_t time = 110; time <= 120; time += 10) {
+          connected_reconnector.update(time);
+          failing_reconnector.update(time);
+        }
+        REQUIRE(reconnectors.output(diagnostics));
+        REQUIRE(diagnostics.reconnections[1].connected);
+        REQUIRE(diagnostics.reconnections[1].attempts == 1);
+        REQUIRE(diagnostics.reconnections[1].reconnections == 1);
+        REQUIRE(diagnostics.reconnections[1].last_latency == 110);
+      }
+    }
+  }
+}
@@ -0,0 +1,429 @@
+/// Commands.cpp
+/// Unit tests to confirm behavior of FDO2 response parsing, including fuzz tests against the
+/// strtoul-based parser which ResponseParser replaced.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/Serial/FDO2/Commands.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Pufferfish/Driver/Serial/FDO2/Device.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+namespace FDO2 = PF::Driver::Serial::FDO2;
+
+using FDO2::CommandTypes;
+using FDO2::Response;
+using FDO2::ResponseParser;
+using FDO2::Responses::ParseStatus;
+
+namespace {
+
+// Reference parser
+
+// strtoul and strtol of the 32-bit target, where long is 32 bits, in terms of the host's 64-bit
+// strtoull and strtoll
+uint32_t strtoul32(const char *start, char **end) {
+  errno = 0;
+  unsigned long long value = std::strtoull(start, end, FDO2::arg_base);
+  bool negative = start[std::strspn(start, " \t\n\v\f\r")] == '-';
+  unsigned long long magnitude = negative ? 0ULL - value : value;
+  if (errno == ERANGE || magnitude > std::numeric_limits<uint32_t>::max()) {
+    return std::numeric_limits<uint32_t>::max();
+  }
+  return static_cast<uint32_t>(value);
+}
+
+int32_t strtol32(const char *start, char **end) {
+  long long value = std::strtoll(start, end, FDO2::arg_base);
+  if (value > std::numeric_limits<int32_t>::max()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  if (value < std::numeric_limits<int32_t>::min()) {
+    return std::numeric_limits<int32_t>::min();
+  }
+  return static_cast<int32_t>(value);
+}
+
+struct ReferenceLayout {
+  CommandTypes type;
+  FDO2::Headers::Header header;
+  std::vector<bool> signed_fields;
+};
+
+const std::vector<ReferenceLayout> reference_layouts{
+    {CommandTypes::vers, FDO2::Headers::vers, {false, false, false, false}},
+    {CommandTypes::mraw,
+     FDO2::Headers::mraw,
+     {true, true, false, true, true, true, true, true}},
+    {CommandTypes::logo, FDO2::Headers::logo, {}},
+    {CommandTypes::bcst, FDO2::Headers::bcst, {false}},
+    {CommandTypes::erro, FDO2::Headers::erro, {true}}};
+
+struct ReferenceResult {
+  bool valid_header = false;
+  CommandTypes type = CommandTypes::vers;
+  ParseStatus status = ParseStatus::ok;
+  std::vector<uint32_t> fields;  // raw values, before narrowing to the types of the fields
+};
+
+// The parser which ResponseParser replaced, which parsed a whole frame, ending with frame_end,
+// with one call of strtoul or strtol for each argument. The parsers of the response types all
+// had the same structure as this, except for LOGO (which isn't compared).
+ReferenceResult reference_parse(const std::string &frame) {
+  ReferenceResult result;
+  for (const ReferenceLayout &layout : reference_layouts) {
+    if (frame.size() >= FDO2::Headers::length &&
+        std::equal(layout.header.begin(), layout.header.end(), frame.begin())) {
+      result.valid_header = true;
+      result.type = layout.type;
+      result.fields.resize(layout.signed_fields.size(), 0);
+
+      const char *end = frame.c_str() + frame.size() - 1;
+      const char *parse_start = frame.c_str() + FDO2::Headers::length;
+      char *parse_end = nullptr;
+      if (*parse_start != FDO2::arg_delimiter) {
+        result.status = ParseStatus::invalid_arg_delimiter;
+        return result;
+      }
+
+      for (size_t i = 0; i < layout.signed_fields.size(); ++i) {
+        parse_start = parse_start + 1;
+        parse_end = nullptr;
+        if (layout.signed_fields[i]) {
+          result.fields[i] = static_cast<uint32_t>(strtol32(parse_start, &parse_end));
+        } else {
+          result.fields[i] = strtoul32(parse_start, &parse_end);
+        }
+
+        if (i + 1 == layout.signed_fields.size()) {
+          if (parse_end != end) {
+            result.status = ParseStatus::unexpected_arg;
+          }
+          return result;
+        }
+        if (parse_end >= end) {
+          result.status = ParseStatus::missing_arg;
+          return result;
+        }
+        if (*parse_end != FDO2::arg_delimiter) {
+          result.status = ParseStatus::invalid_arg_delimiter;
+          return result;
+        }
+        parse_start = parse_end;
+      }
+      return result;
+    }
+  }
+  return result;
+}
+
+// The fields of a response, each narrowed from its raw value as by assignment
+std::vector<int64_t> narrow_fields(CommandTypes type, const std::vector<uint32_t> &raw) {
+  switch (type) {
+    case CommandTypes::vers:
+      return {
+          static_cast<uint8_t>(raw[0]),
+          static_cast<uint8_t>(raw[1]),
+          static_cast<uint16_t>(raw[2]),
+          static_cast<uint8_t>(raw[3])};
+    case CommandTypes::mraw:
+      return {
+          static_cast<int32_t>(raw[0]),
+          static_cast<int32_t>(raw[1]),
+          static_cast<uint32_t>(raw[2]),
+          static_cast<int32_t>(raw[3]),
+          static_cast<int32_t>(raw[4]),
+          static_cast<int32_t>(raw[5]),
+          static_cast<int32_t>(raw[6]),
+          static_cast<int32_t>(raw[7])};
+    case CommandTypes::logo:
+      return {};
+    case CommandTypes::bcst:
+      return {static_cast<uint16_t>(raw[0])};
+    case CommandTypes::erro:
+      return {static_cast<int32_t>(raw[0])};
+  }
+  return {};
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-union-access)
+std::vector<int64_t> response_fields(const Response &response) {
+  switch (response.tag) {
+    case CommandTypes::vers: {
+      const FDO2::Responses::Vers &vers = response.value.vers;
+      return {vers.device_id, vers.num_channels, vers.firmware_rev, vers.type};
+    }
+    case CommandTypes::mraw: {
+      const FDO2::Responses::Mraw &mraw = response.value.mraw;
+      return {
+          mraw.po2,
+          mraw.temperature,
+          mraw.status,
+          mraw.phase_shift,
+          mraw.signal_intensity,
+          mraw.ambient_light,
+          mraw.ambient_pressure,
+          mraw.relative_humidity};
+    }
+    case CommandTypes::logo:
+      return {};
+    case CommandTypes::bcst:
+      return {response.value.bcst.interval};
+    case CommandTypes::erro:
+      return {response.value.erro.code};
+  }
+  return {};
+}
+
+// Fuzzing
+
+// Generates a response with random arguments, and then mutates it at random so that most of the
+// frames exercise the edge cases of the parsers: signs, whitespace, empty and overflowing
+// arguments, and invalid delimiters and headers
+std::string random_frame(std::mt19937 &generator) {
+  static const std::string mutations = " \t\n\v\f+-0123456789x#AEMORSTVW";
+  std::uniform_int_distribution<size_t> layout_index(0, reference_layouts.size() - 1);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<size_t> short_length(1, 5);
+  std::uniform_int_distribution<size_t> long_length(6, 12);
+  std::uniform_int_distribution<size_t> digit(0, 9);
+  std::uniform_int_distribution<size_t> mutation(0, mutations.size() - 1);
+  std::uniform_int_distribution<size_t> num_mutations(1, 3);
+
+  const ReferenceLayout &layout = reference_layouts[layout_index(generator)];
+  std::string frame(layout.header.begin(), layout.header.end());
+  for (size_t i = 0; i < layout.signed_fields.size(); ++i) {
+    frame.push_back(FDO2::arg_delimiter);
+    if (percent(generator) < 10) {
+      frame.push_back(percent(generator) < 50 ? '-' : '+');
+    }
+    size_t length = percent(generator) < 80 ? short_length(generator) : long_length(generator);
+    for (size_t j = 0; j < length; ++j) {
+      frame.push_back(static_cast<char>('0' + digit(generator)));
+    }
+  }
+
+  if (percent(generator) < 75) {
+    size_t count = num_mutations(generator);
+    for (size_t i = 0; i < count && !frame.empty(); ++i) {
+      std::uniform_int_distribution<size_t> position(0, frame.size() - 1);
+      switch (percent(generator) % 3) {
+        case 0:
+          frame[position(generator)] = mutations[mutation(generator)];
+          break;
+        case 1:
+          frame.insert(frame.begin() + position(generator), mutations[mutation(generator)]);
+          break;
+        default:
+          frame.erase(frame.begin() + position(generator));
+          break;
+      }
+    }
+  }
+
+  frame.push_back(FDO2::frame_end);
+  return frame;
+}
+
+ResponseParser::Status parse(ResponseParser &parser, const std::string &frame) {
+  ResponseParser::Status status = ResponseParser::Status::waiting;
+  for (char byte : frame) {
+    status = parser.input(byte);
+  }
+  return status;
+}
+
+}  // namespace
+
+SCENARIO("FDO2 ResponseParser matches the strtoul-based parser on random frames", "[FDO2]") {
+  GIVEN("A response parser which parses every frame") {
+    static const size_t num_frames = 100000;
+    static const uint32_t seed = 41;
+    std::mt19937 generator(seed);
+    ResponseParser parser;
+
+    WHEN("Random valid and mutated frames are input to it byte-by-byte") {
+      THEN("Every frame gets the same header, argument status and field values") {
+        size_t num_valid = 0;
+        for (size_t i = 0; i < num_frames; ++i) {
+          std::string frame = random_frame(generator);
+          if (frame.size() > FDO2::Responses::max_len) {
+            continue;
+          }
+
+          INFO(frame);
+          ReferenceResult expected = reference_parse(frame);
+          ResponseParser::Status status = parse(parser, frame);
+          if (!expected.valid_header) {
+            REQUIRE(status == ResponseParser::Status::invalid_header);
+            continue;
+          }
+          if (expected.type == CommandTypes::logo) {
+            continue;
+          }
+
+          REQUIRE(parser.args_status() == expected.status);
+          if (expected.status == ParseStatus::ok) {
+            REQUIRE(status == ResponseParser::Status::ok);
+            ++num_valid;
+          } else {
+            REQUIRE(status == ResponseParser::Status::invalid_args);
+          }
+          Response response{};
+          parser.output(response);
+          REQUIRE(response.tag == expected.type);
+          REQUIRE(response_fields(response) == narrow_fields(expected.type, expected.fields));
+        }
+        // The generator should cover valid frames as well as invalid ones
+        REQUIRE(num_valid > num_frames / 10);
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 ResponseParser parses responses as their bytes arrive", "[FDO2]") {
+  GIVEN("A response parser") {
+    ResponseParser parser;
+    Response response{};
+
+    WHEN("An MRAW response is input byte-by-byte") {
+      std::string frame = "#MRAW 20945 -2341 12 5125 154030 7132 1013200 45132\r";
+      for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        REQUIRE(parser.input(frame[i]) == ResponseParser::Status::waiting);
+      }
+
+      THEN("Its fields are output when the frame ends") {
+        REQUIRE(parser.input(frame.back()) == ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(response.tag == CommandTypes::mraw);
+        REQUIRE(
+            response_fields(response) ==
+            std::vector<int64_t>{20945, -2341, 12, 5125, 154030, 7132, 1013200, 45132});
+      }
+    }
+
+    WHEN("Arguments overflow their types") {
+      THEN("Signed arguments saturate as with strtol, and unsigned ones as with strtoul") {
+        REQUIRE(
+            parse(parser, "#MRAW 99999999999 -99999999999 -1 2147483648 -2147483648 0 0 0\r") ==
+            ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(
+            response_fields(response) == std::vector<int64_t>{
+                                             2147483647,
+                                             -2147483648,
+                                             4294967295,
+                                             2147483647,
+                                             -2147483648,
+                                             0,
+                                             0,
+                                             0});
+
+        REQUIRE(parse(parser, "#VERS 257 1 65537 4294967296\r") == ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(response_fields(response) == std::vector<int64_t>{1, 1, 1, 255});
+      }
+    }
+
+    WHEN("A LOGO response without arguments is input") {
+      THEN("It's valid") {
+        REQUIRE(parse(parser, "#LOGO\r") == ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(response.tag == CommandTypes::logo);
+        REQUIRE(parse(parser, "#LOGO 1\r") == ResponseParser::Status::invalid_args);
+        REQUIRE(parser.args_status() == ParseStatus::unexpected_arg);
+      }
+    }
+
+    WHEN("A frame with an invalid header or arguments is followed by a valid frame") {
+      THEN("The invalid frame is reported, and the valid frame is parsed") {
+        REQUIRE(parse(parser, "#BC\r") == ResponseParser::Status::invalid_header);
+        REQUIRE(parse(parser, "#BCST 100 2\r") == ResponseParser::Status::invalid_args);
+        REQUIRE(parser.args_status() == ParseStatus::unexpected_arg);
+        REQUIRE(parse(parser, "#BCST 100\r") == ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(response.tag == CommandTypes::bcst);
+        REQUIRE(response.value.bcst.interval == 100);  // NOLINT
+      }
+    }
+
+    WHEN("A frame longer than the maximum frame length is followed by a valid frame") {
+      std::string frame = "#MRAW";
+      while (frame.size() < FDO2::Responses::max_len) {
+        frame += " 1";
+      }
+      frame.push_back(FDO2::frame_end);
+
+      THEN("The long frame is rejected, and the valid frame is parsed") {
+        REQUIRE(parse(parser, frame) == ResponseParser::Status::invalid_frame_length);
+        REQUIRE(parse(parser, "#ERRO -3\r") == ResponseParser::Status::ok);
+        parser.output(response);
+        REQUIRE(response.tag == CommandTypes::erro);
+        REQUIRE(response.value.erro.code == -3);  // NOLINT
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 ResponseReceiver resynchronizes after a frame which is too long", "[FDO2]") {
+  GIVEN("A response receiver") {
+    FDO2::ResponseReceiver receiver;
+    Response response{};
+
+    WHEN("A frame longer than the maximum frame length is input, and then a BCST response") {
+      size_t num_invalid_length = 0;
+      for (size_t i = 0; i < 2 * FDO2::Responses::max_len; ++i) {
+        if (receiver.input('1') == FDO2::ResponseReceiver::InputStatus::invalid_frame_length) {
+          ++num_invalid_length;
+        }
+      }
+
+      THEN("The long frame is reported once, and the response is output after it") {
+        REQUIRE(num_invalid_length == 1);
+        REQUIRE(
+            receiver.input(FDO2::frame_end) ==
+            FDO2::ResponseReceiver::InputStatus::output_ready);
+        REQUIRE(
+            receiver.output(response) ==
+            FDO2::ResponseReceiver::OutputStatus::invalid_frame_length);
+
+        std::string frame = "#BCST 100\r";
+        for (size_t i = 0; i + 1 < frame.size(); ++i) {
+          REQUIRE(
+              receiver.input(static_cast<uint8_t>(frame[i])) ==
+              FDO2::ResponseReceiver::InputStatus::ok);
+        }
+        REQUIRE(
+            receiver.input(static_cast<uint8_t>(frame.back())) ==
+            FDO2::ResponseReceiver::InputStatus::output_ready);
+        REQUIRE(receiver.output(response) == FDO2::ResponseReceiver::OutputStatus::available);
+        REQUIRE(response.tag == CommandTypes::bcst);
+        REQUIRE(receiver.output(response) == FDO2::ResponseReceiver::OutputStatus::waiting);
+      }
+    }
+  }
+}
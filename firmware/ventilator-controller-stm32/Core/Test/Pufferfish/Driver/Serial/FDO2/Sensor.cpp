@@ -0,0 +1,404 @@
+/// Sensor.cpp
+/// Unit tests to confirm behavior of the FDO2 sensor driver's buffering and decimation of
+/// broadcast measurements, and of its failure when they stop.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/Serial/FDO2/Sensor.h"
+
+#include <array>
+#include <string>
+
+#include "Pufferfish/HAL/Mock/BufferedUART.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+namespace FDO2 = PF::Driver::Serial::FDO2;
+using Action = FDO2::Sensor::Action;
+
+namespace {
+
+void input(volatile PF::HAL::Mock::LargeBufferedUART &uart, const std::string &bytes) {
+  for (char byte : bytes) {
+    uart.set_read(static_cast<uint8_t>(byte));
+  }
+}
+
+std::string written(volatile PF::HAL::Mock::LargeBufferedUART &uart) {
+  std::string bytes;
+  uint8_t byte = 0;
+  while (uart.get_write(byte) == PF::BufferStatus::ok) {
+    bytes.push_back(static_cast<char>(byte));
+  }
+  return bytes;
+}
+
+// Calls setup at the time, and returns its result
+PF::InitializableState setup_at(FDO2::Sensor &sensor, PF::HAL::Mock::Time &time, uint32_t ms) {
+  time.set_millis(ms);
+  return sensor.setup();
+}
+
+// Runs setup until the sensor waits for measurements, responding to its requests
+PF::InitializableState start(
+    FDO2::Sensor &sensor,
+    volatile PF::HAL::Mock::LargeBufferedUART &uart,
+    const std::string &bcst_response) {
+  sensor.setup();
+  input(uart, "#VERS 8 1 341 15\r");
+  sensor.setup();
+  sensor.setup();
+  input(uart, bcst_response);
+  sensor.setup();
+  return sensor.setup();
+}
+
+std::string mraw(int32_t po2, int32_t temperature, uint32_t status) {
+  return "#MRAW " + std::to_string(po2) + " " + std::to_string(temperature) + " " +
+         std::to_string(status) + " 2000 150000 300 1013000 40000\r";
+}
+
+}  // namespace
+
+SCENARIO("FDO2 Sensor starts broadcast at its configured interval") {
+  GIVEN("A sensor configured with a 50 ms broadcast interval") {
+    volatile PF::HAL::Mock::LargeBufferedUART uart;
+    PF::HAL::Mock::Time time;
+    FDO2::Device device(uart);
+    FDO2::Sensor sensor(device, time, 50, 2);
+    REQUIRE(sensor.output() == PF::InitializableState::failed);
+
+    WHEN("The sensor responds to the version and broadcast requests") {
+      auto state = start(sensor, uart, "#BCST 50\r");
+
+      THEN("Setup finishes after requesting broadcast at the interval") {
+        REQUIRE(state == PF::InitializableState::ok);
+        REQUIRE(written(uart) == "#VERS\r#BCST 50\r");
+        REQUIRE(sensor.output() == PF::InitializableState::ok);
+      }
+    }
+
+    WHEN("The sensor acknowledges a different broadcast interval") {
+      auto state = start(sensor, uart, "#BCST 100\r");
+
+      THEN("Setup doesn't finish") {
+        REQUIRE(state == PF::InitializableState::setup);
+        REQUIRE(sensor.output() == PF::InitializableState::failed);
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 Sensor retries setup when the sensor doesn't respond as expected") {
+  GIVEN("A sensor configured with a 50 ms broadcast interval") {
+    volatile PF::HAL::Mock::LargeBufferedUART uart;
+    PF::HAL::Mock::Time time;
+    FDO2::Device device(uart);
+    FDO2::Sensor sensor(device, time, 50, 2);
+    setup_at(sensor, time, 0);
+
+    WHEN("The sensor doesn't respond to the version request within the response timeout") {
+      auto before_timeout = setup_at(sensor, time, 49);
+      auto timeout = setup_at(sensor, time, 50);
+      auto retry = setup_at(sensor, time, 50);
+
+      THEN("The version is requested again") {
+        REQUIRE(before_timeout == PF::InitializableState::setup);
+        REQUIRE(timeout == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::check_version);
+        REQUIRE(sensor.statistics(Action::check_version).faults == 1);
+        REQUIRE(written(uart) == "#VERS\r#VERS\r");
+      }
+
+      THEN("Setup finishes once the sensor responds to the retried requests") {
+        setup_at(sensor, time, 50);
+        input(uart, "#VERS 8 1 341 15\r");
+        setup_at(sensor, time, 60);
+        setup_at(sensor, time, 60);
+        input(uart, "#BCST 50\r");
+        REQUIRE(setup_at(sensor, time, 70) == PF::InitializableState::ok);
+        REQUIRE(written(uart) == "#VERS\r#VERS\r#BCST 50\r");
+      }
+    }
+
+    WHEN("The sensor responds with an unexpected version") {
+      input(uart, "#VERS 8 1 340 15\r");
+      auto fault = setup_at(sensor, time, 10);
+      auto retry = setup_at(sensor, time, 10);
+
+      THEN("The version is requested again") {
+        REQUIRE(fault == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::check_version);
+        REQUIRE(sensor.statistics(Action::check_version).faults == 1);
+        REQUIRE(sensor.statistics(Action::start_broadcast).entries == 0);
+        REQUIRE(written(uart) == "#VERS\r#VERS\r");
+      }
+    }
+
+    WHEN("The sensor never responds to the broadcast request") {
+      input(uart, "#VERS 8 1 341 15\r");
+      setup_at(sensor, time, 10);
+      setup_at(sensor, time, 10);
+      auto timeout = setup_at(sensor, time, 60);
+      auto retry = setup_at(sensor, time, 60);
+
+      THEN("Broadcast is requested again, without requesting the version again") {
+        REQUIRE(timeout == PF::InitializableState::setup);
+        REQUIRE(retry == PF::InitializableState::setup);
+        REQUIRE(sensor.get_state() == Action::check_broadcast);
+        REQUIRE(sensor.statistics(Action::check_broadcast).faults == 1);
+        REQUIRE(written(uart) == "#VERS\r#BCST 50\r#BCST 50\r");
+      }
+    }
+
+    WHEN("The sensor never responds, and setup is called every 10 ms") {
+      PF::InitializableState status = PF::InitializableState::setup;
+      uint32_t ms = 0;
+      for (; ms < 10000 && status == PF::InitializableState::setup; ms += 10) {
+        status = setup_at(sensor, time, ms);
+      }
+
+      THEN("Setup fails after more than 100 timeouts, and stays failed") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::check_version).faults == 101);
+        REQUIRE(setup_at(sensor, time, ms) == PF::InitializableState::failed);
+        REQUIRE(sensor.output() == PF::InitializableState::failed);
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 Sensor buffers every measurement, both raw and decimated") {
+  GIVEN("A started sensor which decimates measurements by 2") {
+    volatile PF::HAL::Mock::LargeBufferedUART uart;
+    PF::HAL::Mock::Time time;
+    FDO2::Device device(uart);
+    FDO2::Sensor sensor(device, time, 50, 2);
+    REQUIRE(start(sensor, uart, "#BCST 50\r") == PF::InitializableState::ok);
+
+    WHEN("Three measurements and another response arrive between calls of output") {
+      time.set_millis(1000);
+      input(uart, mraw(200000, 25000, 0));
+      input(uart, "#LOGO\r");
+      sensor.output();
+      time.set_millis(1050);
+      input(uart, mraw(210001, 25100, 4));
+      input(uart, mraw(220000, 25200, 1));
+      sensor.output();
+
+      THEN("Each measurement is read from the raw stream with the time it was received") {
+        FDO2::Sample sample{};
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.time == 1000);
+        REQUIRE(sample.mraw.po2 == 200000);
+        REQUIRE(sample.mraw.temperature == 25000);
+        REQUIRE(sample.mraw.phase_shift == 2000);
+        REQUIRE(sample.mraw.signal_intensity == 150000);
+        REQUIRE(sample.mraw.ambient_light == 300);
+        REQUIRE(sample.mraw.ambient_pressure == 1013000);
+        REQUIRE(sample.mraw.relative_humidity == 40000);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.time == 1050);
+        REQUIRE(sample.mraw.po2 == 210001);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.time == 1050);
+        REQUIRE(sample.mraw.po2 == 220000);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::empty);
+      }
+
+      THEN("The first pair of measurements is averaged into the decimated stream") {
+        FDO2::Sample sample{};
+        REQUIRE(sensor.read_decimated(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.time == 1025);
+        REQUIRE(sample.mraw.po2 == 205000);
+        REQUIRE(sample.mraw.temperature == 25050);
+        REQUIRE(sample.mraw.status == 4);
+        REQUIRE(sample.mraw.ambient_pressure == 1013000);
+        REQUIRE(sensor.read_decimated(sample) == PF::BufferStatus::empty);
+      }
+    }
+
+    WHEN("A malformed measurement arrives between two valid measurements") {
+      time.set_millis(1000);
+      input(uart, mraw(200000, 25000, 0));
+      input(uart, "#MRAW 1 2\r");
+      input(uart, mraw(210000, 25000, 0));
+      auto status = sensor.output();
+
+      THEN("Only the malformed measurement is dropped, and output doesn't fail") {
+        REQUIRE(status == PF::InitializableState::ok);
+        FDO2::Sample sample{};
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.mraw.po2 == 200000);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.mraw.po2 == 210000);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::empty);
+        REQUIRE(sensor.statistics(Action::measure).faults == 0);
+      }
+    }
+
+    WHEN("More measurements arrive than the raw buffer can hold") {
+      const size_t capacity = FDO2::Sensor::raw_buffer_size - 1;
+      for (size_t i = 0; i < capacity + 2; ++i) {
+        time.set_millis(static_cast<uint32_t>(50 * i));
+        input(uart, mraw(static_cast<int32_t>(i), 25000, 0));
+        sensor.output();
+      }
+
+      THEN("The oldest measurements are dropped") {
+        FDO2::Sample sample{};
+        for (size_t i = 2; i < capacity + 2; ++i) {
+          REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+          REQUIRE(sample.mraw.po2 == static_cast<int32_t>(i));
+        }
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::empty);
+      }
+
+      THEN("The decimated stream keeps its newest samples") {
+        FDO2::Sample sample{};
+        const size_t decimated_capacity = FDO2::Sensor::decimated_buffer_size - 1;
+        const size_t num_decimated = (capacity + 2) / 2;
+        for (size_t i = num_decimated - decimated_capacity; i < num_decimated; ++i) {
+          REQUIRE(sensor.read_decimated(sample) == PF::BufferStatus::ok);
+          REQUIRE(sample.time == 100 * i + 25);
+        }
+        REQUIRE(sensor.read_decimated(sample) == PF::BufferStatus::empty);
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 Sensor fails when its measurements stop, so that it can be reconnected") {
+  GIVEN("A started sensor with a 50 ms broadcast interval, supervised by a Reconnector") {
+    volatile PF::HAL::Mock::LargeBufferedUART uart;
+    PF::HAL::Mock::Time time;
+    FDO2::Device device(uart);
+    FDO2::Sensor sensor(device, time, 50, 1);
+    PF::Driver::Reconnector reconnector(sensor, 10, 100, 0);
+    REQUIRE(start(sensor, uart, "#BCST 50\r") == PF::InitializableState::ok);
+    REQUIRE(reconnector.update(0) == PF::InitializableState::ok);
+    written(uart);
+
+    time.set_millis(50);
+    input(uart, mraw(200000, 25000, 0));
+    REQUIRE(sensor.output() == PF::InitializableState::ok);
+    FDO2::Sample sample{};
+    REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+
+    WHEN("The UART goes silent for less than 4 broadcast intervals") {
+      time.set_millis(240);
+      auto status = sensor.output();
+
+      THEN("Measurement doesn't fail") {
+        REQUIRE(status == PF::InitializableState::ok);
+        REQUIRE(reconnector.update(240) == PF::InitializableState::ok);
+        REQUIRE(sensor.statistics(Action::measure).faults == 0);
+      }
+    }
+
+    WHEN("The UART goes silent for 4 broadcast intervals") {
+      time.set_millis(250);
+      auto status = sensor.output();
+      auto update_status = reconnector.update(250);
+
+      THEN("Measurement fails, and the Reconnector detects a disconnection") {
+        REQUIRE(status == PF::InitializableState::failed);
+        REQUIRE(sensor.statistics(Action::measure).faults == 1);
+        REQUIRE(update_status == PF::InitializableState::failed);
+        REQUIRE(reconnector.state() == PF::Driver::Reconnector::State::backing_off);
+        REQUIRE(reconnector.statistics().disconnections == 1);
+      }
+
+      THEN("Reconnecting restarts setup, after which measurements are buffered again") {
+        REQUIRE(reconnector.update(260) == PF::InitializableState::failed);
+        input(uart, "#VERS 8 1 341 15\r#BCST 50\r");
+        reconnector.update(270);
+        reconnector.update(280);
+        reconnector.update(290);
+        REQUIRE(reconnector.update(300) == PF::InitializableState::ok);
+        REQUIRE(written(uart) == "#VERS\r#BCST 50\r");
+        REQUIRE(reconnector.statistics().reconnections == 1);
+        REQUIRE(reconnector.statistics().last_latency == 50);
+
+        time.set_millis(310);
+        input(uart, mraw(210000, 25000, 0));
+        REQUIRE(sensor.output() == PF::InitializableState::ok);
+        REQUIRE(sensor.read_raw(sample) == PF::BufferStatus::ok);
+        REQUIRE(sample.time == 310);
+        REQUIRE(sample.mraw.po2 == 210000);
+      }
+    }
+  }
+}
+
+SCENARIO("FDO2 SampleDecimator averages blocks of samples") {
+  GIVEN("A decimator with a factor of 3") {
+    FDO2::SampleDecimator decimator(3);
+    FDO2::Sample output{};
+
+    WHEN("Two blocks of samples with negative values are input") {
+      FDO2::Sample input{};
+      input.mraw.temperature = -1000;
+      std::array<FDO2::SampleDecimator::Status, 6> statuses{};
+      std::array<FDO2::Sample, 2> outputs{};
+      size_t num_outputs = 0;
+      for (size_t i = 0; i < statuses.size(); ++i) {
+        input.time = static_cast<uint32_t>(4294967200U + 40 * i);  // the clock wraps around
+        input.mraw.po2 = static_cast<int32_t>(10 * i);
+        input.mraw.temperature -= 10;
+        statuses[i] = decimator.transform(input, output);
+        if (statuses[i] == FDO2::SampleDecimator::Status::ok) {
+          outputs[num_outputs++] = output;
+        }
+      }
+
+      THEN("Every third input completes a block, with its average at its midpoint in time") {
+        REQUIRE(statuses[0] == FDO2::SampleDecimator::Status::waiting);
+        REQUIRE(statuses[1] == FDO2::SampleDecimator::Status::waiting);
+        REQUIRE(statuses[2] == FDO2::SampleDecimator::Status::ok);
+        REQUIRE(statuses[5] == FDO2::SampleDecimator::Status::ok);
+        REQUIRE(num_outputs == 2);
+        REQUIRE(outputs[0].time == 4294967240U);
+        REQUIRE(outputs[0].mraw.po2 == 10);
+        REQUIRE(outputs[0].mraw.temperature == -1020);
+        REQUIRE(outputs[1].time == 64);
+        REQUIRE(outputs[1].mraw.po2 == 40);
+        REQUIRE(outputs[1].mraw.temperature == -1050);
+      }
+    }
+  }
+
+  GIVEN("A decimator with a factor of 0") {
+    FDO2::SampleDecimator decimator(0);
+
+    WHEN("A sample is input") {
+      FDO2::Sample input{123, {210000, 2500, 0, 0, 0, 0, 0, 0}};
+      FDO2::Sample output{};
+      auto status = decimator.transform(input, output);
+
+      THEN("It's passed through, as with a factor of 1") {
+        REQUIRE(status == FDO2::SampleDecimator::Status::ok);
+        REQUIRE(output.time == 123);
+        REQUIRE(output.mraw.po2 == 210000);
+      }
+    }
+  }
+}
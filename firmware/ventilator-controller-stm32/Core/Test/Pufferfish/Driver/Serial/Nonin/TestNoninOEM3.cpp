@@ -39,6 +39,69 @@ PF::Driver::Serial::Nonin::PacketStatus invalid_checksum_status =
 PF::Driver::Serial::Nonin::PacketStatus invalid_header_status =
     PF::Driver::Serial::Nonin::PacketStatus::invalid_header;
 
+// Sets valid frames with reserved data bytes as the next bytes to be read from BufferedUART
+void set_reserved_frames(PF::HAL::Mock::ReadOnlyBufferedUART &mock_uart, size_t num_frames) {
+  auto frame = make_array<uint8_t>(0x01, 0x80, 0x01, 0x00, 0x82);
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (uint8_t byte : frame) {
+      mock_uart.set_read(byte);
+    }
+  }
+}
+
+// A valid packet with a heart rate of 72, an SpO2 of 97 and a firmware revision of 48
+const PF::Driver::Serial::Nonin::Packet valid_packet = {{
+    {0x01, 0x81, 0x01, 0x00, 0x83},  /// HR MSB
+    {0x01, 0x80, 0x01, 0x48, 0xCA},  /// HR LSB
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// SpO2
+    {0x01, 0x80, 0x01, 0x30, 0xB2},  /// REV
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// SpO2-D
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// SpO2 Fast
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// SpO2 B-B
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// E-HR MSB
+    {0x01, 0x80, 0x01, 0x48, 0xCA},  /// E-HR LSB
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// E-SpO2
+    {0x01, 0x80, 0x01, 0x61, 0xE3},  /// E-SpO2-D
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// HR-D MSB
+    {0x01, 0x80, 0x01, 0x48, 0xCA},  /// HR-D LSB
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// E-HR-D MSB
+    {0x01, 0x80, 0x01, 0x48, 0xCA},  /// E-HR-D LSB
+    {0x01, 0x80, 0x01, 0x00, 0x82},  /// reserved
+    {0x01, 0x80, 0x01, 0x00, 0x82}   /// reserved
+}};
+
+// Sets the first num_frames frames of valid_packet as the next bytes to be read from BufferedUART
+void set_packet_frames(PF::HAL::Mock::ReadOnlyBufferedUART &mock_uart, size_t num_frames) {
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (uint8_t byte : valid_packet[i]) {
+      mock_uart.set_read(byte);
+    }
+  }
+}
+
+// Reads num_bytes bytes with Device::output, returning the status of the last read
+PF::Driver::Serial::Nonin::PacketStatus read_bytes(
+    PF::Driver::Serial::Nonin::Device &nonin_uart,
+    PF::Driver::Serial::Nonin::Sample &sensor_measurements,
+    size_t num_bytes) {
+  PF::Driver::Serial::Nonin::PacketStatus return_status = waiting_status;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    return_status = nonin_uart.output(sensor_measurements);
+    if (i + 1 < num_bytes) {
+      REQUIRE(return_status == waiting_status);
+    }
+  }
+  return return_status;
+}
+
 SCENARIO("No input data received from BufferedUART", "[NoninOEM3]") {
   PF::HAL::Mock::ReadOnlyBufferedUART mock_uart;
   PF::Driver::Serial::Nonin::Device nonin_uart(mock_uart);
@@ -154,6 +217,17 @@ SCENARIO("Complete packet is not available", "[NoninOEM3]") {
       for (index = 0; index < 9; index++) {
         nonin_uart.output(sensor_measurements);
       }
+      THEN("return_status of Device::output shall be waiting until the packet is complete") {
+        return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == waiting_status);
+      }
+    }
+    AND_WHEN("The rest of the packet is received from BufferedUART") {
+      set_reserved_frames(mock_uart, PF::Driver::Serial::Nonin::packet_size - 2);
+      for (index = 0; index < 124; index++) {
+        return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == waiting_status);
+      }
       THEN("return_status of Device::output shall be checksum_failed on checksum error") {
         return_status = nonin_uart.output(sensor_measurements);
         REQUIRE(return_status == invalid_checksum_status);
@@ -201,7 +275,18 @@ SCENARIO("Complete packet is not available", "[NoninOEM3]") {
       for (index = 0; index < 9; index++) {
         nonin_uart.output(sensor_measurements);
       }
-      THEN("return_status of Device::output shall be checksum_failed on status byte error") {
+      THEN("return_status of Device::output shall be waiting until the packet is complete") {
+        return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == waiting_status);
+      }
+    }
+    AND_WHEN("The rest of the packet is received from BufferedUART") {
+      set_reserved_frames(mock_uart, PF::Driver::Serial::Nonin::packet_size - 2);
+      for (index = 0; index < 124; index++) {
+        return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == waiting_status);
+      }
+      THEN("return_status of Device::output shall be invalid_header on status byte error") {
         return_status = nonin_uart.output(sensor_measurements);
         REQUIRE(return_status == invalid_header_status);
       }
@@ -352,16 +437,26 @@ SCENARIO("Validate the Nonin OEM III with invalid data received from BufferedUAR
         }
       }
     }
-    AND_WHEN("116 to 120 bytes of data receiving from bufferedUART") {
-      for (index = 0; index < 115; index++) {
-        return_status = nonin_uart.output(sensor_measurements);
-      }
-      for (index = 115; index < 120; index++) {
+    AND_WHEN("116 to 125 bytes of data receiving from bufferedUART") {
+      // The second frame of the second packet completes the first packet
+      set_reserved_frames(mock_uart, 1);
+      for (index = 0; index < 124; index++) {
         return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == waiting_status);
       }
+      return_status = nonin_uart.output(sensor_measurements);
       THEN("shall return frame_loss due to loss of 2 frames") {
         REQUIRE(return_status == frame_loss_status);
       }
+      THEN("The frames of the second packet received so far are kept for its completion") {
+        set_reserved_frames(mock_uart, PF::Driver::Serial::Nonin::packet_size - 2);
+        for (index = 0; index < 114; index++) {
+          return_status = nonin_uart.output(sensor_measurements);
+          REQUIRE(return_status == waiting_status);
+        }
+        return_status = nonin_uart.output(sensor_measurements);
+        REQUIRE(return_status == ok_status);
+      }
     }
   }
 }
@@ -536,3 +631,100 @@ SCENARIO("Validate NoninOEM3 for valid packet data", "[NoninOEM3]") {
     }
   }
 }
+
+SCENARIO("Device frames packets across noise and lost frames", "[NoninOEM3]") {
+  PF::HAL::Mock::ReadOnlyBufferedUART mock_uart;
+  PF::Driver::Serial::Nonin::Device nonin_uart(mock_uart);
+  PF::Driver::Serial::Nonin::Sample sensor_measurements{};
+  const size_t frame_size = PF::Driver::Serial::Nonin::frame_max_size;
+  const size_t packet_size = PF::Driver::Serial::Nonin::packet_size;
+
+  GIVEN("A valid packet followed by 2 noise frames and the frames of a new packet") {
+    set_packet_frames(mock_uart, packet_size);
+    set_reserved_frames(mock_uart, 2);
+    set_packet_frames(mock_uart, packet_size);
+
+    WHEN("The first packet is received") {
+      auto return_status = read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      THEN("Device::output shall return ok") {
+        REQUIRE(return_status == ok_status);
+        REQUIRE(sensor_measurements.hr == 72);
+        REQUIRE(sensor_measurements.spo2 == 97);
+      }
+    }
+
+    AND_WHEN("The noise frames and the first 23 frames of the new packet are received") {
+      read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      auto return_status = read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      THEN("Device::output shall return frame_loss due to the noise frames") {
+        REQUIRE(return_status == frame_loss_status);
+      }
+    }
+
+    AND_WHEN("The rest of the new packet is received") {
+      read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      sensor_measurements = PF::Driver::Serial::Nonin::Sample{};
+      auto return_status = read_bytes(nonin_uart, sensor_measurements, 2 * frame_size);
+      THEN("Device::output shall return ok for the new packet") {
+        REQUIRE(return_status == ok_status);
+        REQUIRE(sensor_measurements.hr == 72);
+        REQUIRE(sensor_measurements.e_hr_d == 72);
+        REQUIRE(sensor_measurements.spo2 == 97);
+        REQUIRE(sensor_measurements.e_spo2_d == 97);
+        REQUIRE(sensor_measurements.firmware_revision == 48);
+      }
+    }
+  }
+
+  GIVEN("23 frames of a packet followed by the 25 frames of the next packet") {
+    set_packet_frames(mock_uart, packet_size - 2);
+    set_packet_frames(mock_uart, packet_size);
+
+    WHEN("25 frames are received") {
+      auto return_status = read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      THEN("Device::output shall return frame_loss on the 25th frame") {
+        REQUIRE(return_status == frame_loss_status);
+      }
+    }
+
+    AND_WHEN("The 26th to 48th frames are received") {
+      read_bytes(nonin_uart, sensor_measurements, packet_size * frame_size);
+      auto return_status =
+          read_bytes(nonin_uart, sensor_measurements, (packet_size - 2) * frame_size);
+      THEN("Device::output shall return ok on the 48th frame") {
+        REQUIRE(return_status == ok_status);
+        REQUIRE(sensor_measurements.hr == 72);
+        REQUIRE(sensor_measurements.hr_d == 72);
+        REQUIRE(sensor_measurements.e_hr == 72);
+        REQUIRE(sensor_measurements.e_hr_d == 72);
+        REQUIRE(sensor_measurements.spo2 == 97);
+        REQUIRE(sensor_measurements.spo2_d == 97);
+        REQUIRE(sensor_measurements.e_spo2 == 97);
+        REQUIRE(sensor_measurements.e_spo2_d == 97);
+        REQUIRE(sensor_measurements.spo2_b_b == 97);
+        REQUIRE(sensor_measurements.spo2_fast == 97);
+        REQUIRE(sensor_measurements.firmware_revision == 48);
+      }
+    }
+  }
+
+  GIVEN("5 valid frames of a packet") {
+    set_packet_frames(mock_uart, 5);
+
+    WHEN("The 5 frames are received") {
+      auto return_status = read_bytes(nonin_uart, sensor_measurements, 5 * frame_size);
+      THEN("Device::output shall return waiting") {
+        REQUIRE(return_status == waiting_status);
+        REQUIRE(sensor_measurements.hr == 0);
+      }
+    }
+
+    AND_WHEN("Device::output is invoked after all frames have been read") {
+      read_bytes(nonin_uart, sensor_measurements, 5 * frame_size);
+      THEN("Device::output shall keep returning waiting") {
+        REQUIRE(nonin_uart.output(sensor_measurements) == waiting_status);
+      }
+    }
+  }
+}
@@ -0,0 +1,312 @@
+/// TestPacket.cpp
+/// Unit tests to confirm behavior of Nonin packet validation and parsing.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+
+#include "Pufferfish/Driver/Serial/Nonin/Packet.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::Driver::Serial::Nonin::Frame;
+
+const PF::Driver::Serial::Nonin::SignalQuality green_perfusion =
+    PF::Driver::Serial::Nonin::SignalQuality::green_perfusion;
+const PF::Driver::Serial::Nonin::SignalQuality red_perfusion =
+    PF::Driver::Serial::Nonin::SignalQuality::red_perfusion;
+const PF::Driver::Serial::Nonin::SignalQuality yellow_perfusion =
+    PF::Driver::Serial::Nonin::SignalQuality::yellow_perfusion;
+const PF::Driver::Serial::Nonin::SignalQuality no_perfusion =
+    PF::Driver::Serial::Nonin::SignalQuality::no_perfusion;
+
+SCENARIO("validate the read_status_byte function") {
+  PF::Driver::Serial::Nonin::Sample sensor_measurements{};
+  uint8_t byte_value = 0;
+  const uint8_t frame_index = 1;
+  GIVEN("A Status Byte ") {
+    byte_value = 0x82;
+    WHEN("Status Byte value is 0x82") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Signal perfusion in Sample shall be green perfusion") {
+        REQUIRE(sensor_measurements.signal_perfusion[1] == green_perfusion);
+      }
+    }
+    byte_value = 0x84;
+    WHEN("Status Byte value is 0x84") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Signal perfusion in Sample shall be red perfusion") {
+        REQUIRE(sensor_measurements.signal_perfusion[1] == red_perfusion);
+      }
+    }
+    byte_value = 0x86;
+    WHEN("Status Byte value is 0x86") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Signal perfusion in Sample shall be yellow perfusion") {
+        REQUIRE(sensor_measurements.signal_perfusion[1] == yellow_perfusion);
+      }
+    }
+    byte_value = 0x88;
+    WHEN("Status Byte value is 0x88") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Sensor Alarm is true") REQUIRE(sensor_measurements.sensor_alarm[1] == true);
+    }
+    byte_value = 0x90;
+    WHEN("Status Byte value is 0x90") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Out of track is set to true") REQUIRE(sensor_measurements.out_of_track[1] == true);
+    }
+    byte_value = 0xA0;
+    WHEN("Status Byte value is 0xA0") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Artifact is set to true") REQUIRE(sensor_measurements.artifact[1] == true);
+    }
+
+    byte_value = 0xC0;
+    WHEN("Status Byte value is 0xC0") {
+      PF::Driver::Serial::Nonin::read_status_byte(sensor_measurements, frame_index, byte_value);
+      THEN("Sensor disconnect is set to true") {
+        REQUIRE(sensor_measurements.sensor_disconnect[1] == true);
+      }
+    }
+  }
+}
+
+SCENARIO("read_packet_measurements parses the measurements of a packet", "[NoninOem3]") {
+  GIVEN("A Valid First Packet") {
+    const PF::Driver::Serial::Nonin::Packet test_packet = {
+        0x01, 0x81, 0x01, 0x00, 0x83,  /// HR MSB
+        0x01, 0x80, 0x01, 0x48, 0xCA,  /// HR LSB
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// SpO2
+        0x01, 0x80, 0x01, 0x30, 0xB2,  /// REV
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// SpO2-D
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// SpO2 Fast
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// SpO2 B-B
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// E-HR MSB
+        0x01, 0x80, 0x01, 0x48, 0xCA,  /// E-HR LSB
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// E-SpO2
+        0x01, 0x80, 0x01, 0x61, 0xE3,  /// E-SpO2-D
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// HR-D MSB
+        0x01, 0x80, 0x01, 0x48, 0xCA,  /// HR-D LSB
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// E-HR-D MSB
+        0x01, 0x80, 0x01, 0x48, 0xCA,  /// E-HR-D LSB
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82   /// reserved
+    };
+    PF::Driver::Serial::Nonin::Sample sensor_measurements{};
+
+    WHEN("The measurements of the packet are read") {
+      REQUIRE(
+          PF::Driver::Serial::Nonin::validate_packet(test_packet) ==
+          PF::Driver::Serial::Nonin::PacketValidation::ok);
+      PF::Driver::Serial::Nonin::read_packet_measurements(sensor_measurements, test_packet);
+
+      THEN("Validate the Heart Rate and SpO2") {
+        REQUIRE(sensor_measurements.hr == 72);
+        REQUIRE(sensor_measurements.hr_d == 72);
+        REQUIRE(sensor_measurements.e_hr == 72);
+        REQUIRE(sensor_measurements.e_hr_d == 72);
+        REQUIRE(sensor_measurements.spo2 == 97);
+        REQUIRE(sensor_measurements.spo2_d == 97);
+        REQUIRE(sensor_measurements.e_spo2 == 97);
+        REQUIRE(sensor_measurements.e_spo2_d == 97);
+        REQUIRE(sensor_measurements.spo2_b_b == 97);
+        REQUIRE(sensor_measurements.spo2_fast == 97);
+        REQUIRE(sensor_measurements.firmware_revision == 48);
+      }
+      THEN("The pleth amplitude of every frame is read") {
+        for (size_t index = 0; index < PF::Driver::Serial::Nonin::packet_size; ++index) {
+          REQUIRE(sensor_measurements.packet_pleth[index] == 0x01);
+        }
+      }
+    }
+  }
+
+  GIVEN("A valid Packet with status byte errors set ") {
+    const PF::Driver::Serial::Nonin::Packet test_packet = {
+        0x01, 0x81, 0x01, 0x00, 0x83,  /// HR MSB
+        0x01, 0x82, 0x01, 0x48, 0xCC,  /// HR LSB
+        0x01, 0x86, 0x01, 0x61, 0xE9,  /// SpO2
+        0x01, 0x84, 0x01, 0x30, 0xB6,  /// REV
+        0x01, 0x88, 0x01, 0x00, 0x8A,  /// reserved
+        0x01, 0x90, 0x01, 0x00, 0x92,  /// reserved
+        0x01, 0xA0, 0x01, 0x00, 0xA2,  /// reserved
+        0x01, 0xC0, 0x01, 0x00, 0xC2,  /// reserved
+        0x01, 0x00, 0x01, 0x00, 0x63,  /// SpO2-D
+        0x01, 0x80, 0x01, 0x00, 0xE3,  /// SpO2 Fast
+        0x01, 0x80, 0x01, 0x00, 0xE3,  /// SpO2 B-B
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// E-HR MSB
+        0x01, 0x80, 0x01, 0x00, 0xCA,  /// E-HR LSB
+        0x01, 0x80, 0x01, 0x00, 0xE3,  /// E-SpO2
+        0x01, 0x80, 0x01, 0x00, 0xE3,  /// E-SpO2-D
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// HR-D MSB
+        0x01, 0x80, 0x01, 0x00, 0xCA,  /// HR-D LSB
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// E-HR-D MSB
+        0x01, 0x80, 0x01, 0x00, 0xCA,  /// E-HR-D LSB
+        0x01, 0x80, 0x01, 0x00, 0x82,  /// reserved
+        0x01, 0x80, 0x01, 0x00, 0x82};
+    PF::Driver::Serial::Nonin::Sample sensor_measurements{};
+
+    WHEN("The measurements of the packet are read") {
+      PF::Driver::Serial::Nonin::read_packet_measurements(sensor_measurements, test_packet);
+
+      THEN("Status Byte errors set") {
+        REQUIRE(sensor_measurements.signal_perfusion[0] == no_perfusion);
+        REQUIRE(sensor_measurements.signal_perfusion[1] == green_perfusion);
+        REQUIRE(sensor_measurements.signal_perfusion[2] == yellow_perfusion);
+        REQUIRE(sensor_measurements.signal_perfusion[3] == red_perfusion);
+        REQUIRE(sensor_measurements.sensor_alarm[4] == true);
+        REQUIRE(sensor_measurements.out_of_track[5] == true);
+        REQUIRE(sensor_measurements.artifact[6] == true);
+        REQUIRE(sensor_measurements.sensor_disconnect[7] == true);
+        REQUIRE(sensor_measurements.bit7[8] == true);
+      }
+    }
+  }
+}
+
+SCENARIO("validate_packet checks every frame of a packet") {
+  GIVEN("A packet of valid frames with a sync bit in the first frame") {
+    PF::Driver::Serial::Nonin::Packet packet{};
+    for (Frame &frame : packet) {
+      frame = {0x01, 0x80, 0x01, 0x00, 0x82};
+    }
+    packet[0] = {0x01, 0x81, 0x01, 0x00, 0x83};
+
+    WHEN("The packet is validated") {
+      THEN("It is ok") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::ok);
+      }
+    }
+
+    WHEN("A later frame has a checksum error") {
+      packet[12][4] = 0x00;
+      THEN("The packet has an invalid checksum") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::invalid_checksum);
+      }
+    }
+
+    WHEN("A frame has a checksum error and a later frame has a header error") {
+      packet[3][4] = 0x00;
+      packet[20][0] = 0x02;
+      packet[20][4] = 0x83;
+      THEN("The error of the earlier frame is reported") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::invalid_checksum);
+      }
+    }
+
+    WHEN("A frame's status byte is missing its high bit") {
+      packet[24] = {0x01, 0x00, 0x01, 0x00, 0x02};
+      THEN("The packet has an invalid header") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::invalid_header);
+      }
+    }
+
+    WHEN("A frame other than the first has a sync bit") {
+      packet[7] = {0x01, 0x81, 0x01, 0x00, 0x83};
+      THEN("Frames were lost") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::frame_loss);
+      }
+    }
+
+    WHEN("The first frame has no sync bit") {
+      packet[0] = {0x01, 0x80, 0x01, 0x00, 0x82};
+      THEN("Frames were lost") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::frame_loss);
+      }
+    }
+  }
+
+  GIVEN("The frames received after 23 frames of a packet were followed by the next packet") {
+    PF::Driver::Serial::Nonin::Packet packet{};
+    for (Frame &frame : packet) {
+      frame = {0x01, 0x80, 0x01, 0x00, 0x82};
+    }
+    packet[0] = {0x01, 0x81, 0x01, 0x00, 0x83};
+    packet[23] = {0x01, 0x81, 0x01, 0x00, 0x83};
+
+    WHEN("The 25 frames starting at the first packet are validated") {
+      THEN("Frames were lost") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::frame_loss);
+      }
+    }
+
+    WHEN("The 25 frames starting at the next packet are validated") {
+      PF::Driver::Serial::Nonin::Packet next_packet{};
+      std::copy(packet.cbegin() + 23, packet.cend(), next_packet.begin());
+      std::fill(next_packet.begin() + 2, next_packet.end(), packet[1]);
+      THEN("It is ok") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(next_packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::ok);
+      }
+    }
+  }
+
+  GIVEN("A valid packet preceded by 2 frames of noise") {
+    PF::Driver::Serial::Nonin::Packet packet{};
+    for (Frame &frame : packet) {
+      frame = {0x01, 0x80, 0x01, 0x00, 0x82};
+    }
+    packet[2] = {0x01, 0x81, 0x01, 0x00, 0x83};
+
+    WHEN("The 25 frames starting at the noise are validated") {
+      THEN("Frames were lost") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::frame_loss);
+      }
+    }
+
+    WHEN("The second noise frame also has a checksum error") {
+      packet[1][4] = 0x00;
+      THEN("The loss of frames at the first frame is reported") {
+        REQUIRE(
+            PF::Driver::Serial::Nonin::validate_packet(packet) ==
+            PF::Driver::Serial::Nonin::PacketValidation::frame_loss);
+      }
+    }
+  }
+}
@@ -0,0 +1,139 @@
+/// TestSensor.cpp
+/// Unit tests to confirm behavior of the Nonin OEM III sensor driver's buffering of PLETH
+/// samples into waveform messages.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Driver/Serial/Nonin/Sensor.h"
+
+#include "Pufferfish/HAL/Mock/BufferedUART.h"
+#include "Pufferfish/HAL/Mock/Time.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+namespace Nonin = PF::Driver::Serial::Nonin;
+
+namespace {
+
+// Sets a valid packet, whose PLETH samples count up from first_pleth, as the next bytes to be
+// read from BufferedUART
+void set_packet(PF::HAL::Mock::ReadOnlyBufferedUART &mock_uart, uint8_t first_pleth) {
+  static const uint8_t header = 0x01;
+  for (size_t index = 0; index < Nonin::packet_size; ++index) {
+    const uint8_t status = index == 0 ? 0x81 : 0x80;
+    const auto pleth = static_cast<uint8_t>(first_pleth + index);
+    mock_uart.set_read(header);
+    mock_uart.set_read(status);
+    mock_uart.set_read(pleth);
+    mock_uart.set_read(0x00);
+    mock_uart.set_read(static_cast<uint8_t>(header + status + pleth));
+  }
+}
+
+// Calls setup once for each byte of a packet, since the device consumes one byte per call
+PF::InitializableState setup_packet(Nonin::Sensor &sensor) {
+  PF::InitializableState state = PF::InitializableState::setup;
+  for (size_t i = 0; i < Nonin::packet_size * Nonin::frame_max_size; ++i) {
+    state = sensor.setup();
+  }
+  return state;
+}
+
+// Calls output once for each byte of a packet
+void output_packet(Nonin::Sensor &sensor) {
+  Nonin::SensorConnections connections{};
+  float spo2 = 0;
+  float hr = 0;
+  for (size_t i = 0; i < Nonin::packet_size * Nonin::frame_max_size; ++i) {
+    sensor.output(connections, spo2, hr);
+  }
+}
+
+}  // namespace
+
+SCENARIO("Nonin Sensor buffers the PLETH samples of every valid packet", "[NoninOEM3]") {
+  GIVEN("A sensor which has received one packet during setup") {
+    PF::HAL::Mock::ReadOnlyBufferedUART mock_uart;
+    PF::HAL::Mock::Time time;
+    Nonin::Device device(mock_uart);
+    Nonin::Sensor sensor(device, time);
+    PF::Application::PlethWaveform waveform{};
+    REQUIRE(sensor.output(waveform) == PF::BufferStatus::empty);
+
+    time.set_millis(1000);
+    set_packet(mock_uart, 10);
+    REQUIRE(setup_packet(sensor) == PF::InitializableState::ok);
+
+    WHEN("The waveform is read") {
+      auto status = sensor.output(waveform);
+
+      THEN("It has the samples of the packet, timed at the packet's arrival") {
+        REQUIRE(status == PF::BufferStatus::ok);
+        REQUIRE(waveform.sequence == 0);
+        REQUIRE(waveform.time == 1000);
+        REQUIRE(waveform.samples.size == Nonin::packet_size);
+        for (size_t i = 0; i < Nonin::packet_size; ++i) {
+          REQUIRE(waveform.samples.bytes[i] == 10 + i);
+        }
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::empty);
+      }
+    }
+
+    WHEN("Another packet arrives before the waveform is read") {
+      time.set_millis(1333);
+      set_packet(mock_uart, 100);
+      output_packet(sensor);
+
+      THEN("Waveforms are read in order, with earlier ones timed before the newest samples") {
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::ok);
+        REQUIRE(waveform.sequence == 0);
+        REQUIRE(waveform.time == 1000);
+        REQUIRE(waveform.samples.bytes[0] == 10);
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::ok);
+        REQUIRE(waveform.sequence == Nonin::packet_size);
+        REQUIRE(waveform.time == 1333);
+        REQUIRE(waveform.samples.bytes[0] == 100);
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::empty);
+      }
+    }
+
+    WHEN("More packets arrive than can be buffered") {
+      static const size_t num_packets = 6;
+      for (size_t i = 1; i < num_packets; ++i) {
+        time.set_millis(static_cast<uint32_t>(1000 + 333 * i));
+        set_packet(mock_uart, static_cast<uint8_t>(10 * i));
+        output_packet(sensor);
+      }
+
+      THEN("The oldest samples are dropped, and the sequence numbers count them") {
+        // 150 samples were received, of which only the newest 127 are buffered
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::ok);
+        REQUIRE(waveform.sequence == 23);
+        REQUIRE(waveform.samples.bytes[0] == 10 + 23);
+        // 102 samples are left, which arrived over the 1.36 s before the newest sample
+        REQUIRE(waveform.time == 2665 - 102 * 1000 / Nonin::frame_rate);
+        for (size_t i = 0; i < 4; ++i) {
+          REQUIRE(sensor.output(waveform) == PF::BufferStatus::ok);
+        }
+        REQUIRE(waveform.sequence == 123);
+        REQUIRE(waveform.time == 2665 - 2 * 1000 / Nonin::frame_rate);
+        REQUIRE(sensor.output(waveform) == PF::BufferStatus::empty);
+      }
+    }
+  }
+}
@@ -0,0 +1,186 @@
+/// Filters.cpp
+/// Unit tests to confirm behavior of the biquad and FIR filters and their designs.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Protocols/Application/Filters.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+namespace Design = PF::Protocols::Application::FilterDesign;
+
+using PF::Protocols::Application::BiquadCascade;
+using PF::Protocols::Application::BiquadCoefficients;
+using PF::Protocols::Application::FIRFilter;
+
+namespace {
+
+constexpr float sample_rate = 500;  // Hz
+
+// Designs are evaluated at compile time
+constexpr BiquadCoefficients low_pass = Design::low_pass(50, sample_rate);
+constexpr BiquadCoefficients notch = Design::notch(100, sample_rate, 5);
+constexpr std::array<float, 15> fir_taps = Design::low_pass_taps<15>(50, sample_rate);
+
+// Returns the amplitude of the filter's response to a sine wave of the given frequency, after
+// its transient has decayed
+template <typename Filter>
+float sine_amplitude(Filter &filter, float frequency) {
+  static const size_t settling_samples = 500;
+  static const size_t measured_samples = 500;
+  float amplitude = 0;
+  for (size_t i = 0; i < settling_samples + measured_samples; ++i) {
+    float input = std::sin(2 * static_cast<float>(M_PI) * frequency * i / sample_rate);
+    float output = filter.transform(input);
+    if (i >= settling_samples) {
+      amplitude = std::max(amplitude, std::abs(output));
+    }
+  }
+  return amplitude;
+}
+
+}  // namespace
+
+SCENARIO("Biquad filters are designed at compile time", "[filters]") {
+  GIVEN("The cookbook designs") {
+    THEN("The low-pass coefficients match the designs computed with the standard library") {
+      double w0 = 2 * M_PI * 50 / sample_rate;
+      double alpha = std::sin(w0) / (2 * Design::butterworth_quality);
+      double a0 = 1 + alpha;
+      REQUIRE(low_pass.b0 == Approx((1 - std::cos(w0)) / 2 / a0));
+      REQUIRE(low_pass.b1 == Approx((1 - std::cos(w0)) / a0));
+      REQUIRE(low_pass.a1 == Approx(-2 * std::cos(w0) / a0));
+      REQUIRE(low_pass.a2 == Approx((1 - alpha) / a0));
+    }
+
+    THEN("The low-pass and notch filters have unity DC gain") {
+      for (const BiquadCoefficients &c : {low_pass, notch}) {
+        REQUIRE((c.b0 + c.b1 + c.b2) / (1 + c.a1 + c.a2) == Approx(1));
+      }
+    }
+
+    THEN("The high-pass filter has zero DC gain") {
+      constexpr BiquadCoefficients high_pass = Design::high_pass(50, sample_rate);
+      REQUIRE(high_pass.b0 + high_pass.b1 + high_pass.b2 == Approx(0).margin(1e-6));
+    }
+
+    THEN("The FIR taps are symmetric and sum to 1") {
+      float sum = 0;
+      for (size_t i = 0; i < fir_taps.size(); ++i) {
+        REQUIRE(fir_taps[i] == Approx(fir_taps[fir_taps.size() - 1 - i]));
+        sum += fir_taps[i];
+      }
+      REQUIRE(sum == Approx(1));
+    }
+  }
+}
+
+SCENARIO("Filters attenuate frequencies outside of their passbands", "[filters]") {
+  GIVEN("A 2-section 50 Hz Butterworth low-pass cascade at 500 Hz") {
+    BiquadCascade<2> filter{{low_pass, low_pass}};
+
+    THEN("A 5 Hz sine wave passes through nearly unchanged") {
+      REQUIRE(sine_amplitude(filter, 5) == Approx(1).margin(0.01));
+    }
+
+    THEN("A 200 Hz sine wave is attenuated by more than 40 dB") {
+      REQUIRE(sine_amplitude(filter, 200) < 0.01);
+    }
+  }
+
+  GIVEN("A 100 Hz notch filter at 500 Hz") {
+    BiquadCascade<1> filter{{notch}};
+
+    THEN("A 100 Hz sine wave is removed") { REQUIRE(sine_amplitude(filter, 100) < 0.01); }
+
+    THEN("A 10 Hz sine wave passes through nearly unchanged") {
+      REQUIRE(sine_amplitude(filter, 10) == Approx(1).margin(0.01));
+    }
+  }
+
+  GIVEN("A 15-tap 50 Hz low-pass FIR filter at 500 Hz") {
+    FIRFilter<15> filter{fir_taps};
+
+    THEN("A 5 Hz sine wave passes through nearly unchanged") {
+      REQUIRE(sine_amplitude(filter, 5) == Approx(1).margin(0.02));
+    }
+
+    THEN("A 200 Hz sine wave is attenuated by more than 30 dB") {
+      REQUIRE(sine_amplitude(filter, 200) < 0.03);
+    }
+  }
+}
+
+SCENARIO("Filters process blocks and restart at steady state", "[filters]") {
+  GIVEN("Pairs of identical filters and a block of samples") {
+    BiquadCascade<2> sample_biquad{{low_pass, notch}};
+    BiquadCascade<2> block_biquad{{low_pass, notch}};
+    FIRFilter<15> sample_fir{fir_taps};
+    FIRFilter<15> block_fir{fir_taps};
+    std::array<float, 64> input{};
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>((i * 37) % 11) - 5;
+    }
+
+    WHEN("One filter of each pair processes the block and the other processes each sample") {
+      std::array<float, 64> biquad_output{};
+      std::array<float, 64> fir_output{};
+      block_biquad.transform(input, biquad_output);
+      block_fir.transform(input, fir_output);
+
+      THEN("Their outputs are identical") {
+        for (size_t i = 0; i < input.size(); ++i) {
+          REQUIRE(biquad_output[i] == sample_biquad.transform(input[i]));
+          REQUIRE(fir_output[i] == sample_fir.transform(input[i]));
+        }
+      }
+    }
+
+    WHEN("The block is filtered in place") {
+      std::array<float, 64> biquad_output{};
+      block_biquad.transform(input, biquad_output);
+      sample_biquad.transform(input, input);
+
+      THEN("The output is the same as when it's filtered into another array") {
+        REQUIRE(input == biquad_output);
+      }
+    }
+  }
+
+  GIVEN("Filters which are reset to a constant value") {
+    BiquadCascade<2> biquad{{low_pass, notch}};
+    FIRFilter<15> fir{fir_taps};
+    biquad.reset(40);
+    fir.reset(40);
+
+    WHEN("The constant value is filtered") {
+      float biquad_output = biquad.transform(40);
+      float fir_output = fir.transform(40);
+
+      THEN("The outputs have no transient") {
+        REQUIRE(biquad_output == Approx(40));
+        REQUIRE(fir_output == Approx(40));
+      }
+    }
+  }
+}
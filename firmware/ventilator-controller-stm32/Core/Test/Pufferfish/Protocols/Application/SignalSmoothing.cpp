@@ -0,0 +1,155 @@
+/// SignalSmoothing.cpp
+/// Unit tests to confirm that the multi-channel display smoother is equivalent to a separate
+/// display smoother per channel.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Protocols/Application/SignalSmoothing.h"
+
+#include <array>
+#include <cmath>
+
+#include "Pufferfish/Util/FixedPoint.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Protocols::Application::DisplaySmoother;
+using PF::Protocols::Application::DisplaySmootherStatus;
+using PF::Protocols::Application::MultiChannelDisplaySmoother;
+using PF::Protocols::Application::SmoothingParameters;
+
+namespace {
+
+constexpr size_t num_channels = 4;
+constexpr uint32_t sampling_interval = 5;  // ms
+constexpr std::array<SmoothingParameters, num_channels> params{
+    {{1, 0.5, 100, 100, 128},
+     {0.5, 0.5, 100, 100, 128},
+     {1, 0.5, 100, 1000, 128},
+     {0.2, 2, 50, 1000, 256}}};
+
+// A test signal for each channel, with noise, steps, slow drifts and gaps of NaN
+float test_signal(size_t channel, uint32_t time, uint32_t &noise_state) {
+  static const uint32_t lcg_multiplier = 1664525;
+  static const uint32_t lcg_increment = 1013904223;
+  noise_state = noise_state * lcg_multiplier + lcg_increment;
+  float noise = static_cast<float>(noise_state >> 8U) / static_cast<float>(1U << 24U) - 0.5F;
+  static const uint32_t period = 3000;  // ms
+  uint32_t phase = (time + channel * period / num_channels) % period;
+  static const uint32_t gap_start = 2500;
+  static const uint32_t gap_end = 2600;
+  if (phase >= gap_start && phase < gap_end) {
+    return std::numeric_limits<float>::quiet_NaN();
+  }
+
+  float level = (phase < period / 2) ? 90 : 40;
+  float drift = static_cast<float>(phase % (period / 2)) / 1000;
+  return level + drift + noise * (1 + static_cast<float>(channel));
+}
+
+bool identical(float first, float second) {
+  return (std::isnan(first) && std::isnan(second)) || first == second;
+}
+
+// Runs the multi-channel smoother and a separate smoother per channel side by side, and returns
+// the number of samples at which they differed
+template <typename Number>
+size_t count_differences(uint32_t duration, uint32_t time_step) {
+  MultiChannelDisplaySmoother<Number, num_channels> multi{sampling_interval, params};
+  std::array<DisplaySmoother<Number>, num_channels> singles{
+      {{sampling_interval, params[0]},
+       {sampling_interval, params[1]},
+       {sampling_interval, params[2]},
+       {sampling_interval, params[3]}}};
+
+  size_t differences = 0;
+  uint32_t noise_state = 1;
+  std::array<float, num_channels> multi_filtered{};
+  std::array<float, num_channels> single_filtered{};
+  for (uint32_t time = 0; time < duration; time += time_step) {
+    std::array<float, num_channels> raw{};
+    for (size_t i = 0; i < num_channels; ++i) {
+      raw[i] = test_signal(i, time, noise_state);
+    }
+    auto multi_status = multi.transform(time, raw, multi_filtered);
+    for (size_t i = 0; i < num_channels; ++i) {
+      auto single_status = singles[i].transform(time, raw[i], single_filtered[i]);
+      if (single_status != multi_status || !identical(single_filtered[i], multi_filtered[i])) {
+        ++differences;
+      }
+    }
+  }
+  return differences;
+}
+
+}  // namespace
+
+SCENARIO(
+    "The multi-channel display smoother is equivalent to a display smoother per channel",
+    "[signal_smoothing]") {
+  GIVEN("Four channels with different parameters and noisy signals with steps and gaps") {
+    static const uint32_t duration = 30000;  // ms
+
+    WHEN("The float smoothers are updated at every sampling interval") {
+      size_t differences = count_differences<float>(duration, sampling_interval);
+
+      THEN("Their outputs are identical at every sample") { REQUIRE(differences == 0); }
+    }
+
+    WHEN("The float smoothers are updated more often than the sampling interval") {
+      size_t differences = count_differences<float>(duration, 2);
+
+      THEN("Their outputs and statuses are identical at every sample") {
+        REQUIRE(differences == 0);
+      }
+    }
+
+    WHEN("The Q31 smoothers are updated at every sampling interval") {
+      size_t differences = count_differences<PF::Util::Q31>(duration, sampling_interval);
+
+      THEN("Their outputs are identical at every sample") { REQUIRE(differences == 0); }
+    }
+
+    WHEN("The Q15 smoothers are updated more often than the sampling interval") {
+      size_t differences = count_differences<PF::Util::Q15>(duration, 2);
+
+      THEN("Their outputs and statuses are identical at every sample") {
+        REQUIRE(differences == 0);
+      }
+    }
+  }
+
+  GIVEN("A multi-channel smoother which was just updated") {
+    MultiChannelDisplaySmoother<float, num_channels> multi{sampling_interval, params};
+    std::array<float, num_channels> filtered{};
+    multi.transform(0, {1, 2, 3, 4}, filtered);
+    std::array<float, num_channels> previous = filtered;
+
+    WHEN("It's updated again before the sampling interval has elapsed") {
+      auto status = multi.transform(sampling_interval - 1, {5, 6, 7, 8}, filtered);
+
+      THEN("It returns waiting status and leaves the filtered values unchanged") {
+        REQUIRE(status == DisplaySmootherStatus::waiting);
+        for (size_t i = 0; i < num_channels; ++i) {
+          REQUIRE(identical(filtered[i], previous[i]));
+        }
+      }
+    }
+  }
+}
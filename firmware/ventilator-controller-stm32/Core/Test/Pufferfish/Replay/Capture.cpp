@@ -0,0 +1,195 @@
+/// Capture.cpp
+/// Unit tests to confirm behavior of the backend UART capture parser.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Replay/Capture.h"
+
+#include <sstream>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+using PF::Replay::CaptureStatus;
+
+namespace {
+
+CaptureStatus parse(const std::string &text, PF::Replay::Capture &capture, size_t &error_line) {
+  std::istringstream input(text);
+  return PF::Replay::read_capture(input, capture, error_line);
+}
+
+}  // namespace
+
+SCENARIO("The capture parser reads well-formed captures", "[capture]") {
+  GIVEN("A capture with comments, blank lines, and spaced and unspaced hex bytes") {
+    const std::string text =
+        "# header comment\n"
+        "\n"
+        "10 0102ff\n"
+        "   # indented comment\n"
+        "10 AB cd\r\n"
+        "25\n"
+        "  40 00 7f 80\n";
+
+    WHEN("The capture is parsed") {
+      PF::Replay::Capture capture;
+      size_t error_line = 1;
+      auto status = parse(text, capture, error_line);
+
+      THEN("The read_capture function returns ok status and reports no error line") {
+        REQUIRE(status == CaptureStatus::ok);
+        REQUIRE(error_line == 0);
+      }
+
+      THEN("Comments and blank lines are skipped and each event keeps its bytes in order") {
+        REQUIRE(capture.size() == 4);
+        REQUIRE(capture[0].time == 10);
+        REQUIRE(capture[0].bytes == std::vector<uint8_t>{0x01, 0x02, 0xff});
+        REQUIRE(capture[1].time == 10);
+        REQUIRE(capture[1].bytes == std::vector<uint8_t>{0xab, 0xcd});
+        REQUIRE(capture[2].time == 25);
+        REQUIRE(capture[2].bytes.empty());
+        REQUIRE(capture[3].time == 40);
+        REQUIRE(capture[3].bytes == std::vector<uint8_t>{0x00, 0x7f, 0x80});
+      }
+    }
+  }
+
+  GIVEN("A capture written by the write_capture function") {
+    PF::Replay::Capture original;
+    original.push_back({0, {0x00, 0x10}});
+    original.push_back({7, {}});
+    original.push_back({1000, {0xde, 0xad, 0xbe, 0xef}});
+    std::ostringstream output;
+    PF::Replay::write_capture(output, original, "round trip");
+
+    WHEN("The written text is parsed") {
+      PF::Replay::Capture capture;
+      size_t error_line = 0;
+      auto status = parse(output.str(), capture, error_line);
+
+      THEN("The parsed events are equal to the written events") {
+        REQUIRE(status == CaptureStatus::ok);
+        REQUIRE(capture.size() == original.size());
+        for (size_t i = 0; i < original.size(); ++i) {
+          REQUIRE(capture[i].time == original[i].time);
+          REQUIRE(capture[i].bytes == original[i].bytes);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("The capture parser rejects malformed lines", "[capture]") {
+  GIVEN("A capture whose third line has an odd number of hex digits") {
+    const std::string text =
+        "# comment\n"
+        "1 0102\n"
+        "2 abc\n"
+        "3 04\n";
+
+    WHEN("The capture is parsed") {
+      PF::Replay::Capture capture;
+      size_t error_line = 0;
+      auto status = parse(text, capture, error_line);
+
+      THEN("The read_capture function returns invalid_bytes status for line 3") {
+        REQUIRE(status == CaptureStatus::invalid_bytes);
+        REQUIRE(error_line == 3);
+      }
+
+      THEN("Only the events before the invalid line are parsed") {
+        REQUIRE(capture.size() == 1);
+        REQUIRE(capture[0].time == 1);
+      }
+    }
+  }
+
+  GIVEN("A capture with a single trailing hex digit") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    auto status = parse("5 0\n", capture, error_line);
+
+    THEN("The read_capture function returns invalid_bytes status for line 1") {
+      REQUIRE(status == CaptureStatus::invalid_bytes);
+      REQUIRE(error_line == 1);
+    }
+  }
+
+  GIVEN("A capture with a byte split by whitespace") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    auto status = parse("5 01 2 3\n", capture, error_line);
+
+    THEN("The read_capture function returns invalid_bytes status for line 1") {
+      REQUIRE(status == CaptureStatus::invalid_bytes);
+      REQUIRE(error_line == 1);
+    }
+  }
+
+  GIVEN("A capture with a non-hex digit") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    auto status = parse("5 01\n6 0g\n", capture, error_line);
+
+    THEN("The read_capture function returns invalid_bytes status for line 2") {
+      REQUIRE(status == CaptureStatus::invalid_bytes);
+      REQUIRE(error_line == 2);
+    }
+  }
+
+  GIVEN("A capture with a line that does not start with a timestamp") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    auto status = parse("5 01\n\nff 02\n", capture, error_line);
+
+    THEN("The read_capture function returns invalid_time status for line 3") {
+      REQUIRE(status == CaptureStatus::invalid_time);
+      REQUIRE(error_line == 3);
+    }
+  }
+
+  GIVEN("A capture whose timestamps decrease") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    auto status = parse("10 01\n9 02\n", capture, error_line);
+
+    THEN("The read_capture function returns time_decreased status for line 2") {
+      REQUIRE(status == CaptureStatus::time_decreased);
+      REQUIRE(error_line == 2);
+      REQUIRE(capture.size() == 1);
+    }
+  }
+
+  GIVEN("A previously-parsed capture") {
+    PF::Replay::Capture capture;
+    size_t error_line = 0;
+    REQUIRE(parse("1 01\n2 02\n", capture, error_line) == CaptureStatus::ok);
+
+    WHEN("A malformed capture is parsed into the same object") {
+      auto status = parse("3 0\n", capture, error_line);
+
+      THEN("The previous events are cleared") {
+        REQUIRE(status == CaptureStatus::invalid_bytes);
+        REQUIRE(capture.empty());
+      }
+    }
+  }
+}
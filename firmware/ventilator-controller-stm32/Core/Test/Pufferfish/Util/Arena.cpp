@@ -0,0 +1,183 @@
+/// Arena.cpp
+/// Unit tests to confirm behavior of the scoped scratch arena.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/Arena.h"
+
+#include <cstdint>
+
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/Vector.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+SCENARIO("The Arena allocates memory in stack order", "[arena]") {
+  GIVEN("An empty Arena with capacity 64") {
+    PF::Util::Arena<64> arena;
+
+    THEN("The used method reports that no memory is used") {
+      REQUIRE(arena.used() == 0);
+      REQUIRE(arena.available() == 64);
+      REQUIRE(arena.max_size() == 64);
+      REQUIRE(arena.high_water_mark() == 0);
+    }
+
+    WHEN("A byte and then a uint32_t are allocated") {
+      void *byte = nullptr;
+      void *word = nullptr;
+      auto byte_status = arena.allocate(1, 1, byte);
+      auto word_status = arena.allocate(sizeof(uint32_t), alignof(uint32_t), word);
+
+      THEN("Both allocations return ok status") {
+        REQUIRE(byte_status == PF::IndexStatus::ok);
+        REQUIRE(word_status == PF::IndexStatus::ok);
+      }
+
+      THEN("The uint32_t is aligned and placed after the byte") {
+        REQUIRE(reinterpret_cast<uintptr_t>(word) % alignof(uint32_t) == 0);
+        REQUIRE(static_cast<uint8_t *>(word) > static_cast<uint8_t *>(byte));
+      }
+
+      THEN("The used method includes the alignment padding") {
+        REQUIRE(arena.used() == 2 * sizeof(uint32_t));
+        REQUIRE(arena.available() == 64 - 2 * sizeof(uint32_t));
+        REQUIRE(arena.high_water_mark() == 2 * sizeof(uint32_t));
+      }
+    }
+
+    WHEN("More memory is requested than the arena has available") {
+      void *first = nullptr;
+      void *second = nullptr;
+      auto first_status = arena.allocate(60, 1, first);
+      auto second_status = arena.allocate(8, 1, second);
+
+      THEN("The allocation which doesn't fit returns out of bounds status") {
+        REQUIRE(first_status == PF::IndexStatus::ok);
+        REQUIRE(second_status == PF::IndexStatus::out_of_bounds);
+        REQUIRE(second == nullptr);
+      }
+
+      THEN("The failed allocation doesn't use any memory") {
+        REQUIRE(arena.used() == 60);
+        REQUIRE(arena.high_water_mark() == 60);
+      }
+    }
+
+    WHEN("Padding for alignment would overflow the arena") {
+      void *first = nullptr;
+      void *second = nullptr;
+      arena.allocate(63, 1, first);
+      auto second_status = arena.allocate(1, 8, second);
+
+      THEN("The allocation returns out of bounds status") {
+        REQUIRE(second_status == PF::IndexStatus::out_of_bounds);
+        REQUIRE(arena.used() == 63);
+      }
+    }
+  }
+}
+
+SCENARIO("The Arena returns memory when a Scope ends", "[arena]") {
+  GIVEN("An Arena with capacity 32 and 8 bytes allocated outside of any scope") {
+    PF::Util::Arena<32> arena;
+    void *outer = nullptr;
+    arena.allocate(8, 1, outer);
+
+    WHEN("16 bytes are allocated within a scope which then ends") {
+      {
+        PF::Util::Arena<32>::Scope scope(arena);
+        void *inner = nullptr;
+        REQUIRE(arena.allocate(16, 1, inner) == PF::IndexStatus::ok);
+        REQUIRE(arena.used() == 24);
+      }
+
+      THEN("The used method reports only the memory allocated outside of the scope") {
+        REQUIRE(arena.used() == 8);
+      }
+
+      THEN("The high water mark includes the memory allocated within the scope") {
+        REQUIRE(arena.high_water_mark() == 24);
+      }
+
+      THEN("The memory from the scope can be allocated again") {
+        void *reused = nullptr;
+        REQUIRE(arena.allocate(24, 1, reused) == PF::IndexStatus::ok);
+        REQUIRE(reused == static_cast<uint8_t *>(outer) + 8);
+      }
+    }
+
+    WHEN("Scopes are nested") {
+      {
+        PF::Util::Arena<32>::Scope outer_scope(arena);
+        void *first = nullptr;
+        arena.allocate(8, 1, first);
+        {
+          PF::Util::Arena<32>::Scope inner_scope(arena);
+          void *second = nullptr;
+          arena.allocate(8, 1, second);
+          REQUIRE(arena.used() == 24);
+        }
+        REQUIRE(arena.used() == 16);
+      }
+
+      THEN("Each scope returns only the memory allocated during its lifetime") {
+        REQUIRE(arena.used() == 8);
+        REQUIRE(arena.high_water_mark() == 24);
+      }
+    }
+  }
+}
+
+SCENARIO("The Arena creates value-initialized objects", "[arena]") {
+  GIVEN("An Arena whose memory was previously filled with nonzero bytes") {
+    using Buffer = PF::Util::Containers::ByteVector<16>;
+    PF::Util::Arena<sizeof(Buffer) + alignof(Buffer)> arena;
+    {
+      PF::Util::Arena<sizeof(Buffer) + alignof(Buffer)>::Scope scope(arena);
+      void *memory = nullptr;
+      REQUIRE(arena.allocate(arena.max_size(), 1, memory) == PF::IndexStatus::ok);
+      auto *bytes = static_cast<uint8_t *>(memory);
+      for (size_t i = 0; i < arena.max_size(); ++i) {
+        bytes[i] = 0xff;
+      }
+    }
+
+    WHEN("A ByteVector is created in the arena") {
+      Buffer *buffer = nullptr;
+      auto status = arena.create(buffer);
+
+      THEN("The create method returns ok status") {
+        REQUIRE(status == PF::IndexStatus::ok);
+        REQUIRE(buffer != nullptr);
+      }
+
+      THEN("The ByteVector is empty and aligned") {
+        REQUIRE(buffer->empty());
+        REQUIRE(reinterpret_cast<uintptr_t>(buffer) % alignof(Buffer) == 0);
+      }
+
+      THEN("A second ByteVector can't be created in the arena") {
+        Buffer *second = nullptr;
+        REQUIRE(arena.create(second) == PF::IndexStatus::out_of_bounds);
+        REQUIRE(second == nullptr);
+      }
+    }
+  }
+}
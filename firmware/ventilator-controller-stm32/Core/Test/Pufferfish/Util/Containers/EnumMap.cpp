@@ -18,6 +18,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "Pufferfish/Statuses.h"
 #include "catch2/catch.hpp"
@@ -1400,4 +1401,41 @@ SCENARIO("The method clear in EnumMap works corretly") {
       THEN("The empty method reports that the EnumMap is empty") { REQUIRE(map.empty() == true); }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("The keys of an EnumMap can be traversed") {
+  GIVEN("An EnumMap with capacity 40, has {3, 30}, {35, 350}, {7, 70} items") {
+    PF::Util::Containers::EnumMap<uint8_t, uint32_t, 40> map{{3, 30}, {35, 350}, {7, 70}};
+
+    WHEN("The values of the keys are collected with keys().for_each") {
+      std::vector<uint8_t> keys;
+      std::vector<uint32_t> values;
+      map.keys().for_each([&map, &keys, &values](uint8_t key) {
+        keys.push_back(key);
+        values.push_back(map[key]);
+      });
+
+      THEN("The keys are visited in increasing order") {
+        REQUIRE(keys == std::vector<uint8_t>{3, 7, 35});
+      }
+      THEN("The values of the keys are visited in order of their keys") {
+        REQUIRE(values == std::vector<uint32_t>{30, 70, 350});
+      }
+    }
+
+    WHEN("The item with key 7 is erased and the keys are traversed") {
+      map.erase(7);
+      std::vector<uint8_t> keys;
+      map.keys().for_each([&keys](uint8_t key) { keys.push_back(key); });
+
+      THEN("The erased key is not visited") { REQUIRE(keys == std::vector<uint8_t>{3, 35}); }
+    }
+
+    WHEN("The clear method is called and the keys are traversed") {
+      map.clear();
+      size_t visited = 0;
+      map.keys().for_each([&visited](uint8_t /*key*/) { ++visited; });
+
+      THEN("No keys are visited") { REQUIRE(visited == 0); }
+    }
+  }
+}
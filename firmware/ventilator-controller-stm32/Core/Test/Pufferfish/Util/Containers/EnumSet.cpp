@@ -17,6 +17,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "Pufferfish/Statuses.h"
 #include "catch2/catch.hpp"
@@ -601,4 +602,111 @@ SCENARIO("The method clear in Enumset works corretly") {
       THEN("The empty method reports that the Enumset is empty") { REQUIRE(set.empty() == true); }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("The EnumSet packs keys into 32-bit words") {
+  GIVEN("A EnumSet with capacity 70, which spans 3 words, with keys 0, 31, 32, 63, 64 and 69") {
+    PF::Util::Containers::EnumSet<size_t, 70> set{0, 31, 32, 63, 64, 69};
+
+    THEN("The EnumSet is backed by 3 words") { REQUIRE(set.num_words == 3); }
+    THEN("The EnumSet is smaller than an array of 70 bools") {
+      REQUIRE(sizeof(set) < sizeof(std::array<bool, 70>));
+    }
+    THEN("The size method reports size as 6") { REQUIRE(set.size() == 6); }
+    THEN("The available method reports that 64 keys are available") {
+      REQUIRE(set.available() == 64);
+    }
+    THEN("The has method returns true for the keys at the boundaries of each word") {
+      for (size_t key : {0, 31, 32, 63, 64, 69}) {
+        REQUIRE(set.has(key) == true);
+      }
+    }
+    THEN("The has method returns false for the keys next to the boundaries of each word") {
+      for (size_t key : {1, 30, 33, 62, 65, 68, 70, 96}) {
+        REQUIRE(set.has(key) == false);
+      }
+    }
+
+    WHEN("The for_each method is called") {
+      std::vector<size_t> keys;
+      set.for_each([&keys](size_t key) { keys.push_back(key); });
+
+      THEN("The for_each method visits every key once, in increasing order") {
+        REQUIRE(keys == std::vector<size_t>{0, 31, 32, 63, 64, 69});
+      }
+    }
+
+    WHEN("The keys in the middle word are erased and the for_each method is called") {
+      set.erase(32);
+      set.erase(63);
+      std::vector<size_t> keys;
+      set.for_each([&keys](size_t key) { keys.push_back(key); });
+
+      THEN("The size method reports size as 4") { REQUIRE(set.size() == 4); }
+      THEN("The for_each method skips the empty word") {
+        REQUIRE(keys == std::vector<size_t>{0, 31, 64, 69});
+      }
+    }
+
+    WHEN("The clear method is called") {
+      set.clear();
+      size_t visited = 0;
+      set.for_each([&visited](size_t /*key*/) { ++visited; });
+
+      THEN("The empty method reports that the EnumSet is empty") { REQUIRE(set.empty() == true); }
+      THEN("The for_each method visits no keys") { REQUIRE(visited == 0); }
+    }
+  }
+
+  GIVEN("A EnumSet with capacity 64 in which every key has been input") {
+    PF::Util::Containers::EnumSet<size_t, 64> set;
+    for (size_t i = 0; i < 64; ++i) {
+      REQUIRE(set.input(i) == PF::IndexStatus::ok);
+    }
+
+    THEN("The full method reports that the EnumSet is full") { REQUIRE(set.full() == true); }
+    THEN("The size method reports size as 64") { REQUIRE(set.size() == 64); }
+    THEN("The input method returns out of bounds status for key 64") {
+      REQUIRE(set.input(64) == PF::IndexStatus::out_of_bounds);
+      REQUIRE(set.size() == 64);
+    }
+  }
+}
+
+SCENARIO("The EnumSet union and intersection operators work correctly") {
+  GIVEN("A EnumSet with keys 1, 2 and 40 and a EnumSet with keys 2, 3 and 40, of capacity 48") {
+    using TestSet = PF::Util::Containers::EnumSet<size_t, 48>;
+    TestSet first{1, 2, 40};
+    TestSet second{2, 3, 40};
+
+    WHEN("The second set is added to the first set with the |= operator") {
+      first |= second;
+
+      THEN("The first set has keys 1, 2, 3 and 40") { REQUIRE(first == TestSet{1, 2, 3, 40}); }
+      THEN("The size method reports size as 4") { REQUIRE(first.size() == 4); }
+      THEN("The second set is unchanged") { REQUIRE(second == TestSet{2, 3, 40}); }
+    }
+
+    WHEN("The first set is intersected with the second set with the &= operator") {
+      first &= second;
+
+      THEN("The first set has keys 2 and 40") { REQUIRE(first == TestSet{2, 40}); }
+      THEN("The size method reports size as 2") { REQUIRE(first.size() == 2); }
+      THEN("The second set is unchanged") { REQUIRE(second == TestSet{2, 3, 40}); }
+    }
+
+    WHEN("The first set is intersected with an empty set") {
+      first &= TestSet{};
+
+      THEN("The empty method reports that the first set is empty") {
+        REQUIRE(first.empty() == true);
+      }
+    }
+
+    WHEN("The sets are compared") {
+      THEN("The sets are not equal") {
+        REQUIRE(first != second);
+        REQUIRE_FALSE(first == second);
+      }
+    }
+  }
+}
@@ -0,0 +1,214 @@
+/// HashedOrderedMap.cpp
+/// Unit tests to confirm behavior of the insertion-ordered hash map.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/Containers/HashedOrderedMap.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Pufferfish/Statuses.h"
+#include "Pufferfish/Util/Containers/OrderedMap.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+namespace {
+
+using Pairs = std::vector<std::pair<uint32_t, uint32_t>>;
+
+template <typename Map>
+Pairs items_of(const Map &map) {
+  Pairs items;
+  map.for_each([&items](const auto &pair) { items.emplace_back(pair.first, pair.second); });
+  return items;
+}
+
+// Maps every key to the same bucket, so that every operation has to walk a full probe sequence
+struct CollidingHash {
+  constexpr uint32_t operator()(const uint32_t & /*key*/) const noexcept { return 0; }
+};
+
+// Maps keys to buckets by their lowest bits, so that nearby keys form runs of probe sequences
+// which wrap around the end of the index
+struct ClusteringHash {
+  static constexpr uint32_t shift = 28;
+
+  constexpr uint32_t operator()(const uint32_t &key) const noexcept { return key << shift; }
+};
+
+}  // namespace
+
+SCENARIO("The HashedOrderedMap behaves like a map") {
+  GIVEN("A HashedOrderedMap with capacity 4, constructed with {1, 10}, {2, 20} and {3, 30}") {
+    PF::Util::Containers::HashedOrderedMap<uint32_t, uint32_t, 4> map{{1, 10}, {2, 20}, {3, 30}};
+
+    THEN("The size method reports size as 3") { REQUIRE(map.size() == 3); }
+    THEN("The available method reports that 1 pair is available") {
+      REQUIRE(map.available() == 1);
+    }
+    THEN("The empty and full methods report that the map is neither empty nor full") {
+      REQUIRE(map.empty() == false);
+      REQUIRE(map.full() == false);
+    }
+    THEN("The has method returns true for keys 1-3 and false for keys 0 and 4") {
+      REQUIRE(map.has(1) == true);
+      REQUIRE(map.has(2) == true);
+      REQUIRE(map.has(3) == true);
+      REQUIRE(map.has(0) == false);
+      REQUIRE(map.has(4) == false);
+    }
+    THEN("The output method returns the values of keys 1-3") {
+      uint32_t value = 0;
+      REQUIRE(map.output(2, value) == PF::IndexStatus::ok);
+      REQUIRE(value == 20);
+      REQUIRE(map.output(4, value) == PF::IndexStatus::out_of_bounds);
+      REQUIRE(value == 20);
+    }
+
+    WHEN("The value of key 2 is replaced with 200") {
+      auto status = map.input(2, 200);
+
+      THEN("The input method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The size method reports size as 3") { REQUIRE(map.size() == 3); }
+      THEN("The key keeps its position in the order of insertion") {
+        REQUIRE(items_of(map) == Pairs{{1, 10}, {2, 200}, {3, 30}});
+      }
+    }
+
+    WHEN("The pair with key 4 is input, and then a pair with key 5 is input") {
+      auto status4 = map.input(4, 40);
+      auto status5 = map.input(5, 50);
+
+      THEN("The input method returns ok status for key 4") {
+        REQUIRE(status4 == PF::IndexStatus::ok);
+      }
+      THEN("The input method returns out of bounds status for key 5") {
+        REQUIRE(status5 == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The full method reports that the map is full") { REQUIRE(map.full() == true); }
+      THEN("The has method returns false for key 5") { REQUIRE(map.has(5) == false); }
+    }
+
+    WHEN("The pair with key 2 is erased") {
+      auto status = map.erase(2);
+
+      THEN("The erase method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The size method reports size as 2") { REQUIRE(map.size() == 2); }
+      THEN("The has method returns false for key 2") { REQUIRE(map.has(2) == false); }
+      THEN("The erase method returns out of bounds status if key 2 is erased again") {
+        REQUIRE(map.erase(2) == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The remaining pairs keep their order of insertion") {
+        REQUIRE(items_of(map) == Pairs{{1, 10}, {3, 30}});
+      }
+    }
+
+    WHEN("The pair with key 1 is erased and then re-input") {
+      map.erase(1);
+      map.input(1, 100);
+
+      THEN("The re-input pair is last in the order of insertion") {
+        REQUIRE(items_of(map) == Pairs{{2, 20}, {3, 30}, {1, 100}});
+      }
+    }
+
+    WHEN("Every pair is erased and then 4 new pairs are input") {
+      map.erase(3);
+      map.erase(1);
+      map.erase(2);
+      bool empty = map.empty();
+      for (uint32_t key = 5; key < 9; ++key) {
+        REQUIRE(map.input(key, key) == PF::IndexStatus::ok);
+      }
+
+      THEN("The map was empty after the pairs were erased") { REQUIRE(empty == true); }
+      THEN("The erased nodes are reused for the new pairs") {
+        REQUIRE(items_of(map) == Pairs{{5, 5}, {6, 6}, {7, 7}, {8, 8}});
+        REQUIRE(map.full() == true);
+      }
+    }
+
+    WHEN("The clear method is called") {
+      map.clear();
+
+      THEN("The empty method reports that the map is empty") { REQUIRE(map.empty() == true); }
+      THEN("The has method returns false for keys 1-3") {
+        REQUIRE(map.has(1) == false);
+        REQUIRE(map.has(2) == false);
+        REQUIRE(map.has(3) == false);
+      }
+      THEN("The for_each method visits no pairs") { REQUIRE(items_of(map).empty()); }
+    }
+  }
+}
+
+SCENARIO("The HashedOrderedMap behaves like an OrderedMap under hash collisions") {
+  GIVEN("HashedOrderedMaps whose hashes collide, and an OrderedMap, each with capacity 12") {
+    PF::Util::Containers::HashedOrderedMap<uint32_t, uint32_t, 12> hashed;
+    PF::Util::Containers::HashedOrderedMap<uint32_t, uint32_t, 12, CollidingHash> colliding;
+    PF::Util::Containers::HashedOrderedMap<uint32_t, uint32_t, 12, ClusteringHash> clustering;
+    PF::Util::Containers::OrderedMap<uint32_t, uint32_t, 12> ordered;
+
+    WHEN("The same pseudorandom sequence of inputs and erasures is applied to every map") {
+      static const size_t num_operations = 20000;
+      static const uint32_t num_keys = 40;
+      uint32_t state = 1;
+      size_t mismatches = 0;
+      for (size_t i = 0; i < num_operations; ++i) {
+        state = state * 1103515245U + 12345U;
+        uint32_t key = (state >> 16U) % num_keys;
+        bool erasing = ((state >> 8U) % 3) == 0;
+
+        PF::IndexStatus expected = erasing ? ordered.erase(key) : ordered.input(key, i);
+        if ((erasing ? hashed.erase(key) : hashed.input(key, i)) != expected) {
+          ++mismatches;
+        }
+        if ((erasing ? colliding.erase(key) : colliding.input(key, i)) != expected) {
+          ++mismatches;
+        }
+        if ((erasing ? clustering.erase(key) : clustering.input(key, i)) != expected) {
+          ++mismatches;
+        }
+        for (uint32_t probe = 0; probe < num_keys; ++probe) {
+          bool has = ordered.has(probe);
+          if (hashed.has(probe) != has || colliding.has(probe) != has ||
+              clustering.has(probe) != has) {
+            ++mismatches;
+          }
+        }
+      }
+
+      Pairs expected_items;
+      for (const auto &pair : ordered.items()) {
+        expected_items.emplace_back(pair.first, pair.second);
+      }
+
+      THEN("Every operation returns the same status, and every map has the same keys") {
+        REQUIRE(mismatches == 0);
+      }
+      THEN("Every map has the same pairs in the same order") {
+        REQUIRE(items_of(hashed) == expected_items);
+        REQUIRE(items_of(colliding) == expected_items);
+        REQUIRE(items_of(clustering) == expected_items);
+      }
+    }
+  }
+}
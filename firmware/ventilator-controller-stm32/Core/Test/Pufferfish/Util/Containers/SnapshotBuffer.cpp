@@ -0,0 +1,149 @@
+/// SnapshotBuffer.cpp
+/// Unit tests to confirm behavior of the lock-free snapshot double buffer.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/Containers/SnapshotBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+namespace {
+
+// Every element of a record is set to the same value, so a torn read shows up as a record
+// whose elements differ
+using Record = std::array<uint32_t, 64>;
+
+Record make_record(uint32_t value) {
+  Record record{};
+  record.fill(value);
+  return record;
+}
+
+bool consistent(const Record &record) {
+  for (const auto &element : record) {
+    if (element != record[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+SCENARIO("SnapshotBuffer reads back the most recently written value", "[SnapshotBuffer]") {
+  GIVEN("A SnapshotBuffer constructed with an initial record of 7s") {
+    PF::Util::Containers::SnapshotBuffer<Record> buffer{make_record(7)};
+
+    WHEN("A snapshot is read without any writes") {
+      Record snapshot{};
+      auto status = buffer.read(snapshot);
+
+      THEN("The read method returns ok status") {
+        REQUIRE(status == PF::Util::Containers::SnapshotBuffer<Record>::Status::ok);
+      }
+      THEN("The snapshot is the initial record") { REQUIRE(snapshot == make_record(7)); }
+      THEN("The version method returns 0") { REQUIRE(buffer.version() == 0); }
+    }
+
+    WHEN("A record of 1s is written and then a snapshot is read") {
+      buffer.write(make_record(1));
+      Record snapshot{};
+      auto status = buffer.read(snapshot);
+
+      THEN("The read method returns ok status") {
+        REQUIRE(status == PF::Util::Containers::SnapshotBuffer<Record>::Status::ok);
+      }
+      THEN("The snapshot is the record of 1s") { REQUIRE(snapshot == make_record(1)); }
+      THEN("The version method returns 1") { REQUIRE(buffer.version() == 1); }
+    }
+
+    WHEN("Records of 1s, 2s, and 3s are written and then a snapshot is read") {
+      buffer.write(make_record(1));
+      buffer.write(make_record(2));
+      buffer.write(make_record(3));
+      Record snapshot{};
+      auto status = buffer.read(snapshot);
+
+      THEN("The read method returns ok status") {
+        REQUIRE(status == PF::Util::Containers::SnapshotBuffer<Record>::Status::ok);
+      }
+      THEN("The snapshot is the record of 3s") { REQUIRE(snapshot == make_record(3)); }
+      THEN("The version method returns 3") { REQUIRE(buffer.version() == 3); }
+    }
+  }
+}
+
+SCENARIO(
+    "SnapshotBuffer never returns torn snapshots while being written concurrently",
+    "[SnapshotBuffer]") {
+  GIVEN("A SnapshotBuffer whose records are written in a separate thread") {
+    PF::Util::Containers::SnapshotBuffer<Record> buffer{make_record(0)};
+    static const uint32_t num_writes = 200000;
+
+    WHEN("Snapshots are repeatedly read until the writer finishes") {
+      std::atomic<bool> writing{true};
+      std::thread writer([&buffer, &writing]() {
+        for (uint32_t i = 1; i <= num_writes; ++i) {
+          buffer.write(make_record(i));
+        }
+        writing = false;
+      });
+
+      size_t ok_reads = 0;
+      size_t torn_reads = 0;
+      size_t out_of_order_reads = 0;
+      uint32_t previous = 0;
+      do {
+        Record snapshot{};
+        if (buffer.read(snapshot) != PF::Util::Containers::SnapshotBuffer<Record>::Status::ok) {
+          continue;
+        }
+
+        ++ok_reads;
+        if (!consistent(snapshot)) {
+          ++torn_reads;
+        }
+        if (snapshot[0] < previous) {
+          ++out_of_order_reads;
+        }
+        previous = snapshot[0];
+      } while (writing);
+      writer.join();
+
+      THEN("At least one snapshot was read successfully") { REQUIRE(ok_reads > 0); }
+      THEN("No successfully-read snapshot is torn") { REQUIRE(torn_reads == 0); }
+      THEN("Successfully-read snapshots never go back to older versions") {
+        REQUIRE(out_of_order_reads == 0);
+      }
+      THEN("After the writer finishes, a snapshot of the last record is read") {
+        Record snapshot{};
+        auto status = buffer.read(snapshot);
+        REQUIRE(status == PF::Util::Containers::SnapshotBuffer<Record>::Status::ok);
+        REQUIRE(snapshot == make_record(num_writes));
+        REQUIRE(buffer.version() == num_writes);
+      }
+    }
+  }
+}
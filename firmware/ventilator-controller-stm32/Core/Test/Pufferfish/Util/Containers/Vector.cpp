@@ -10,8 +10,10 @@
 
 #include "Pufferfish/Util/Containers/Vector.h"
 
+#include <array>
 #include <initializer_list>
 #include <iostream>
+#include <vector>
 
 #include "Pufferfish/Util/Containers/Array.h"
 #include "catch2/catch.hpp"
@@ -2001,3 +2003,241 @@ SCENARIO("The vector created from initializer list works correctly") {
     }
   }
 }
+
+namespace {
+
+using Elements = std::vector<uint32_t>;
+
+template <size_t array_size>
+Elements elements_of(const PF::Util::Containers::Vector<uint32_t, array_size> &vector) {
+  return Elements(vector.begin(), vector.end());
+}
+
+// Builds a Vector at compile time, using only constexpr methods
+constexpr ByteVector<8> make_constexpr_vector() {
+  ByteVector<8> vector{1, 2, 3, 4, 5};
+  vector.erase(0);
+  vector.swap_erase(0);
+  vector.insert(1, 9);
+  vector.push_back(6);
+  vector.erase_range(2, 3);
+  vector.resize(vector.size() + 1);
+  return vector;
+}
+
+}  // namespace
+
+SCENARIO("The methods in Vector can be used in constexpr contexts") {
+  GIVEN("A ByteVector built at compile time from {1, 2, 3, 4, 5} with constexpr methods") {
+    static constexpr ByteVector<8> vector = make_constexpr_vector();
+
+    THEN("The size method reports size as 5 at compile time") {
+      static_assert(vector.size() == 5, "Unexpected size");
+      REQUIRE(vector.size() == 5);
+    }
+    THEN("The Vector has the expected sequence of bytes at compile time") {
+      static_assert(vector[0] == 5 && vector[1] == 9 && vector[2] == 4, "Unexpected elements");
+      static_assert(vector[3] == 6 && vector[4] == 0, "Unexpected elements");
+      REQUIRE(vector[1] == 9);
+    }
+  }
+}
+
+SCENARIO("The method in Vector: swap_erase works correctly") {
+  GIVEN("A uint32_t vector with capacity 8, with elements {10, 11, 12, 13, 14}") {
+    PF::Util::Containers::Vector<uint32_t, 8> vector{10, 11, 12, 13, 14};
+
+    WHEN("The swap_erase method is called on index 1") {
+      auto status = vector.swap_erase(1);
+
+      THEN("The swap_erase method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The last element is moved into the erased position") {
+        REQUIRE(elements_of(vector) == Elements{10, 14, 12, 13});
+      }
+    }
+
+    WHEN("The swap_erase method is called on the last index") {
+      auto status = vector.swap_erase(4);
+
+      THEN("The swap_erase method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The other elements are unchanged") {
+        REQUIRE(elements_of(vector) == Elements{10, 11, 12, 13});
+      }
+    }
+
+    WHEN("The swap_erase method is called on index 5") {
+      auto status = vector.swap_erase(5);
+
+      THEN("The swap_erase method returns out of bounds status") {
+        REQUIRE(status == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The vector is unchanged") {
+        REQUIRE(elements_of(vector) == Elements{10, 11, 12, 13, 14});
+      }
+    }
+  }
+}
+
+SCENARIO("The method in Vector: erase_range works correctly") {
+  GIVEN("A uint32_t vector with capacity 8, with elements {10, 11, 12, 13, 14, 15}") {
+    PF::Util::Containers::Vector<uint32_t, 8> vector{10, 11, 12, 13, 14, 15};
+
+    WHEN("The erase_range method is called on indices 1 to 4") {
+      auto status = vector.erase_range(1, 4);
+
+      THEN("The erase_range method returns ok status") {
+        REQUIRE(status == PF::IndexStatus::ok);
+      }
+      THEN("The remaining elements keep their order") {
+        REQUIRE(elements_of(vector) == Elements{10, 14, 15});
+      }
+    }
+
+    WHEN("The erase_range method is called on indices 0 to 6") {
+      auto status = vector.erase_range(0, 6);
+
+      THEN("The erase_range method returns ok status") {
+        REQUIRE(status == PF::IndexStatus::ok);
+      }
+      THEN("The empty method reports that the vector is empty") { REQUIRE(vector.empty()); }
+    }
+
+    WHEN("The erase_range method is called on indices 4 to 7, or on indices 3 to 3") {
+      auto past_end_status = vector.erase_range(4, 7);
+      auto empty_range_status = vector.erase_range(3, 3);
+
+      THEN("The erase_range method returns out of bounds status") {
+        REQUIRE(past_end_status == PF::IndexStatus::out_of_bounds);
+        REQUIRE(empty_range_status == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The vector is unchanged") {
+        REQUIRE(elements_of(vector) == Elements{10, 11, 12, 13, 14, 15});
+      }
+    }
+  }
+}
+
+SCENARIO("The method in Vector: insert works correctly") {
+  GIVEN("A uint32_t vector with capacity 5, with elements {10, 11, 12}") {
+    PF::Util::Containers::Vector<uint32_t, 5> vector{10, 11, 12};
+
+    WHEN("The insert method is called on index 0, and then on index 4") {
+      auto front_status = vector.insert(0, 9);
+      auto back_status = vector.insert(4, 13);
+
+      THEN("The insert method returns ok status") {
+        REQUIRE(front_status == PF::IndexStatus::ok);
+        REQUIRE(back_status == PF::IndexStatus::ok);
+      }
+      THEN("The elements are inserted in place") {
+        REQUIRE(elements_of(vector) == Elements{9, 10, 11, 12, 13});
+      }
+      THEN("The insert method returns out of bounds status once the vector is full") {
+        REQUIRE(vector.insert(2, 0) == PF::IndexStatus::out_of_bounds);
+        REQUIRE(elements_of(vector) == Elements{9, 10, 11, 12, 13});
+      }
+    }
+
+    WHEN("The insert method is called on index 4") {
+      auto status = vector.insert(4, 13);
+
+      THEN("The insert method returns out of bounds status") {
+        REQUIRE(status == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The vector is unchanged") { REQUIRE(elements_of(vector) == Elements{10, 11, 12}); }
+    }
+  }
+}
+
+SCENARIO("The method in Vector: append works correctly") {
+  GIVEN("A ByteVector with capacity 8, with bytes {1, 2, 3}") {
+    ByteVector<8> vector{1, 2, 3};
+
+    WHEN("An array of 4 bytes is appended, and then a vector of 1 byte is appended") {
+      std::array<uint8_t, 4> array{4, 5, 6, 7};
+      ByteVector<4> source{8};
+      auto array_status = vector.append(array);
+      auto vector_status = vector.append(source);
+
+      THEN("The append method returns ok status") {
+        REQUIRE(array_status == PF::IndexStatus::ok);
+        REQUIRE(vector_status == PF::IndexStatus::ok);
+      }
+      THEN("The bytes are added to the end of the vector") {
+        REQUIRE(vector.full());
+        for (size_t i = 0; i < 8; ++i) {
+          REQUIRE(vector[i] == i + 1);
+        }
+      }
+    }
+
+    WHEN("6 bytes are appended") {
+      std::array<uint8_t, 6> array{4, 5, 6, 7, 8, 9};
+      auto status = vector.append(array.data(), array.size());
+
+      THEN("The append method returns out of bounds status") {
+        REQUIRE(status == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("No bytes are added") { REQUIRE(vector.size() == 3); }
+    }
+  }
+
+  GIVEN("A vector of std::vectors, which are not trivially copyable, with capacity 3") {
+    PF::Util::Containers::Vector<std::vector<uint32_t>, 3> vector;
+    vector.push_back(Elements{1, 2});
+
+    WHEN("An array of 2 std::vectors is appended") {
+      std::array<std::vector<uint32_t>, 2> array{Elements{3}, Elements{4, 5, 6}};
+      auto status = vector.append(array);
+
+      THEN("The append method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The std::vectors are copied element-wise") {
+        REQUIRE(vector[0] == Elements{1, 2});
+        REQUIRE(vector[1] == Elements{3});
+        REQUIRE(vector[2] == Elements{4, 5, 6});
+        REQUIRE(array[1] == Elements{4, 5, 6});
+      }
+    }
+  }
+}
+
+SCENARIO("The methods in Vector: resize and resize_uninitialized work correctly") {
+  GIVEN("A ByteVector with capacity 8 whose bytes were all set to 0xff, then cleared") {
+    ByteVector<8> vector{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    vector.clear();
+
+    WHEN("The resize method is called for new size 4") {
+      auto status = vector.resize(4);
+
+      THEN("The resize method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+      THEN("The added bytes are value-initialized") {
+        for (size_t i = 0; i < 4; ++i) {
+          REQUIRE(vector[i] == 0);
+        }
+      }
+    }
+
+    WHEN("The resize_uninitialized method is called for new size 4") {
+      auto status = vector.resize_uninitialized(4);
+
+      THEN("The resize_uninitialized method returns ok status") {
+        REQUIRE(status == PF::IndexStatus::ok);
+      }
+      THEN("The size method reports size as 4") { REQUIRE(vector.size() == 4); }
+      THEN("The added bytes keep their previous values") {
+        for (size_t i = 0; i < 4; ++i) {
+          REQUIRE(vector[i] == 0xff);
+        }
+      }
+    }
+
+    WHEN("The resize_uninitialized method is called for new size 9") {
+      auto status = vector.resize_uninitialized(9);
+
+      THEN("The resize_uninitialized method returns out of bounds status") {
+        REQUIRE(status == PF::IndexStatus::out_of_bounds);
+      }
+      THEN("The size method reports size as 0") { REQUIRE(vector.size() == 0); }
+    }
+  }
+}
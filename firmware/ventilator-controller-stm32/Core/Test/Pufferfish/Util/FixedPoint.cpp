@@ -0,0 +1,158 @@
+/// FixedPoint.cpp
+/// Unit tests to confirm behavior of the saturating fixed-point numbers.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/FixedPoint.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Pufferfish/Util/Numeric.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+using PF::Util::Q15;
+using PF::Util::Q31;
+
+SCENARIO("Fixed-point numbers are converted from and to floats", "[fixed_point]") {
+  GIVEN("Floats within the range of Q15") {
+    WHEN("They're converted to Q15") {
+      THEN("They're rounded to the nearest representable value") {
+        REQUIRE(Q15(0).raw() == 0);
+        REQUIRE(Q15(0.5F).raw() == 16384);
+        REQUIRE(Q15(-0.25F).raw() == -8192);
+        REQUIRE(Q15(1.4F / 32768).raw() == 1);
+        REQUIRE(Q15(1.6F / 32768).raw() == 2);
+        REQUIRE(Q15(-1.6F / 32768).raw() == -2);
+      }
+
+      THEN("They're converted back to floats within half of the resolution") {
+        for (float value : {0.F, 0.1F, -0.3F, 0.999F, -0.999F}) {
+          REQUIRE(std::abs(static_cast<float>(Q15(value)) - value) <= 0.5F / 32768);
+        }
+      }
+    }
+  }
+
+  GIVEN("Floats outside of the range of Q15 and Q31") {
+    WHEN("They're converted to fixed-point") {
+      THEN("They saturate symmetrically") {
+        REQUIRE(Q15(1).raw() == 32767);
+        REQUIRE(Q15(-1).raw() == -32767);
+        REQUIRE(Q15(100).raw() == 32767);
+        REQUIRE(Q31(1).raw() == 2147483647);
+        REQUIRE(Q31(-1).raw() == -2147483647);
+        REQUIRE(Q31(-100).raw() == -2147483647);
+      }
+    }
+  }
+
+  GIVEN("A float NaN") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    WHEN("It's converted to Q15 and back") {
+      Q15 fixed(nan);
+
+      THEN("The fixed-point number is the NaN marker, which converts back to NaN") {
+        REQUIRE(fixed.is_nan());
+        REQUIRE(fixed.raw() == std::numeric_limits<int16_t>::min());
+        REQUIRE(std::isnan(static_cast<float>(fixed)));
+      }
+    }
+  }
+}
+
+SCENARIO("Fixed-point arithmetic saturates and is bit-exact", "[fixed_point]") {
+  GIVEN("Q15 numbers") {
+    WHEN("They're added and subtracted without overflow") {
+      THEN("The results are exact") {
+        REQUIRE((Q15(0.25F) + Q15(0.5F)).raw() == 24576);
+        REQUIRE((Q15(0.25F) - Q15(0.5F)).raw() == -8192);
+        REQUIRE((-Q15(0.25F)).raw() == -8192);
+      }
+    }
+
+    WHEN("They're added and subtracted with overflow") {
+      THEN("The results saturate to the largest magnitude, and never to the NaN marker") {
+        REQUIRE((Q15(0.75F) + Q15(0.75F)) == Q15::max());
+        REQUIRE((Q15(-0.75F) - Q15(0.75F)) == Q15::lowest());
+        REQUIRE(!(Q15::lowest() - Q15::max()).is_nan());
+        REQUIRE((-Q15::lowest()) == Q15::max());
+      }
+    }
+
+    WHEN("They're multiplied") {
+      THEN("The products are truncated towards negative infinity") {
+        REQUIRE((Q15(0.5F) * Q15(0.5F)).raw() == 8192);
+        REQUIRE((Q15::from_raw(3) * Q15(0.5F)).raw() == 1);
+        REQUIRE((Q15::from_raw(-3) * Q15(0.5F)).raw() == -2);
+        REQUIRE((Q15::max() * Q15::max()).raw() == 32766);
+        REQUIRE((Q15::lowest() * Q15::lowest()).raw() == 32766);
+      }
+    }
+  }
+
+  GIVEN("Q31 numbers") {
+    WHEN("They're multiplied and accumulated") {
+      Q31 accumulator{};
+      for (int i = 0; i < 4; ++i) {
+        accumulator += Q31(0.1F) * Q31(0.5F);
+      }
+
+      THEN("The result matches the float computation within the resolution of float") {
+        REQUIRE(accumulator.raw() == 429496736);
+        REQUIRE(static_cast<float>(accumulator) == Approx(0.2F).margin(1e-7));
+      }
+    }
+
+    WHEN("They're compared") {
+      THEN("The comparisons match the comparisons of the floats") {
+        REQUIRE(Q31(0.1F) < Q31(0.2F));
+        REQUIRE(Q31(-0.1F) <= Q31(-0.1F));
+        REQUIRE(Q31(0.3F) > Q31(-0.3F));
+        REQUIRE(Q31(0.3F) != Q31(-0.3F));
+      }
+    }
+  }
+}
+
+SCENARIO("The numeric policies provide NaN markers and absolute values", "[fixed_point]") {
+  GIVEN("The float and Q15 policies") {
+    using FloatPolicy = PF::Util::Numeric<float>;
+    using Q15Policy = PF::Util::Numeric<Q15>;
+
+    THEN("Their NaN markers are recognized as NaN") {
+      REQUIRE(FloatPolicy::is_nan(FloatPolicy::nan()));
+      REQUIRE(Q15Policy::is_nan(Q15Policy::nan()));
+      REQUIRE(!Q15Policy::is_nan(Q15::lowest()));
+    }
+
+    THEN("Their absolute values agree") {
+      REQUIRE(FloatPolicy::abs(-0.5F) == 0.5F);
+      REQUIRE(Q15Policy::abs(Q15(-0.5F)) == Q15(0.5F));
+      REQUIRE(Q15Policy::abs(Q15::lowest()) == Q15::max());
+    }
+
+    THEN("Only the Q15 policy requires values to be scaled") {
+      REQUIRE(!FloatPolicy::is_fixed_point);
+      REQUIRE(Q15Policy::is_fixed_point);
+    }
+  }
+}
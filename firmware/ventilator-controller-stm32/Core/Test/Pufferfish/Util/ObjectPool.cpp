@@ -0,0 +1,172 @@
+/// ObjectPool.cpp
+/// Unit tests to confirm behavior of the object pool and its handles.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/ObjectPool.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "Pufferfish/Statuses.h"
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+namespace {
+
+// Counts how many instances are alive, to check that the pool destroys its objects
+struct Tracked {
+  static int alive;
+
+  Tracked() { ++alive; }
+  Tracked(const Tracked &) = delete;
+  Tracked &operator=(const Tracked &) = delete;
+  ~Tracked() { --alive; }
+
+  uint32_t value = 0;
+};
+
+int Tracked::alive = 0;
+
+}  // namespace
+
+SCENARIO("The ObjectPool lends out objects through handles", "[objectpool]") {
+  GIVEN("An empty ObjectPool with capacity 2") {
+    Tracked::alive = 0;
+    using Pool = PF::Util::ObjectPool<Tracked, 2>;
+    Pool pool;
+
+    THEN("The size method reports that no objects are in use") {
+      REQUIRE(pool.size() == 0);
+      REQUIRE(pool.available() == 2);
+      REQUIRE(pool.max_size() == 2);
+      REQUIRE(pool.high_water_mark() == 0);
+      REQUIRE(Tracked::alive == 0);
+    }
+
+    WHEN("An object is acquired") {
+      Pool::Handle handle;
+      REQUIRE(!handle.valid());
+      auto status = pool.acquire(handle);
+
+      THEN("The acquire method returns ok status") { REQUIRE(status == PF::IndexStatus::ok); }
+
+      THEN("The handle owns a value-initialized object") {
+        REQUIRE(handle.valid());
+        REQUIRE(handle->value == 0);
+        REQUIRE((*handle).value == 0);
+        REQUIRE(Tracked::alive == 1);
+      }
+
+      THEN("The size and high water mark methods report that 1 object is in use") {
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.available() == 1);
+        REQUIRE(pool.high_water_mark() == 1);
+      }
+
+      THEN("Releasing the handle destroys the object and returns its slot") {
+        handle.release();
+        REQUIRE(!handle.valid());
+        REQUIRE(Tracked::alive == 0);
+        REQUIRE(pool.size() == 0);
+        REQUIRE(pool.high_water_mark() == 1);
+      }
+    }
+
+    WHEN("Every slot is in use") {
+      Pool::Handle first;
+      Pool::Handle second;
+      Pool::Handle third;
+      pool.acquire(first);
+      pool.acquire(second);
+      auto status = pool.acquire(third);
+
+      THEN("The acquire method returns out of bounds status") {
+        REQUIRE(status == PF::IndexStatus::out_of_bounds);
+        REQUIRE(!third.valid());
+        REQUIRE(pool.size() == 2);
+        REQUIRE(Tracked::alive == 2);
+      }
+
+      THEN("A slot released out of order can be acquired again") {
+        first->value = 1;
+        second->value = 2;
+        Tracked *released = &*first;
+        first.release();
+        REQUIRE(pool.acquire(third) == PF::IndexStatus::ok);
+        REQUIRE(&*third == released);
+        REQUIRE(third->value == 0);
+        REQUIRE(second->value == 2);
+        REQUIRE(pool.high_water_mark() == 2);
+      }
+    }
+
+    WHEN("A handle goes out of scope") {
+      {
+        Pool::Handle handle;
+        pool.acquire(handle);
+        REQUIRE(Tracked::alive == 1);
+      }
+
+      THEN("Its object is destroyed and its slot is returned") {
+        REQUIRE(Tracked::alive == 0);
+        REQUIRE(pool.size() == 0);
+      }
+    }
+
+    WHEN("A handle is moved") {
+      Pool::Handle source;
+      pool.acquire(source);
+      source->value = 5;
+      Pool::Handle destination(std::move(source));
+
+      THEN("The object is owned by the destination and not by the source") {
+        REQUIRE(!source.valid());  // NOLINT(bugprone-use-after-move)
+        REQUIRE(destination.valid());
+        REQUIRE(destination->value == 5);
+        REQUIRE(Tracked::alive == 1);
+        REQUIRE(pool.size() == 1);
+      }
+
+      THEN("Move-assigning over a handle releases the object it owned") {
+        Pool::Handle other;
+        pool.acquire(other);
+        REQUIRE(Tracked::alive == 2);
+        other = std::move(destination);
+        REQUIRE(Tracked::alive == 1);
+        REQUIRE(pool.size() == 1);
+        REQUIRE(other->value == 5);
+      }
+    }
+
+    WHEN("A handle which already owns an object acquires another one") {
+      Pool::Handle handle;
+      pool.acquire(handle);
+      handle->value = 7;
+      pool.acquire(handle);
+
+      THEN("The previous object is released first") {
+        REQUIRE(Tracked::alive == 1);
+        REQUIRE(pool.size() == 1);
+        REQUIRE(handle->value == 0);
+        REQUIRE(pool.high_water_mark() == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,125 @@
+/// StackMonitor.cpp
+/// Unit tests to confirm behavior of the stack high-water mark monitor.
+
+// Copyright (c) 2020 Pez-Globo and the Pufferfish project contributors
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied.
+//
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pufferfish/Util/StackMonitor.h"
+
+#include <array>
+#include <cstdint>
+
+#include "catch2/catch.hpp"
+
+namespace PF = Pufferfish;
+
+SCENARIO("The StackMonitor measures the high-water mark of a painted stack", "[stackmonitor]") {
+  GIVEN("A StackMonitor for a 1024-word stack which is painted from its top") {
+    static const size_t num_words = 1024;
+    static const size_t guard_words = PF::Util::StackMonitor::paint_guard / sizeof(uint32_t);
+    std::array<uint32_t, num_words> stack{};
+    uint32_t *top = stack.data() + num_words;
+    PF::Util::StackMonitor monitor(stack.data(), top);
+    monitor.paint(top);
+
+    THEN("The size method reports the size of the stack in bytes") {
+      REQUIRE(monitor.size() == num_words * sizeof(uint32_t));
+    }
+
+    THEN("Everything below the paint guard is painted") {
+      for (size_t i = 0; i < num_words - guard_words; ++i) {
+        REQUIRE(stack[i] == PF::Util::StackMonitor::paint_pattern);
+      }
+      REQUIRE(stack[num_words - guard_words] == 0);
+    }
+
+    THEN("The high-water mark initially covers the paint guard") {
+      REQUIRE(monitor.high_water_mark() == PF::Util::StackMonitor::paint_guard);
+    }
+
+    WHEN("The stack is scanned without any further usage") {
+      bool changed = monitor.update(num_words);
+
+      THEN("The high-water mark doesn't change") {
+        REQUIRE(!changed);
+        REQUIRE(monitor.high_water_mark() == PF::Util::StackMonitor::paint_guard);
+      }
+    }
+
+    WHEN("Words below the paint guard are used, leaving a painted gap above the deepest word") {
+      const size_t deepest = 100;
+      stack[deepest] = 0;
+      stack[deepest + 50] = 0;  // NOLINT(readability-magic-numbers)
+      bool changed = monitor.update(num_words);
+
+      THEN("A full scan finds the deepest used word") {
+        REQUIRE(changed);
+        REQUIRE(monitor.high_water_mark() == (num_words - deepest) * sizeof(uint32_t));
+      }
+
+      THEN("Usage above the high-water mark doesn't change it") {
+        stack[deepest + 1] = 0;
+        REQUIRE(!monitor.update(num_words));
+        REQUIRE(monitor.high_water_mark() == (num_words - deepest) * sizeof(uint32_t));
+      }
+    }
+
+    WHEN("The stack is scanned a few words at a time") {
+      const size_t deepest = 500;
+      const size_t words_per_update = 64;
+      stack[deepest] = 0;
+      size_t num_updates = 0;
+      while (!monitor.update(words_per_update)) {
+        ++num_updates;
+        REQUIRE(num_updates * words_per_update <= num_words);
+      }
+
+      THEN("The deepest used word is found after enough updates to reach it") {
+        REQUIRE(num_updates == deepest / words_per_update);
+        REQUIRE(monitor.high_water_mark() == (num_words - deepest) * sizeof(uint32_t));
+      }
+
+      THEN("Deeper usage is found by the next pass") {
+        stack[10] = 0;  // NOLINT(readability-magic-numbers)
+        REQUIRE(monitor.update(words_per_update));
+        REQUIRE(monitor.high_water_mark() == (num_words - 10) * sizeof(uint32_t));
+      }
+    }
+
+    WHEN("The entire stack is used") {
+      stack[0] = 0;
+      monitor.update(1);
+
+      THEN("The high-water mark is the size of the stack") {
+        REQUIRE(monitor.high_water_mark() == monitor.size());
+      }
+    }
+  }
+
+  GIVEN("A StackMonitor whose stack pointer is within the paint guard of the bottom") {
+    std::array<uint32_t, 16> stack{};
+    PF::Util::StackMonitor monitor(stack.data(), stack.data() + stack.size());
+    monitor.paint(stack.data() + stack.size());
+
+    THEN("Nothing is painted, so the entire stack is considered used") {
+      for (uint32_t word : stack) {
+        REQUIRE(word == 0);
+      }
+      REQUIRE(monitor.high_water_mark() == monitor.size());
+    }
+  }
+}
@@ -0,0 +1,179 @@
+#!/bin/bash
+# Attributes the static RAM and the stack frames of a linked firmware image to Pufferfish
+# namespaces, so that the components which use the most memory can be found after every build.
+#
+# Usage: ./memory-budget-report.sh <firmware.map> <build directory> [report file]
+# Static RAM is read from the linker map, which lists every input section placed in RAM; with
+# -fdata-sections, each object gets its own section named after its symbol. Stack frames are read
+# from the .su files which -fstack-usage writes next to each object file in the build directory.
+# Symbols are grouped by their first NAMESPACE_DEPTH (by default 3) scopes, e.g.
+# Pufferfish::Driver::Serial; symbols outside of any scope are grouped by the file defining them.
+# The CXXFILT environment variable can be set to override the demangler which is used.
+#
+# Stack frames are reported per function, since a call graph isn't available from the .su files;
+# the worst-case stack depth at runtime is reported by the firmware's stack monitor instead.
+
+if [ "$#" -lt 2 ]; then
+  echo "Usage: $0 <firmware.map> <build directory> [report file]"
+  exit 1
+fi
+
+MAP_FILE="$1"
+BUILD_DIR="$2"
+REPORT_FILE="${3:-/dev/stdout}"
+CXXFILT="${CXXFILT:-arm-none-eabi-c++filt}"
+NAMESPACE_DEPTH="${NAMESPACE_DEPTH:-3}"
+
+# Awk function which returns the group of a demangled symbol or function signature, or "" if it
+# isn't in any scope
+GROUP_FUNCTION='
+  function group(name,    depth, i, c, start, scopes, num_scopes, result) {
+    sub(/^[a-z ]+ for /, "", name)  # e.g. "guard variable for ..."
+    # Drop the parameter list and everything after it, along with any return type before the name
+    depth = 0
+    start = 1
+    for (i = 1; i <= length(name); ++i) {
+      c = substr(name, i, 1)
+      if (c == "<") { ++depth }
+      else if (c == ">") { --depth }
+      else if (depth == 0 && c == " ") { start = i + 1 }
+      else if (depth == 0 && c == "(") { break }
+    }
+    name = substr(name, start, i - start)
+    # Split the qualified name into its scopes, ignoring any "::" within template arguments
+    depth = 0
+    num_scopes = 0
+    start = 1
+    for (i = 1; i < length(name); ++i) {
+      c = substr(name, i, 1)
+      if (c == "<") { ++depth }
+      else if (c == ">") { --depth }
+      else if (depth == 0 && substr(name, i, 2) == "::") {
+        scopes[++num_scopes] = substr(name, start, i - start)
+        start = i + 2
+        ++i
+      }
+    }
+    if (num_scopes == 0) { return "" }
+    result = scopes[1]
+    for (i = 2; i <= num_scopes && i <= max_depth; ++i) { result = result "::" scopes[i] }
+    return result
+  }
+  function file_group(file) {
+    sub(/\(.*$/, "", file)  # member of an archive
+    sub(/^.*\//, "", file)
+    sub(/\.(obj|o)$/, "", file)
+    return "(" file ")"
+  }
+'
+
+TEMP_DIR=`mktemp -d`
+trap 'rm -rf "$TEMP_DIR"' EXIT
+
+# Input sections placed in RAM, as "size<tab>file<tab>symbol" lines. An input section is listed on
+# one line followed by its address, size and file, or on two lines if its name is long.
+awk '
+  function hex(value,    result, i, digit) {
+    sub(/^0[xX]/, "", value)
+    result = 0
+    for (i = 1; i <= length(value); ++i) {
+      digit = index("0123456789abcdef", tolower(substr(value, i, 1))) - 1
+      result = result * 16 + digit
+    }
+    return result
+  }
+  function emit(size, file,    symbol) {
+    if (hex(size) == 0) { return }
+    symbol = section
+    sub(/^\.(data|bss|dtcm_data|dma_buffers)\.?/, "", symbol)
+    if (symbol == "") { symbol = "-" }
+    printf "%d\t%s\t%s\n", hex(size), file, symbol
+  }
+  /^Linker script and memory map/ { in_map = 1; next }
+  !in_map { next }
+  /^ \.(data|bss|dtcm_data|dma_buffers)([. \t]|$)/ {
+    section = $1
+    if (NF >= 4 && $2 ~ /^0x/) { emit($3, $4); section = "" }
+    next
+  }
+  section != "" {
+    if (NF >= 3 && $1 ~ /^0x/) { emit($2, $3) }
+    section = ""
+  }
+' "$MAP_FILE" > "$TEMP_DIR/sections"
+if [ ! -s "$TEMP_DIR/sections" ]; then
+  echo "No RAM input sections found in $MAP_FILE"
+  exit 1
+fi
+cut -f 3 "$TEMP_DIR/sections" | "$CXXFILT" > "$TEMP_DIR/symbols"
+cut -f 1,2 "$TEMP_DIR/sections" | paste - "$TEMP_DIR/symbols" > "$TEMP_DIR/static"
+
+# Stack frames, as "size<tab>qualifiers<tab>file<tab>signature" lines
+find "$BUILD_DIR" -name '*.su' -exec cat {} + | awk -F '\t' '
+  {
+    signature = $1
+    file = $1
+    sub(/^[^:]*:[0-9]+:[0-9]+:/, "", signature)
+    sub(/:[0-9]+:[0-9]+:.*$/, "", file)
+    printf "%d\t%s\t%s\t%s\n", $2, $3, file, signature
+  }
+' > "$TEMP_DIR/frames"
+
+static_by_group() {
+  awk -F '\t' -v max_depth="$NAMESPACE_DEPTH" "$GROUP_FUNCTION"'
+    {
+      name = group($3)
+      if (name == "") { name = file_group($2) }
+      bytes[name] += $1
+      symbols[name] += 1
+      total += $1
+    }
+    END {
+      for (name in bytes) { printf "%10d %8d  %s\n", bytes[name], symbols[name], name }
+      printf "%10d %8d  %s\n", total, NR, "Total" > "/dev/stderr"
+    }
+  ' "$TEMP_DIR/static" 2> "$TEMP_DIR/static_total" | sort -k 1,1nr
+  cat "$TEMP_DIR/static_total"
+}
+
+frames_by_group() {
+  awk -F '\t' -v max_depth="$NAMESPACE_DEPTH" "$GROUP_FUNCTION"'
+    {
+      name = group($4)
+      if (name == "") { name = file_group($3) }
+      if (!(name in largest) || $1 > largest[name]) {
+        largest[name] = $1
+        function_[name] = $4
+      }
+      if ($2 ~ /dynamic/) { ++dynamic[name] }
+      functions[name] += 1
+    }
+    END {
+      for (name in largest) {
+        printf "%10d %9d %8d  %s\n      in %s\n",
+          largest[name], functions[name], dynamic[name], name, function_[name]
+      }
+    }
+  ' "$TEMP_DIR/frames" | paste - - | sort -k 1,1nr | tr '\t' '\n'
+}
+
+{
+  echo "Memory budget report for $MAP_FILE"
+  echo
+  echo "Static RAM by namespace:"
+  printf "%10s %8s  %s\n" "Bytes" "Symbols" "Group"
+  static_by_group
+  echo
+  if [ ! -s "$TEMP_DIR/frames" ]; then
+    echo "No stack usage found in $BUILD_DIR; was it built with -fstack-usage?"
+    exit 0
+  fi
+  echo "Largest stack frame by namespace:"
+  printf "%10s %9s %8s  %s\n" "Bytes" "Functions" "Dynamic" "Group"
+  frames_by_group
+  echo
+  echo "Largest stack frames:"
+  printf "%10s %-16s %s\n" "Bytes" "Qualifiers" "Function"
+  sort -t "$(printf '\t')" -k 1,1nr "$TEMP_DIR/frames" | head -n 25 |
+    awk -F '\t' '{ printf "%10d %-16s %s\n", $1, $2, $4 }'
+} > "$REPORT_FILE"
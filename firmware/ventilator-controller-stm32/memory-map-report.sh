@@ -0,0 +1,132 @@
+#!/bin/bash
+# Reports where a linked firmware image places its code and data, so that the placement of hot
+# code and data in ITCM, DTCM and D2 SRAM can be checked after every build.
+#
+# Usage: ./memory-map-report.sh <firmware.elf> <linker script> [report file]
+# The OBJDUMP and NM environment variables can be set to override the binutils which are used.
+
+if [ "$#" -lt 2 ]; then
+  echo "Usage: $0 <firmware.elf> <linker script> [report file]"
+  exit 1
+fi
+
+ELF_FILE="$1"
+LINKER_SCRIPT="$2"
+REPORT_FILE="${3:-/dev/stdout}"
+OBJDUMP="${OBJDUMP:-arm-none-eabi-objdump}"
+NM="${NM:-arm-none-eabi-nm}"
+
+# Regions listed in the MEMORY command of the linker script, as "name origin length" lines
+REGIONS=`awk '
+  function hex(value,    result, i, digit) {
+    sub(/^0[xX]/, "", value)
+    result = 0
+    for (i = 1; i <= length(value); ++i) {
+      digit = index("0123456789abcdef", tolower(substr(value, i, 1))) - 1
+      result = result * 16 + digit
+    }
+    return result
+  }
+  function bytes(value,    multiplier) {
+    multiplier = 1
+    if (value ~ /[Kk]$/) { multiplier = 1024 }
+    if (value ~ /[Mm]$/) { multiplier = 1024 * 1024 }
+    sub(/[KkMm]$/, "", value)
+    return ((value ~ /^0[xX]/) ? hex(value) : value + 0) * multiplier
+  }
+  /^MEMORY/ { in_memory = 1; next }
+  in_memory && /^}/ { exit }
+  in_memory && /ORIGIN/ {
+    line = $0
+    gsub(/[=,:]/, " ", line)
+    split(line, fields, " ")
+    for (i in fields) {
+      if (fields[i] == "ORIGIN") { origin = fields[i + 1] }
+      if (fields[i] == "LENGTH") { length_ = fields[i + 1] }
+    }
+    print fields[1], bytes(origin), bytes(length_)
+  }
+' "$LINKER_SCRIPT"`
+if [ -z "$REGIONS" ]; then
+  echo "No memory regions found in $LINKER_SCRIPT"
+  exit 1
+fi
+
+# Region usage from the output sections. A section which is copied at startup (e.g. .data or
+# .itcm_text) uses space both in the region it runs from and in the region it is loaded from.
+region_usage() {
+  "$OBJDUMP" -h "$ELF_FILE" | awk -v regions="$REGIONS" '
+    function hex(value,    result, i, digit) {
+      sub(/^0[xX]/, "", value)
+      result = 0
+      for (i = 1; i <= length(value); ++i) {
+        digit = index("0123456789abcdef", tolower(substr(value, i, 1))) - 1
+        result = result * 16 + digit
+      }
+      return result
+    }
+    BEGIN {
+      num_regions = split(regions, lines, "\n")
+      for (i = 1; i <= num_regions; ++i) {
+        split(lines[i], fields, " ")
+        names[i] = fields[1]; origins[i] = fields[2]; lengths[i] = fields[3]; used[i] = 0
+      }
+    }
+    function region(address,    i) {
+      for (i = 1; i <= num_regions; ++i) {
+        if (address >= origins[i] && address < origins[i] + lengths[i]) { return i }
+      }
+      return 0
+    }
+    $1 ~ /^[0-9]+$/ && NF >= 6 { name = $2; size = hex($3); vma = hex($4); lma = hex($5); next }
+    name != "" && /ALLOC/ {
+      used[region(vma)] += size
+      if (/LOAD/ && lma != vma) { used[region(lma)] += size }
+      name = ""
+    }
+    END {
+      printf "%-12s %12s %12s %8s\n", "Region", "Used", "Size", "Usage"
+      for (i = 1; i <= num_regions; ++i) {
+        printf "%-12s %12d %12d %7.2f%%\n", names[i], used[i], lengths[i], 100 * used[i] / lengths[i]
+      }
+    }
+  '
+}
+
+# Symbols placed in a region, largest first
+region_symbols() {
+  "$NM" -S -C --size-sort -r "$ELF_FILE" | awk -v origin="$2" -v length_="$3" '
+    function hex(value,    result, i, digit) {
+      sub(/^0[xX]/, "", value)
+      result = 0
+      for (i = 1; i <= length(value); ++i) {
+        digit = index("0123456789abcdef", tolower(substr(value, i, 1))) - 1
+        result = result * 16 + digit
+      }
+      return result
+    }
+    {
+      address = hex($1)
+      if (NF < 4 || address < origin || address >= origin + length_) { next }
+      size = hex($2)
+      name = $4
+      for (i = 5; i <= NF; ++i) { name = name " " $i }
+      printf "  0x%08x %8d %s %s\n", address, size, $3, name
+    }
+  '
+}
+
+{
+  echo "Memory map report for $ELF_FILE"
+  echo
+  region_usage
+  # Code and data only ever lands outside flash and RAM_D1 because it was explicitly placed
+  echo "$REGIONS" | while read NAME ORIGIN LENGTH; do
+    if [ "$NAME" == "FLASH" ] || [ "$NAME" == "RAM_D1" ]; then
+      continue
+    fi
+    echo
+    echo "Symbols in $NAME:"
+    region_symbols "$NAME" "$ORIGIN" "$LENGTH"
+  done
+} > "$REPORT_FILE"